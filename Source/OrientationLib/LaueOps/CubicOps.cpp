@@ -35,6 +35,8 @@
 
 #include "CubicOps.h"
 
+#include <algorithm>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -1351,6 +1353,210 @@ void CubicOps::getF7(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F7)
   }
 }
 
+namespace Detail
+{
+  namespace CubicHigh
+  {
+    static const int k_NumSlipSystems = 12;
+
+    /**
+     * @brief The SlipSystemTable struct holds the 12 {111}<110> slip systems of one orientation rotated
+     * into the sample frame and normalized, stored component by component so the pair loops below
+     * run over contiguous arrays.
+     */
+    struct SlipSystemTable
+    {
+      float dirX[k_NumSlipSystems];
+      float dirY[k_NumSlipSystems];
+      float dirZ[k_NumSlipSystems];
+      float planeX[k_NumSlipSystems];
+      float planeY[k_NumSlipSystems];
+      float planeZ[k_NumSlipSystems];
+      float planeComponent[k_NumSlipSystems];
+      float schmidFactor[k_NumSlipSystems];
+    };
+
+    /**
+     * @brief fillSlipSystemTable Rotates the slip systems by the transpose of the orientation matrix of q,
+     * exactly as getmPrime() and getF1() do, and caches the Schmid factor of each system for the unit
+     * loading direction ld.
+     */
+    static void fillSlipSystemTable(const QuatF& q, const float ld[3], SlipSystemTable& table)
+    {
+      float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+      FOrientArrayType om(9);
+      FOrientTransformsType::qu2om(FOrientArrayType(q), om);
+      om.toGMatrix(g);
+
+      float v[3] = {0.0f, 0.0f, 0.0f};
+      for(int i = 0; i < k_NumSlipSystems; i++)
+      {
+        v[0] = g[0][0] * CubicSlipDirections[i][0] + g[1][0] * CubicSlipDirections[i][1] + g[2][0] * CubicSlipDirections[i][2];
+        v[1] = g[0][1] * CubicSlipDirections[i][0] + g[1][1] * CubicSlipDirections[i][1] + g[2][1] * CubicSlipDirections[i][2];
+        v[2] = g[0][2] * CubicSlipDirections[i][0] + g[1][2] * CubicSlipDirections[i][1] + g[2][2] * CubicSlipDirections[i][2];
+        MatrixMath::Normalize3x1(v);
+        table.dirX[i] = v[0];
+        table.dirY[i] = v[1];
+        table.dirZ[i] = v[2];
+        float directionComponent = std::fabs(ld[0] * v[0] + ld[1] * v[1] + ld[2] * v[2]);
+
+        v[0] = g[0][0] * CubicSlipPlanes[i][0] + g[1][0] * CubicSlipPlanes[i][1] + g[2][0] * CubicSlipPlanes[i][2];
+        v[1] = g[0][1] * CubicSlipPlanes[i][0] + g[1][1] * CubicSlipPlanes[i][1] + g[2][1] * CubicSlipPlanes[i][2];
+        v[2] = g[0][2] * CubicSlipPlanes[i][0] + g[1][2] * CubicSlipPlanes[i][1] + g[2][2] * CubicSlipPlanes[i][2];
+        MatrixMath::Normalize3x1(v);
+        table.planeX[i] = v[0];
+        table.planeY[i] = v[1];
+        table.planeZ[i] = v[2];
+        table.planeComponent[i] = std::fabs(ld[0] * v[0] + ld[1] * v[1] + ld[2] * v[2]);
+
+        table.schmidFactor[i] = directionComponent * table.planeComponent[i];
+      }
+    }
+
+    /**
+     * @brief maxSchmidFactorSystem Returns the first slip system holding the largest Schmid factor, or 0 if
+     * every Schmid factor is 0, matching the strict comparison used by the single pair methods.
+     */
+    static int maxSchmidFactorSystem(const SlipSystemTable& table)
+    {
+      int ss = 0;
+      float maxSchmidFactor = 0.0f;
+      for(int i = 0; i < k_NumSlipSystems; i++)
+      {
+        if(table.schmidFactor[i] > maxSchmidFactor)
+        {
+          maxSchmidFactor = table.schmidFactor[i];
+          ss = i;
+        }
+      }
+      return ss;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getSlipTransmissionMetrics(const QuatF& q1, const QuatF* quats, const int32_t* neighbors, size_t count, const float LD[3], bool maxSF, float* mPrime, float* F1, float* F1spt,
+                                          float* F7)
+{
+  using namespace Detail::CubicHigh;
+
+  float ld[3] = {LD[0], LD[1], LD[2]};
+  MatrixMath::Normalize3x1(ld);
+
+  SlipSystemTable table1;
+  SlipSystemTable table2;
+  fillSlipSystemTable(q1, ld, table1);
+  int ss1 = maxSchmidFactorSystem(table1);
+
+  // With maxSF only the highest Schmid factor system of q1 contributes, otherwise every system competes
+  int first = maxSF ? ss1 : 0;
+  int last = maxSF ? ss1 + 1 : k_NumSlipSystems;
+
+  for(size_t n = 0; n < count; n++)
+  {
+    fillSlipSystemTable(quats[(nullptr != neighbors) ? neighbors[n] : n], ld, table2);
+
+    if(nullptr != mPrime)
+    {
+      int ss2 = maxSchmidFactorSystem(table2);
+      float planeMisalignment = std::fabs(table1.dirX[ss1] * table2.dirX[ss2] + table1.dirY[ss1] * table2.dirY[ss2] + table1.dirZ[ss1] * table2.dirZ[ss2]);
+      float directionMisalignment = std::fabs(table1.planeX[ss1] * table2.planeX[ss2] + table1.planeY[ss1] * table2.planeY[ss2] + table1.planeZ[ss1] * table2.planeZ[ss2]);
+      mPrime[n] = planeMisalignment * directionMisalignment;
+    }
+
+    float maxF1 = 0.0f, maxF1spt = 0.0f, maxF7 = 0.0f;
+    for(int i = first; i < last; i++)
+    {
+      float totalDirectionMisalignment = 0.0f;
+      float totalPlaneMisalignment = 0.0f;
+      for(int j = 0; j < k_NumSlipSystems; j++)
+      {
+        totalDirectionMisalignment += std::fabs(table1.planeX[i] * table2.planeX[j] + table1.planeY[i] * table2.planeY[j] + table1.planeZ[i] * table2.planeZ[j]);
+        totalPlaneMisalignment += std::fabs(table1.dirX[i] * table2.dirX[j] + table1.dirY[i] * table2.dirY[j] + table1.dirZ[i] * table2.dirZ[j]);
+      }
+      float f1 = table1.schmidFactor[i] * table1.planeComponent[i] * totalDirectionMisalignment;
+      float f7 = table1.planeComponent[i] * table1.planeComponent[i] * totalDirectionMisalignment;
+      maxF1 = std::max(maxF1, f1);
+      maxF1spt = std::max(maxF1spt, f1 * totalPlaneMisalignment);
+      maxF7 = std::max(maxF7, f7);
+    }
+
+    if(nullptr != F1)
+    {
+      F1[n] = maxF1;
+    }
+    if(nullptr != F1spt)
+    {
+      F1spt[n] = maxF1spt;
+    }
+    if(nullptr != F7)
+    {
+      F7[n] = maxF7;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getSchmidFactorsAndSS(const float* loads, size_t count, float plane[3], float direction[3], float* schmidFactors, float* angleComps, int32_t* slipSystems)
+{
+  // Build the symmetrically equivalent slip systems once; planes with a negative z component are
+  // duplicates of the ones kept and are skipped just like in the single load version.
+  float planeX[k_NumSymQuats], planeY[k_NumSymQuats], planeZ[k_NumSymQuats];
+  float dirX[k_NumSymQuats], dirY[k_NumSymQuats], dirZ[k_NumSymQuats];
+  int32_t symOp[k_NumSymQuats];
+  int numSystems = 0;
+  float planeMag = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+  float directionMag = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+  for(int i = 0; i < k_NumSymQuats; i++)
+  {
+    float z = CubicMatSym[i][2][0] * plane[0] + CubicMatSym[i][2][1] * plane[1] + CubicMatSym[i][2][2] * plane[2];
+    if(z >= 0)
+    {
+      planeX[numSystems] = (CubicMatSym[i][0][0] * plane[0] + CubicMatSym[i][0][1] * plane[1] + CubicMatSym[i][0][2] * plane[2]) / planeMag;
+      planeY[numSystems] = (CubicMatSym[i][1][0] * plane[0] + CubicMatSym[i][1][1] * plane[1] + CubicMatSym[i][1][2] * plane[2]) / planeMag;
+      planeZ[numSystems] = z / planeMag;
+      dirX[numSystems] = (CubicMatSym[i][0][0] * direction[0] + CubicMatSym[i][0][1] * direction[1] + CubicMatSym[i][0][2] * direction[2]) / directionMag;
+      dirY[numSystems] = (CubicMatSym[i][1][0] * direction[0] + CubicMatSym[i][1][1] * direction[1] + CubicMatSym[i][1][2] * direction[2]) / directionMag;
+      dirZ[numSystems] = (CubicMatSym[i][2][0] * direction[0] + CubicMatSym[i][2][1] * direction[1] + CubicMatSym[i][2][2] * direction[2]) / directionMag;
+      symOp[numSystems] = i;
+      numSystems++;
+    }
+  }
+
+  for(size_t n = 0; n < count; n++)
+  {
+    const float* load = loads + 3 * n;
+    float loadMag = std::sqrt(load[0] * load[0] + load[1] * load[1] + load[2] * load[2]);
+    float schmidFactor = 0.0f, maxCosPhi = 0.0f, maxCosLambda = 0.0f;
+    int32_t slipsys = 0;
+    for(int s = 0; s < numSystems; s++)
+    {
+      float cosPhi = std::fabs(load[0] * planeX[s] + load[1] * planeY[s] + load[2] * planeZ[s]) / loadMag;
+      float cosLambda = std::fabs(load[0] * dirX[s] + load[1] * dirY[s] + load[2] * dirZ[s]) / loadMag;
+      float schmid = cosPhi * cosLambda;
+      if(schmid > schmidFactor)
+      {
+        schmidFactor = schmid;
+        slipsys = symOp[s];
+        maxCosPhi = cosPhi;
+        maxCosLambda = cosLambda;
+      }
+    }
+    schmidFactors[n] = schmidFactor;
+    slipSystems[n] = slipsys;
+    if(nullptr != angleComps)
+    {
+      angleComps[2 * n] = (schmidFactor > 0.0f) ? std::acos(maxCosPhi) : 0.0f;
+      angleComps[2 * n + 1] = (schmidFactor > 0.0f) ? std::acos(maxCosLambda) : 0.0f;
+    }
+  }
+}
+
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
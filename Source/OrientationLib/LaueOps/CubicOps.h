@@ -118,6 +118,11 @@ class OrientationLib_EXPORT CubicOps : public LaueOps
     virtual void getF1spt(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F1spt);
     virtual void getF7(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F7);
 
+    using LaueOps::getSchmidFactorsAndSS;
+    virtual void getSchmidFactorsAndSS(const float* loads, size_t count, float plane[3], float direction[3], float* schmidFactors, float* angleComps, int32_t* slipSystems);
+    virtual void getSlipTransmissionMetrics(const QuatF& q1, const QuatF* quats, const int32_t* neighbors, size_t count, const float LD[3], bool maxSF, float* mPrime, float* F1, float* F1spt,
+                                            float* F7);
+
 
     virtual void generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatArrayType* c1, FloatArrayType* c2, FloatArrayType* c3);
 
@@ -0,0 +1,181 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "IPFColorLookupTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Utilities/ColorTable.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+/**
+ * @brief The FillIPFColorLookupTableImpl class implements a threaded algorithm that samples the IPF colors of
+ * a Laue class for a range of rows of the lookup table. Each grid node is mapped back from the stereographic
+ * projection to a crystal direction d, and the color is taken from an orientation that carries the sample
+ * Z axis onto d.
+ */
+class FillIPFColorLookupTableImpl
+{
+public:
+  FillIPFColorLookupTableImpl(LaueOps* ops, int resolution, uint8_t* colors)
+  : m_Ops(ops)
+  , m_Resolution(resolution)
+  , m_Colors(colors)
+  {
+  }
+  virtual ~FillIPFColorLookupTableImpl() = default;
+
+  void fill(size_t start, size_t end) const
+  {
+    float halfResolution = 0.5f * static_cast<float>(m_Resolution);
+    size_t rows = static_cast<size_t>(m_Resolution);
+    for(size_t r = start; r < end; r++)
+    {
+      size_t hemisphere = r / rows;
+      size_t row = r % rows;
+      float zSign = (hemisphere == 0) ? 1.0f : -1.0f;
+      for(size_t col = 0; col < rows; col++)
+      {
+        float px = (static_cast<float>(col) + 0.5f) / halfResolution - 1.0f;
+        float py = (static_cast<float>(row) + 0.5f) / halfResolution - 1.0f;
+        float rr = px * px + py * py;
+        // Nodes outside of the projection circle take the color of the nearest point on the equator
+        if(rr > 1.0f)
+        {
+          float norm = std::sqrt(rr);
+          px /= norm;
+          py /= norm;
+          rr = 1.0f;
+        }
+        float dir[3] = {2.0f * px / (1.0f + rr), 2.0f * py / (1.0f + rr), zSign * (1.0f - rr) / (1.0f + rr)};
+
+        // The third column of the Bunge orientation matrix is (sin(phi2)sin(Phi), cos(phi2)sin(Phi), cos(Phi))
+        double phi = std::acos(std::max(-1.0f, std::min(1.0f, dir[2])));
+        double phi2 = std::atan2(dir[0], dir[1]);
+        SIMPL::Rgb argb = m_Ops->generateIPFColor(0.0, phi, phi2, 0.0, 0.0, 1.0, false);
+
+        uint8_t* node = m_Colors + 3 * (r * rows + col);
+        node[0] = static_cast<uint8_t>(RgbColor::dRed(argb));
+        node[1] = static_cast<uint8_t>(RgbColor::dGreen(argb));
+        node[2] = static_cast<uint8_t>(RgbColor::dBlue(argb));
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    fill(r.begin(), r.end());
+  }
+#endif
+
+private:
+  LaueOps* m_Ops;
+  int m_Resolution;
+  uint8_t* m_Colors;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::IPFColorLookupTable(LaueOps* ops, int resolution)
+: m_Resolution(resolution)
+, m_HalfResolution(0.5f * static_cast<float>(resolution))
+, m_HasInversion(ops->getHasInversion())
+, m_HemisphereSize(3 * static_cast<size_t>(resolution) * static_cast<size_t>(resolution))
+{
+  size_t numHemispheres = m_HasInversion ? 1 : 2;
+  m_Colors.resize(numHemispheres * m_HemisphereSize, 0);
+  size_t totalRows = numHemispheres * static_cast<size_t>(m_Resolution);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalRows), FillIPFColorLookupTableImpl(ops, m_Resolution, m_Colors.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FillIPFColorLookupTableImpl serial(ops, m_Resolution, m_Colors.data());
+    serial.fill(0, totalRows);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::~IPFColorLookupTable() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::Pointer IPFColorLookupTable::New(LaueOps* ops, int resolution)
+{
+  Pointer sharedPtr(new IPFColorLookupTable(ops, resolution));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorLookupTable::Pointer IPFColorLookupTable::GetLookupTable(LaueOps* ops)
+{
+  static std::mutex tablesMutex;
+  static std::map<QString, Pointer> tables;
+
+  std::lock_guard<std::mutex> lock(tablesMutex);
+  QString name = ops->getSymmetryName();
+  std::map<QString, Pointer>::iterator iter = tables.find(name);
+  if(iter != tables.end())
+  {
+    return iter->second;
+  }
+  Pointer table = New(ops, DefaultResolution);
+  tables[name] = table;
+  return table;
+}
@@ -0,0 +1,185 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+#include "OrientationLib/OrientationLib.h"
+
+class LaueOps;
+
+/**
+ * @brief The IPFColorLookupTable class holds the IPF color of every crystal direction of one Laue class.
+ * The colors are sampled on a square grid laid over the stereographic projection of the upper hemisphere
+ * (and of the lower hemisphere for classes without inversion symmetry). The IPF color of an orientation only
+ * depends on the crystal direction that is parallel to the reference direction, so once the table exists
+ * coloring an orientation costs one matrix-vector product and a table read instead of a loop over the
+ * symmetry operators.
+ */
+class OrientationLib_EXPORT IPFColorLookupTable
+{
+  public:
+    SIMPL_SHARED_POINTERS(IPFColorLookupTable)
+    SIMPL_TYPE_MACRO(IPFColorLookupTable)
+
+    /**
+     * @brief New Builds a table for the Laue class of ops
+     * @param ops The Laue class whose generateIPFColor() is sampled
+     * @param resolution Number of grid nodes along each side of a hemisphere
+     * @return
+     */
+    static Pointer New(LaueOps* ops, int resolution = DefaultResolution);
+
+    /**
+     * @brief GetLookupTable Returns the table of the Laue class of ops at the default resolution. The
+     * table is built the first time it is requested and shared afterwards.
+     * @param ops
+     * @return
+     */
+    static Pointer GetLookupTable(LaueOps* ops);
+
+    virtual ~IPFColorLookupTable();
+
+    static const int DefaultResolution = 512;
+
+    /**
+     * @brief getResolution Returns the number of grid nodes along each side of a hemisphere
+     * @return
+     */
+    int getResolution() const
+    {
+      return m_Resolution;
+    }
+
+    /**
+     * @brief getColor Writes the IPF color of a crystal direction into rgb
+     * @param dir Unit vector in the crystal reference frame
+     * @param rgb Receives the red, green and blue values
+     * @param interpolate Blend the four surrounding grid nodes instead of taking the nearest one
+     */
+    void getColor(const float dir[3], uint8_t* rgb, bool interpolate) const
+    {
+      float x = dir[0];
+      float y = dir[1];
+      float z = dir[2];
+      size_t hemisphere = 0;
+      if(z < 0.0f)
+      {
+        if(m_HasInversion)
+        {
+          x = -x;
+          y = -y;
+          z = -z;
+        }
+        else
+        {
+          hemisphere = 1;
+          z = -z;
+        }
+      }
+      // Grid node i sits at the center of the i'th cell of the projection plane
+      float denom = 1.0f / (1.0f + z);
+      float u = (x * denom + 1.0f) * m_HalfResolution - 0.5f;
+      float v = (y * denom + 1.0f) * m_HalfResolution - 0.5f;
+      const uint8_t* table = m_Colors.data() + hemisphere * m_HemisphereSize;
+
+      if(!interpolate)
+      {
+        size_t col = clampNode(static_cast<int>(u + 0.5f));
+        size_t row = clampNode(static_cast<int>(v + 0.5f));
+        const uint8_t* node = table + 3 * (row * m_Resolution + col);
+        rgb[0] = node[0];
+        rgb[1] = node[1];
+        rgb[2] = node[2];
+        return;
+      }
+
+      float fu = std::floor(u);
+      float fv = std::floor(v);
+      float wu = u - fu;
+      float wv = v - fv;
+      size_t col0 = clampNode(static_cast<int>(fu));
+      size_t row0 = clampNode(static_cast<int>(fv));
+      size_t col1 = clampNode(static_cast<int>(fu) + 1);
+      size_t row1 = clampNode(static_cast<int>(fv) + 1);
+      const uint8_t* n00 = table + 3 * (row0 * m_Resolution + col0);
+      const uint8_t* n01 = table + 3 * (row0 * m_Resolution + col1);
+      const uint8_t* n10 = table + 3 * (row1 * m_Resolution + col0);
+      const uint8_t* n11 = table + 3 * (row1 * m_Resolution + col1);
+      for(int c = 0; c < 3; c++)
+      {
+        float bottom = n00[c] + wu * (n01[c] - n00[c]);
+        float top = n10[c] + wu * (n11[c] - n10[c]);
+        rgb[c] = static_cast<uint8_t>(bottom + wv * (top - bottom) + 0.5f);
+      }
+    }
+
+  protected:
+    IPFColorLookupTable(LaueOps* ops, int resolution);
+
+    /**
+     * @brief clampNode Keeps a grid index inside the table
+     * @param index
+     * @return
+     */
+    size_t clampNode(int index) const
+    {
+      if(index < 0)
+      {
+        return 0;
+      }
+      if(index >= m_Resolution)
+      {
+        return static_cast<size_t>(m_Resolution - 1);
+      }
+      return static_cast<size_t>(index);
+    }
+
+  private:
+    int m_Resolution;
+    float m_HalfResolution;
+    bool m_HasInversion;
+    size_t m_HemisphereSize;
+    std::vector<uint8_t> m_Colors;
+
+    IPFColorLookupTable(const IPFColorLookupTable&) = delete; // Copy Constructor Not Implemented
+    void operator=(const IPFColorLookupTable&) = delete;     // Move assignment Not Implemented
+};
+
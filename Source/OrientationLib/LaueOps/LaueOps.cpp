@@ -41,15 +41,17 @@
 
 #include <QtCore/QDateTime>
 
-#include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Utilities/ColorTable.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/CounterRandomGenerator.hpp"
 
 #include "OrientationLib/LaueOps/CubicLowOps.h"
 #include "OrientationLib/LaueOps/CubicOps.h"
 #include "OrientationLib/LaueOps/HexagonalLowOps.h"
 #include "OrientationLib/LaueOps/HexagonalOps.h"
+#include "OrientationLib/LaueOps/IPFColorLookupTable.h"
 #include "OrientationLib/LaueOps/MonoclinicOps.h"
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
 #include "OrientationLib/LaueOps/TetragonalLowOps.h"
@@ -297,12 +299,14 @@ void LaueOps::_calcDetermineHomochoricValues(uint64_t seed, float init[3], float
 {
   float random;
 
-  SIMPL_RANDOMNG_NEW_SEEDED(seed)
-  random = static_cast<float>(rg.genrand_res53());
+  // Seeding a Mersenne Twister for every orientation costs far more than the three numbers drawn from it; the
+  // counter based generator gives the same kind of per-seed reproducibility for free, and is safe to use from threads
+  CounterRandomGenerator rg(seed);
+  random = static_cast<float>(rg.genrand_res53(0));
   r1 = (step[0] * phi[0]) + (step[0] * random) - (init[0]);
-  random = static_cast<float>(rg.genrand_res53());
+  random = static_cast<float>(rg.genrand_res53(1));
   r2 = (step[1] * phi[1]) + (step[1] * random) - (init[1]);
-  random = static_cast<float>(rg.genrand_res53());
+  random = static_cast<float>(rg.genrand_res53(2));
   r3 = (step[2] * phi[2]) + (step[2] * random) - (init[2]);
 }
 
@@ -415,6 +419,180 @@ std::vector<QString> LaueOps::GetLaueNames()
   return names;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::generateIPFColors(const float* eulers, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate)
+{
+  IPFColorLookupTable::Pointer table = IPFColorLookupTable::GetLookupTable(this);
+  generateIPFColors(table.get(), eulers, count, refDir, rgb, interpolate);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::generateIPFColors(const IPFColorLookupTable* table, const float* eulers, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate)
+{
+  float sampleDir[3] = {refDir[0], refDir[1], refDir[2]};
+  MatrixMath::Normalize3x1(sampleDir);
+  float g[9] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  FOrientArrayType om(g, 9);
+  float crystalDir[3] = {0.0f, 0.0f, 0.0f};
+  for(size_t i = 0; i < count; i++)
+  {
+    FOrientTransformsType::eu2om(FOrientArrayType(const_cast<float*>(eulers + 3 * i), 3), om);
+    crystalDir[0] = g[0] * sampleDir[0] + g[1] * sampleDir[1] + g[2] * sampleDir[2];
+    crystalDir[1] = g[3] * sampleDir[0] + g[4] * sampleDir[1] + g[5] * sampleDir[2];
+    crystalDir[2] = g[6] * sampleDir[0] + g[7] * sampleDir[1] + g[8] * sampleDir[2];
+    table->getColor(crystalDir, rgb + 3 * i, interpolate);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::generateIPFColorsFromQuats(const float* quats, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate)
+{
+  IPFColorLookupTable::Pointer table = IPFColorLookupTable::GetLookupTable(this);
+  generateIPFColorsFromQuats(table.get(), quats, count, refDir, rgb, interpolate);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::generateIPFColorsFromQuats(const IPFColorLookupTable* table, const float* quats, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate)
+{
+  float sampleDir[3] = {refDir[0], refDir[1], refDir[2]};
+  MatrixMath::Normalize3x1(sampleDir);
+  float g[9] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  FOrientArrayType om(g, 9);
+  float crystalDir[3] = {0.0f, 0.0f, 0.0f};
+  for(size_t i = 0; i < count; i++)
+  {
+    FOrientTransformsType::qu2om(FOrientArrayType(const_cast<float*>(quats + 4 * i), 4), om);
+    crystalDir[0] = g[0] * sampleDir[0] + g[1] * sampleDir[1] + g[2] * sampleDir[2];
+    crystalDir[1] = g[3] * sampleDir[0] + g[4] * sampleDir[1] + g[5] * sampleDir[2];
+    crystalDir[2] = g[6] * sampleDir[0] + g[7] * sampleDir[1] + g[8] * sampleDir[2];
+    MatrixMath::Normalize3x1(crystalDir);
+    table->getColor(crystalDir, rgb + 3 * i, interpolate);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::getSchmidFactorsAndSS(const float* loads, size_t count, float* schmidFactors, float* angleComps, int32_t* slipSystems)
+{
+  float load[3] = {0.0f, 0.0f, 0.0f};
+  float angles[2] = {0.0f, 0.0f};
+  int ss = 0;
+  for(size_t i = 0; i < count; i++)
+  {
+    load[0] = loads[3 * i];
+    load[1] = loads[3 * i + 1];
+    load[2] = loads[3 * i + 2];
+    getSchmidFactorAndSS(load, schmidFactors[i], angles, ss);
+    slipSystems[i] = ss;
+    if(nullptr != angleComps)
+    {
+      angleComps[2 * i] = angles[0];
+      angleComps[2 * i + 1] = angles[1];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::getSchmidFactorsAndSS(const float* loads, size_t count, float plane[3], float direction[3], float* schmidFactors, float* angleComps, int32_t* slipSystems)
+{
+  float load[3] = {0.0f, 0.0f, 0.0f};
+  float angles[2] = {0.0f, 0.0f};
+  int ss = 0;
+  for(size_t i = 0; i < count; i++)
+  {
+    load[0] = loads[3 * i];
+    load[1] = loads[3 * i + 1];
+    load[2] = loads[3 * i + 2];
+    getSchmidFactorAndSS(load, plane, direction, schmidFactors[i], angles, ss);
+    slipSystems[i] = ss;
+    if(nullptr != angleComps)
+    {
+      angleComps[2 * i] = angles[0];
+      angleComps[2 * i + 1] = angles[1];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::getSlipTransmissionMetrics(const QuatF& q1, const QuatF* quats, const int32_t* neighbors, size_t count, const float LD[3], bool maxSF, float* mPrime, float* F1, float* F1spt,
+                                         float* F7)
+{
+  QuatF qa = QuaternionMathF::New();
+  QuatF qb = QuaternionMathF::New();
+  float ld[3] = {0.0f, 0.0f, 0.0f};
+  float value = 0.0f;
+  for(size_t i = 0; i < count; i++)
+  {
+    QuaternionMathF::Copy(q1, qa);
+    QuaternionMathF::Copy(quats[(nullptr != neighbors) ? neighbors[i] : i], qb);
+    // The single pair methods may normalize the loading direction in place
+    ld[0] = LD[0], ld[1] = LD[1], ld[2] = LD[2];
+    if(nullptr != mPrime)
+    {
+      value = 0.0f;
+      getmPrime(qa, qb, ld, value);
+      mPrime[i] = value;
+    }
+    if(nullptr != F1)
+    {
+      value = 0.0f;
+      getF1(qa, qb, ld, maxSF, value);
+      F1[i] = value;
+    }
+    if(nullptr != F1spt)
+    {
+      value = 0.0f;
+      getF1spt(qa, qb, ld, maxSF, value);
+      F1spt[i] = value;
+    }
+    if(nullptr != F7)
+    {
+      value = 0.0f;
+      getF7(qa, qb, ld, maxSF, value);
+      F7[i] = value;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::getOdfBins(const float* eulers, size_t count, int32_t* bins)
+{
+  FOrientArrayType rod(4);
+  for(size_t i = 0; i < count; i++)
+  {
+    FOrientTransformsType::eu2ro(FOrientArrayType(const_cast<float*>(eulers + 3 * i), 3), rod);
+    bins[i] = getOdfBin(rod);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::getMisoBins(const float* axisAngles, size_t count, int32_t* bins)
+{
+  FOrientArrayType rod(4);
+  for(size_t i = 0; i < count; i++)
+  {
+    FOrientTransformsType::ax2ro(FOrientArrayType(const_cast<float*>(axisAngles + 4 * i), 4), rod);
+    bins[i] = getMisoBin(rod);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
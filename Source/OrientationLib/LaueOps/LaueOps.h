@@ -50,6 +50,7 @@
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
+class IPFColorLookupTable;
 
 /*
  * @class LaueOps LaueOps.h OrientationLib/LaueOps/LaueOps.h
@@ -152,6 +153,64 @@ class OrientationLib_EXPORT LaueOps
     virtual void getF1spt(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F1spt) = 0;
     virtual void getF7(QuatF& q1, QuatF& q2, float LD[3], bool maxSF, float& F7) = 0;
 
+    /**
+     * @brief getSchmidFactorsAndSS Batch form of getSchmidFactorAndSS() for an array of loading directions
+     * that are already expressed in the crystal frame of this Laue class.
+     * @param loads Loading directions, 3 values per entry
+     * @param count Number of loading directions
+     * @param schmidFactors [output] 1 value per entry
+     * @param angleComps [output] 2 values per entry, may be nullptr
+     * @param slipSystems [output] 1 value per entry
+     */
+    virtual void getSchmidFactorsAndSS(const float* loads, size_t count, float* schmidFactors, float* angleComps, int32_t* slipSystems);
+
+    /**
+     * @brief getSchmidFactorsAndSS Batch form of getSchmidFactorAndSS() for a user supplied slip system. The
+     * symmetrically equivalent copies of the slip system are generated once for the whole array.
+     * @param loads Loading directions in the crystal frame, 3 values per entry
+     * @param count Number of loading directions
+     * @param plane Slip plane normal
+     * @param direction Slip direction
+     * @param schmidFactors [output] 1 value per entry
+     * @param angleComps [output] 2 values per entry, may be nullptr
+     * @param slipSystems [output] 1 value per entry
+     */
+    virtual void getSchmidFactorsAndSS(const float* loads, size_t count, float plane[3], float direction[3], float* schmidFactors, float* angleComps, int32_t* slipSystems);
+
+    /**
+     * @brief getSlipTransmissionMetrics Evaluates mPrime, F1, F1spt and F7 between one orientation and a list
+     * of other orientations in a single pass. Implementations that support these metrics rotate the slip
+     * systems of q1 once for the whole list and those of each neighbor once for all four metrics.
+     * @param q1 Orientation on the transmitting side of every pair
+     * @param quats Orientation array the neighbors are read from
+     * @param neighbors Indices into quats, or nullptr to use quats[0] ... quats[count - 1]
+     * @param count Number of pairs
+     * @param LD Loading direction in the sample frame
+     * @param maxSF Use only the slip system with the highest Schmid factor in q1 for F1, F1spt and F7
+     * @param mPrime [output] 1 value per pair, may be nullptr
+     * @param F1 [output] 1 value per pair, may be nullptr
+     * @param F1spt [output] 1 value per pair, may be nullptr
+     * @param F7 [output] 1 value per pair, may be nullptr
+     */
+    virtual void getSlipTransmissionMetrics(const QuatF& q1, const QuatF* quats, const int32_t* neighbors, size_t count, const float LD[3], bool maxSF, float* mPrime, float* F1, float* F1spt,
+                                            float* F7);
+
+    /**
+     * @brief getOdfBins Batch form of getOdfBin() for an array of orientations given as Euler angles
+     * @param eulers Bunge Euler angles, 3 values per entry
+     * @param count Number of orientations
+     * @param bins [output] 1 value per entry
+     */
+    virtual void getOdfBins(const float* eulers, size_t count, int32_t* bins);
+
+    /**
+     * @brief getMisoBins Batch form of getMisoBin() for an array of misorientations given in axis-angle form
+     * @param axisAngles Unit axis followed by the angle, 4 values per entry
+     * @param count Number of misorientations
+     * @param bins [output] 1 value per entry
+     */
+    virtual void getMisoBins(const float* axisAngles, size_t count, int32_t* bins);
+
 
     virtual void generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatArrayType* c1, FloatArrayType* c2, FloatArrayType* c3) = 0;
 
@@ -186,6 +245,53 @@ class OrientationLib_EXPORT LaueOps
      */
     virtual SIMPL::Rgb generateRodriguesColor(float r1, float r2, float r3) = 0;
 
+    /**
+     * @brief generateIPFColors Generates the IPF colors of an array of orientations that all belong to this
+     * Laue class. The colors are read from the shared IPFColorLookupTable of the Laue class instead of
+     * searching the symmetry operators of every orientation. Fetching the shared table takes a lock, so
+     * parallel loops should fetch it once and call the overload that takes the table instead.
+     * @param eulers Bunge Euler angles in radians, 3 values per orientation
+     * @param count Number of orientations
+     * @param refDir Reference direction in the sample frame
+     * @param rgb [output] 3 values per orientation
+     * @param interpolate Blend the surrounding lookup table nodes instead of taking the nearest one
+     */
+    void generateIPFColors(const float* eulers, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate = false);
+
+    /**
+     * @brief generateIPFColorsFromQuats Same as generateIPFColors() for orientations given as quaternions
+     * @param quats Quaternions in (x, y, z, w) order, 4 values per orientation
+     * @param count Number of orientations
+     * @param refDir Reference direction in the sample frame
+     * @param rgb [output] 3 values per orientation
+     * @param interpolate Blend the surrounding lookup table nodes instead of taking the nearest one
+     */
+    void generateIPFColorsFromQuats(const float* quats, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate = false);
+
+    /**
+     * @brief generateIPFColors Same as the member function, but reads the colors from a table that the caller
+     * has already fetched with IPFColorLookupTable::GetLookupTable()
+     * @param table Lookup table of the Laue class the orientations belong to
+     * @param eulers Bunge Euler angles in radians, 3 values per orientation
+     * @param count Number of orientations
+     * @param refDir Reference direction in the sample frame
+     * @param rgb [output] 3 values per orientation
+     * @param interpolate Blend the surrounding lookup table nodes instead of taking the nearest one
+     */
+    static void generateIPFColors(const IPFColorLookupTable* table, const float* eulers, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate = false);
+
+    /**
+     * @brief generateIPFColorsFromQuats Same as the member function, but reads the colors from a table that
+     * the caller has already fetched with IPFColorLookupTable::GetLookupTable()
+     * @param table Lookup table of the Laue class the orientations belong to
+     * @param quats Quaternions in (x, y, z, w) order, 4 values per orientation
+     * @param count Number of orientations
+     * @param refDir Reference direction in the sample frame
+     * @param rgb [output] 3 values per orientation
+     * @param interpolate Blend the surrounding lookup table nodes instead of taking the nearest one
+     */
+    static void generateIPFColorsFromQuats(const IPFColorLookupTable* table, const float* quats, size_t count, const float refDir[3], uint8_t* rgb, bool interpolate = false);
+
     /**
      * @brief generateMisorientationColor Generates a color based on the method developed by C. Schuh and S. Patala.
      * @param q A Quaternion representing the crystal direction
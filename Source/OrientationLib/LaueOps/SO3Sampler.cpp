@@ -31,6 +31,16 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SO3Sampler.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/ArrayHelpers.hpp"
@@ -103,6 +113,248 @@ static const int FZoarray[32] = { NoAxisOrder,NoAxisOrder,TwoFoldAxisOrder,TwoFo
                                   SixFoldAxisOrder,SixFoldAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder};
 
 
+namespace
+{
+/**
+ * @brief insideLaueSector Tests whether the direction n lies inside the standard stereographic sector of the
+ * Laue group that belongs to the FZ type and order. The primary axis is along z and the dihedral two-fold
+ * axes are the normals of the dihedral FZ planes, as in insideDihedralFZ.
+ */
+bool insideLaueSector(const double* n, int FZtype, int FZorder)
+{
+  const double x = n[0];
+  const double y = n[1];
+  const double z = n[2];
+  switch(FZtype)
+  {
+    case AnorthicType: // -1
+      return z >= 0.0;
+    case CyclicType:
+      switch(FZorder)
+      {
+        case TwoFoldAxisOrder: // 2/m
+          return z >= 0.0 && y >= 0.0;
+        case ThreeFoldAxisOrder: // -3, azimuth in [0,120]
+          return z >= 0.0 && y >= 0.0 && LPs::srt * x + 0.5 * y >= 0.0;
+        case FourFoldAxisOrder: // 4/m, azimuth in [0,90]
+          return z >= 0.0 && y >= 0.0 && x >= 0.0;
+        case SixFoldAxisOrder: // 6/m, azimuth in [0,60]
+          return z >= 0.0 && y >= 0.0 && LPs::srt * x - 0.5 * y >= 0.0;
+        default:
+          return false;
+      }
+    case DihedralType:
+      switch(FZorder)
+      {
+        case TwoFoldAxisOrder: // mmm
+          return z >= 0.0 && y >= 0.0 && x >= 0.0;
+        case ThreeFoldAxisOrder: // -3m, azimuth in [0,60]
+          return z >= 0.0 && y >= 0.0 && LPs::srt * x - 0.5 * y >= 0.0;
+        case FourFoldAxisOrder: // 4/mmm, azimuth in [0,45]
+          return z >= 0.0 && y >= 0.0 && x >= y;
+        case SixFoldAxisOrder: // 6/mmm, azimuth in [0,30]
+          return z >= 0.0 && y >= 0.0 && 0.5 * x - LPs::srt * y >= 0.0;
+        default:
+          return false;
+      }
+    case TetrahedralType: // m-3
+      return z >= 0.0 && y >= 0.0 && x >= y && x >= z;
+    case OctahedralType: // m-3m
+      return z >= 0.0 && y >= z && x >= y;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief The SampleGridImpl class implements a threaded algorithm that tests the cubochoric grid points of a
+ * range of x-slabs against a (mis)orientation fundamental zone and collects the accepted Rodrigues vectors per slab.
+ */
+class SampleGridImpl
+{
+public:
+  SampleGridImpl(SO3Sampler* sampler, int first, int last, double delta, double gridShift, double edge, int FZtype, int FZorder, bool misorientationZone, std::vector<std::vector<double>>& slabs)
+  : m_Sampler(sampler)
+  , m_First(first)
+  , m_Last(last)
+  , m_Delta(delta)
+  , m_GridShift(gridShift)
+  , m_Edge(edge)
+  , m_FZtype(FZtype)
+  , m_FZorder(FZorder)
+  , m_MisorientationZone(misorientationZone)
+  , m_Slabs(slabs)
+  {
+  }
+  virtual ~SampleGridImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+    DOrientArrayType cu(3);
+    DOrientArrayType rod(4);
+
+    for(size_t s = start; s < end; s++)
+    {
+      std::vector<double>& slab = m_Slabs[s];
+      double x = (static_cast<double>(m_First + static_cast<int>(s)) + m_GridShift) * m_Delta;
+      if(fabs(x) > m_Edge)
+      {
+        continue;
+      }
+      for(int j = m_First; j <= m_Last; j++)
+      {
+        double y = (static_cast<double>(j) + m_GridShift) * m_Delta;
+        if(fabs(y) > m_Edge)
+        {
+          continue;
+        }
+        for(int k = m_First; k <= m_Last; k++)
+        {
+          double z = (static_cast<double>(k) + m_GridShift) * m_Delta;
+          if(fabs(z) > m_Edge)
+          {
+            continue;
+          }
+          cu[0] = x;
+          cu[1] = y;
+          cu[2] = z;
+          OrientationTransformsType::cu2ro(cu, rod);
+
+          bool inside = m_MisorientationZone ? m_Sampler->IsinsideMFZ(rod.data(), m_FZtype, m_FZorder) : m_Sampler->IsinsideFZ(rod.data(), m_FZtype, m_FZorder);
+          if(inside)
+          {
+            slab.insert(slab.end(), rod.data(), rod.data() + 4);
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  SO3Sampler* m_Sampler;
+  int m_First;
+  int m_Last;
+  double m_Delta;
+  double m_GridShift;
+  double m_Edge;
+  int m_FZtype;
+  int m_FZorder;
+  bool m_MisorientationZone;
+  std::vector<std::vector<double>>& m_Slabs;
+};
+
+/**
+ * @brief The SampleNeighborhoodImpl class implements a threaded algorithm that generates the orientations around
+ * a reference orientation. Each x-index of the sampling cube owns a fixed block of the output array.
+ */
+class SampleNeighborhoodImpl
+{
+public:
+  SampleNeighborhoodImpl(int nsteps, double delta, double semi, const double* sigma, bool surfaceOnly, double* rodrigues)
+  : m_Nsteps(nsteps)
+  , m_Delta(delta)
+  , m_Semi(semi)
+  , m_Sigma(sigma)
+  , m_SurfaceOnly(surfaceOnly)
+  , m_Rodrigues(rodrigues)
+  {
+  }
+  virtual ~SampleNeighborhoodImpl() = default;
+
+  void emit(double x, double y, double z, size_t index, DOrientArrayType& cu, DOrientArrayType& rod) const
+  {
+    typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+    cu[0] = x;
+    cu[1] = y;
+    cu[2] = z;
+    OrientationTransformsType::cu2ro(cu, rod);
+    SO3Sampler::RodriguesComposition(m_Sigma, rod.data());
+    std::copy(rod.data(), rod.data() + 4, m_Rodrigues + index * 4);
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    DOrientArrayType cu(3);
+    DOrientArrayType rod(4);
+    int Np = m_Nsteps;
+    size_t n = static_cast<size_t>(2 * Np + 1);
+    size_t m = static_cast<size_t>(2 * Np - 1);
+
+    for(size_t s = start; s < end; s++)
+    {
+      int i = static_cast<int>(s) - Np;
+      double x = static_cast<double>(i) * m_Delta;
+      if(!m_SurfaceOnly)
+      {
+        for(int j = -Np; j <= Np; j++)
+        {
+          double y = static_cast<double>(j) * m_Delta;
+          for(int k = -Np; k <= Np; k++)
+          {
+            double z = static_cast<double>(k) * m_Delta;
+            emit(-x, -y, -z, (s * n + (j + Np)) * n + (k + Np), cu, rod);
+          }
+        }
+        continue;
+      }
+
+      // The surface is laid out as the x-y bottom and top planes, followed by the y-z planes and the x-z planes,
+      // each stored as pairs of opposite faces
+      for(int j = -Np; j <= Np; j++)
+      {
+        double y = static_cast<double>(j) * m_Delta;
+        size_t index = 2 * (s * n + (j + Np));
+        emit(-x, -y, -m_Semi, index, cu, rod);
+        emit(-x, -y, m_Semi, index + 1, cu, rod);
+      }
+      // y-z planes; here the slab index runs along y
+      size_t yzOffset = 2 * n * n;
+      for(int k = -Np + 1; k <= Np - 1; k++)
+      {
+        double z = static_cast<double>(k) * m_Delta;
+        size_t index = yzOffset + 2 * (s * m + (k + Np - 1));
+        emit(-m_Semi, -x, -z, index, cu, rod);
+        emit(m_Semi, -x, -z, index + 1, cu, rod);
+      }
+      if(i > -Np && i < Np)
+      {
+        size_t xzOffset = yzOffset + 2 * n * m;
+        for(int k = -Np + 1; k <= Np - 1; k++)
+        {
+          double z = static_cast<double>(k) * m_Delta;
+          size_t index = xzOffset + 2 * ((s - 1) * m + (k + Np - 1));
+          emit(-x, -m_Semi, -z, index, cu, rod);
+          emit(-x, m_Semi, -z, index + 1, cu, rod);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int m_Nsteps;
+  double m_Delta;
+  double m_Semi;
+  const double* m_Sigma;
+  bool m_SurfaceOnly;
+  double* m_Rodrigues;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -338,27 +590,18 @@ bool SO3Sampler::insideDihedralFZ(double* rod, int order)
 bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 {
   bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = rod[0] * rod[3];
-  r[1] = rod[1] * rod[3];
-  r[2] = rod[2] * rod[3];
+  double r[3] = {fabs(rod[0] * rod[3]), fabs(rod[1] * rod[3]), fabs(rod[2] * rod[3])};
   const double r1 = 1.0;
 
   // primary cube planes (only needed for octahedral case)
   if (ot == OctahedralType) {
-
-    typedef OrientationTransforms<std::vector<double>, double> OrientationTransformsType;
-
-    // std::vector<double> absR = OrientationTransformsType::OMHelperType::absValue(r);
-    // double maxVal = OrientationTransformsType::OMHelperType::maxval(absR);
-    c1 = OrientationTransformsType::OMHelperType::maxval(OrientationTransformsType::OMHelperType::absValue(r)) <= LPs::BP[3];
-
+    c1 = std::max(r[0], std::max(r[1], r[2])) <= LPs::BP[3];
   } else {
     c1 = true;
   }
 
   // octahedral truncation planes, both for tetrahedral and octahedral point groups
-  c2 = ((fabs(r[0])+fabs(r[1])+fabs(r[2])) <= r1);
+  c2 = ((r[0]+r[1]+r[2]) <= r1);
 
   // if both c1 and c2, then the point is inside
   if (c1 && c2) { res = true;}
@@ -421,50 +664,282 @@ bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 //--------------------------------------------------------------------------
 SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZ(int nsteps,int pgnum)
 {
-
-  double                        x, y, z, delta;
-  OrientationListArrayType              FZlist;
-  int32_t                 FZtype, FZorder;
+  OrientationListArrayType FZlist;
 
   // step size for sampling of grid; total number of samples = (2*nsteps+1)**3
-  delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
-
-  // determine which function we should call for this point group symmetry
-  FZtype = FZtarray[pgnum-1];
-  FZorder = FZoarray[pgnum-1];
-  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+  double delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
 
   // loop over the cube of volume pi^2; note that we do not want to include
   // the opposite edges/facets of the cube, to avoid double counting rotations
   // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-  for(int i = -nsteps; i < nsteps; i++)
+  std::vector<double> rodrigues;
+  size_t count = sampleGrid(-nsteps, nsteps - 1, delta, 0.0, std::numeric_limits<double>::max(), pgnum, false, rodrigues);
+  for(size_t i = 0; i < count; i++)
   {
-    x = static_cast<double>(i) * delta;
+    DOrientArrayType rod(4);
+    std::copy(rodrigues.begin() + i * 4, rodrigues.begin() + i * 4 + 4, rod.data());
+    FZlist.push_back(rod);
+  }
 
-    for(int j = -nsteps; j < nsteps; j++)
-    {
-      y = static_cast<double>(j) * delta;
+  return FZlist;
+}
 
-      for (int k = -nsteps; k < nsteps; k++)
-      {
-        z = static_cast<double>(k) * delta;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::SampleRFZ(int nsteps, int pgnum, double gridShift, std::vector<double>& rodrigues)
+{
+  // same grid as the EMsoft sampler: the +edge facets of the cube are part of the grid, the -edge facets are not
+  double delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+  return sampleGrid(-nsteps + 1, nsteps, delta, gridShift, 0.5 * LPs::ap, pgnum, false, rodrigues);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::SampleMFZ(int nsteps, int pgnum, double gridShift, std::vector<double>& rodrigues)
+{
+  double delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+  return sampleGrid(-nsteps + 1, nsteps, delta, gridShift, 0.5 * LPs::ap, pgnum, true, rodrigues);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::sampleGrid(int first, int last, double delta, double gridShift, double edge, int pgnum, bool misorientationZone, std::vector<double>& rodrigues)
+{
+  rodrigues.clear();
+  if(pgnum < 1 || pgnum > 32 || last < first)
+  {
+    return 0;
+  }
 
-        // convert to Rodrigues representation
-        DOrientArrayType cu(x, y, z);
-        DOrientArrayType rod(4);
-        OrientationTransformsType::cu2ro(cu, rod);
+  int FZtype = GetFZType(pgnum);
+  int FZorder = GetFZOrder(pgnum);
 
-        // If insideFZ=true, then add this point to the linked list FZlist and keep
-        // track of how many points there are on this list
-        bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-        if (b)
-        {
-          FZlist.push_back(rod);
-        }
+  // The cubochoric map sends every cube shell max(|x|,|y|,|z|) = h onto a sphere of homochoric vectors, so the
+  // rotation angle only depends on h. Grid points outside of the shell that holds the largest rotation angle of
+  // the fundamental zone can not be inside of it; the small margin covers the polynomial fit used in ho2ax.
+  double omega = GetMaxFZAngle(FZtype, FZorder);
+  double bound = 0.5 * LPs::ap * std::pow((omega - sin(omega)) / SIMPLib::Constants::k_Pi, 1.0 / 3.0) * 1.001;
+  edge = std::min(edge, bound);
 
-      }
+  // restrict the index range to the bounding cube; the per-point edge test keeps the exact boundary behavior
+  first = std::max(first, static_cast<int>(std::ceil(-edge / delta - gridShift)) - 1);
+  last = std::min(last, static_cast<int>(std::floor(edge / delta - gridShift)) + 1);
+  if(last < first)
+  {
+    return 0;
+  }
+
+  size_t numSlabs = static_cast<size_t>(last - first + 1);
+  std::vector<std::vector<double>> slabs(numSlabs);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), SampleGridImpl(this, first, last, delta, gridShift, edge, FZtype, FZorder, misorientationZone, slabs), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SampleGridImpl serial(this, first, last, delta, gridShift, edge, FZtype, FZorder, misorientationZone, slabs);
+    serial.generate(0, numSlabs);
+  }
+
+  // concatenate the slabs in grid order, releasing each one as soon as it has been copied
+  size_t total = 0;
+  for(const std::vector<double>& slab : slabs)
+  {
+    total += slab.size();
+  }
+  rodrigues.resize(total);
+  size_t offset = 0;
+  for(std::vector<double>& slab : slabs)
+  {
+    std::copy(slab.begin(), slab.end(), rodrigues.begin() + offset);
+    offset += slab.size();
+    std::vector<double>().swap(slab);
+  }
+
+  return total / 4;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::SampleNeighborhood(int nsteps, double misorientation, const double* sigma, bool surfaceOnly, std::vector<double>& rodrigues)
+{
+  rodrigues.clear();
+  if(nsteps < 1)
+  {
+    return 0;
+  }
+
+  // step size for sampling of grid; the edge length of the cube is (pi ( w - sin(w) ))^1/3 with w the misorientation angle
+  double semi = pow(SIMPLib::Constants::k_Pi * (misorientation - sin(misorientation)), 1.0 / 3.0) * 0.5;
+  double delta = semi / static_cast<double>(nsteps);
+
+  // see the misorientation sampling paper for the number of points on the sub-cube surface
+  size_t n = static_cast<size_t>(2 * nsteps + 1);
+  size_t numSamples = surfaceOnly ? static_cast<size_t>(24 * nsteps * nsteps + 2) : n * n * n;
+  rodrigues.resize(numSamples * 4);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n, 1), SampleNeighborhoodImpl(nsteps, delta, semi, sigma, surfaceOnly, rodrigues.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SampleNeighborhoodImpl serial(nsteps, delta, semi, sigma, surfaceOnly, rodrigues.data());
+    serial.generate(0, n);
+  }
+
+  return numSamples;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SO3Sampler::RodriguesComposition(const double* sigma, double* rod)
+{
+  double rho[3] = {-rod[0] * rod[3], -rod[1] * rod[3], -rod[2] * rod[3]};
+
+  // perform the Rodrigues rotation composition with sigma to get rhomis
+  double denom = 1.0 + (sigma[0] * rho[0] + sigma[1] * rho[1] + sigma[2] * rho[2]);
+  if(denom == 0.0)
+  {
+    double len = sqrt(sigma[0] * sigma[0] + sigma[1] * sigma[1] + sigma[2] * sigma[2]);
+    rod[0] = sigma[0] / len;
+    rod[1] = sigma[1] / len;
+    rod[2] = sigma[2] / len;
+    rod[3] = std::numeric_limits<double>::infinity(); // set this to infinity
+    return;
+  }
+
+  double rhomis[3];
+  rhomis[0] = (rho[0] - sigma[0] + (rho[1] * sigma[2] - rho[2] * sigma[1])) / denom;
+  rhomis[1] = (rho[1] - sigma[1] + (rho[2] * sigma[0] - rho[0] * sigma[2])) / denom;
+  rhomis[2] = (rho[2] - sigma[2] + (rho[0] * sigma[1] - rho[1] * sigma[0])) / denom;
+  // revert rhomis to a four-component Rodrigues vector
+  double len = sqrt(rhomis[0] * rhomis[0] + rhomis[1] * rhomis[1] + rhomis[2] * rhomis[2]);
+  if(len != 0.0)
+  {
+    rod[0] = -rhomis[0] / len;
+    rod[1] = -rhomis[1] / len;
+    rod[2] = -rhomis[2] / len;
+    rod[3] = len;
+  }
+  else
+  {
+    rod[0] = 0.0;
+    rod[1] = 0.0;
+    rod[2] = 0.0;
+    rod[3] = 0.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SO3Sampler::GetFZType(int pgnum)
+{
+  return FZtarray[pgnum - 1];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SO3Sampler::GetFZOrder(int pgnum)
+{
+  return FZoarray[pgnum - 1];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double SO3Sampler::GetMaxFZAngle(int FZtype, int FZorder)
+{
+  // the largest rotation angle is found at the vertex of the FZ polyhedron that is farthest from the origin
+  double rmax = std::numeric_limits<double>::infinity();
+  switch(FZtype)
+  {
+    case DihedralType:
+    {
+      // regular 2n-gon with inradius 1 in the x-y plane, capped at |z| = tan(pi/2n)
+      double c = cos(SIMPLib::Constants::k_Pi / static_cast<double>(2 * FZorder));
+      double t = LPs::BP[FZorder - 1];
+      rmax = sqrt(1.0 / (c * c) + t * t);
+      break;
+    }
+    case TetrahedralType:
+      // octahedron |x|+|y|+|z| <= 1
+      rmax = 1.0;
+      break;
+    case OctahedralType:
+    {
+      // truncated cube with vertices at (a, a, 1-2a), a = tan(pi/8)
+      double a = LPs::BP[3];
+      rmax = sqrt(2.0 * a * a + (1.0 - 2.0 * a) * (1.0 - 2.0 * a));
+      break;
     }
+    default:
+      // AnorthicType and CyclicType contain 180 degree rotations
+      break;
+  }
+  if(std::isinf(rmax))
+  {
+    return SIMPLib::Constants::k_Pi;
   }
+  return 2.0 * atan(rmax);
+}
 
-  return FZlist;
+//--------------------------------------------------------------------------
+//
+// FUNCTION: IsinsideMFZ
+//
+//> @brief does Rodrigues point lie inside the misorientation FZ of two crystals with the same symmetry?
+//
+//> @note Swapping the two crystals inverts the misorientation, and applying the same symmetry operator to both
+//> crystals conjugates it. Both leave the rotation angle unchanged, so the minimum-angle representative stays in
+//> the Rodrigues FZ and only its axis is reduced, to the standard stereographic sector of the Laue group.
+//
+//> @param rod Rodrigues coordinates  (double precision)
+//> @param FZtype FZ type
+//> @param FZorder FZ order
+//--------------------------------------------------------------------------
+bool SO3Sampler::IsinsideMFZ(double* rod, int FZtype, int FZorder)
+{
+  if(!IsinsideFZ(rod, FZtype, FZorder))
+  {
+    return false;
+  }
+  // the identity has no axis
+  if(rod[3] == 0.0)
+  {
+    return true;
+  }
+  if(insideLaueSector(rod, FZtype, FZorder))
+  {
+    return true;
+  }
+  // for 180 degree rotations the axis n and -n describe the same rotation
+  if(std::isinf(rod[3]))
+  {
+    double n[3] = {-rod[0], -rod[1], -rod[2]};
+    return insideLaueSector(n, FZtype, FZorder);
+  }
+  return false;
 }
@@ -31,7 +31,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
-
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
@@ -61,6 +61,62 @@ class OrientationLib_EXPORT SO3Sampler
     // sampler routine
     OrientationListArrayType SampleRFZ(int nsteps,int pgnum);
 
+    /**
+     * @brief SampleRFZ Generates a uniform cubochoric grid sampling of the Rodrigues fundamental zone of the
+     * given point group and writes the accepted grid points as 4-component Rodrigues vectors into a single
+     * contiguous array. Only grid points inside the bounding cube of the fundamental zone are visited and the
+     * grid is processed in parallel slabs; the output order is that of a serial i, j, k traversal.
+     * @param nsteps Number of grid steps along the semi-edge of the cubochoric cube
+     * @param pgnum Point group number (1-32, International Tables order)
+     * @param gridShift Offset of the grid from the origin in units of the grid step (0.0 or 0.5)
+     * @param rodrigues Output array; resized to 4 values per accepted grid point
+     * @return Number of accepted grid points
+     */
+    size_t SampleRFZ(int nsteps, int pgnum, double gridShift, std::vector<double>& rodrigues);
+
+    /**
+     * @brief SampleMFZ Same as SampleRFZ, but only keeps the grid points that lie inside the misorientation
+     * fundamental zone, i.e. the part of the Rodrigues fundamental zone whose rotation axes fall inside the
+     * standard stereographic sector of the Laue group. This is valid for misorientations between two crystals
+     * of the same point group.
+     * @param nsteps Number of grid steps along the semi-edge of the cubochoric cube
+     * @param pgnum Point group number (1-32, International Tables order)
+     * @param gridShift Offset of the grid from the origin in units of the grid step (0.0 or 0.5)
+     * @param rodrigues Output array; resized to 4 values per accepted grid point
+     * @return Number of accepted grid points
+     */
+    size_t SampleMFZ(int nsteps, int pgnum, double gridShift, std::vector<double>& rodrigues);
+
+    /**
+     * @brief SampleNeighborhood Generates a uniform sampling of the orientations around a reference orientation,
+     * either on the surface of constant misorientation or filling the whole neighborhood up to that misorientation.
+     * Every sample has a fixed position in the output array, so the array is allocated once and filled in parallel.
+     * @param nsteps Number of grid steps along the semi-edge of the sampling cube
+     * @param misorientation Misorientation angle (radians)
+     * @param sigma 3-component Rodrigues vector of the reference orientation
+     * @param surfaceOnly If true only the orientations at exactly the misorientation angle are generated
+     * @param rodrigues Output array; resized to 4 values per sample
+     * @return Number of samples
+     */
+    size_t SampleNeighborhood(int nsteps, double misorientation, const double* sigma, bool surfaceOnly, std::vector<double>& rodrigues);
+
+    /**
+     * @brief RodriguesComposition Composes the 4-component Rodrigues vector rod with the 3-component Rodrigues
+     * vector sigma of the reference orientation, in place.
+     * @param sigma
+     * @param rod
+     */
+    static void RodriguesComposition(const double* sigma, double* rod);
+
+    /**
+     * @brief IsinsideMFZ
+     * @param rod
+     * @param FZtype
+     * @param FZorder
+     * @return
+     */
+    bool IsinsideMFZ(double* rod, int FZtype, int FZorder);
+
     /**
      * @brief IsinsideFZ
      * @param rod
@@ -94,11 +150,46 @@ class OrientationLib_EXPORT SO3Sampler
      */
     bool insideDihedralFZ(double* rod, int order);
 
-  private:
+    /**
+     * @brief GetFZType Returns the fundamental zone type for the point group number (1-32)
+     * @param pgnum
+     * @return
+     */
+    static int GetFZType(int pgnum);
+
+    /**
+     * @brief GetFZOrder Returns the order of the primary rotation axis for the point group number (1-32)
+     * @param pgnum
+     * @return
+     */
+    static int GetFZOrder(int pgnum);
+
+    /**
+     * @brief GetMaxFZAngle Returns the largest rotation angle (radians) found inside a fundamental zone, or
+     * pi for the fundamental zones that extend to infinity in Rodrigues space.
+     * @param FZtype
+     * @param FZorder
+     * @return
+     */
+    static double GetMaxFZAngle(int FZtype, int FZorder);
 
   protected:
     SO3Sampler();
 
+    /**
+     * @brief sampleGrid Shared implementation of the grid based fundamental zone samplers
+     * @param first First grid index along each axis
+     * @param last Last grid index along each axis
+     * @param delta Grid step
+     * @param gridShift Grid offset in units of the grid step
+     * @param edge Grid points with any coordinate larger than edge (in absolute value) are skipped
+     * @param pgnum Point group number
+     * @param misorientationZone If true the misorientation fundamental zone is sampled
+     * @param rodrigues Output array
+     * @return Number of accepted grid points
+     */
+    size_t sampleGrid(int first, int last, double delta, double gridShift, double edge, int pgnum, bool misorientationZone, std::vector<double>& rodrigues);
+
   private:
     SO3Sampler(const SO3Sampler&) = delete;     // Copy Constructor Not Implemented
     void operator=(const SO3Sampler&) = delete; // Move assignment Not Implemented
@@ -49,6 +49,7 @@ set(OrientationLib_LaueOps_HDRS
   ${OrientationLib_SOURCE_DIR}/LaueOps/TriclinicOps.h
   ${OrientationLib_SOURCE_DIR}/LaueOps/MonoclinicOps.h
   ${OrientationLib_SOURCE_DIR}/LaueOps/SO3Sampler.h
+  ${OrientationLib_SOURCE_DIR}/LaueOps/IPFColorLookupTable.h
 )
 set(OrientationLib_LaueOps_SRCS
   ${OrientationLib_SOURCE_DIR}/LaueOps/LaueOps.cpp
@@ -64,6 +65,7 @@ set(OrientationLib_LaueOps_SRCS
   ${OrientationLib_SOURCE_DIR}/LaueOps/TriclinicOps.cpp
   ${OrientationLib_SOURCE_DIR}/LaueOps/MonoclinicOps.cpp
   ${OrientationLib_SOURCE_DIR}/LaueOps/SO3Sampler.cpp
+  ${OrientationLib_SOURCE_DIR}/LaueOps/IPFColorLookupTable.cpp
 )
 cmp_IDE_SOURCE_PROPERTIES( "LaueOps" "${OrientationLib_LaueOps_HDRS}" "${OrientationLib_LaueOps_SRCS}" "0")
 if( ${PROJECT_INSTALL_HEADERS} EQUAL 1 )
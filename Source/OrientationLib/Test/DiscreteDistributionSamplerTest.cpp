@@ -0,0 +1,198 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLib/Texture/DiscreteDistributionSampler.hpp"
+#include "OrientationLib/Utilities/CounterRandomGenerator.hpp"
+
+#include "OrientationLib/Test/OrientationLibTestFileLocations.h"
+
+class DiscreteDistributionSamplerTest
+{
+public:
+  DiscreteDistributionSamplerTest()
+  {
+  }
+  virtual ~DiscreteDistributionSamplerTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCounterRandomGeneratorDeterminism()
+  {
+    const uint64_t numCounters = 1000;
+    CounterRandomGenerator generator(5489, 3);
+    CounterRandomGenerator sameGenerator(5489, 3);
+    CounterRandomGenerator otherStream(5489, 4);
+    CounterRandomGenerator otherSeed(5490, 3);
+
+    // The same seed, stream and counter always give the same number, whatever order the counters are visited in
+    std::vector<uint64_t> forward(numCounters, 0);
+    for(uint64_t c = 0; c < numCounters; c++)
+    {
+      forward[c] = generator.genrand_int64(c);
+    }
+    size_t streamMatches = 0;
+    size_t seedMatches = 0;
+    for(uint64_t c = numCounters; c > 0; c--)
+    {
+      DREAM3D_REQUIRE_EQUAL(sameGenerator.genrand_int64(c - 1), forward[c - 1])
+      streamMatches += (otherStream.genrand_int64(c - 1) == forward[c - 1]) ? 1 : 0;
+      seedMatches += (otherSeed.genrand_int64(c - 1) == forward[c - 1]) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(streamMatches, 0)
+    DREAM3D_REQUIRE_EQUAL(seedMatches, 0)
+
+    // Split generators are reproducible as well and independent of their parent
+    CounterRandomGenerator split = generator.split(7);
+    CounterRandomGenerator sameSplit = sameGenerator.split(7);
+    size_t parentMatches = 0;
+    for(uint64_t c = 0; c < numCounters; c++)
+    {
+      DREAM3D_REQUIRE_EQUAL(split.genrand_int64(c), sameSplit.genrand_int64(c))
+      parentMatches += (split.genrand_int64(c) == forward[c]) ? 1 : 0;
+
+      double random = generator.genrand_res53(c);
+      DREAM3D_REQUIRE(random >= 0.0 && random < 1.0)
+    }
+    DREAM3D_REQUIRE_EQUAL(parentMatches, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  // The linear scan over the bins that the sampler replaced
+  // -----------------------------------------------------------------------------
+  int32_t LinearScan(const std::vector<double>& densities, double random)
+  {
+    double totalDensity = 0.0;
+    for(size_t j = 0; j < densities.size(); j++)
+    {
+      totalDensity = totalDensity + densities[j];
+      if(random < totalDensity)
+      {
+        return static_cast<int32_t>(j);
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSamplerMatchesLinearScan()
+  {
+    // Densities that do not sum to 1, with empty bins at the start, in the middle and at the end
+    std::vector<double> densities = {0.0, 0.05, 0.2, 0.0, 0.0, 0.15, 0.3, 0.1, 0.0};
+    DiscreteDistributionSampler<double> sampler(densities.data(), densities.size());
+    DREAM3D_REQUIRE_EQUAL(sampler.getNumberOfBins(), densities.size())
+
+    CounterRandomGenerator generator(12345);
+    for(uint64_t c = 0; c < 10000; c++)
+    {
+      double random = generator.genrand_res53(c);
+      DREAM3D_REQUIRE_EQUAL(sampler.sample(random), LinearScan(densities, random))
+    }
+
+    // Random numbers on the bin edges select the next bin, and numbers past the total density select bin 0
+    DREAM3D_REQUIRE_EQUAL(sampler.sample(0.0), 1)
+    DREAM3D_REQUIRE_EQUAL(sampler.sample(0.05), LinearScan(densities, 0.05))
+    DREAM3D_REQUIRE_EQUAL(sampler.sample(0.9), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Draws many samples and checks the bin counts against the weights with a chi-square test
+  // -----------------------------------------------------------------------------
+  void TestSamplerChiSquare()
+  {
+    std::vector<double> weights = {1.0, 0.0, 3.0, 6.0, 2.0, 8.0};
+    double totalWeight = 0.0;
+    for(size_t j = 0; j < weights.size(); j++)
+    {
+      totalWeight += weights[j];
+    }
+    std::vector<double> densities(weights.size(), 0.0);
+    for(size_t j = 0; j < weights.size(); j++)
+    {
+      densities[j] = weights[j] / totalWeight;
+    }
+    DiscreteDistributionSampler<double> sampler(densities.data(), densities.size());
+
+    const uint64_t numSamples = 200000;
+    std::vector<uint64_t> counts(weights.size(), 0);
+    CounterRandomGenerator generator(5489);
+    for(uint64_t c = 0; c < numSamples; c++)
+    {
+      counts[sampler.sample(generator.genrand_res53(c))]++;
+    }
+
+    // An empty bin is never drawn
+    DREAM3D_REQUIRE_EQUAL(counts[1], 0)
+
+    double chiSquare = 0.0;
+    for(size_t j = 0; j < weights.size(); j++)
+    {
+      if(weights[j] > 0.0)
+      {
+        double expected = numSamples * densities[j];
+        chiSquare += (counts[j] - expected) * (counts[j] - expected) / expected;
+      }
+    }
+    // 18.47 is the 0.1% critical value of the chi-square distribution with 4 degrees of freedom
+    DREAM3D_REQUIRE(chiSquare < 18.47)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start DiscreteDistributionSamplerTest" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestCounterRandomGeneratorDeterminism())
+    DREAM3D_REGISTER_TEST(TestSamplerMatchesLinearScan())
+    DREAM3D_REGISTER_TEST(TestSamplerChiSquare())
+  }
+
+private:
+  DiscreteDistributionSamplerTest(const DiscreteDistributionSamplerTest&); // Copy Constructor Not Implemented
+  void operator=(const DiscreteDistributionSamplerTest&);                  // Move assignment Not Implemented
+};
@@ -0,0 +1,221 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/Utilities/FeatureMisorientationCache.h"
+
+#include "OrientationLib/Test/OrientationLibTestFileLocations.h"
+
+class FeatureMisorientationCacheTest
+{
+public:
+  FeatureMisorientationCacheTest()
+  {
+  }
+  virtual ~FeatureMisorientationCacheTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  // Stores a rotation of angle degrees about the sample Z axis as the quaternion of the feature
+  // -----------------------------------------------------------------------------
+  void SetRotationAboutZ(FloatArrayType::Pointer avgQuats, size_t feature, float angle)
+  {
+    float halfAngle = 0.5f * angle * SIMPLib::Constants::k_PiOver180;
+    avgQuats->setComponent(feature, 0, 0.0f);
+    avgQuats->setComponent(feature, 1, 0.0f);
+    avgQuats->setComponent(feature, 2, std::sin(halfAngle));
+    avgQuats->setComponent(feature, 3, std::cos(halfAngle));
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  float GetAngleInDegrees(FeatureMisorientationCache::Pointer table, int32_t feature, int32_t neighbor)
+  {
+    int64_t entry = table->findEntry(feature, neighbor);
+    DREAM3D_REQUIRE(entry >= 0)
+    DREAM3D_REQUIRE(table->isValid(static_cast<size_t>(entry)))
+    return table->getAngle(static_cast<size_t>(entry)) * SIMPLib::Constants::k_180OverPi;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCacheValidation()
+  {
+    FeatureMisorientationCache::Clear();
+
+    // Two cubic features that neighbor each other, misoriented by 10 degrees about Z
+    size_t numFeatures = 3;
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(numFeatures, "NeighborList");
+    NeighborList<int32_t>::SharedVectorType neighborsOf1(new std::vector<int32_t>(1, 2));
+    NeighborList<int32_t>::SharedVectorType neighborsOf2(new std::vector<int32_t>(1, 1));
+    neighborList->setList(1, neighborsOf1);
+    neighborList->setList(2, neighborsOf2);
+
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(numFeatures, cDims, "AvgQuats");
+    SetRotationAboutZ(avgQuats, 0, 0.0f);
+    SetRotationAboutZ(avgQuats, 1, 0.0f);
+    SetRotationAboutZ(avgQuats, 2, 10.0f);
+
+    cDims[0] = 1;
+    Int32ArrayType::Pointer featurePhases = Int32ArrayType::CreateArray(numFeatures, cDims, "Phases");
+    featurePhases->initializeWithValue(1);
+    featurePhases->setValue(0, 0);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, cDims, "CrystalStructures");
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+
+    FeatureMisorientationCache::Pointer table = FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures);
+    DREAM3D_REQUIRE_VALID_POINTER(table.get())
+    DREAM3D_REQUIRE_EQUAL(table->getNumberOfFeatures(), numFeatures)
+    DREAM3D_REQUIRE(std::abs(GetAngleInDegrees(table, 1, 2) - 10.0f) < 1.0E-3f)
+    DREAM3D_REQUIRE_EQUAL(table->findEntry(1, 0), -1)
+
+    // Unchanged inputs hand out the cached table
+    FeatureMisorientationCache::Pointer cached = FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures);
+    DREAM3D_REQUIRE(cached == table)
+
+    // Orientations that are rewritten in place no longer match the table and the new one sees the new orientation
+    SetRotationAboutZ(avgQuats, 2, 20.0f);
+    FeatureMisorientationCache::Pointer rotated = FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures);
+    DREAM3D_REQUIRE(rotated != table)
+    DREAM3D_REQUIRE(std::abs(GetAngleInDegrees(rotated, 2, 1) - 20.0f) < 1.0E-3f)
+    // The table handed out earlier keeps the values it was computed from
+    DREAM3D_REQUIRE(std::abs(GetAngleInDegrees(table, 1, 2) - 10.0f) < 1.0E-3f)
+
+    // Neither does a neighbor list that is rewritten in place
+    neighborsOf1->clear();
+    neighborsOf2->clear();
+    FeatureMisorientationCache::Pointer noNeighbors = FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures);
+    DREAM3D_REQUIRE(noNeighbors != rotated)
+    DREAM3D_REQUIRE_EQUAL(noNeighbors->getNumberOfNeighbors(1), 0)
+    DREAM3D_REQUIRE_EQUAL(noNeighbors->findEntry(1, 2), -1)
+
+    // A replaced array never matches the table of the array it replaced
+    Int32ArrayType::Pointer newPhases = Int32ArrayType::CreateArray(numFeatures, cDims, "Phases");
+    newPhases->initializeWithValue(1);
+    FeatureMisorientationCache::Pointer replaced = FeatureMisorientationCache::Get(neighborList, avgQuats, newPhases, crystalStructures);
+    DREAM3D_REQUIRE(replaced != noNeighbors)
+
+    // Changing an array no table depends on keeps the cached table
+    featurePhases->setValue(1, 0);
+    DREAM3D_REQUIRE(FeatureMisorientationCache::Get(neighborList, avgQuats, newPhases, crystalStructures) == replaced)
+
+    // Only the newest table of a neighbor list is kept, and it is dropped once one of its input arrays is released
+    DREAM3D_REQUIRE_EQUAL(FeatureMisorientationCache::GetNumberOfCachedTables(), 1)
+    newPhases.reset();
+    DREAM3D_REQUIRE_EQUAL(FeatureMisorientationCache::GetNumberOfCachedTables(), 0)
+
+    FeatureMisorientationCache::Clear();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestLargeInputValidation()
+  {
+    FeatureMisorientationCache::Clear();
+
+    // Enough features for the inputs to be fingerprinted in several blocks; only the last two features neighbor each other
+    size_t numFeatures = 100000;
+    int32_t last = static_cast<int32_t>(numFeatures - 1);
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(numFeatures, "NeighborList");
+    NeighborList<int32_t>::SharedVectorType neighborsOfLast(new std::vector<int32_t>(1, last - 1));
+    neighborList->setList(last - 1, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>(1, last)));
+    neighborList->setList(last, neighborsOfLast);
+
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(numFeatures, cDims, "AvgQuats");
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      SetRotationAboutZ(avgQuats, i, static_cast<float>(i % 50));
+    }
+
+    cDims[0] = 1;
+    Int32ArrayType::Pointer featurePhases = Int32ArrayType::CreateArray(numFeatures, cDims, "Phases");
+    featurePhases->initializeWithValue(1);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, cDims, "CrystalStructures");
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+
+    FeatureMisorientationCache::Pointer table = FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures);
+    DREAM3D_REQUIRE(FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures) == table)
+    DREAM3D_REQUIRE(table->isValid(static_cast<size_t>(table->findEntry(last - 1, last))))
+
+    // A change in the last block of an array is detected
+    featurePhases->setValue(numFeatures - 1, 0);
+    FeatureMisorientationCache::Pointer unknownPhase = FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures);
+    DREAM3D_REQUIRE(unknownPhase != table)
+    DREAM3D_REQUIRE(!unknownPhase->isValid(static_cast<size_t>(unknownPhase->findEntry(last - 1, last))))
+
+    // So is a list of the last block of the neighbor list that grows
+    neighborsOfLast->push_back(0);
+    FeatureMisorientationCache::Pointer grown = FeatureMisorientationCache::Get(neighborList, avgQuats, featurePhases, crystalStructures);
+    DREAM3D_REQUIRE(grown != unknownPhase)
+    DREAM3D_REQUIRE_EQUAL(grown->getNumberOfNeighbors(numFeatures - 1), 2)
+
+    FeatureMisorientationCache::Clear();
+    DREAM3D_REQUIRE_EQUAL(FeatureMisorientationCache::GetNumberOfCachedTables(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "<===== Start FeatureMisorientationCacheTest" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestCacheValidation())
+    DREAM3D_REGISTER_TEST(TestLargeInputValidation())
+  }
+
+private:
+  FeatureMisorientationCacheTest(const FeatureMisorientationCacheTest&); // Copy Constructor Not Implemented
+  void operator=(const FeatureMisorientationCacheTest&);                 // Move assignment Not Implemented
+};
@@ -30,6 +30,9 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <cmath>
+#include <vector>
+
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/SIMPLib.h"
 #include "UnitTestSupport.hpp"
@@ -37,6 +40,7 @@
 #include "OrientationLibTestFileLocations.h"
 
 #include "OrientationLib/LaueOps/SO3Sampler.h"
+#include "OrientationLib/OrientationLibConstants.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/Utilities/ModifiedLambertProjection3D.hpp"
 
@@ -75,6 +79,84 @@ public:
     DREAM3D_REQUIRE_EQUAL(333227, orientations.size());
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SO3ArraySamplingTest()
+  {
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+    std::vector<double> rodrigues;
+
+    // the bounded, parallel sampler must find exactly the grid points of a full traversal of the cube
+    int nsteps = 12;
+    double delta = 0.5 * LPs::ap / static_cast<double>(nsteps);
+    int32_t pointGroups[4] = {32, 29, 24, 12};
+    for(int32_t pgnum : pointGroups)
+    {
+      for(double gridShift : {0.0, 0.5})
+      {
+        std::vector<double> expected;
+        for(int i = -nsteps + 1; i <= nsteps; i++)
+        {
+          for(int j = -nsteps + 1; j <= nsteps; j++)
+          {
+            for(int k = -nsteps + 1; k <= nsteps; k++)
+            {
+              DOrientArrayType cu((i + gridShift) * delta, (j + gridShift) * delta, (k + gridShift) * delta);
+              if(std::fabs(cu[0]) > 0.5 * LPs::ap || std::fabs(cu[1]) > 0.5 * LPs::ap || std::fabs(cu[2]) > 0.5 * LPs::ap)
+              {
+                continue;
+              }
+              DOrientArrayType rod(4);
+              OrientationTransformsType::cu2ro(cu, rod);
+              if(sampler->IsinsideFZ(rod.data(), SO3Sampler::GetFZType(pgnum), SO3Sampler::GetFZOrder(pgnum)))
+              {
+                expected.insert(expected.end(), rod.data(), rod.data() + 4);
+              }
+            }
+          }
+        }
+
+        size_t count = sampler->SampleRFZ(nsteps, pgnum, gridShift, rodrigues);
+        DREAM3D_REQUIRE_EQUAL(count * 4, expected.size())
+        DREAM3D_REQUIRE_EQUAL(rodrigues.size(), expected.size())
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(rodrigues[i], expected[i])
+        }
+      }
+    }
+
+    size_t count = sampler->SampleRFZ(10, 32, 0.0, rodrigues);
+    DREAM3D_REQUIRE_EQUAL(361, count)
+
+    // the cubic misorientation FZ is the part of the RFZ with r1 >= r2 >= r3 >= 0
+    size_t mfzCount = sampler->SampleMFZ(40, 32, 0.0, rodrigues);
+    size_t rfzCount = sampler->SampleRFZ(40, 32, 0.0, rodrigues);
+    DREAM3D_REQUIRE(mfzCount * 40 < rfzCount)
+    DREAM3D_REQUIRE(mfzCount * 60 > rfzCount)
+    sampler->SampleMFZ(40, 32, 0.0, rodrigues);
+    for(size_t i = 0; i < mfzCount; i++)
+    {
+      const double* rod = rodrigues.data() + i * 4;
+      DREAM3D_REQUIRE(sampler->IsinsideFZ(const_cast<double*>(rod), 4, 0))
+      DREAM3D_REQUIRE(rod[3] == 0.0 || (rod[0] >= rod[1] && rod[1] >= rod[2] && rod[2] >= 0.0))
+    }
+
+    // constant misorientation sampling puts all samples on the surface of the sub-cube
+    double sigma[3] = {0.0, 0.0, 0.0};
+    double omega = 5.0 * SIMPLib::Constants::k_PiOver180;
+    count = sampler->SampleNeighborhood(6, omega, sigma, true, rodrigues);
+    DREAM3D_REQUIRE_EQUAL(24 * 6 * 6 + 2, count)
+    DREAM3D_REQUIRE_EQUAL(rodrigues.size(), count * 4)
+    count = sampler->SampleNeighborhood(6, omega, sigma, false, rodrigues);
+    DREAM3D_REQUIRE_EQUAL(13 * 13 * 13, count)
+    for(size_t i = 0; i < count; i++)
+    {
+      DREAM3D_REQUIRE(2.0 * atan(rodrigues[i * 4 + 3]) <= omega + 1.0E-5)
+    }
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -133,6 +215,7 @@ public:
     DREAM3D_REGISTER_TEST(InsideCubicFZTest())
     DREAM3D_REGISTER_TEST(TestPyramid())
     DREAM3D_REGISTER_TEST(SO3CountTest())
+    DREAM3D_REGISTER_TEST(SO3ArraySamplingTest())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 
@@ -0,0 +1,108 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The DiscreteDistributionSampler class draws bins of a discrete distribution such as the ODF or MDF bins,
+ * with a binary search in the cumulative distribution instead of a linear scan over all bins. The cumulative sums
+ * are accumulated in the same order and precision as the linear scans they replace, so a given random number selects
+ * the same bin: the first bin whose cumulative density exceeds it, or bin 0 if the random number is not smaller than
+ * the total density. The sampler is read-only once initialized and may be shared between threads.
+ */
+template <typename T> class DiscreteDistributionSampler
+{
+  public:
+    DiscreteDistributionSampler() = default;
+
+    /**
+     * @brief DiscreteDistributionSampler
+     * @param densities Density of each bin
+     * @param numBins Number of bins
+     */
+    DiscreteDistributionSampler(const T* densities, size_t numBins)
+    {
+      initialize(densities, numBins);
+    }
+
+    virtual ~DiscreteDistributionSampler() = default;
+
+    /**
+     * @brief initialize Computes the cumulative distribution of the densities
+     * @param densities Density of each bin
+     * @param numBins Number of bins
+     */
+    void initialize(const T* densities, size_t numBins)
+    {
+      m_Cumulative.resize(numBins);
+      T totalDensity = static_cast<T>(0);
+      for(size_t j = 0; j < numBins; j++)
+      {
+        totalDensity = totalDensity + densities[j];
+        m_Cumulative[j] = totalDensity;
+      }
+    }
+
+    /**
+     * @brief getNumberOfBins
+     * @return
+     */
+    size_t getNumberOfBins() const
+    {
+      return m_Cumulative.size();
+    }
+
+    /**
+     * @brief sample Returns the bin selected by a random number in [0,1)
+     * @param random
+     * @return
+     */
+    int32_t sample(T random) const
+    {
+      typename std::vector<T>::const_iterator iter = std::upper_bound(m_Cumulative.begin(), m_Cumulative.end(), random);
+      if(iter == m_Cumulative.end())
+      {
+        return 0;
+      }
+      return static_cast<int32_t>(iter - m_Cumulative.begin());
+    }
+
+  private:
+    std::vector<T> m_Cumulative;
+};
@@ -39,13 +39,112 @@
 #define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
 #endif
 
+#include <vector>
+
+#include <QtCore/QDateTime>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/SIMPLib.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Texture/DiscreteDistributionSampler.hpp"
 #include "OrientationLib/Texture/Texture.hpp"
+#include "OrientationLib/Utilities/CounterRandomGenerator.hpp"
+
+/**
+ * @brief The GenODFPlotDataImpl class implements a threaded algorithm that draws orientations from the ODF bins of
+ * a Laue class. Every sample draws its bin and the seed of its orientation inside that bin from its own counters of
+ * a CounterRandomGenerator, so the result only depends on the seed and not on the number of threads.
+ */
+template <typename T, class LaueOpsType> class GenODFPlotDataImpl
+{
+  public:
+    GenODFPlotDataImpl(const DiscreteDistributionSampler<T>* sampler, const CounterRandomGenerator& rg, T* eulers)
+    : m_Sampler(sampler)
+    , m_Rg(rg)
+    , m_Eulers(eulers)
+    {
+    }
+    virtual ~GenODFPlotDataImpl() = default;
+
+    void generate(size_t start, size_t end) const
+    {
+      LaueOpsType ops;
+      for(size_t i = start; i < end; i++)
+      {
+        int choose = m_Sampler->sample(static_cast<T>(m_Rg.genrand_res53(2 * i)));
+        FOrientArrayType eu = ops.determineEulerAngles(m_Rg.genrand_int64(2 * i + 1), choose);
+        m_Eulers[3 * i + 0] = eu[0];
+        m_Eulers[3 * i + 1] = eu[1];
+        m_Eulers[3 * i + 2] = eu[2];
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const DiscreteDistributionSampler<T>* m_Sampler;
+    CounterRandomGenerator m_Rg;
+    T* m_Eulers;
+};
+
+/**
+ * @brief The GenMDFPlotDataImpl class implements a threaded algorithm that draws misorientations from the MDF bins of
+ * a Laue class and stores the 5 degree misorientation angle bin of every sample.
+ */
+template <typename T, class LaueOpsType> class GenMDFPlotDataImpl
+{
+  public:
+    GenMDFPlotDataImpl(const DiscreteDistributionSampler<T>* sampler, const CounterRandomGenerator& rg, int32_t* angleBins)
+    : m_Sampler(sampler)
+    , m_Rg(rg)
+    , m_AngleBins(angleBins)
+    {
+    }
+    virtual ~GenMDFPlotDataImpl() = default;
+
+    void generate(size_t start, size_t end) const
+    {
+      float radtodeg = 180.0f / float(M_PI);
+      LaueOpsType ops;
+      FOrientArrayType ax(4, 0.0);
+      for(size_t i = start; i < end; i++)
+      {
+        int choose = m_Sampler->sample(static_cast<T>(m_Rg.genrand_res53(2 * i)));
+        FOrientArrayType rod = ops.determineRodriguesVector(m_Rg.genrand_int64(2 * i + 1), choose);
+        FOrientTransformsType::ro2ax(rod, ax);
+
+        float w = ax[3] * radtodeg;
+        m_AngleBins[i] = static_cast<int32_t>(w / 5.0f);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const DiscreteDistributionSampler<T>* m_Sampler;
+    CounterRandomGenerator m_Rg;
+    int32_t* m_AngleBins;
+};
 
 /**
  * @brief This class contains static functions to generate ODF and MDF data as X,Y points. This data can be discretized
@@ -230,48 +329,93 @@ public:
     return err;
   }
 
+  /**
+   * @brief GenODFPlotData Draws npoints orientations from the ODF bins of the Laue class LaueOpsType. The samples
+   * are drawn in parallel and a given seed always reproduces the same Euler angles.
+   * @param odf ODF bin data which has been sized to LaueOpsType::k_OdfSize
+   * @param eulers Euler angles to be generated. This memory must already be preallocated.
+   * @param npoints The number of orientations to generate
+   * @param seed Seed of the random numbers
+   */
+  template <typename T, class LaueOpsType> static int GenODFPlotData(const T* odf, T* eulers, size_t npoints, uint64_t seed)
+  {
+    DiscreteDistributionSampler<T> sampler(odf, LaueOpsType::k_OdfSize);
+    CounterRandomGenerator rg(seed);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, npoints), GenODFPlotDataImpl<T, LaueOpsType>(&sampler, rg, eulers), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      GenODFPlotDataImpl<T, LaueOpsType> serial(&sampler, rg, eulers);
+      serial.generate(0, npoints);
+    }
+    return 0;
+  }
+
+  /**
+   * @brief GenMDFPlotData Draws size misorientations from the MDF bins of the Laue class LaueOpsType and
+   * histograms their misorientation angles into 5 degree bins. The samples are drawn in parallel and a given
+   * seed always reproduces the same histogram.
+   * @param mdf MDF bin data which has been sized to LaueOpsType::k_MdfSize
+   * @param xval [output] X Values of the Scatter plot. This memory must already be preallocated.
+   * @param yval [output] Y Values of the Scatter plot. This memory must already be preallocated.
+   * @param npoints The number of XY points for the Scatter Plot
+   * @param size The number of samples of the MDF to take
+   * @param seed Seed of the random numbers
+   */
+  template <typename T, class LaueOpsType> static int GenMDFPlotData(const T* mdf, T* xval, T* yval, int npoints, int size, uint64_t seed)
+  {
+    DiscreteDistributionSampler<T> sampler(mdf, LaueOpsType::k_MdfSize);
+    CounterRandomGenerator rg(seed);
+    std::vector<int32_t> angleBins(static_cast<size_t>(size), 0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, angleBins.size()), GenMDFPlotDataImpl<T, LaueOpsType>(&sampler, rg, angleBins.data()), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      GenMDFPlotDataImpl<T, LaueOpsType> serial(&sampler, rg, angleBins.data());
+      serial.generate(0, angleBins.size());
+    }
+
+    for(int i = 0; i < npoints; i++)
+    {
+      yval[i] = 0;
+    }
+    for(int i = 0; i < size; i++)
+    {
+      yval[angleBins[i]]++;
+    }
+    for(int i = 0; i < npoints; i++)
+    {
+      xval[i] = i * 5.0 + 2.5;
+      yval[i] = yval[i] / float(size);
+    }
+    return 0;
+  }
+
   /**
    * @brief  This method will generate ODF data for 3 scatter plots which are the
    * <001>, <011> and <111> directions.
    * @param odf Pointer to ODF bin data which has been sized to CubicOps::k_OdfSize
    * @param eulers Euler angles to be generated. This memory must already be preallocated.
    * @param npoints The number of points for the Scatter Plot which is at least the number of elements used in the allocation of the various output arrays.
+   * @param seed Seed of the random numbers. The same seed always generates the same Euler angles.
    */
-  template <typename T> static int GenCubicODFPlotData(const T* odf, T* eulers, size_t npoints)
+  template <typename T> static int GenCubicODFPlotData(const T* odf, T* eulers, size_t npoints, uint64_t seed = QDateTime::currentMSecsSinceEpoch())
   {
-    uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-    SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-    int err = 0;
-    int choose;
-    T totaldensity;
-    T random, density;
-
-    CubicOps ops;
-    T td1;
-    // float* odfPtr = &(odf.front());
-    for(size_t i = 0; i < npoints; i++)
-    {
-      m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < CubicOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    return GenODFPlotData<T, CubicOps>(odf, eulers, npoints, seed);
   }
 
   /**
@@ -284,41 +428,11 @@ public:
    * @param odf [input] The ODF data
    * @param eulers Euler angles to be generated. This memory must already be preallocated.
    * @param size The number of points for the Scatter Plot
+   * @param seed Seed of the random numbers. The same seed always generates the same Euler angles.
    */
-  template <typename T> static int GenHexODFPlotData(T* odf, T* eulers, int npoints)
+  template <typename T> static int GenHexODFPlotData(T* odf, T* eulers, int npoints, uint64_t seed = QDateTime::currentMSecsSinceEpoch())
   {
-    uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-    SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-    int err = 0;
-    int choose;
-    float totaldensity;
-    float random, density;
-    HexagonalOps ops;
-
-    float td1;
-    for(int i = 0; i < npoints; i++)
-    {
-      m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < HexagonalOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    return GenODFPlotData<T, HexagonalOps>(odf, eulers, static_cast<size_t>(npoints), seed);
   }
 
   /**
@@ -331,41 +445,11 @@ public:
    * @param odf The ODF Data
    * @param eulers Euler angles to be generated. This memory must already be preallocated.
    * @param size The number of points for the Scatter Plot
+   * @param seed Seed of the random numbers. The same seed always generates the same Euler angles.
    */
-  template <typename T> static int GenOrthoRhombicODFPlotData(T* odf, T* eulers, int npoints)
+  template <typename T> static int GenOrthoRhombicODFPlotData(T* odf, T* eulers, int npoints, uint64_t seed = QDateTime::currentMSecsSinceEpoch())
   {
-    uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-    SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-    int err = 0;
-    int choose;
-    float totaldensity;
-    float random, density;
-    OrthoRhombicOps ops;
-
-    float td1;
-    for(int i = 0; i < npoints; i++)
-    {
-      m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < OrthoRhombicOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    return GenODFPlotData<T, OrthoRhombicOps>(odf, eulers, static_cast<size_t>(npoints), seed);
   }
 
   /**
@@ -375,53 +459,14 @@ public:
    * type is a QVector conforming class type that holds the data.
    * QVector falls into this category. The input data for the
    * euler angles is in Columnar fashion instead of row major format.
-   * @param e1s The first euler angles (input)
-   * @param e2s The second euler angles (input)
-   * @param e3s The third euler angles (input)
-   * @param weights Array of weights values. (input)
-   * @param sigmas Array of sigma values. (input)
-   * @param xA X Values of the A axis PF Scatter plot (Output). This memory must already be preallocated.
-   * @param yA Y Values of the A axis PF Scatter plot (Output). This memory must already be preallocated.
-   * @param xB X Values of the B axis PF Scatter plot (Output). This memory must already be preallocated.
-   * @param yB Y Values of the B axis PF Scatter plot (Output). This memory must already be preallocated.
-   * @param xC X Values of the C axis PF Scatter plot (Output). This memory must already be preallocated.
-   * @param yC Y Values of the C axis PF Scatter plot (Output). This memory must already be preallocated.
+   * @param odf The ODF Data
+   * @param eulers Euler angles to be generated. This memory must already be preallocated.
    * @param size The number of points for the Scatter Plot
+   * @param seed Seed of the random numbers. The same seed always generates the same Euler angles.
    */
-  template <typename T> static int GenAxisODFPlotData(T* odf, T* eulers, int npoints)
+  template <typename T> static int GenAxisODFPlotData(T* odf, T* eulers, int npoints, uint64_t seed = QDateTime::currentMSecsSinceEpoch())
   {
-    uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-    SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-    int err = 0;
-    int choose;
-    float totaldensity;
-    float random, density;
-    OrthoRhombicOps ops;
-
-    float td1;
-    for(int i = 0; i < npoints; i++)
-    {
-      m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < OrthoRhombicOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    return GenODFPlotData<T, OrthoRhombicOps>(odf, eulers, static_cast<size_t>(npoints), seed);
   }
 
   /**
@@ -432,59 +477,11 @@ public:
    * @param y [outout] Y Values of the Scatter plot. This memory must already be preallocated.
    * @param npoints The number of XY points for the Scatter Plot
    * @param size The number of samples of the MDF to take
+   * @param seed Seed of the random numbers. The same seed always generates the same plot.
    */
-  template <typename T> static int GenCubicMDFPlotData(T* mdf, T* xval, T* yval, int npoints, int size)
+  template <typename T> static int GenCubicMDFPlotData(T* mdf, T* xval, T* yval, int npoints, int size, uint64_t seed = QDateTime::currentMSecsSinceEpoch())
   {
-    float radtodeg = 180.0f / float(M_PI);
-
-    uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-    SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-
-    int err = 0;
-    float density;
-    float totaldensity;
-    int choose = 0;
-    float random;
-    float w;
-
-    CubicOps ops;
-
-    for(int i = 0; i < npoints; i++)
-    {
-      yval[i] = 0;
-    }
-
-    float td1;
-    for(int i = 0; i < size; i++)
-    {
-      m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < CubicOps::k_MdfSize; j++)
-      {
-        density = mdf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      FOrientArrayType rod = ops.determineRodriguesVector(m_Seed, choose);
-      FOrientArrayType ax(4, 0.0);
-      FOrientTransformsType::ro2ax(rod, ax);
-
-      w = ax[3] * radtodeg;
-      yval[int(w / 5.0)]++;
-    }
-    for(int i = 0; i < npoints; i++)
-    {
-      xval[i] = i * 5.0 + 2.5;
-      yval[i] = yval[i] / float(size);
-    }
-    return err;
+    return GenMDFPlotData<T, CubicOps>(mdf, xval, yval, npoints, size, seed);
   }
 
   /**
@@ -495,58 +492,11 @@ public:
    * @param y [outout] Y Values of the Scatter plot. This memory must already be preallocated.
    * @param npoints The number of XY points for the Scatter Plot
    * @param size The number of samples of the MDF to take
+   * @param seed Seed of the random numbers. The same seed always generates the same plot.
    */
-  template <typename T> static int GenHexMDFPlotData(T* mdf, T* xval, T* yval, int npoints, int size)
+  template <typename T> static int GenHexMDFPlotData(T* mdf, T* xval, T* yval, int npoints, int size, uint64_t seed = QDateTime::currentMSecsSinceEpoch())
   {
-    float radtodeg = 180.0f / float(M_PI);
-
-    uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-    SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-
-    int err = 0;
-    int choose = 0;
-    float density;
-    float totaldensity;
-    float random;
-    HexagonalOps ops;
-
-    for(int i = 0; i < npoints; i++)
-    {
-      yval[i] = 0;
-    }
-    //    float ra1, ra2, ra3, rb1, rb2, rb3, rc1, rc2, rc3;
-    float td1;
-    for(int i = 0; i < size; i++)
-    {
-      m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(size_t j = 0; j < HexagonalOps::k_MdfSize; j++)
-      {
-        density = mdf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      FOrientArrayType rod = ops.determineRodriguesVector(m_Seed, choose);
-      FOrientArrayType ax(4, 0.0);
-      FOrientTransformsType::ro2ax(rod, ax);
-
-      float w = ax[3] * radtodeg;
-      size_t index = static_cast<size_t>(w / 5.0f);
-      yval[index]++;
-    }
-    for(int i = 0; i < npoints; i++)
-    {
-      xval[i] = i * 5.0 + 2.5;
-      yval[i] = yval[i] / float(size);
-    }
-    return err;
+    return GenMDFPlotData<T, HexagonalOps>(mdf, xval, yval, npoints, size, seed);
   }
 
 protected:
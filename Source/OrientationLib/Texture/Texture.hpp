@@ -35,9 +35,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
+#include <QtCore/QDateTime>
 #include <QtCore/QString>
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -45,12 +47,83 @@
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/SIMPLib.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "OrientationLib/LaueOps/CubicOps.h"
 #include "OrientationLib/LaueOps/HexagonalOps.h"
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Texture/DiscreteDistributionSampler.hpp"
+#include "OrientationLib/Utilities/CounterRandomGenerator.hpp"
+
+/**
+ * @brief The CalculateMDFDataImpl class implements a threaded algorithm that draws pairs of orientations from an ODF
+ * and stores the MDF bin of their misorientation. Sample i draws all of its random numbers from its own counters of
+ * a CounterRandomGenerator, so the bin of a sample only depends on the seed and on i.
+ */
+template <typename T, class LaueOpsType> class CalculateMDFDataImpl
+{
+  public:
+    CalculateMDFDataImpl(const DiscreteDistributionSampler<T>* sampler, const CounterRandomGenerator& rg, size_t firstSample, int32_t* mdfBins)
+    : m_Sampler(sampler)
+    , m_Rg(rg)
+    , m_FirstSample(firstSample)
+    , m_MdfBins(mdfBins)
+    {
+    }
+    virtual ~CalculateMDFDataImpl() = default;
+
+    void generate(size_t start, size_t end) const
+    {
+      LaueOpsType orientationOps;
+      QuatF q1;
+      QuatF q2;
+      float n1, n2, n3;
+      FOrientArrayType qu(4);
+      FOrientArrayType ro(4);
+      for(size_t i = start; i < end; i++)
+      {
+        uint64_t counter = 4 * (m_FirstSample + i);
+        int choose1 = m_Sampler->sample(static_cast<T>(m_Rg.genrand_res53(counter)));
+        int choose2 = m_Sampler->sample(static_cast<T>(m_Rg.genrand_res53(counter + 1)));
+
+        FOrientArrayType eu = orientationOps.determineEulerAngles(m_Rg.genrand_int64(counter + 2), choose1);
+        OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
+        q1 = qu.toQuaternion();
+
+        eu = orientationOps.determineEulerAngles(m_Rg.genrand_int64(counter + 3), choose2);
+        OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
+        q2 = qu.toQuaternion();
+        float w = orientationOps.getMisoQuat(q1, q2, n1, n2, n3);
+
+        FOrientArrayType ax(n1, n2, n3, w);
+        OrientationTransforms<FOrientArrayType, float>::ax2ro(ax, ro);
+
+        ro = orientationOps.getMDFFZRod(ro);
+        m_MdfBins[i] = orientationOps.getMisoBin(ro);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const DiscreteDistributionSampler<T>* m_Sampler;
+    CounterRandomGenerator m_Rg;
+    size_t m_FirstSample;
+    int32_t* m_MdfBins;
+};
 
 /**
  * @class Texture Texture.h AIM/Common/Texture.h
@@ -490,24 +563,16 @@ public:
    * @param numEntries The number of elemnts in teh Angles/Axes/Weights arrays which should all the be same size or at least
    * the value passed here is the minium size of all the arrays. The sizes of the ODF and MDF arrays are
    * determined by calling the getODFSize and getMDFSize functions of the parameterized LaueOps class.
+   * @param seed Seed of the random numbers. The same seed always generates the same MDF.
    */
-  template <typename T, class LaueOps> static void CalculateMDFData(T* angles, T* axes, T* weights, T* odf, T* mdf, size_t numEntries)
+  template <typename T, class LaueOps>
+  static void CalculateMDFData(T* angles, T* axes, T* weights, T* odf, T* mdf, size_t numEntries, uint64_t seed = QDateTime::currentMSecsSinceEpoch())
   {
     LaueOps orientationOps;
     const int odfsize = orientationOps.getODFSize();
     const int mdfsize = orientationOps.getMDFSize();
 
-    uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-    SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-
     int mbin;
-    float w = 0;
-    int choose1, choose2;
-    QuatF q1;
-    QuatF q2;
-    float totaldensity;
-    float n1, n2, n3;
-    float random1, random2, density;
 
     for(int i = 0; i < mdfsize; i++)
     {
@@ -527,55 +592,39 @@ public:
       remainingcount = remainingcount + mdf[mbin];
     }
 
-    for(int i = 0; i < remainingcount; i++)
+    // The random misorientations are drawn in parallel batches; they are then accepted in sample order, skipping the
+    // samples that fall into a bin set from the angle/axis list, so the MDF only depends on the seed
+    DiscreteDistributionSampler<T> sampler(odf, static_cast<size_t>(odfsize));
+    CounterRandomGenerator rg(seed);
+    std::vector<int32_t> mdfBins(static_cast<size_t>(std::max(remainingcount, 1024)), 0);
+    size_t firstSample = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+    while(remainingcount > 0)
     {
-      m_Seed++;
-      SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-      random1 = rg.genrand_res53();
-      random2 = rg.genrand_res53();
-      choose1 = 0;
-      choose2 = 0;
-
-      totaldensity = 0;
-      for(int j = 0; j < odfsize; j++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
       {
-        density = odf[j];
-        float d = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random1 >= d && random1 < totaldensity)
-        {
-          choose1 = static_cast<int>(j);
-        }
-        if(random2 >= d && random2 < totaldensity)
-        {
-          choose2 = static_cast<int>(j);
-        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, mdfBins.size()), CalculateMDFDataImpl<T, LaueOps>(&sampler, rg, firstSample, mdfBins.data()), tbb::auto_partitioner());
       }
-
-      FOrientArrayType eu = orientationOps.determineEulerAngles(m_Seed, choose1);
-      FOrientArrayType qu(4);
-      OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
-      q1 = qu.toQuaternion();
-
-      m_Seed++;
-      eu = orientationOps.determineEulerAngles(m_Seed, choose2);
-      OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
-      q2 = qu.toQuaternion();
-      w = orientationOps.getMisoQuat(q1, q2, n1, n2, n3);
-
-      FOrientArrayType ax(n1, n2, n3, w);
-      FOrientArrayType ro(4);
-      OrientationTransforms<FOrientArrayType, float>::ax2ro(ax, ro);
-
-      ro = orientationOps.getMDFFZRod(ro);
-      mbin = orientationOps.getMisoBin(ro);
-      if(mdf[mbin] >= 0)
+      else
+#endif
       {
-        mdf[mbin]++;
+        CalculateMDFDataImpl<T, LaueOps> serial(&sampler, rg, firstSample, mdfBins.data());
+        serial.generate(0, mdfBins.size());
       }
-      if(mdf[mbin] < 0)
+      firstSample += mdfBins.size();
+
+      for(size_t i = 0; i < mdfBins.size() && remainingcount > 0; i++)
       {
-        i = i - 1;
+        mbin = mdfBins[i];
+        if(mdf[mbin] >= 0)
+        {
+          mdf[mbin]++;
+          remainingcount--;
+        }
       }
     }
     for(int i = 0; i < mdfsize; i++)
@@ -0,0 +1,108 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief The CounterRandomGenerator class is a counter-based random number generator: the n-th number of a stream
+ * is a pure function of the seed, the stream and n (SplitMix64 mixing of the counter). Any sample of a parallel
+ * loop can therefore draw its numbers from its own index, and the results do not depend on the number of threads
+ * or the order in which the samples are processed. Unlike the Mersenne Twister, creating a generator costs nothing,
+ * so a new one may be created for every sample.
+ */
+class CounterRandomGenerator
+{
+  public:
+    /**
+     * @brief CounterRandomGenerator
+     * @param seed Seed of the generator
+     * @param stream Independent stream of the seed
+     */
+    explicit CounterRandomGenerator(uint64_t seed, uint64_t stream = 0)
+    : m_Key(Mix(seed + Mix(stream + k_Golden)))
+    {
+    }
+
+    virtual ~CounterRandomGenerator() = default;
+
+    /**
+     * @brief split Returns an independent generator for the given stream, e.g. one per feature or per sample
+     * @param stream
+     * @return
+     */
+    CounterRandomGenerator split(uint64_t stream) const
+    {
+      return CounterRandomGenerator(m_Key, stream);
+    }
+
+    /**
+     * @brief genrand_int64 Returns the 64 bit random number at the given counter
+     * @param counter
+     * @return
+     */
+    uint64_t genrand_int64(uint64_t counter) const
+    {
+      return Mix(m_Key + (counter + 1) * k_Golden);
+    }
+
+    /**
+     * @brief genrand_res53 Returns the random number at the given counter as a double in [0,1) with 53 bit resolution
+     * @param counter
+     * @return
+     */
+    double genrand_res53(uint64_t counter) const
+    {
+      return static_cast<double>(genrand_int64(counter) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Mix SplitMix64 finalizer
+     * @param z
+     * @return
+     */
+    static uint64_t Mix(uint64_t z)
+    {
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+
+  private:
+    static const uint64_t k_Golden = 0x9E3779B97F4A7C15ULL;
+
+    uint64_t m_Key;
+};
@@ -0,0 +1,552 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FeatureMisorientationCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Math/QuaternionMath.hpp"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+namespace
+{
+// Number of tables kept alive at the same time; a pipeline rarely works on more than one neighbor list
+const size_t k_MaxCachedTables = 4;
+
+const uint64_t k_HashSeed = 14695981039346656037ULL;
+const uint64_t k_HashPrime = 1099511628211ULL;
+
+/**
+ * @brief HashBytes Folds the bytes into an FNV-1a style 64 bit hash, one 8 byte word at a time
+ */
+uint64_t HashBytes(const void* data, size_t numBytes, uint64_t hash)
+{
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  size_t numWords = numBytes / sizeof(uint64_t);
+  for(size_t w = 0; w < numWords; w++)
+  {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes + w * sizeof(uint64_t), sizeof(uint64_t));
+    hash = (hash ^ word) * k_HashPrime;
+  }
+  for(size_t b = numWords * sizeof(uint64_t); b < numBytes; b++)
+  {
+    hash = (hash ^ bytes[b]) * k_HashPrime;
+  }
+  return hash;
+}
+
+// The inputs are hashed in blocks of this many bytes (arrays) or features (neighbor lists) that are processed in
+// parallel; the block hashes are then hashed in order, so the fingerprint does not depend on the number of threads
+const size_t k_HashBlockBytes = 1 << 18;
+const size_t k_HashBlockFeatures = 1 << 14;
+
+/**
+ * @brief The ArrayFingerprintImpl class implements a threaded algorithm that hashes the blocks of a range of bytes
+ */
+class ArrayFingerprintImpl
+{
+public:
+  ArrayFingerprintImpl(const uint8_t* bytes, size_t numBytes, uint64_t* blockHashes)
+  : m_Bytes(bytes)
+  , m_NumBytes(numBytes)
+  , m_BlockHashes(blockHashes)
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t b = start; b < end; b++)
+    {
+      size_t first = b * k_HashBlockBytes;
+      m_BlockHashes[b] = HashBytes(m_Bytes + first, std::min(k_HashBlockBytes, m_NumBytes - first), k_HashSeed);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const uint8_t* m_Bytes;
+  size_t m_NumBytes;
+  uint64_t* m_BlockHashes;
+};
+
+/**
+ * @brief The NeighborListFingerprintImpl class implements a threaded algorithm that hashes the length and the entries
+ * of the lists of each block of features
+ */
+class NeighborListFingerprintImpl
+{
+public:
+  NeighborListFingerprintImpl(NeighborList<int32_t>& neighborList, size_t numFeatures, uint64_t* blockHashes)
+  : m_NeighborList(neighborList)
+  , m_NumFeatures(numFeatures)
+  , m_BlockHashes(blockHashes)
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t b = start; b < end; b++)
+    {
+      uint64_t hash = k_HashSeed;
+      size_t last = std::min((b + 1) * k_HashBlockFeatures, m_NumFeatures);
+      for(size_t i = b * k_HashBlockFeatures; i < last; i++)
+      {
+        std::vector<int32_t>& list = m_NeighborList.getListReference(static_cast<int32_t>(i));
+        uint64_t numNeighbors = list.size();
+        hash = HashBytes(&numNeighbors, sizeof(numNeighbors), hash);
+        hash = HashBytes(list.data(), list.size() * sizeof(int32_t), hash);
+      }
+      m_BlockHashes[b] = hash;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  NeighborList<int32_t>& m_NeighborList;
+  size_t m_NumFeatures;
+  uint64_t* m_BlockHashes;
+};
+
+/**
+ * @brief Fingerprint Hashes the values of the array
+ */
+template <typename T> uint64_t Fingerprint(DataArray<T>& array)
+{
+  size_t numBytes = array.getSize() * sizeof(T);
+  std::vector<uint64_t> blockHashes((numBytes + k_HashBlockBytes - 1) / k_HashBlockBytes, 0);
+  ArrayFingerprintImpl serial(reinterpret_cast<const uint8_t*>(array.getPointer(0)), numBytes, blockHashes.data());
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true && blockHashes.size() > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blockHashes.size()), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.compute(0, blockHashes.size());
+  }
+  return HashBytes(blockHashes.data(), blockHashes.size() * sizeof(uint64_t), k_HashSeed);
+}
+
+/**
+ * @brief Fingerprint Hashes the length and the entries of every list of the neighbor list
+ */
+uint64_t Fingerprint(NeighborList<int32_t>& neighborList)
+{
+  size_t numFeatures = neighborList.getNumberOfTuples();
+  std::vector<uint64_t> blockHashes((numFeatures + k_HashBlockFeatures - 1) / k_HashBlockFeatures, 0);
+  NeighborListFingerprintImpl serial(neighborList, numFeatures, blockHashes.data());
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true && blockHashes.size() > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blockHashes.size()), serial, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    serial.compute(0, blockHashes.size());
+  }
+  return HashBytes(blockHashes.data(), blockHashes.size() * sizeof(uint64_t), k_HashSeed);
+}
+
+/**
+ * @brief The InputArray struct identifies one input of a cached table by the array object and the size and
+ * fingerprint of the values it had when the table was computed, so an array that is replaced, resized or rewritten
+ * in place never matches an old table.
+ */
+struct InputArray
+{
+  IDataArray::WeakPointer array;
+  size_t numTuples = 0;
+  uint64_t fingerprint = 0;
+
+  InputArray() = default;
+
+  InputArray(const IDataArray::Pointer& source, uint64_t sourceFingerprint)
+  : array(source)
+  , numTuples(source->getNumberOfTuples())
+  , fingerprint(sourceFingerprint)
+  {
+  }
+
+  bool expired() const
+  {
+    return array.expired();
+  }
+
+  bool refersTo(const IDataArray::Pointer& source) const
+  {
+    return array.lock() == source;
+  }
+
+  bool matches(const IDataArray::Pointer& source, uint64_t sourceFingerprint) const
+  {
+    return refersTo(source) && numTuples == source->getNumberOfTuples() && fingerprint == sourceFingerprint;
+  }
+};
+
+struct CachedTable
+{
+  InputArray neighborList;
+  InputArray avgQuats;
+  InputArray featurePhases;
+  InputArray crystalStructures;
+  FeatureMisorientationCache::Pointer table;
+
+  bool expired() const
+  {
+    return neighborList.expired() || avgQuats.expired() || featurePhases.expired() || crystalStructures.expired();
+  }
+};
+
+/**
+ * @brief TablesMutex Guards the registry of cached tables. It is only held to look a table up or to insert one,
+ * never while a table or a fingerprint is computed.
+ */
+std::mutex& TablesMutex()
+{
+  static std::mutex tablesMutex;
+  return tablesMutex;
+}
+
+/**
+ * @brief CachedTables Returns the registry of cached tables, oldest first
+ */
+std::vector<CachedTable>& CachedTables()
+{
+  static std::vector<CachedTable> tables;
+  return tables;
+}
+
+/**
+ * @brief DropExpiredTables Removes the tables whose input arrays no longer exist. The caller holds TablesMutex().
+ */
+void DropExpiredTables()
+{
+  std::vector<CachedTable>& tables = CachedTables();
+  tables.erase(std::remove_if(tables.begin(), tables.end(), [](const CachedTable& cached) { return cached.expired(); }), tables.end());
+}
+}
+
+/**
+ * @brief The FeatureMisorientationCacheImpl class implements a threaded algorithm that computes the misorientation
+ * of every neighbor list entry of a range of features.
+ */
+class FeatureMisorientationCacheImpl
+{
+public:
+  FeatureMisorientationCacheImpl(const size_t* offsets, const int32_t* neighbors, const float* avgQuats, const int32_t* featurePhases, const uint32_t* crystalStructures, float* angles, float* axes,
+                                 uint8_t* valid)
+  : m_Offsets(offsets)
+  , m_Neighbors(neighbors)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Angles(angles)
+  , m_Axes(axes)
+  , m_Valid(valid)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+
+  virtual ~FeatureMisorientationCacheImpl()
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    const QuatF* avgQuats = reinterpret_cast<const QuatF*>(m_AvgQuats);
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+
+    for(size_t i = start; i < end; i++)
+    {
+      QuaternionMathF::Copy(avgQuats[i], q1);
+      uint32_t xtalType1 = m_CrystalStructures[m_FeaturePhases[i]];
+      for(size_t entry = m_Offsets[i]; entry < m_Offsets[i + 1]; entry++)
+      {
+        int32_t neighbor = m_Neighbors[entry];
+        uint32_t xtalType2 = m_CrystalStructures[m_FeaturePhases[neighbor]];
+        if(xtalType1 == xtalType2 && xtalType1 < static_cast<uint32_t>(m_OrientationOps.size()))
+        {
+          QuaternionMathF::Copy(avgQuats[neighbor], q2);
+          m_Angles[entry] = m_OrientationOps[xtalType1]->getMisoQuat(q1, q2, n1, n2, n3);
+          m_Axes[3 * entry] = n1;
+          m_Axes[3 * entry + 1] = n2;
+          m_Axes[3 * entry + 2] = n3;
+          m_Valid[entry] = 1;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const size_t* m_Offsets;
+  const int32_t* m_Neighbors;
+  const float* m_AvgQuats;
+  const int32_t* m_FeaturePhases;
+  const uint32_t* m_CrystalStructures;
+  float* m_Angles;
+  float* m_Axes;
+  uint8_t* m_Valid;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureMisorientationCache::FeatureMisorientationCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureMisorientationCache::~FeatureMisorientationCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureMisorientationCache::Pointer FeatureMisorientationCache::Get(NeighborList<int32_t>::Pointer neighborList, FloatArrayType::Pointer avgQuats, Int32ArrayType::Pointer featurePhases,
+                                                                    UInt32ArrayType::Pointer crystalStructures)
+{
+  if(nullptr == neighborList.get() || nullptr == avgQuats.get() || nullptr == featurePhases.get() || nullptr == crystalStructures.get())
+  {
+    return NullPointer();
+  }
+
+  // The fingerprints are computed in parallel outside the lock; hashing the inputs reads each value once, which is far
+  // cheaper than the misorientations, which take a pass over the symmetry operators for every entry
+  CachedTable cached;
+  cached.neighborList = InputArray(neighborList, Fingerprint(*neighborList));
+  cached.avgQuats = InputArray(avgQuats, Fingerprint(*avgQuats));
+  cached.featurePhases = InputArray(featurePhases, Fingerprint(*featurePhases));
+  cached.crystalStructures = InputArray(crystalStructures, Fingerprint(*crystalStructures));
+
+  {
+    std::lock_guard<std::mutex> lock(TablesMutex());
+    DropExpiredTables();
+    for(const CachedTable& entry : CachedTables())
+    {
+      if(entry.neighborList.matches(neighborList, cached.neighborList.fingerprint) && entry.avgQuats.matches(avgQuats, cached.avgQuats.fingerprint) &&
+         entry.featurePhases.matches(featurePhases, cached.featurePhases.fingerprint) && entry.crystalStructures.matches(crystalStructures, cached.crystalStructures.fingerprint))
+      {
+        return entry.table;
+      }
+    }
+  }
+
+  FeatureMisorientationCache::Pointer table = FeatureMisorientationCache::Pointer(new FeatureMisorientationCache());
+  table->compute(*neighborList, avgQuats->getPointer(0), featurePhases->getPointer(0), crystalStructures->getPointer(0), crystalStructures->getNumberOfTuples());
+  cached.table = table;
+
+  std::lock_guard<std::mutex> lock(TablesMutex());
+  DropExpiredTables();
+  std::vector<CachedTable>& tables = CachedTables();
+  // A table of the same neighbor list is stale now; it is replaced rather than kept next to the new one
+  tables.erase(std::remove_if(tables.begin(), tables.end(), [&neighborList](const CachedTable& entry) { return entry.neighborList.refersTo(neighborList); }), tables.end());
+  if(tables.size() >= k_MaxCachedTables)
+  {
+    tables.erase(tables.begin());
+  }
+  tables.push_back(cached);
+  return table;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureMisorientationCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(TablesMutex());
+  CachedTables().clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureMisorientationCache::GetNumberOfCachedTables()
+{
+  std::lock_guard<std::mutex> lock(TablesMutex());
+  DropExpiredTables();
+  return CachedTables().size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureMisorientationCache::compute(NeighborList<int32_t>& neighborList, const float* avgQuats, const int32_t* featurePhases, const uint32_t* crystalStructures, size_t numEnsembles)
+{
+  size_t numFeatures = neighborList.getNumberOfTuples();
+  m_Offsets.assign(numFeatures + 1, 0);
+  for(size_t i = 0; i < numFeatures; i++)
+  {
+    m_Offsets[i + 1] = m_Offsets[i] + neighborList.getListReference(static_cast<int32_t>(i)).size();
+  }
+  size_t numEntries = m_Offsets[numFeatures];
+  m_Neighbors.resize(numEntries);
+  for(size_t i = 0; i < numFeatures; i++)
+  {
+    std::vector<int32_t>& list = neighborList.getListReference(static_cast<int32_t>(i));
+    std::copy(list.begin(), list.end(), m_Neighbors.begin() + m_Offsets[i]);
+  }
+  m_Angles.assign(numEntries, 0.0f);
+  m_Axes.assign(3 * numEntries, 0.0f);
+  m_Valid.assign(numEntries, 0);
+  if(numEntries == 0 || numEnsembles == 0)
+  {
+    return;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures),
+                      FeatureMisorientationCacheImpl(m_Offsets.data(), m_Neighbors.data(), avgQuats, featurePhases, crystalStructures, m_Angles.data(), m_Axes.data(), m_Valid.data()),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FeatureMisorientationCacheImpl serial(m_Offsets.data(), m_Neighbors.data(), avgQuats, featurePhases, crystalStructures, m_Angles.data(), m_Axes.data(), m_Valid.data());
+    serial.compute(0, numFeatures);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureMisorientationCache::getNumberOfFeatures() const
+{
+  return m_Offsets.empty() ? 0 : m_Offsets.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureMisorientationCache::getOffset(size_t feature) const
+{
+  return m_Offsets[feature];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureMisorientationCache::getNumberOfNeighbors(size_t feature) const
+{
+  return m_Offsets[feature + 1] - m_Offsets[feature];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t FeatureMisorientationCache::findEntry(int32_t feature, int32_t neighbor) const
+{
+  if(feature < 0 || static_cast<size_t>(feature) >= getNumberOfFeatures())
+  {
+    return -1;
+  }
+  for(size_t entry = m_Offsets[feature]; entry < m_Offsets[feature + 1]; entry++)
+  {
+    if(m_Neighbors[entry] == neighbor)
+    {
+      return static_cast<int64_t>(entry);
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FeatureMisorientationCache::isValid(size_t entry) const
+{
+  return m_Valid[entry] != 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float FeatureMisorientationCache::getAngle(size_t entry) const
+{
+  return m_Angles[entry];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureMisorientationCache::getAxis(size_t entry, float& n1, float& n2, float& n3) const
+{
+  n1 = m_Axes[3 * entry];
+  n2 = m_Axes[3 * entry + 1];
+  n3 = m_Axes[3 * entry + 2];
+}
@@ -0,0 +1,160 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+
+#include "OrientationLib/OrientationLib.h"
+
+/**
+ * @brief The FeatureMisorientationCache class holds the misorientation between every feature and each entry of its
+ * neighbor list, stored in neighbor list order. Tables are computed in parallel and kept per NeighborList object, so
+ * filters that run one after the other on the same features read the misorientations instead of recomputing them.
+ * A cached table is found by the identity of the neighbor list, average orientation, phase and crystal structure
+ * arrays it was computed from, together with their sizes and a fingerprint of their values, so arrays that are
+ * replaced, resized or rewritten in place are detected without any help from the filters that change them. Tables
+ * whose input arrays have been released are dropped whenever the registry is used.
+ *
+ * The misorientation of entry j of feature i is the one returned by LaueOps::getMisoQuat(q_i, q_neighbor), i.e. the
+ * angle in radians and the axis in the fundamental zone of the common crystal structure. Entries whose features have
+ * different crystal structures, or an unknown crystal structure, are flagged invalid.
+ */
+class OrientationLib_EXPORT FeatureMisorientationCache
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureMisorientationCache)
+    SIMPL_TYPE_MACRO(FeatureMisorientationCache)
+
+    virtual ~FeatureMisorientationCache();
+
+    /**
+     * @brief Get Returns the misorientation table for the given neighbor list. A cached table is reused when it was
+     * computed from the same arrays holding the same values; otherwise the table is computed and replaces the cached
+     * one.
+     * @param neighborList Neighbor list of the features
+     * @param avgQuats Average quaternion of each feature (4 components per tuple)
+     * @param featurePhases Phase of each feature
+     * @param crystalStructures Crystal structure of each phase
+     * @return
+     */
+    static Pointer Get(NeighborList<int32_t>::Pointer neighborList, FloatArrayType::Pointer avgQuats, Int32ArrayType::Pointer featurePhases, UInt32ArrayType::Pointer crystalStructures);
+
+    /**
+     * @brief Clear Releases every cached table
+     */
+    static void Clear();
+
+    /**
+     * @brief GetNumberOfCachedTables Returns the number of tables whose input arrays still exist
+     * @return
+     */
+    static size_t GetNumberOfCachedTables();
+
+    /**
+     * @brief getNumberOfFeatures
+     * @return
+     */
+    size_t getNumberOfFeatures() const;
+
+    /**
+     * @brief getOffset Returns the index of the first entry of the given feature
+     * @param feature
+     * @return
+     */
+    size_t getOffset(size_t feature) const;
+
+    /**
+     * @brief getNumberOfNeighbors Returns the number of entries of the given feature
+     * @param feature
+     * @return
+     */
+    size_t getNumberOfNeighbors(size_t feature) const;
+
+    /**
+     * @brief findEntry Returns the entry of feature whose neighbor is neighbor, or -1 if there is none
+     * @param feature
+     * @param neighbor
+     * @return
+     */
+    int64_t findEntry(int32_t feature, int32_t neighbor) const;
+
+    /**
+     * @brief isValid Returns whether both features of the entry share a known crystal structure
+     * @param entry
+     * @return
+     */
+    bool isValid(size_t entry) const;
+
+    /**
+     * @brief getAngle Returns the misorientation angle of the entry in radians
+     * @param entry
+     * @return
+     */
+    float getAngle(size_t entry) const;
+
+    /**
+     * @brief getAxis Returns the misorientation axis of the entry
+     * @param entry
+     * @param n1
+     * @param n2
+     * @param n3
+     */
+    void getAxis(size_t entry, float& n1, float& n2, float& n3) const;
+
+  protected:
+    FeatureMisorientationCache();
+
+    /**
+     * @brief compute Fills the table from the inputs
+     */
+    void compute(NeighborList<int32_t>& neighborList, const float* avgQuats, const int32_t* featurePhases, const uint32_t* crystalStructures, size_t numEnsembles);
+
+  private:
+    std::vector<size_t> m_Offsets;
+    std::vector<int32_t> m_Neighbors;
+    std::vector<float> m_Angles;
+    std::vector<float> m_Axes;
+    std::vector<uint8_t> m_Valid;
+
+    FeatureMisorientationCache(const FeatureMisorientationCache&) = delete; // Copy Constructor Not Implemented
+    void operator=(const FeatureMisorientationCache&) = delete;             // Move assignment Not Implemented
+};
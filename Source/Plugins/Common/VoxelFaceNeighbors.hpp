@@ -0,0 +1,250 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The VoxelFaceNeighbors namespace enumerates the six face neighbors of every Cell of an image
+ * geometry. The X rows of the volume are split into contiguous slabs that are processed in parallel,
+ * each slab feeding its own visitor, so visitors may accumulate per-Feature results without locking.
+ *
+ * A visitor implements
+ *
+ *     template <bool Interior> void visit(int64_t index, uint8_t faceMask);
+ *
+ * Cells away from the outside of the volume are passed as visit<true>(index, k_AllFaces), so the visitor
+ * can test its neighbors without any bounds checks. The remaining Cells are passed as visit<false>()
+ * with the bits of the faces that have a neighbor. Face l of a Cell is shared with the Cell at
+ * index + offsets[l] (see NeighborOffsets), in the -Z, -Y, -X, +X, +Y, +Z order used by the filters.
+ *
+ * The kernel is header only and lives next to the plugins, which all have this directory on their include path,
+ * so any plugin can use it without linking another plugin or library.
+ */
+namespace VoxelFaceNeighbors
+{
+const uint8_t k_MinusZ = 0x01;
+const uint8_t k_MinusY = 0x02;
+const uint8_t k_MinusX = 0x04;
+const uint8_t k_PlusX = 0x08;
+const uint8_t k_PlusY = 0x10;
+const uint8_t k_PlusZ = 0x20;
+const uint8_t k_AllFaces = 0x3F;
+
+/**
+ * @brief NeighborOffsets Fills the index offsets of the six face neighbors
+ * @param dims
+ * @param offsets
+ */
+inline void NeighborOffsets(const int64_t dims[3], int64_t offsets[6])
+{
+  offsets[0] = -dims[0] * dims[1];
+  offsets[1] = -dims[0];
+  offsets[2] = -1;
+  offsets[3] = 1;
+  offsets[4] = dims[0];
+  offsets[5] = dims[0] * dims[1];
+}
+
+/**
+ * @brief ExtendedFaces Returns the bits of the faces whose axis spans more than one Cell. Faces along a
+ * flat axis of a 2D image never have neighbors and are not part of the outside of the image.
+ * @param dims
+ * @return
+ */
+inline uint8_t ExtendedFaces(const int64_t dims[3])
+{
+  uint8_t faces = 0;
+  if(dims[0] > 1)
+  {
+    faces |= (k_MinusX | k_PlusX);
+  }
+  if(dims[1] > 1)
+  {
+    faces |= (k_MinusY | k_PlusY);
+  }
+  if(dims[2] > 1)
+  {
+    faces |= (k_MinusZ | k_PlusZ);
+  }
+  return faces;
+}
+
+/**
+ * @brief NumberOfSlabs Returns how many visitors Enumerate() expects
+ * @param dims
+ * @return
+ */
+inline size_t NumberOfSlabs(const int64_t dims[3])
+{
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  numSlabs = static_cast<size_t>(std::max(init.default_num_threads(), 1));
+#endif
+  return std::min(numSlabs, static_cast<size_t>(std::max(dims[1] * dims[2], static_cast<int64_t>(1))));
+}
+
+/**
+ * @brief The SlabImpl class implements a threaded algorithm that walks the rows of a set of slabs and hands
+ * every Cell to the visitor of its slab
+ */
+template <typename VisitorType> class SlabImpl
+{
+  int64_t m_Dims[3];
+  size_t m_NumSlabs;
+  VisitorType* m_Visitors;
+
+public:
+  SlabImpl(const int64_t dims[3], size_t numSlabs, VisitorType* visitors)
+  : m_NumSlabs(numSlabs)
+  , m_Visitors(visitors)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~SlabImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    int64_t numRows = m_Dims[1] * m_Dims[2];
+    int64_t xPoints = m_Dims[0];
+    for(size_t slab = start; slab < end; slab++)
+    {
+      VisitorType& visitor = m_Visitors[slab];
+      int64_t rowStart = static_cast<int64_t>(slab) * numRows / static_cast<int64_t>(m_NumSlabs);
+      int64_t rowEnd = static_cast<int64_t>(slab + 1) * numRows / static_cast<int64_t>(m_NumSlabs);
+      for(int64_t row = rowStart; row < rowEnd; row++)
+      {
+        int64_t y = row % m_Dims[1];
+        int64_t z = row / m_Dims[1];
+        int64_t index = row * xPoints;
+
+        uint8_t rowMask = k_AllFaces;
+        if(z == 0)
+        {
+          rowMask &= ~k_MinusZ;
+        }
+        if(z == m_Dims[2] - 1)
+        {
+          rowMask &= ~k_PlusZ;
+        }
+        if(y == 0)
+        {
+          rowMask &= ~k_MinusY;
+        }
+        if(y == m_Dims[1] - 1)
+        {
+          rowMask &= ~k_PlusY;
+        }
+
+        if(xPoints == 1)
+        {
+          visitor.template visit<false>(index, static_cast<uint8_t>(rowMask & ~(k_MinusX | k_PlusX)));
+          continue;
+        }
+
+        visitor.template visit<false>(index, static_cast<uint8_t>(rowMask & ~k_MinusX));
+        if(rowMask == k_AllFaces)
+        {
+          for(int64_t x = 1; x < xPoints - 1; x++)
+          {
+            visitor.template visit<true>(index + x, k_AllFaces);
+          }
+        }
+        else
+        {
+          for(int64_t x = 1; x < xPoints - 1; x++)
+          {
+            visitor.template visit<false>(index + x, rowMask);
+          }
+        }
+        visitor.template visit<false>(index + xPoints - 1, static_cast<uint8_t>(rowMask & ~k_PlusX));
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief Enumerate Visits every Cell of the volume once. The visitors vector must hold NumberOfSlabs(dims)
+ * visitors; visitor s sees the Cells of the s-th slab of rows, in ascending index order.
+ * @param dims
+ * @param visitors
+ */
+template <typename VisitorType> void Enumerate(const int64_t dims[3], std::vector<VisitorType>& visitors)
+{
+  size_t numSlabs = visitors.size();
+  if(numSlabs == 0 || dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0)
+  {
+    return;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs), SlabImpl<VisitorType>(dims, numSlabs, visitors.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SlabImpl<VisitorType> serial(dims, numSlabs, visitors.data());
+    serial.compute(0, numSlabs);
+  }
+}
+}
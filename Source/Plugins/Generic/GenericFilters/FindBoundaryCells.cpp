@@ -45,9 +45,66 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/VoxelFaceNeighbors.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
+/**
+ * @brief The BoundaryCellsVisitor class counts, for every Cell of one slab, the faces it shares with a
+ * different Feature and, optionally, the axes along which it touches the outside of the volume
+ */
+class BoundaryCellsVisitor
+{
+  const int32_t* m_FeatureIds;
+  int8_t* m_BoundaryCells;
+  int64_t m_Offsets[6];
+  bool m_CountX;
+  bool m_CountY;
+  bool m_CountZ;
+  int32_t m_IgnoreFeatureZeroVal;
+
+public:
+  BoundaryCellsVisitor(const int32_t* featureIds, int8_t* boundaryCells, const int64_t dims[3], bool includeVolumeBoundary, int32_t ignoreFeatureZeroVal)
+  : m_FeatureIds(featureIds)
+  , m_BoundaryCells(boundaryCells)
+  , m_CountX(includeVolumeBoundary && dims[0] > 2)
+  , m_CountY(includeVolumeBoundary && dims[1] > 2)
+  , m_CountZ(includeVolumeBoundary && dims[2] > 2)
+  , m_IgnoreFeatureZeroVal(ignoreFeatureZeroVal)
+  {
+    VoxelFaceNeighbors::NeighborOffsets(dims, m_Offsets);
+  }
+
+  template <bool Interior> void visit(int64_t index, uint8_t faceMask)
+  {
+    int8_t onsurf = 0;
+    int32_t feature = m_FeatureIds[index];
+    if(feature >= 0)
+    {
+      if(!Interior && feature != 0)
+      {
+        const uint8_t xFaces = VoxelFaceNeighbors::k_MinusX | VoxelFaceNeighbors::k_PlusX;
+        const uint8_t yFaces = VoxelFaceNeighbors::k_MinusY | VoxelFaceNeighbors::k_PlusY;
+        const uint8_t zFaces = VoxelFaceNeighbors::k_MinusZ | VoxelFaceNeighbors::k_PlusZ;
+        onsurf += (m_CountX && (faceMask & xFaces) != xFaces) ? 1 : 0;
+        onsurf += (m_CountY && (faceMask & yFaces) != yFaces) ? 1 : 0;
+        onsurf += (m_CountZ && (faceMask & zFaces) != zFaces) ? 1 : 0;
+      }
+
+      for(int32_t l = 0; l < 6; l++)
+      {
+        if(Interior || (faceMask & (1 << l)) != 0)
+        {
+          int32_t neighborFeature = m_FeatureIds[index + m_Offsets[l]];
+          onsurf += (neighborFeature != feature && neighborFeature > m_IgnoreFeatureZeroVal) ? 1 : 0;
+        }
+      }
+    }
+    m_BoundaryCells[index] = onsurf;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -163,89 +220,19 @@ void FindBoundaryCells::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -1 * (xPoints * yPoints);
-  neighpoints[1] = -1 * (xPoints);
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
+  int64_t dims[3] = {
+      static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints()), static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints()),
+      static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints()),
+  };
 
-  int32_t feature = 0;
-  int32_t onsurf = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
-
-  int ignoreFeatureZeroVal = 0;
+  int32_t ignoreFeatureZeroVal = 0;
   if (m_IgnoreFeatureZero == false)
   {
     ignoreFeatureZeroVal = -1;
   }
 
-  int64_t zStride = 0, yStride = 0;
-  for(int64_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(int64_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(int64_t k = 0; k < xPoints; k++)
-      {
-        onsurf = 0;
-        feature = m_FeatureIds[zStride + yStride + k];
-        if(feature >= 0)
-        {
-          if(m_IncludeVolumeBoundary == true)
-          {
-            if (xPoints > 2 && (k == 0 || k == xPoints - 1)) { onsurf++; }
-            if (yPoints > 2 && (j == 0 || j == yPoints - 1)) { onsurf++; }
-            if (zPoints > 2 && (i == 0 || i == zPoints - 1)) { onsurf++; }
-
-            if(onsurf > 0 && feature == 0) { onsurf = 0; }
-          }
-
-          for(int64_t l = 0; l < 6; l++)
-          {
-            good = 1;
-            neighbor = zStride + yStride + k + neighpoints[l];
-            if(l == 0 && i == 0)
-            {
-              good = 0;
-            }
-            if(l == 5 && i == (zPoints - 1))
-            {
-              good = 0;
-            }
-            if(l == 1 && j == 0)
-            {
-              good = 0;
-            }
-            if(l == 4 && j == (yPoints - 1))
-            {
-              good = 0;
-            }
-            if(l == 2 && k == 0)
-            {
-              good = 0;
-            }
-            if(l == 3 && k == (xPoints - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > ignoreFeatureZeroVal)
-            {
-              onsurf++;
-            }
-          }
-        }
-        m_BoundaryCells[zStride + yStride + k] = onsurf;
-      }
-    }
-  }
+  std::vector<BoundaryCellsVisitor> visitors(VoxelFaceNeighbors::NumberOfSlabs(dims), BoundaryCellsVisitor(m_FeatureIds, m_BoundaryCells, dims, m_IncludeVolumeBoundary, ignoreFeatureZeroVal));
+  VoxelFaceNeighbors::Enumerate(dims, visitors);
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
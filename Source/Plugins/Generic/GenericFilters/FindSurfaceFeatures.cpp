@@ -43,9 +43,51 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Common/VoxelFaceNeighbors.hpp"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
+/**
+ * @brief The SurfaceFeaturesVisitor class flags the Features of one slab that touch the outside of the
+ * volume or a Cell of Feature 0
+ */
+class SurfaceFeaturesVisitor
+{
+  const int32_t* m_FeatureIds;
+  int64_t m_Offsets[6];
+  uint8_t m_ExtendedFaces;
+
+public:
+  SurfaceFeaturesVisitor(const int32_t* featureIds, const int64_t dims[3], size_t numFeatures)
+  : m_FeatureIds(featureIds)
+  , m_ExtendedFaces(VoxelFaceNeighbors::ExtendedFaces(dims))
+  , surfaceFeatures(numFeatures, 0)
+  {
+    VoxelFaceNeighbors::NeighborOffsets(dims, m_Offsets);
+  }
+
+  template <bool Interior> void visit(int64_t index, uint8_t faceMask)
+  {
+    int32_t gnum = m_FeatureIds[index];
+    if(surfaceFeatures[gnum] != 0)
+    {
+      return;
+    }
+    bool onSurface = !Interior && (m_ExtendedFaces & ~faceMask) != 0;
+    for(int32_t l = 0; l < 6; l++)
+    {
+      if(Interior || (faceMask & (1 << l)) != 0)
+      {
+        onSurface = onSurface || (m_FeatureIds[index + m_Offsets[l]] == 0);
+      }
+    }
+    surfaceFeatures[gnum] = onSurface ? 1 : 0;
+  }
+
+  std::vector<uint8_t> surfaceFeatures;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -147,148 +189,23 @@ void FindSurfaceFeatures::find_surfacefeatures()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
 
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-
-  int64_t zStride = 0, yStride = 0;
-  for(int64_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(int64_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(int64_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        if(m_SurfaceFeatures[gnum] == false)
-        {
-          if(k <= 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(k >= xPoints - 1)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(j <= 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(j >= yPoints - 1)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(i <= 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(i >= zPoints - 1)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(m_SurfaceFeatures[gnum] == false)
-          {
-            if(m_FeatureIds[zStride + yStride + k - 1] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k + 1] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k - xPoints] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k + xPoints] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k - (xPoints * yPoints)] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-            if(m_FeatureIds[zStride + yStride + k + (xPoints * yPoints)] == 0)
-            {
-              m_SurfaceFeatures[gnum] = true;
-            }
-          }
-        }
-      }
-    }
-  }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindSurfaceFeatures::find_surfacefeatures2D()
-{
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-
-  int64_t xPoints = 0, yPoints = 0;
+  int64_t dims[3] = {
+      static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints()), static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints()),
+      static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints()),
+  };
+  size_t numFeatures = m_SurfaceFeaturesPtr.lock()->getNumberOfTuples();
 
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  }
-  if(m->getGeometryAs<ImageGeom>()->getYPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  }
-  if(m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-  {
-    xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-    yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  }
+  // A flat axis of a 2D image does not count as part of its outer boundary
+  std::vector<SurfaceFeaturesVisitor> visitors(VoxelFaceNeighbors::NumberOfSlabs(dims), SurfaceFeaturesVisitor(m_FeatureIds, dims, numFeatures));
+  VoxelFaceNeighbors::Enumerate(dims, visitors);
 
-  int64_t yStride;
-  for(int64_t j = 0; j < yPoints; j++)
+  for(size_t s = 0; s < visitors.size(); s++)
   {
-    yStride = j * xPoints;
-    for(int64_t k = 0; k < xPoints; k++)
+    for(size_t i = 0; i < numFeatures; i++)
     {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      if(m_SurfaceFeatures[gnum] == false)
+      if(visitors[s].surfaceFeatures[i] != 0)
       {
-        if(k <= 0)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(k >= xPoints - 1)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(j <= 0)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(j >= yPoints - 1)
-        {
-          m_SurfaceFeatures[gnum] = true;
-        }
-        if(m_SurfaceFeatures[gnum] == false)
-        {
-          if(m_FeatureIds[yStride + k - 1] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(m_FeatureIds[yStride + k + 1] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(m_FeatureIds[yStride + k - static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints())] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-          if(m_FeatureIds[yStride + k + static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints())] == 0)
-          {
-            m_SurfaceFeatures[gnum] = true;
-          }
-        }
+        m_SurfaceFeatures[i] = true;
       }
     }
   }
@@ -307,16 +224,7 @@ void FindSurfaceFeatures::execute()
     return;
   }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() > 1 && m->getGeometryAs<ImageGeom>()->getYPoints() > 1 && m->getGeometryAs<ImageGeom>()->getZPoints() > 1)
-  {
-    find_surfacefeatures();
-  }
-  if(m->getGeometryAs<ImageGeom>()->getXPoints() == 1 || m->getGeometryAs<ImageGeom>()->getYPoints() == 1 || m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-  {
-    find_surfacefeatures2D();
-  }
+  find_surfacefeatures();
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
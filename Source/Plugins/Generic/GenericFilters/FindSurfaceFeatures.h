@@ -164,15 +164,11 @@ protected:
   void initialize();
 
   /**
-   * @brief find_surfacefeatures Determines which Features intersect the outer surface of a 3D volume.
+   * @brief find_surfacefeatures Determines which Features intersect the outer surface of a 3D volume,
+   * or the outer boundary of a 2D area, or touch Feature 0.
    */
   void find_surfacefeatures();
 
-  /**
-   * @brief find_surfacefeatures2D Determines which Features intersect the outer boundary of a 2D area.
-   */
-  void find_surfacefeatures2D();
-
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(bool, SurfaceFeatures)
@@ -0,0 +1,233 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "GenericTestFileLocations.h"
+
+class FindBoundaryCellsTest
+{
+
+public:
+  FindBoundaryCellsTest()
+  {
+  }
+  virtual ~FindBoundaryCellsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindBoundaryCells Filter from the FilterManager
+    QString filtName = "FindBoundaryCells";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindBoundaryCellsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Generic Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fills the volume with blocks of Features 0 to 4, so every Cell sees a mix of equal and different neighbors
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer CreateFeatureIds(const int64_t dims[3])
+  {
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(static_cast<size_t>(dims[0] * dims[1] * dims[2]), cDims, SIMPL::CellData::FeatureIds);
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          featureIds->setValue((z * dims[1] + y) * dims[0] + x, static_cast<int32_t>((x / 3 + 2 * (y / 2) + 3 * (z / 2)) % 5));
+        }
+      }
+    }
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial sweep the filter replaced, kept as the reference for its output
+  // -----------------------------------------------------------------------------
+  int8_t ReferenceBoundaryCount(const int32_t* featureIds, const int64_t dims[3], int64_t x, int64_t y, int64_t z, bool ignoreFeatureZero, bool includeVolumeBoundary)
+  {
+    int32_t ignoreFeatureZeroVal = ignoreFeatureZero ? 0 : -1;
+    int64_t index = (z * dims[1] + y) * dims[0] + x;
+    int32_t feature = featureIds[index];
+    int8_t onsurf = 0;
+    if(feature < 0)
+    {
+      return onsurf;
+    }
+    if(includeVolumeBoundary)
+    {
+      onsurf += (dims[0] > 2 && (x == 0 || x == dims[0] - 1)) ? 1 : 0;
+      onsurf += (dims[1] > 2 && (y == 0 || y == dims[1] - 1)) ? 1 : 0;
+      onsurf += (dims[2] > 2 && (z == 0 || z == dims[2] - 1)) ? 1 : 0;
+      if(feature == 0)
+      {
+        onsurf = 0;
+      }
+    }
+    const int64_t neighbors[6][3] = {{0, 0, -1}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for(int32_t l = 0; l < 6; l++)
+    {
+      int64_t nx = x + neighbors[l][0];
+      int64_t ny = y + neighbors[l][1];
+      int64_t nz = z + neighbors[l][2];
+      if(nx < 0 || nx >= dims[0] || ny < 0 || ny >= dims[1] || nz < 0 || nz >= dims[2])
+      {
+        continue;
+      }
+      int32_t neighborFeature = featureIds[(nz * dims[1] + ny) * dims[0] + nx];
+      if(neighborFeature != feature && neighborFeature > ignoreFeatureZeroVal)
+      {
+        onsurf++;
+      }
+    }
+    return onsurf;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunAndCompare(const int64_t dims[3], bool ignoreFeatureZero, bool includeVolumeBoundary)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t geomDims[3] = {static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2])};
+    image->setDimensions(geomDims);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims = {geomDims[0], geomDims[1], geomDims[2]};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+    Int32ArrayType::Pointer featureIds = CreateFeatureIds(dims);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindBoundaryCells");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+    var.setValue(QString("BoundaryCells"));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("BoundaryCellsArrayName", var), true)
+    var.setValue(ignoreFeatureZero);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("IgnoreFeatureZero", var), true)
+    var.setValue(includeVolumeBoundary);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("IncludeVolumeBoundary", var), true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+    Int8ArrayType::Pointer boundaryCells = cellAttrMat->getAttributeArrayAs<Int8ArrayType>("BoundaryCells");
+    DREAM3D_REQUIRE_VALID_POINTER(boundaryCells.get())
+
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          int8_t expected = ReferenceBoundaryCount(featureIds->getPointer(0), dims, x, y, z, ignoreFeatureZero, includeVolumeBoundary);
+          DREAM3D_REQUIRE_EQUAL(boundaryCells->getValue((z * dims[1] + y) * dims[0] + x), expected)
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindBoundaryCells()
+  {
+    // A volume, a 2D image, an image flat in X and a volume only two Cells thick in Y
+    const int64_t volumes[4][3] = {{13, 9, 7}, {11, 8, 1}, {1, 10, 6}, {7, 2, 5}};
+    for(size_t v = 0; v < 4; v++)
+    {
+      for(int32_t options = 0; options < 4; options++)
+      {
+        DREAM3D_REQUIRE_EQUAL(RunAndCompare(volumes[v], (options & 1) != 0, (options & 2) != 0), EXIT_SUCCESS)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestFindBoundaryCells());
+  }
+
+private:
+  FindBoundaryCellsTest(const FindBoundaryCellsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindBoundaryCellsTest&);        // Move assignment Not Implemented
+};
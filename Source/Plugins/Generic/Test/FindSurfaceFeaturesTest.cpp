@@ -0,0 +1,232 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "GenericTestFileLocations.h"
+
+class FindSurfaceFeaturesTest
+{
+
+public:
+  FindSurfaceFeaturesTest()
+  {
+  }
+  virtual ~FindSurfaceFeaturesTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindSurfaceFeatures Filter from the FilterManager
+    QString filtName = "FindSurfaceFeatures";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindSurfaceFeaturesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Generic Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Sets the Feature of every Cell of the box [min, max] of the volume
+  // -----------------------------------------------------------------------------
+  void FillBox(Int32ArrayType::Pointer featureIds, const size_t dims[3], const size_t min[3], const size_t max[3], int32_t feature)
+  {
+    for(size_t z = min[2]; z <= max[2]; z++)
+    {
+      for(size_t y = min[1]; y <= max[1]; y++)
+      {
+        for(size_t x = min[0]; x <= max[0]; x++)
+        {
+          featureIds->setValue((z * dims[1] + y) * dims[0] + x, feature);
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  BoolArrayType::Pointer RunFilter(Int32ArrayType::Pointer featureIds, const size_t dims[3], size_t numFeatures)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t geomDims[3] = {dims[0], dims[1], dims[2]};
+    image->setDimensions(geomDims);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    tDims = QVector<size_t>(1, numFeatures);
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featAttrMat);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindSurfaceFeatures");
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    filter->setProperty("FeatureIdsArrayPath", var);
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::SurfaceFeatures));
+    filter->setProperty("SurfaceFeaturesArrayPath", var);
+
+    filter->execute();
+    if(filter->getErrorCondition() < 0)
+    {
+      return BoolArrayType::NullPointer();
+    }
+    return featAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::SurfaceFeatures);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSurfaceFeatures3D()
+  {
+    const size_t dims[3] = {10, 10, 10};
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims[0] * dims[1] * dims[2], cDims, SIMPL::CellData::FeatureIds);
+    featureIds->initializeWithValue(1);
+
+    // Feature 2 and Feature 5 are buried in Feature 1, Feature 3 touches a Cell of Feature 0 and Feature 4 touches
+    // the +X side of the volume
+    const size_t min2[3] = {2, 2, 2}, max2[3] = {4, 4, 4};
+    FillBox(featureIds, dims, min2, max2, 2);
+    const size_t min3[3] = {6, 6, 6}, max3[3] = {8, 8, 8};
+    FillBox(featureIds, dims, min3, max3, 3);
+    featureIds->setValue((7 * dims[1] + 7) * dims[0] + 5, 0);
+    const size_t min4[3] = {9, 4, 4}, max4[3] = {9, 5, 5};
+    FillBox(featureIds, dims, min4, max4, 4);
+    const size_t min5[3] = {2, 6, 6}, max5[3] = {3, 7, 7};
+    FillBox(featureIds, dims, min5, max5, 5);
+
+    BoolArrayType::Pointer surfaceFeatures = RunFilter(featureIds, dims, 6);
+    DREAM3D_REQUIRE_VALID_POINTER(surfaceFeatures.get())
+
+    DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(1), true)
+    DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(2), false)
+    DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(3), true)
+    DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(4), true)
+    DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(5), false)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the same layout on an image flat in Z and on one flat in X; the flat axis is not part of the outside
+  // -----------------------------------------------------------------------------
+  int TestSurfaceFeatures2D()
+  {
+    for(size_t flatAxis = 0; flatAxis < 3; flatAxis += 2)
+    {
+      // The image spans 8 by 6 Cells in its two extended axes (u, v)
+      size_t uAxis = (flatAxis == 0) ? 1 : 0;
+      size_t vAxis = (flatAxis == 0) ? 2 : 1;
+      size_t dims[3] = {1, 1, 1};
+      dims[uAxis] = 8;
+      dims[vAxis] = 6;
+
+      QVector<size_t> cDims(1, 1);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims[0] * dims[1] * dims[2], cDims, SIMPL::CellData::FeatureIds);
+      featureIds->initializeWithValue(1);
+
+      // Feature 2 is buried in Feature 1 and Feature 3 touches the +u side of the image
+      size_t min2[3] = {0, 0, 0}, max2[3] = {0, 0, 0};
+      min2[uAxis] = 2;
+      max2[uAxis] = 3;
+      min2[vAxis] = 2;
+      max2[vAxis] = 3;
+      FillBox(featureIds, dims, min2, max2, 2);
+      size_t min3[3] = {0, 0, 0}, max3[3] = {0, 0, 0};
+      min3[uAxis] = 7;
+      max3[uAxis] = 7;
+      min3[vAxis] = 2;
+      max3[vAxis] = 3;
+      FillBox(featureIds, dims, min3, max3, 3);
+
+      BoolArrayType::Pointer surfaceFeatures = RunFilter(featureIds, dims, 4);
+      DREAM3D_REQUIRE_VALID_POINTER(surfaceFeatures.get())
+
+      DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(1), true)
+      DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(2), false)
+      DREAM3D_REQUIRE_EQUAL(surfaceFeatures->getValue(3), true)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSurfaceFeatures3D());
+    DREAM3D_REGISTER_TEST(TestSurfaceFeatures2D());
+  }
+
+private:
+  FindSurfaceFeaturesTest(const FindSurfaceFeaturesTest&); // Copy Constructor Not Implemented
+  void operator=(const FindSurfaceFeaturesTest&);          // Move assignment Not Implemented
+};
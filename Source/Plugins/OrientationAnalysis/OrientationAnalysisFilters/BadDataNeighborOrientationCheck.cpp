@@ -35,6 +35,15 @@
 
 #include "BadDataNeighborOrientationCheck.h"
 
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -46,6 +55,94 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The BadDataNeighborOrientationCheckImpl class implements a threaded algorithm that finds, for a list of
+ * voxels, which of their six face neighbors are in the requested good/bad state and lie within the misorientation
+ * tolerance of the voxel. The result for each voxel is a bit mask with bit j set for neighbor direction j.
+ */
+class BadDataNeighborOrientationCheckImpl
+{
+public:
+  BadDataNeighborOrientationCheckImpl(float* quats, int32_t* cellPhases, uint32_t* crystalStructures, bool* goodVoxels, int64_t dims[3], float misorientationTolerance, const int64_t* points,
+                                      uint8_t* neighborMasks, bool neighborsGood)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_GoodVoxels(goodVoxels)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_Points(points)
+  , m_NeighborMasks(neighborMasks)
+  , m_NeighborsGood(neighborsGood)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+
+  virtual ~BadDataNeighborOrientationCheckImpl()
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+
+    for(size_t k = start; k < end; k++)
+    {
+      int64_t i = m_Points[k];
+      int64_t column = i % m_Dims[0];
+      int64_t row = (i / m_Dims[0]) % m_Dims[1];
+      int64_t plane = i / (m_Dims[0] * m_Dims[1]);
+      bool inside[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+      uint8_t mask = 0;
+      for(int32_t j = 0; j < 6; j++)
+      {
+        if(!inside[j])
+        {
+          continue;
+        }
+        int64_t neighbor = i + neighpoints[j];
+        if(m_GoodVoxels[neighbor] != m_NeighborsGood || m_CellPhases[i] != m_CellPhases[neighbor] || m_CellPhases[i] <= 0)
+        {
+          continue;
+        }
+        QuaternionMathF::Copy(quats[i], q1);
+        QuaternionMathF::Copy(quats[neighbor], q2);
+        float w = m_OrientationOps[m_CrystalStructures[m_CellPhases[i]]]->getMisoQuat(q1, q2, n1, n2, n3);
+        if(w < m_MisorientationTolerance)
+        {
+          mask |= static_cast<uint8_t>(1 << j);
+        }
+      }
+      m_NeighborMasks[k] = mask;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_Quats;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  bool* m_GoodVoxels;
+  int64_t m_Dims[3];
+  float m_MisorientationTolerance;
+  const int64_t* m_Points;
+  uint8_t* m_NeighborMasks;
+  bool m_NeighborsGood;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -220,10 +317,6 @@ void BadDataNeighborOrientationCheck::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
   int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
   neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
   neighpoints[1] = static_cast<int64_t>(-dims[0]);
@@ -232,139 +325,103 @@ void BadDataNeighborOrientationCheck::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  float w = 10000.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  QVector<int32_t> neighborCount(totalPoints, 0);
+  // Finds the neighbor masks of a list of voxels, in parallel when available
+  auto findNeighborMasks = [&](const std::vector<int64_t>& points, std::vector<uint8_t>& masks, bool neighborsGood) {
+    masks.resize(points.size());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, points.size()), BadDataNeighborOrientationCheckImpl(m_Quats, m_CellPhases, m_CrystalStructures, m_GoodVoxels, dims, misorientationTolerance,
+                                                                                                      points.data(), masks.data(), neighborsGood),
+                        tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      BadDataNeighborOrientationCheckImpl serial(m_Quats, m_CellPhases, m_CrystalStructures, m_GoodVoxels, dims, misorientationTolerance, points.data(), masks.data(), neighborsGood);
+      serial.compute(0, points.size());
+    }
+  };
 
+  // Count, for every bad voxel, the good neighbors it agrees with
+  std::vector<int64_t> badVoxels;
   for(size_t i = 0; i < totalPoints; i++)
   {
     if(m_GoodVoxels[i] == false)
     {
-      column = i % dims[0];
-      row = (i / dims[0]) % dims[1];
-      plane = i / (dims[0] * dims[1]);
-      for(int32_t j = 0; j < 6; j++)
-      {
-        good = 1;
-        neighbor = i + neighpoints[j];
-        if(j == 0 && plane == 0)
-        {
-          good = 0;
-        }
-        if(j == 5 && plane == (dims[2] - 1))
-        {
-          good = 0;
-        }
-        if(j == 1 && row == 0)
-        {
-          good = 0;
-        }
-        if(j == 4 && row == (dims[1] - 1))
-        {
-          good = 0;
-        }
-        if(j == 2 && column == 0)
-        {
-          good = 0;
-        }
-        if(j == 3 && column == (dims[0] - 1))
-        {
-          good = 0;
-        }
-        if(good == 1 && m_GoodVoxels[neighbor] == true)
-        {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          QuaternionMathF::Copy(quats[i], q1);
-
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          QuaternionMathF::Copy(quats[neighbor], q2);
-
-          if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-          {
-            w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-          }
-          if(w < misorientationTolerance)
-          {
-            neighborCount[i]++;
-          }
-        }
-      }
+      badVoxels.push_back(static_cast<int64_t>(i));
+    }
+  }
+  std::vector<uint8_t> masks;
+  findNeighborMasks(badVoxels, masks, true);
+  std::vector<int32_t> neighborCount(totalPoints, 0);
+  for(size_t k = 0; k < badVoxels.size(); k++)
+  {
+    for(int32_t j = 0; j < 6; j++)
+    {
+      neighborCount[badVoxels[k]] += (masks[k] >> j) & 1;
     }
   }
 
-  int32_t currentLevel = 6;
-  int32_t counter = 0;
-
-  while(currentLevel > m_NumberOfNeighbors)
+  // Flipping a voxel to good can only raise the counts of its bad neighbors, so at each level only the neighbors of
+  // the voxels flipped in the previous wave need to be looked at again. The waves stop when nothing reaches the level,
+  // which is the same closure the serial sweeps over the whole volume converged to.
+  std::vector<uint8_t> queued(totalPoints, 0);
+  std::vector<int64_t> frontier;
+  std::vector<int64_t> nextFrontier;
+  for(int32_t currentLevel = 6; currentLevel > m_NumberOfNeighbors; currentLevel--)
   {
-    counter = 1;
-    while(counter > 0)
+    frontier.clear();
+    size_t numBad = 0;
+    for(size_t k = 0; k < badVoxels.size(); k++)
+    {
+      int64_t i = badVoxels[k];
+      if(m_GoodVoxels[i] == true)
+      {
+        continue;
+      }
+      badVoxels[numBad++] = i;
+      if(neighborCount[i] >= currentLevel)
+      {
+        frontier.push_back(i);
+        queued[i] = 1;
+      }
+    }
+    badVoxels.resize(numBad);
+
+    while(!frontier.empty())
     {
-      counter = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      for(const int64_t& i : frontier)
       {
-        if(neighborCount[i] >= currentLevel && m_GoodVoxels[i] == false)
+        m_GoodVoxels[i] = true;
+      }
+      findNeighborMasks(frontier, masks, false);
+
+      nextFrontier.clear();
+      for(size_t k = 0; k < frontier.size(); k++)
+      {
+        for(int32_t j = 0; j < 6; j++)
         {
-          m_GoodVoxels[i] = true;
-          counter++;
-          column = i % dims[0];
-          row = (i / dims[0]) % dims[1];
-          plane = i / (dims[0] * dims[1]);
-          for(int64_t j = 0; j < 6; j++)
+          if(((masks[k] >> j) & 1) == 0)
+          {
+            continue;
+          }
+          int64_t neighbor = frontier[k] + neighpoints[j];
+          neighborCount[neighbor]++;
+          if(neighborCount[neighbor] >= currentLevel && queued[neighbor] == 0)
           {
-            good = 1;
-            neighbor = i + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (dims[1] - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && m_GoodVoxels[neighbor] == false)
-            {
-              phase1 = m_CrystalStructures[m_CellPhases[i]];
-              QuaternionMathF::Copy(quats[i], q1);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              QuaternionMathF::Copy(quats[neighbor], q2);
-
-              if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-              {
-                w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-              }
-              if(w < misorientationTolerance)
-              {
-                neighborCount[neighbor]++;
-              }
-            }
+            queued[neighbor] = 1;
+            nextFrontier.push_back(neighbor);
           }
         }
       }
+      frontier.swap(nextFrontier);
     }
-    currentLevel = currentLevel - 1;
   }
 
   // If there is an error set this to something negative and also set a message
@@ -31,6 +31,14 @@
 #include "EMsoftSO3Sampler.h"
 
 #include <cmath>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
@@ -42,6 +50,7 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/SIMPLibVersion.h"
 
+#include "OrientationLib/LaueOps/SO3Sampler.h"
 #include "OrientationLib/OrientationLibConstants.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
@@ -49,6 +58,50 @@
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 
+/**
+ * @brief The RodriguesToEulerImpl class implements a threaded algorithm that converts the sampled 4-component
+ * Rodrigues vectors into Bunge Euler angles.
+ */
+class RodriguesToEulerImpl
+{
+public:
+  RodriguesToEulerImpl(const double* rodrigues, float* eulers)
+  : m_Rodrigues(rodrigues)
+  , m_Eulers(eulers)
+  {
+  }
+  virtual ~RodriguesToEulerImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+    DOrientArrayType rod(4);
+    DOrientArrayType eu(3, 0.0);
+    for(size_t i = start; i < end; i++)
+    {
+      rod[0] = m_Rodrigues[i * 4 + 0];
+      rod[1] = m_Rodrigues[i * 4 + 1];
+      rod[2] = m_Rodrigues[i * 4 + 2];
+      rod[3] = m_Rodrigues[i * 4 + 3];
+      OrientationTransformsType::ro2eu(rod, eu);
+
+      m_Eulers[i * 3 + 0] = static_cast<float>(eu[0]);
+      m_Eulers[i * 3 + 1] = static_cast<float>(eu[1]);
+      m_Eulers[i * 3 + 2] = static_cast<float>(eu[2]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double* m_Rodrigues;
+  float* m_Eulers;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -60,6 +113,7 @@ EMsoftSO3Sampler::EMsoftSO3Sampler()
 , m_MisOr(3.0)
 , m_MisOrFull(3.0)
 , m_OffsetGrid(false)
+, m_MisorientationFZ(false)
 , m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
 , m_EMsoftAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
 , m_EulerAngles(nullptr)
@@ -102,6 +156,7 @@ void EMsoftSO3Sampler::setupFilterParameters()
     QStringList linkedProps;
     linkedProps << "PointGroup"
                 << "OffsetGrid"
+                << "MisorientationFZ"
                 << "MisOr"
                 << "RefOr"
                 << "MisOrFull"
@@ -116,6 +171,8 @@ void EMsoftSO3Sampler::setupFilterParameters()
     parameters.push_back(SIMPL_NEW_INTEGER_FP("Point group number (see documentation for list)", PointGroup, FilterParameter::Parameter, EMsoftSO3Sampler, 0));
     parameters.push_back(BooleanFilterParameter::New("Offset sampling grid from origin?", "OffsetGrid", getOffsetGrid(), FilterParameter::Parameter,
                                                      SIMPL_BIND_SETTER(EMsoftSO3Sampler, this, OffsetGrid), SIMPL_BIND_GETTER(EMsoftSO3Sampler, this, OffsetGrid), 0));
+    parameters.push_back(BooleanFilterParameter::New("Sample misorientation fundamental zone?", "MisorientationFZ", getMisorientationFZ(), FilterParameter::Parameter,
+                                                     SIMPL_BIND_SETTER(EMsoftSO3Sampler, this, MisorientationFZ), SIMPL_BIND_GETTER(EMsoftSO3Sampler, this, MisorientationFZ), 0));
 
     /* equal misorientation sampling method */
     parameters.push_back(SIMPL_NEW_DOUBLE_FP("Misorientation angle (degree)", MisOr, FilterParameter::Parameter, EMsoftSO3Sampler, 1));
@@ -283,19 +340,12 @@ void EMsoftSO3Sampler::execute()
     return;
   }
 
-  OrientationListArrayType FZlist;
-  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+  SO3Sampler::Pointer sampler = SO3Sampler::New();
+  std::vector<double> rodrigues;
+  size_t numSamples = 0;
 
   if(getsampleModeSelector() == 0)
   {
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
-    double x, y, z, delta;
-    int32_t FZtype, FZorder;
-
-    // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
-    delta = (0.50 * LPs::ap) / static_cast<double>(getNumsp());
-
     // do we need to shift this array away from the origin?
     double gridShift = 0.0;
     if(getOffsetGrid())
@@ -303,453 +353,69 @@ void EMsoftSO3Sampler::execute()
       gridShift = 0.5;
     }
 
-    // determine which function we should call for this point group symmetry
-    FZtype = OrientationAnalysisConstants::FZtarray[getPointGroup() - 1];
-    FZorder = OrientationAnalysisConstants::FZoarray[getPointGroup() - 1];
-
-    // loop over the cube of volume pi^2; note that we do not want to include
-    // the opposite edges/facets of the cube, to avoid double counting rotations
-    // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-    int Np = getNumsp();
-    int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1);
-    int Dn = Totp / 10;
-    int Dc = Dn;
-    int Di = 0;
-    int Dg = 0;
-
-    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
-    double edge = 0.5 * LPs::ap;
-
-    for(int i = -Np + 1; i < Np + 1; i++)
-    {
-      x = (static_cast<double>(i) + gridShift) * delta;
-
-      if(fabs(x) <= edge)
-      {
-
-        for(int j = -Np + 1; j < Np + 1; j++)
-        {
-          y = (static_cast<double>(j) + gridShift) * delta;
-
-          if(fabs(y) <= edge)
-          {
-
-            for(int k = -Np + 1; k < Np + 1; k++)
-            {
-              z = (static_cast<double>(k) + gridShift) * delta;
-
-              if(fabs(z) <= edge)
-              {
-
-                // convert to Rodrigues representation
-                DOrientArrayType cu(x, y, z);
-                DOrientArrayType rod(4);
-                OrientationTransformsType::cu2ro(cu, rod);
-
-                // If insideFZ=true, then add this point to FZlist
-                bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-                if(b)
-                {
-                  FZlist.push_back(rod);
-                  Dg += 1;
-                }
-                Di += 1;
-              }
-            }
-          }
-        }
-      }
-
-      // report on status of computation
-      if(Di > Dc)
-      {
-        QString ss = QString("Euler Angles | Tested: %1 of %2 | Inside RFZ: %3 ").arg(QString::number(Di), QString::number(Totp), QString::number(Dg));
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-        Dc += Dn;
-      }
-      if(getCancel())
-      {
-        break;
-      }
-    }
-  }
-
-  // here are the misorientation sampling cases:
-  if(getsampleModeSelector() != 0)
-  {
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
-    double x, y, z, delta, omega, semi;
-
-    // step size for sampling of grid; the edge length of the cube is (pi ( w - sin(w) ))^1/3 with w the misorientation angle
-    omega = getMisOr() * SIMPLib::Constants::k_PiOver180;
-    semi = pow(SIMPLib::Constants::k_Pi * (omega - sin(omega)), 1.0 / 3.0) * 0.5;
-    delta = semi / static_cast<double>(getNumsp());
-
-    // convert the reference orientation to a 3-component Rodrigues vector sigma
-    DOrientArrayType sigm(4), sigma(3), referenceOrientation(3);
-    referenceOrientation[0] = static_cast<double>(getRefOr().x * SIMPLib::Constants::k_PiOver180);
-    referenceOrientation[1] = static_cast<double>(getRefOr().y * SIMPLib::Constants::k_PiOver180);
-    referenceOrientation[2] = static_cast<double>(getRefOr().z * SIMPLib::Constants::k_PiOver180);
-    OrientationTransformsType::eu2ro(referenceOrientation, sigm);
-    sigma[0] = sigm[0] * sigm[3];
-    sigma[1] = sigm[1] * sigm[3];
-    sigma[2] = sigm[2] * sigm[3];
-
-    if(getsampleModeSelector() == 1)
+    // only the grid points inside the bounding cube of the fundamental zone are visited
+    if(getMisorientationFZ())
     {
-      // set counter parameters for the loop over the sub-cube surface
-      int Np = getNumsp();
-      int Totp = 24 * Np * Np + 2;
-      int Dn = Totp / 20;
-      int Dc = Dn;
-      int Dg = 0;
-
-      // x-y bottom and top planes
-      for(int i = -Np; i <= Np; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int j = -Np; j <= Np; j++)
-        {
-          y = static_cast<double>(j) * delta;
-          // convert to Rodrigues representation and apply Rodrigues composition formula
-          {
-            DOrientArrayType cu(-x, -y, -semi);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-          {
-            DOrientArrayType cu(-x, -y, semi);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-        }
-        if(getCancel())
-        {
-          break;
-        }
-      }
-      // y-z  planes
-      for(int j = -Np; j <= Np; j++)
-      {
-        y = static_cast<double>(j) * delta;
-        for(int k = -Np + 1; k <= Np - 1; k++)
-        {
-          z = static_cast<double>(k) * delta;
-          // convert to Rodrigues representation and apply Rodrigues composition formula
-          {
-            DOrientArrayType cu(-semi, -y, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-          {
-            DOrientArrayType cu(semi, -y, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-        }
-        if(getCancel())
-        {
-          break;
-        }
-      }
-      // finally the x-z  planes
-      for(int i = -Np + 1; i <= Np - 1; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int k = -Np + 1; k <= Np - 1; k++)
-        {
-          z = static_cast<double>(k) * delta;
-          // convert to Rodrigues representation and apply Rodrigues composition formula
-          {
-            DOrientArrayType cu(-x, -semi, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-          {
-            DOrientArrayType cu(-x, semi, -z);
-            DOrientArrayType rod(4);
-            OrientationTransformsType::cu2ro(cu, rod);
-            RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
-            Dg += 1;
-          }
-        }
-        if(getCancel())
-        {
-          break;
-        }
-      }
-
-      // report on status of computation
-      if(Dg > Dc)
-      {
-        QString ss = QString("Euler Angles | Generated: %1 / %2").arg(QString::number(Dg), QString::number(Totp));
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-        Dc += Dn;
-      }
+      numSamples = sampler->SampleMFZ(getNumsp(), getPointGroup(), gridShift, rodrigues);
     }
     else
     {
-      // set counter parameters for the loop over the sub-cube surface
-      int Np = getNumsp();
-      int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1); // see misorientation sampling paper for this expression
-      int Dn = Totp / 20;
-      int Dc = Dn;
-      int Dg = 0;
-
-      for(int i = -Np; i <= Np; i++)
-      {
-        x = static_cast<double>(i) * delta;
-        for(int j = -Np; j <= Np; j++)
-        {
-          y = static_cast<double>(j) * delta;
-          for(int k = -Np; k <= Np; k++)
-          {
-            z = static_cast<double>(k) * delta;
-            // convert to Rodrigues representation and apply Rodrigues composition formula
-            {
-              DOrientArrayType cu(-x, -y, -z);
-              DOrientArrayType rod(4);
-              OrientationTransformsType::cu2ro(cu, rod);
-              RodriguesComposition(sigma, rod);
-              FZlist.push_back(rod);
-              Dg += 1;
-            }
-          }
-        }
-        // report on status of computation
-        if(Dg > Dc)
-        {
-          QString ss = QString("Euler Angles | Generated: %1 / %2").arg(QString::number(Dg), QString::number(Totp));
-          notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-          Dc += Dn;
-        }
-      }
+      numSamples = sampler->SampleRFZ(getNumsp(), getPointGroup(), gridShift, rodrigues);
     }
-  }
-
-  // resize the EulerAngles array to the number of items in FZlist; don't forget to redefine the hard pointer
-  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
-  QVector<size_t> tDims(1, FZlist.size());
-  am->resizeAttributeArrays(tDims);
-  m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
-
-  // copy the Rodrigues vectors as Euler angles into the m_EulerAngles array; convert doubles to floats along the way
-  int j = -1;
-  for(DOrientArrayType rod : FZlist)
-  {
-    j += 1;
-    DOrientArrayType eu(3, 0.0);
-    OrientationTransformsType::ro2eu(rod, eu);
-
-    m_EulerAngles[j * 3 + 0] = static_cast<float>(eu[0]);
-    m_EulerAngles[j * 3 + 1] = static_cast<float>(eu[1]);
-    m_EulerAngles[j * 3 + 2] = static_cast<float>(eu[2]);
-  }
-
-  notifyStatusMessage(getHumanLabel(), "Complete");
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void EMsoftSO3Sampler::RodriguesComposition(DOrientArrayType sigma, DOrientArrayType& rod)
-{
-  DOrientArrayType rho(3), rhomis(3);
-  rho[0] = -rod[0] * rod[3];
-  rho[1] = -rod[1] * rod[3];
-  rho[2] = -rod[2] * rod[3];
-
-  // perform the Rodrigues rotation composition with sigma to get rhomis
-  double denom = 1.0 + (sigma[0] * rho[0] + sigma[1] * rho[1] + sigma[2] * rho[2]);
-  if(denom == 0.0)
-  {
-    double len;
-    len = sqrt(sigma[0] * sigma[0] + sigma[1] * sigma[1] + sigma[2] * sigma[2]);
-    rod[0] = sigma[0] / len;
-    rod[1] = sigma[1] / len;
-    rod[2] = sigma[2] / len;
-    rod[3] = std::numeric_limits<double>::infinity(); // set this to infinity
+    QString ss = QString("Euler Angles | Inside %1: %2").arg(getMisorientationFZ() ? "MFZ" : "RFZ").arg(QString::number(numSamples));
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
   }
   else
   {
-    rhomis[0] = (rho[0] - sigma[0] + (rho[1] * sigma[2] - rho[2] * sigma[1])) / denom;
-    rhomis[1] = (rho[1] - sigma[1] + (rho[2] * sigma[0] - rho[0] * sigma[2])) / denom;
-    rhomis[2] = (rho[2] - sigma[2] + (rho[0] * sigma[1] - rho[1] * sigma[0])) / denom;
-    // revert rhomis to a four-component Rodrigues vector
-    double len;
-    len = sqrt(rhomis[0] * rhomis[0] + rhomis[1] * rhomis[1] + rhomis[2] * rhomis[2]);
-    if(len != 0.0)
-    {
-      rod[0] = -rhomis[0] / len;
-      rod[1] = -rhomis[1] / len;
-      rod[2] = -rhomis[2] / len;
-      rod[3] = len;
-    }
-    else
-    {
-      rod[0] = 0.0;
-      rod[1] = 0.0;
-      rod[2] = 0.0;
-      rod[3] = 0.0;
-    }
-  }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool EMsoftSO3Sampler::IsinsideFZ(double* rod, int FZtype, int FZorder)
-{
-  bool insideFZ = false;
-  // dealing with 180 rotations is needed only for
-  // FZtypes 0 and 1; the other FZs are always finite.
-  switch(FZtype)
-  {
-  case OrientationAnalysisConstants::AnorthicType:
-    insideFZ = true; // all points are inside the FZ
-    break;
-  case OrientationAnalysisConstants::CyclicType:
-    insideFZ = insideCyclicFZ(rod, FZorder); // infinity is checked inside this function
-    break;
-  case OrientationAnalysisConstants::DihedralType:
-    if(!std::isinf(rod[3]))
-      insideFZ = insideDihedralFZ(rod, FZorder);
-    break;
-  case OrientationAnalysisConstants::TetrahedralType:
-    if(!std::isinf(rod[3]))
-      insideFZ = insideCubicFZ(rod, OrientationAnalysisConstants::TetrahedralType);
-    break;
-  case OrientationAnalysisConstants::OctahedralType:
-    if(!std::isinf(rod[3]))
-      insideFZ = insideCubicFZ(rod, OrientationAnalysisConstants::OctahedralType);
-    break;
-  default:
-    insideFZ = false;
-    break;
-  }
-  return insideFZ;
-}
+    // here are the misorientation sampling cases
+    typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+    bool surfaceOnly = (getsampleModeSelector() == 1);
+    FloatVec3_t refOr = surfaceOnly ? getRefOr() : getRefOrFull();
+    double omega = (surfaceOnly ? getMisOr() : getMisOrFull()) * SIMPLib::Constants::k_PiOver180;
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool EMsoftSO3Sampler::insideCyclicFZ(double* rod, int order)
-{
-
-  bool insideFZ = false;
+    // convert the reference orientation to a 3-component Rodrigues vector sigma
+    DOrientArrayType sigm(4), referenceOrientation(3);
+    referenceOrientation[0] = static_cast<double>(refOr.x * SIMPLib::Constants::k_PiOver180);
+    referenceOrientation[1] = static_cast<double>(refOr.y * SIMPLib::Constants::k_PiOver180);
+    referenceOrientation[2] = static_cast<double>(refOr.z * SIMPLib::Constants::k_PiOver180);
+    OrientationTransformsType::eu2ro(referenceOrientation, sigm);
+    double sigma[3] = {sigm[0] * sigm[3], sigm[1] * sigm[3], sigm[2] * sigm[3]};
 
-  if(! std::isinf(rod[3]))
-  {
-    // check the z-component vs. tan(pi/2n)
-    insideFZ = fabs(rod[2] * rod[3]) <= LPs::BP[order - 1];
-  }
-  else if(rod[2] == 0.0)
-  {
-    insideFZ = true;
+    numSamples = sampler->SampleNeighborhood(getNumsp(), omega, sigma, surfaceOnly, rodrigues);
+    QString ss = QString("Euler Angles | Generated: %1").arg(QString::number(numSamples));
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
   }
-  return insideFZ;
-}
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool EMsoftSO3Sampler::insideDihedralFZ(double* rod, int order)
-{
-
-  bool res = false, c1 = false, c2 = false;
-  double r[3] = {rod[0] * rod[3], rod[1] * rod[3], rod[2] * rod[3]};
-  const double r1 = 1.0;
-
-  // first, check the z-component vs. tan(pi/2n)  (same as insideCyclicFZ)
-  c1 = fabs(r[2]) <= LPs::BP[order - 1];
-  res = false;
-
-  // check the square boundary planes if c1=true
-  if(c1)
+  if(getCancel())
   {
-    switch(order)
-    {
-    case OrientationAnalysisConstants::TwoFoldAxisOrder:
-      c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
-      break;
-    case OrientationAnalysisConstants::ThreeFoldAxisOrder:
-      c2 = fabs(LPs::srt * r[0] + 0.50 * r[1]) <= r1;
-      c2 = c2 && (fabs(LPs::srt * r[0] - 0.50 * r[1]) <= r1);
-      c2 = c2 && (fabs(r[1]) <= r1);
-      break;
-    case OrientationAnalysisConstants::FourFoldAxisOrder:
-      c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
-      c2 = c2 && ((LPs::r22 * fabs(r[0] + r[1]) <= r1) && (LPs::r22 * fabs(r[0] - r[1]) <= r1));
-      break;
-    case OrientationAnalysisConstants::SixFoldAxisOrder:
-      c2 = fabs(0.50 * r[0] + LPs::srt * r[1]) <= r1;
-      c2 = c2 && (fabs(LPs::srt * r[0] + 0.50 * r[1]) <= r1);
-      c2 = c2 && (fabs(LPs::srt * r[0] - 0.50 * r[1]) <= r1);
-      c2 = c2 && (fabs(0.50 * r[0] - LPs::srt * r[1]) <= r1);
-      c2 = c2 && (fabs(r[1]) <= r1);
-      c2 = c2 && (fabs(r[0]) <= r1);
-      break;
-    default:
-      res = false;
-      break;
-    }
-    res = c2;
+    return;
   }
-  return res;
-}
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool EMsoftSO3Sampler::insideCubicFZ(double* rod, int ot)
-{
-  bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = rod[0] * rod[3];
-  r[1] = rod[1] * rod[3];
-  r[2] = rod[2] * rod[3];
-  const double r1 = 1.0;
-
-  // primary cube planes (only needed for octahedral case)
-  if(ot == OrientationAnalysisConstants::OctahedralType)
-  {
+  // resize the EulerAngles array to the number of samples; don't forget to redefine the hard pointer
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
+  QVector<size_t> tDims(1, numSamples);
+  am->resizeAttributeArrays(tDims);
+  m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
 
-    typedef OrientationTransforms<std::vector<double>, double> OrientationTransformsType;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-    c1 = OrientationTransformsType::OMHelperType::maxval(OrientationTransformsType::OMHelperType::absValue(r)) <= LPs::BP[3];
-  }
-  else
+  // copy the Rodrigues vectors as Euler angles into the m_EulerAngles array; convert doubles to floats along the way
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    c1 = true;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSamples), RodriguesToEulerImpl(rodrigues.data(), m_EulerAngles), tbb::auto_partitioner());
   }
-
-  // octahedral truncation planes, both for tetrahedral and octahedral point groups
-  c2 = ((fabs(r[0]) + fabs(r[1]) + fabs(r[2])) <= r1);
-
-  // if both c1 and c2, then the point is inside
-  if(c1 && c2)
+  else
+#endif
   {
-    res = true;
+    RodriguesToEulerImpl serial(rodrigues.data(), m_EulerAngles);
+    serial.convert(0, numSamples);
   }
 
-  return res;
+  notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
 // -----------------------------------------------------------------------------
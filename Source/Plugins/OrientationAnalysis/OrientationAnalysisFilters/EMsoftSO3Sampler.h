@@ -56,6 +56,7 @@ class OrientationAnalysis_EXPORT EMsoftSO3Sampler : public AbstractFilter
     PYB11_PROPERTY(double MisOrFull READ getMisOrFull WRITE setMisOrFull)
     PYB11_PROPERTY(FloatVec3_t RefOrFull READ getRefOrFull WRITE setRefOrFull)
     PYB11_PROPERTY(bool OffsetGrid READ getOffsetGrid WRITE setOffsetGrid)
+    PYB11_PROPERTY(bool MisorientationFZ READ getMisorientationFZ WRITE setMisorientationFZ)
     PYB11_PROPERTY(QString EulerAnglesArrayName READ getEulerAnglesArrayName WRITE setEulerAnglesArrayName)
     PYB11_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
     PYB11_PROPERTY(QString EMsoftAttributeMatrixName READ getEMsoftAttributeMatrixName WRITE setEMsoftAttributeMatrixName)
@@ -95,6 +96,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, OffsetGrid)
   Q_PROPERTY(bool OffsetGrid READ getOffsetGrid WRITE setOffsetGrid)
 
+  SIMPL_FILTER_PARAMETER(bool, MisorientationFZ)
+  Q_PROPERTY(bool MisorientationFZ READ getMisorientationFZ WRITE setMisorientationFZ)
+
   SIMPL_FILTER_PARAMETER(QString, EulerAnglesArrayName)
   Q_PROPERTY(QString EulerAnglesArrayName READ getEulerAnglesArrayName WRITE setEulerAnglesArrayName)
 
@@ -164,51 +168,6 @@ public:
   */
   void preflight() override;
 
-  /**
-   * @brief RodriguesComposition
-   * @param sigma
-   * @param rod
-   */
-  void RodriguesComposition(DOrientArrayType sigma, DOrientArrayType& rod);
-
-  /**
-   * @brief OrientationListArrayType
-   */
-  typedef std::list<DOrientArrayType> OrientationListArrayType;
-
-  /**
-   * @brief IsinsideFZ
-   * @param rod
-   * @param FZtype
-   * @param FZorder
-   * @return
-   */
-  bool IsinsideFZ(double* rod, int FZtype, int FZorder);
-
-  /**
-   * @brief insideCubicFZ
-   * @param rod
-   * @param symType
-   * @return
-   */
-  bool insideCubicFZ(double* rod, int symType);
-
-  /**
-   * @brief insideCyclicFZ
-   * @param rod
-   * @param order
-   * @return
-   */
-  bool insideCyclicFZ(double* rod, int order);
-
-  /**
-   * @brief insideDihedralFZ
-   * @param rod
-   * @param order
-   * @return
-   */
-  bool insideDihedralFZ(double* rod, int order);
-
   /**
    * @brief setUpdateProgress
    * @param tuplesCompleted Number of Euler angle tuples completed so far....
@@ -35,8 +35,23 @@
 
 #include "FindAvgOrientations.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -44,13 +59,166 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/HelperClasses/ThreadLocalAccumulator.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+namespace
+{
+// Sums are kept in 32.32 fixed point so that adding them up is associative and the averages do not
+// depend on how the elements were split between threads. A feature may hold up to 2^31 elements.
+const double k_FixedPointScale = 4294967296.0;
+
+// Per feature: 4 quaternion component sums, optionally followed by the 10 unique entries of the
+// outer product sum used by the eigen average
+const size_t k_MeanComponents = 4;
+const size_t k_EigenComponents = 10;
+
+/**
+ * @brief The FeatureQuatSums struct holds one thread's running sums for every feature.
+ */
+struct FeatureQuatSums
+{
+  std::vector<int64_t> sums;
+  std::vector<int64_t> counts;
+};
+
+inline int64_t toFixedPoint(double value)
+{
+  return static_cast<int64_t>(std::llround(value * k_FixedPointScale));
+}
+} // namespace
+
+/**
+ * @brief The FindFirstFeatureElementImpl class implements a threaded algorithm that finds the
+ * lowest element index belonging to each feature. The orientation of that element is the
+ * reference every other element of the feature is rotated towards, so the choice is the same
+ * for every run no matter how the elements are split between threads.
+ */
+class FindFirstFeatureElementImpl
+{
+public:
+  FindFirstFeatureElementImpl(int32_t* featureIds, int32_t* cellPhases, ThreadLocalAccumulator<std::vector<int64_t>>* firstElements)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_FirstElements(firstElements)
+  {
+  }
+  virtual ~FindFirstFeatureElementImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    std::vector<int64_t>& firstElements = m_FirstElements->local();
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t featureId = m_FeatureIds[i];
+      if(featureId > 0 && m_CellPhases[i] > 0 && static_cast<int64_t>(i) < firstElements[featureId])
+      {
+        firstElements[featureId] = static_cast<int64_t>(i);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds;
+  int32_t* m_CellPhases;
+  ThreadLocalAccumulator<std::vector<int64_t>>* m_FirstElements;
+};
+
+/**
+ * @brief The AccumulateFeatureQuatsImpl class implements a threaded algorithm that rotates every
+ * element's quaternion to the symmetrically equivalent one nearest its feature's reference
+ * orientation and adds it to the calling thread's per feature sums.
+ */
+class AccumulateFeatureQuatsImpl
+{
+public:
+  AccumulateFeatureQuatsImpl(int32_t* featureIds, int32_t* cellPhases, float* quats, uint32_t* crystalStructures, const std::vector<QuatF>& references, bool accumulateOuterProducts,
+                             ThreadLocalAccumulator<FeatureQuatSums>* sums)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_References(references)
+  , m_AccumulateOuterProducts(accumulateOuterProducts)
+  , m_Sums(sums)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+  virtual ~AccumulateFeatureQuatsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    FeatureQuatSums& sums = m_Sums->local();
+    size_t stride = m_AccumulateOuterProducts ? k_MeanComponents + k_EigenComponents : k_MeanComponents;
+    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+    QuatF reference = QuaternionMathF::New();
+    QuatF voxquat = QuaternionMathF::New();
+
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t featureId = m_FeatureIds[i];
+      int32_t phase = m_CellPhases[i];
+      if(featureId <= 0 || phase <= 0)
+      {
+        continue;
+      }
+      QuaternionMathF::Copy(m_References[featureId], reference);
+      QuaternionMathF::Copy(quats[i], voxquat);
+      m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(reference, voxquat);
+
+      int64_t* featureSums = sums.sums.data() + stride * featureId;
+      sums.counts[featureId]++;
+      double q[4] = {voxquat.x, voxquat.y, voxquat.z, voxquat.w};
+      for(size_t c = 0; c < k_MeanComponents; c++)
+      {
+        featureSums[c] += toFixedPoint(q[c]);
+      }
+      if(m_AccumulateOuterProducts)
+      {
+        int64_t* outer = featureSums + k_MeanComponents;
+        for(size_t r = 0; r < 4; r++)
+        {
+          for(size_t c = r; c < 4; c++)
+          {
+            *outer += toFixedPoint(q[r] * q[c]);
+            outer++;
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds;
+  int32_t* m_CellPhases;
+  float* m_Quats;
+  uint32_t* m_CrystalStructures;
+  const std::vector<QuatF>& m_References;
+  bool m_AccumulateOuterProducts;
+  ThreadLocalAccumulator<FeatureQuatSums>* m_Sums;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 FindAvgOrientations::FindAvgOrientations()
-: m_FeatureIdsArrayPath("", "", "")
+: m_AveragingMethod(0)
+, m_FeatureIdsArrayPath("", "", "")
 , m_CellPhasesArrayPath("", "", "")
 , m_QuatsArrayPath("", "", "")
 , m_CrystalStructuresArrayPath("", "", "")
@@ -78,6 +246,20 @@ FindAvgOrientations::~FindAvgOrientations() = default;
 void FindAvgOrientations::setupFilterParameters()
 {
   FilterParameterVector parameters;
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Averaging Method");
+    parameter->setPropertyName("AveragingMethod");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(FindAvgOrientations, this, AveragingMethod));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(FindAvgOrientations, this, AveragingMethod));
+
+    QVector<QString> choices;
+    choices.push_back("Symmetry Reduced Mean");
+    choices.push_back("Principal Eigenvector");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
   parameters.push_back(SeparatorFilterParameter::New("Element Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Category::Element);
@@ -121,6 +303,7 @@ void FindAvgOrientations::readFilterParameters(AbstractFilterParametersReader* r
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
+  setAveragingMethod(reader->readValue("AveragingMethod", getAveragingMethod()));
   reader->closeFilterGroup();
 }
 
@@ -139,6 +322,14 @@ void FindAvgOrientations::dataCheck()
   setErrorCondition(0);
   setWarningCondition(0);
 
+  if(getAveragingMethod() < 0 || getAveragingMethod() > 1)
+  {
+    QString ss = QObject::tr("The averaging method must be 0 (Symmetry Reduced Mean) or 1 (Principal Eigenvector)");
+    setErrorCondition(-6500);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
   QVector<DataArrayPath> dataArrayPaths;
 
   QVector<size_t> cDims(1, 1);
@@ -231,45 +422,121 @@ void FindAvgOrientations::execute()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
-  std::vector<float> counts(totalFeatures, 0.0f);
-
-  int32_t phase = 0;
-  QuatF voxquat = QuaternionMathF::New();
-  QuatF curavgquat = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
-  for(size_t i = 1; i < totalFeatures; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Stage 1: the first element of each feature in memory order provides the reference orientation
+  ThreadLocalAccumulator<std::vector<int64_t>> firstElements(std::vector<int64_t>(totalFeatures, std::numeric_limits<int64_t>::max()));
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    QuaternionMathF::ElementWiseAssign(avgQuats[i], 0.0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), FindFirstFeatureElementImpl(m_FeatureIds, m_CellPhases, &firstElements), tbb::auto_partitioner());
   }
-
-  for(size_t i = 0; i < totalPoints; i++)
+  else
+#endif
   {
-    if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
+    FindFirstFeatureElementImpl serial(m_FeatureIds, m_CellPhases, &firstElements);
+    serial.compute(0, totalPoints);
+  }
+
+  std::vector<int64_t> firstElement(totalFeatures, std::numeric_limits<int64_t>::max());
+  firstElements.combine([&](const std::vector<int64_t>& local) {
+    for(size_t i = 1; i < totalFeatures; i++)
     {
-      counts[m_FeatureIds[i]] += 1.0f;
-      phase = m_CellPhases[i];
-      QuaternionMathF::Copy(quats[i], voxquat);
-      QuaternionMathF::Copy(avgQuats[m_FeatureIds[i]], curavgquat);
-      QuaternionMathF::ScalarDivide(curavgquat, counts[m_FeatureIds[i]]);
+      firstElement[i] = std::min(firstElement[i], local[i]);
+    }
+  });
 
-      if(counts[m_FeatureIds[i]] == 1.0f)
-      {
-        QuaternionMathF::Identity(curavgquat);
-      }
-      m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
-      QuaternionMathF::Add(avgQuats[m_FeatureIds[i]], voxquat, avgQuats[m_FeatureIds[i]]);
+  std::vector<QuatF> references(totalFeatures, QuaternionMathF::New());
+  QuatF identity = QuaternionMathF::New();
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    if(firstElement[i] == std::numeric_limits<int64_t>::max())
+    {
+      continue;
     }
+    int64_t element = firstElement[i];
+    QuaternionMathF::Identity(identity);
+    QuaternionMathF::Copy(quats[element], references[i]);
+    m_OrientationOps[m_CrystalStructures[m_CellPhases[element]]]->getNearestQuat(identity, references[i]);
+  }
+
+  // Stage 2: sum the symmetry reduced quaternions of every feature
+  bool useEigen = (getAveragingMethod() == 1);
+  size_t stride = useEigen ? k_MeanComponents + k_EigenComponents : k_MeanComponents;
+  FeatureQuatSums totals;
+  totals.sums.resize(totalFeatures * stride, 0);
+  totals.counts.resize(totalFeatures, 0);
+  ThreadLocalAccumulator<FeatureQuatSums> localSums(totals);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), AccumulateFeatureQuatsImpl(m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, references, useEigen, &localSums),
+                      tbb::auto_partitioner());
   }
+  else
+#endif
+  {
+    AccumulateFeatureQuatsImpl serial(m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, references, useEigen, &localSums);
+    serial.compute(0, totalPoints);
+  }
+
+  localSums.combine([&](const FeatureQuatSums& local) {
+    for(size_t i = 0; i < totals.sums.size(); i++)
+    {
+      totals.sums[i] += local.sums[i];
+    }
+    for(size_t i = 0; i < totals.counts.size(); i++)
+    {
+      totals.counts[i] += local.counts[i];
+    }
+  });
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    if(counts[i] == 0.0f)
+    int64_t count = totals.counts[i];
+    if(count == 0)
     {
       QuaternionMathF::Identity(avgQuats[i]);
     }
-    QuaternionMathF::ScalarDivide(avgQuats[i], counts[i]);
+    else if(useEigen)
+    {
+      // Markley's average: the eigenvector of the mean outer product with the largest eigenvalue
+      const int64_t* outer = totals.sums.data() + stride * i + k_MeanComponents;
+      Eigen::Matrix4d m;
+      for(int r = 0; r < 4; r++)
+      {
+        for(int c = r; c < 4; c++)
+        {
+          m(r, c) = static_cast<double>(*outer) / k_FixedPointScale / static_cast<double>(count);
+          m(c, r) = m(r, c);
+          outer++;
+        }
+      }
+      Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> solver(m);
+      Eigen::Vector4d v = solver.eigenvectors().col(3);
+      if(v(3) < 0.0)
+      {
+        v = -v;
+      }
+      avgQuats[i].x = static_cast<float>(v(0));
+      avgQuats[i].y = static_cast<float>(v(1));
+      avgQuats[i].z = static_cast<float>(v(2));
+      avgQuats[i].w = static_cast<float>(v(3));
+    }
+    else
+    {
+      const int64_t* sums = totals.sums.data() + stride * i;
+      avgQuats[i].x = static_cast<float>(static_cast<double>(sums[0]) / k_FixedPointScale / static_cast<double>(count));
+      avgQuats[i].y = static_cast<float>(static_cast<double>(sums[1]) / k_FixedPointScale / static_cast<double>(count));
+      avgQuats[i].z = static_cast<float>(static_cast<double>(sums[2]) / k_FixedPointScale / static_cast<double>(count));
+      avgQuats[i].w = static_cast<float>(static_cast<double>(sums[3]) / k_FixedPointScale / static_cast<double>(count));
+    }
     QuaternionMathF::UnitQuaternion(avgQuats[i]);
 
     FOrientArrayType eu(m_FeatureEulerAngles + (3 * i), 3);
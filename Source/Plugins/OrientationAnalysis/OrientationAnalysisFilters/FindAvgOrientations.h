@@ -50,6 +50,7 @@ class OrientationAnalysis_EXPORT FindAvgOrientations : public AbstractFilter
 {
   Q_OBJECT
     PYB11_CREATE_BINDINGS(FindAvgOrientations SUPERCLASS AbstractFilter)
+    PYB11_PROPERTY(int AveragingMethod READ getAveragingMethod WRITE setAveragingMethod)
     PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
     PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
     PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
@@ -63,6 +64,9 @@ public:
 
   ~FindAvgOrientations() override;
 
+  SIMPL_FILTER_PARAMETER(int, AveragingMethod)
+  Q_PROPERTY(int AveragingMethod READ getAveragingMethod WRITE setAveragingMethod)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureIdsArrayPath)
   Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 
@@ -35,6 +35,17 @@
 
 #include "FindBoundaryStrengths.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -47,6 +58,72 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The FindBoundaryStrengthsImpl class implements a threaded algorithm that computes the slip transmission
+ * metrics in both directions for a set of unique feature pairs. The metrics of pair p are stored as
+ * mPrime_1, mPrime_2, F1_1, F1_2, F1spt_1, F1spt_2, F7_1, F7_2 at 8 * p, where _1 is seen from the first feature.
+ */
+class FindBoundaryStrengthsImpl
+{
+public:
+  FindBoundaryStrengthsImpl(const int32_t* featurePairs, float* avgQuats, int32_t* featurePhases, uint32_t* crystalStructures, float* loading, float* pairMetrics)
+  : m_FeaturePairs(featurePairs)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Loading(loading)
+  , m_PairMetrics(pairMetrics)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+
+  virtual ~FindBoundaryStrengthsImpl()
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+    float LD[3] = {m_Loading[0], m_Loading[1], m_Loading[2]};
+
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t gname1 = m_FeaturePairs[2 * i];
+      int32_t gname2 = m_FeaturePairs[2 * i + 1];
+      float* metrics = m_PairMetrics + 8 * i;
+      QuaternionMathF::Copy(avgQuats[gname1], q1);
+      QuaternionMathF::Copy(avgQuats[gname2], q2);
+      LaueOps::Pointer ops = m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]];
+      ops->getmPrime(q1, q2, LD, metrics[0]);
+      ops->getmPrime(q2, q1, LD, metrics[1]);
+      ops->getF1(q1, q2, LD, true, metrics[2]);
+      ops->getF1(q2, q1, LD, true, metrics[3]);
+      ops->getF1spt(q1, q2, LD, true, metrics[4]);
+      ops->getF1spt(q2, q1, LD, true, metrics[5]);
+      ops->getF7(q1, q2, LD, true, metrics[6]);
+      ops->getF7(q2, q1, LD, true, metrics[7]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeaturePairs;
+  float* m_AvgQuats;
+  int32_t* m_FeaturePhases;
+  uint32_t* m_CrystalStructures;
+  float* m_Loading;
+  float* m_PairMetrics;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -284,12 +361,6 @@ void FindBoundaryStrengths::execute()
 
   size_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-  float mPrime_1 = 0.0f, mPrime_2 = 0.0f, F1_1 = 0.0f, F1_2 = 0.0f, F1spt_1 = 0.0f, F1spt_2 = 0.0f, F7_1 = 0.0f, F7_2 = 0.0f;
-  int32_t gname1 = 0, gname2 = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
   float LD[3] = {0.0f, 0.0f, 0.0f};
 
   LD[0] = m_Loading.x;
@@ -297,56 +368,76 @@ void FindBoundaryStrengths::execute()
   LD[2] = m_Loading.z;
   MatrixMath::Normalize3x1(LD);
 
-  for(size_t i = 0; i < numTriangles; i++)
+  // A mesh has far more faces than feature pairs, so the metrics are computed once per unordered feature pair (in
+  // both directions) and the faces only copy them, swapping the two directions when their labels are reversed
+  std::vector<int32_t> facePairIndex(numTriangles, -1);
+  std::vector<int32_t> featurePairs;
   {
-    gname1 = m_SurfaceMeshFaceLabels[i * 2];
-    gname2 = m_SurfaceMeshFaceLabels[i * 2 + 1];
-    if(gname1 > 0 && gname2 > 0)
+    std::unordered_map<uint64_t, int32_t> pairIndices;
+    for(size_t i = 0; i < numTriangles; i++)
     {
-      QuaternionMathF::Copy(avgQuats[gname1], q1);
-      QuaternionMathF::Copy(avgQuats[gname2], q2);
-      if(m_CrystalStructures[m_FeaturePhases[gname1]] == m_CrystalStructures[m_FeaturePhases[gname2]] && m_FeaturePhases[gname1] > 0)
+      int32_t gname1 = m_SurfaceMeshFaceLabels[i * 2];
+      int32_t gname2 = m_SurfaceMeshFaceLabels[i * 2 + 1];
+      if(gname1 <= 0 || gname2 <= 0 || m_CrystalStructures[m_FeaturePhases[gname1]] != m_CrystalStructures[m_FeaturePhases[gname2]] || m_FeaturePhases[gname1] <= 0)
       {
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getmPrime(q1, q2, LD, mPrime_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getmPrime(q2, q1, LD, mPrime_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1(q1, q2, LD, true, F1_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1(q2, q1, LD, true, F1_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1spt(q1, q2, LD, true, F1spt_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF1spt(q2, q1, LD, true, F1spt_2);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF7(q1, q2, LD, true, F7_1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[gname1]]]->getF7(q2, q1, LD, true, F7_2);
+        continue;
       }
-      else
+      int32_t lowName = std::min(gname1, gname2);
+      int32_t highName = std::max(gname1, gname2);
+      uint64_t key = (static_cast<uint64_t>(lowName) << 32) | static_cast<uint32_t>(highName);
+      auto inserted = pairIndices.insert(std::make_pair(key, static_cast<int32_t>(featurePairs.size() / 2)));
+      if(inserted.second)
       {
-        mPrime_1 = 0.0f;
-        F1_1 = 0.0f;
-        F1spt_1 = 0.0f;
-        F7_1 = 0.0f;
-        mPrime_2 = 0.0f;
-        F1_2 = 0.0f;
-        F1spt_2 = 0.0f;
-        F7_2 = 0.0f;
+        featurePairs.push_back(lowName);
+        featurePairs.push_back(highName);
       }
+      facePairIndex[i] = inserted.first->second;
     }
-    else
+  }
+  size_t numPairs = featurePairs.size() / 2;
+  std::vector<float> pairMetrics(8 * numPairs, 0.0f);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPairs), FindBoundaryStrengthsImpl(featurePairs.data(), m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD, pairMetrics.data()),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindBoundaryStrengthsImpl serial(featurePairs.data(), m_AvgQuats, m_FeaturePhases, m_CrystalStructures, LD, pairMetrics.data());
+    serial.compute(0, numPairs);
+  }
+
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    int32_t pair = facePairIndex[i];
+    if(pair < 0)
     {
-      mPrime_1 = 0.0f;
-      F1_1 = 0.0f;
-      F1spt_1 = 0.0f;
-      F7_1 = 0.0f;
-      mPrime_2 = 0.0f;
-      F1_2 = 0.0f;
-      F1spt_2 = 0.0f;
-      F7_2 = 0.0f;
+      for(size_t k = 0; k < 2; k++)
+      {
+        m_SurfaceMeshmPrimes[2 * i + k] = 0.0f;
+        m_SurfaceMeshF1s[2 * i + k] = 0.0f;
+        m_SurfaceMeshF1spts[2 * i + k] = 0.0f;
+        m_SurfaceMeshF7s[2 * i + k] = 0.0f;
+      }
+      continue;
     }
-    m_SurfaceMeshmPrimes[2 * i] = mPrime_1;
-    m_SurfaceMeshmPrimes[2 * i + 1] = mPrime_2;
-    m_SurfaceMeshF1s[2 * i] = F1_1;
-    m_SurfaceMeshF1s[2 * i + 1] = F1_2;
-    m_SurfaceMeshF1spts[2 * i] = F1spt_1;
-    m_SurfaceMeshF1spts[2 * i + 1] = F1spt_2;
-    m_SurfaceMeshF7s[2 * i] = F7_1;
-    m_SurfaceMeshF7s[2 * i + 1] = F7_2;
+    const float* metrics = pairMetrics.data() + 8 * pair;
+    // first and second are the pair's directions as seen from the first and second label of this face
+    size_t first = (m_SurfaceMeshFaceLabels[i * 2] == featurePairs[2 * pair]) ? 0 : 1;
+    size_t second = 1 - first;
+    m_SurfaceMeshmPrimes[2 * i] = metrics[first];
+    m_SurfaceMeshmPrimes[2 * i + 1] = metrics[second];
+    m_SurfaceMeshF1s[2 * i] = metrics[2 + first];
+    m_SurfaceMeshF1s[2 * i + 1] = metrics[2 + second];
+    m_SurfaceMeshF1spts[2 * i] = metrics[4 + first];
+    m_SurfaceMeshF1spts[2 * i + 1] = metrics[4 + second];
+    m_SurfaceMeshF7s[2 * i] = metrics[6 + first];
+    m_SurfaceMeshF7s[2 * i + 1] = metrics[6 + second];
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
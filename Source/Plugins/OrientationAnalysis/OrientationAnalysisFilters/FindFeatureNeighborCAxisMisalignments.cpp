@@ -246,55 +246,51 @@ void FindFeatureNeighborCAxisMisalignments::execute()
 
   float w = 0.0f;
   float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float g2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float g1t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float g2t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-  float c1[3] = {0.0f, 0.0f, 0.0f};
-  float c2[3] = {0.0f, 0.0f, 0.0f};
   float caxis[3] = {0.0f, 0.0f, 1.0f};
   size_t hexneighborlistsize = 0;
   QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   uint32_t phase1 = 0, phase2 = 0;
   size_t nname = 0;
   misalignmentlists.resize(totalFeatures);
 
+  // Every feature appears in the lists of all of its neighbors, so find the sample direction of each hexagonal
+  // c-axis once up front instead of once per neighbor list entry
+  std::vector<float> sampleCAxes(3 * totalFeatures, 0.0f);
   for(size_t i = 1; i < totalFeatures; i++)
   {
+    if(m_CrystalStructures[m_FeaturePhases[i]] != Ebsd::CrystalStructure::Hexagonal_High)
+    {
+      continue;
+    }
     QuaternionMathF::Copy(avgQuats[i], q1);
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
     FOrientArrayType om(9);
     FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
     om.toGMatrix(g1);
     // transpose the g matrix so when caxis is multiplied by it
     // it will give the sample direction that the caxis is along
     MatrixMath::Transpose3x3(g1, g1t);
-    MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+    MatrixMath::Multiply3x3with3x1(g1t, caxis, &sampleCAxes[3 * i]);
     // normalize so that the dot product can be taken below without
     // dividing by the magnitudes (they would be 1)
-    MatrixMath::Normalize3x1(c1);
+    MatrixMath::Normalize3x1(&sampleCAxes[3 * i]);
+  }
+
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
+    float* c1 = &sampleCAxes[3 * i];
     misalignmentlists[i].resize(neighborlist[i].size(), -1.0f);
+    hexneighborlistsize = neighborlist[i].size();
     for(size_t j = 0; j < neighborlist[i].size(); j++)
     {
-      w = std::numeric_limits<float>::max();
       nname = neighborlist[i][j];
       phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      hexneighborlistsize = neighborlist[i].size();
       if(phase1 == phase2 && (phase1 == Ebsd::CrystalStructure::Hexagonal_High))
       {
-        QuaternionMathF::Copy(avgQuats[nname], q2);
-        FOrientTransformsType::qu2om(FOrientArrayType(q2), om);
-        om.toGMatrix(g2);
-        // transpose the g matrix so when caxis is multiplied by it
-        // it will give the sample direction that the caxis is along
-        MatrixMath::Transpose3x3(g2, g2t);
-        MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
-        // normalize so that the dot product can be taken below without
-        // dividing by the magnitudes (they would be 1)
-        MatrixMath::Normalize3x1(c2);
-
+        float* c2 = &sampleCAxes[3 * nname];
         w = GeometryMath::CosThetaBetweenVectors(c1, c2);
         SIMPLibMath::boundF(w, -1, 1);
         w = acosf(w);
@@ -311,10 +307,7 @@ void FindFeatureNeighborCAxisMisalignments::execute()
       }
       else
       {
-        if(m_FindAvgMisals == true)
-        {
-          hexneighborlistsize--;
-        }
+        hexneighborlistsize--;
         misalignmentlists[i][j] = NAN;
       }
     }
@@ -328,7 +321,6 @@ void FindFeatureNeighborCAxisMisalignments::execute()
       {
         m_AvgCAxisMisalignments[i] = NAN;
       }
-      hexneighborlistsize = 0;
     }
   }
 
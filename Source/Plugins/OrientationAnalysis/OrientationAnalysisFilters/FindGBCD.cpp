@@ -35,6 +35,9 @@
 
 #include "FindGBCD.h"
 
+#include <algorithm>
+#include <vector>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -58,11 +61,28 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/HelperClasses/ThreadLocalAccumulator.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The GBCDHistogram struct is one worker's share of the GBCD: the area binned for
+ * every phase plus the total area binned for every phase
+ */
+struct GBCDHistogram
+{
+  std::vector<double> gbcd;
+  std::vector<double> totalFaceArea;
+  size_t binsPerPhase;
+};
+
+using GBCDHistograms = ThreadLocalAccumulator<GBCDHistogram>;
+
 /**
  * @brief The CalculateGBCDImpl class implements a threaded algorithm that calculates the
- * grain boundary character distribution (GBCD) for a surface mesh
+ * grain boundary character distribution (GBCD) for a surface mesh. When given a set of
+ * thread local histograms every worker bins the triangle areas straight into its own
+ * histogram; otherwise the bin index and hemisphere of every symmetric representation are
+ * written to the chunk buffers for the caller to accumulate.
  */
 class CalculateGBCDImpl
 {
@@ -82,10 +102,13 @@ class CalculateGBCDImpl
   UInt32ArrayType::Pointer m_CrystalStructuresArray;
   QVector<LaueOps::Pointer> m_OrientationOps;
 
+  DoubleArrayType::Pointer m_AreasArray;
+  GBCDHistograms* m_Histograms;
+
 public:
   CalculateGBCDImpl(size_t i, size_t numMisoReps, Int32ArrayType::Pointer Labels, DoubleArrayType::Pointer Normals, FloatArrayType::Pointer Eulers, Int32ArrayType::Pointer Phases,
                     UInt32ArrayType::Pointer CrystalStructures, Int32ArrayType::Pointer Bins, BoolArrayType::Pointer HemiCheck, FloatArrayType::Pointer GBCDdeltas, Int32ArrayType::Pointer GBCDsizes,
-                    FloatArrayType::Pointer GBCDlimits)
+                    FloatArrayType::Pointer GBCDlimits, DoubleArrayType::Pointer Areas = DoubleArrayType::NullPointer(), GBCDHistograms* Histograms = nullptr)
   : startOffset(i)
   , numEntriesPerTri(numMisoReps)
   , m_LabelsArray(Labels)
@@ -98,6 +121,8 @@ public:
   , m_GbcdBinsArray(Bins)
   , m_GbcdHemiCheckArray(HemiCheck)
   , m_CrystalStructuresArray(CrystalStructures)
+  , m_AreasArray(Areas)
+  , m_Histograms(Histograms)
   {
     m_OrientationOps = LaueOps::getOrientationOpsQVector();
   }
@@ -112,8 +137,20 @@ public:
     float* m_GBCDdeltas = m_GbcdDeltasArray->getPointer(0);
     float* m_GBCDlimits = m_GbcdLimitsArray->getPointer(0);
     int* m_GBCDsizes = m_GbcdSizesArray->getPointer(0);
-    int32_t* m_Bins = m_GbcdBinsArray->getPointer(0);
-    bool* m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
+    int32_t* m_Bins = nullptr;
+    bool* m_HemiCheck = nullptr;
+    double* m_Areas = nullptr;
+    GBCDHistogram* histogram = nullptr;
+    if(nullptr != m_Histograms)
+    {
+      m_Areas = m_AreasArray->getPointer(0);
+      histogram = &(m_Histograms->local());
+    }
+    else
+    {
+      m_Bins = m_GbcdBinsArray->getPointer(0);
+      m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
+    }
 
     int32_t* m_Labels = m_LabelsArray->getPointer(0);
     double* m_Normals = m_NormalsArray->getPointer(0);
@@ -140,8 +177,9 @@ public:
     float sqCoord[2] = {0.0f, 0.0f}, sqCoordInv[2] = {0.0f, 0.0f};
     bool nhCheck = false, nhCheckInv = true;
     int32_t SYMcounter = 0;
-    int64_t TRIcounter = static_cast<int64_t>(start - startOffset);
     int64_t TRIcounterShift = 0;
+    double area = 0.0;
+    double* phaseGBCD = nullptr;
 
     for(size_t i = start; i < end; i++)
     {
@@ -159,7 +197,12 @@ public:
 
       if(m_Phases[feature1] == m_Phases[feature2] && m_Phases[feature1] > 0)
       {
-        TRIcounterShift = (TRIcounter * numEntriesPerTri);
+        TRIcounterShift = static_cast<int64_t>((i - startOffset) * numEntriesPerTri);
+        if(nullptr != histogram)
+        {
+          area = m_Areas[i];
+          phaseGBCD = &(histogram->gbcd[m_Phases[feature1] * histogram->binsPerPhase]);
+        }
         uint32_t cryst = m_CrystalStructures[m_Phases[feature1]];
         for(int32_t q = 0; q < 2; q++)
         {
@@ -233,8 +276,17 @@ public:
                 gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoord);
                 if(gbcd_index != -1)
                 {
-                  m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheck;
-                  m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                  if(nullptr != histogram)
+                  {
+                    // The northern hemisphere goes in the even bin, the southern one in the odd bin
+                    phaseGBCD[2 * gbcd_index + (nhCheck ? 0 : 1)] += area;
+                    histogram->totalFaceArea[m_Phases[feature1]] += area;
+                  }
+                  else
+                  {
+                    m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheck;
+                    m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                  }
                 }
                 SYMcounter++;
                 if(inversion == 1)
@@ -242,8 +294,16 @@ public:
                   gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoordInv);
                   if(gbcd_index != -1)
                   {
-                    m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheckInv;
-                    m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                    if(nullptr != histogram)
+                    {
+                      phaseGBCD[2 * gbcd_index + (nhCheckInv ? 0 : 1)] += area;
+                      histogram->totalFaceArea[m_Phases[feature1]] += area;
+                    }
+                    else
+                    {
+                      m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheckInv;
+                      m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
+                    }
                   }
                   SYMcounter++;
                 }
@@ -256,7 +316,6 @@ public:
           }
         }
       }
-      TRIcounter++;
     }
   }
 
@@ -619,10 +678,41 @@ void FindGBCD::execute()
   {
     faceChunkSize = totalFaces;
   }
-  // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
-  sizeGBCD(faceChunkSize, numMisoReps);
+  // call the sizeGBCD function with a chunk size of 0 to only compute the GBCD dimensions
+  sizeGBCD(0, numMisoReps);
   int32_t totalGBCDBins = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
 
+  // As long as the private copies of the GBCD stay reasonably small (256 MB for all of them together)
+  // every worker bins the triangle areas directly into its own histogram and the copies are summed at
+  // the end. For very fine resolutions fall back to writing the bins of each chunk of faces into
+  // shared buffers
+  const size_t maxThreadLocalGBCDBytes = 256 * 1024 * 1024;
+  size_t numThreadLocalCopies = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    numThreadLocalCopies = static_cast<size_t>(std::max(init.default_num_threads(), 1));
+  }
+#endif
+  size_t threadLocalGBCDBytes = totalPhases * static_cast<size_t>(totalGBCDBins) * sizeof(double);
+  // The exemplar the workers copy from is kept alive next to their copies
+  bool useThreadLocalHistograms = (threadLocalGBCDBytes <= maxThreadLocalGBCDBytes / (numThreadLocalCopies + 1));
+
+  GBCDHistogram exemplar;
+  if(useThreadLocalHistograms)
+  {
+    exemplar.gbcd.assign(totalPhases * totalGBCDBins, 0.0);
+    exemplar.totalFaceArea.assign(totalPhases, 0.0);
+    exemplar.binsPerPhase = static_cast<size_t>(totalGBCDBins);
+  }
+  else
+  {
+    // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
+    sizeGBCD(faceChunkSize, numMisoReps);
+  }
+  GBCDHistograms histograms(exemplar);
+  GBCDHistograms* histogramsPtr = useThreadLocalHistograms ? &histograms : nullptr;
+
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t currentMillis = millis;
   uint64_t startMillis = millis;
@@ -647,20 +737,25 @@ void FindGBCD::execute()
     {
       faceChunkSize = totalFaces - i;
     }
-    m_GbcdBinsArray->initializeWithValue(-1);
+    if(!useThreadLocalHistograms)
+    {
+      m_GbcdBinsArray->initializeWithValue(-1);
+    }
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel == true)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize),
                         CalculateGBCDImpl(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                                          m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray),
+                                          m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray,
+                                          m_SurfaceMeshFaceAreasPtr.lock(), histogramsPtr),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
       CalculateGBCDImpl serial(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(),
-                               m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
+                               m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray, m_SurfaceMeshFaceAreasPtr.lock(),
+                               histogramsPtr);
       serial.generate(i, i + faceChunkSize);
     }
 
@@ -680,6 +775,11 @@ void FindGBCD::execute()
       return;
     }
 
+    if(useThreadLocalHistograms)
+    {
+      continue;
+    }
+
     int32_t phase = 0;
     int32_t feature = 0;
     double area = 0.0;
@@ -687,6 +787,10 @@ void FindGBCD::execute()
     {
       area = m_SurfaceMeshFaceAreas[i + j];
       feature = m_SurfaceMeshFaceLabels[2 * (i + j)];
+      if(feature < 0)
+      {
+        continue;
+      }
       phase = m_FeaturePhases[feature];
       for(size_t k = 0; k < numMisoReps; k++)
       {
@@ -704,6 +808,21 @@ void FindGBCD::execute()
     }
   }
 
+  if(useThreadLocalHistograms)
+  {
+    size_t totalGBCDSize = totalPhases * totalGBCDBins;
+    histograms.combine([&](const GBCDHistogram& histogram) {
+      for(size_t b = 0; b < totalGBCDSize; b++)
+      {
+        m_GBCD[b] += histogram.gbcd[b];
+      }
+      for(size_t p = 0; p < totalPhases; p++)
+      {
+        totalFaceArea[p] += histogram.totalFaceArea[p];
+      }
+    });
+  }
+
   ss = QObject::tr("Starting GBCD Normalization");
   notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
@@ -732,17 +851,27 @@ void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
   m_GbcdLimitsArray->initializeWithZeros();
   m_GbcdSizesArray = Int32ArrayType::CreateArray(5, "GBCDSizes");
   m_GbcdSizesArray->initializeWithZeros();
-  QVector<size_t> cDims(1, numMisoReps);
-  m_GbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, cDims, "GBCDBins");
-  m_GbcdBinsArray->initializeWithZeros();
-  m_GbcdHemiCheckArray = BoolArrayType::CreateArray(faceChunkSize, cDims, "GBCDHemiCheck");
-  m_GbcdHemiCheckArray->initializeWithValue(false);
+  if(faceChunkSize > 0)
+  {
+    QVector<size_t> cDims(1, numMisoReps);
+    m_GbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, cDims, "GBCDBins");
+    m_GbcdBinsArray->initializeWithZeros();
+    m_GbcdHemiCheckArray = BoolArrayType::CreateArray(faceChunkSize, cDims, "GBCDHemiCheck");
+    m_GbcdHemiCheckArray->initializeWithValue(false);
+    m_GbcdBins = m_GbcdBinsArray->getPointer(0);
+    m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
+  }
+  else
+  {
+    m_GbcdBinsArray = Int32ArrayType::NullPointer();
+    m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
+    m_GbcdBins = nullptr;
+    m_HemiCheck = nullptr;
+  }
 
   m_GbcdDeltas = m_GbcdDeltasArray->getPointer(0);
   m_GbcdSizes = m_GbcdSizesArray->getPointer(0);
   m_GbcdLimits = m_GbcdLimitsArray->getPointer(0);
-  m_GbcdBins = m_GbcdBinsArray->getPointer(0);
-  m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
   // Original Ranges from Dave R.
   // m_GBCDlimits[0] = 0.0f;
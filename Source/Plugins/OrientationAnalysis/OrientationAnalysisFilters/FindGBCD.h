@@ -202,7 +202,7 @@ protected:
 
   /**
    * @brief sizeGBCD Determines the sizing for the GBCD arrays
-   * @param faceChunkSize Number of triangles per chunk
+   * @param faceChunkSize Number of triangles per chunk; 0 skips allocating the chunk buffers
    * @param numMisoReps Dimensionality for bins
    */
   void sizeGBCD(size_t faceChunkSize, size_t numMisoReps);
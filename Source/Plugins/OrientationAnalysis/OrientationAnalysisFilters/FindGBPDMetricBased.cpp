@@ -45,6 +45,8 @@
 
 #include "FindGBPDMetricBased.h"
 
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -62,10 +64,10 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/HelperClasses/ThreadLocalAccumulator.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include "tbb/concurrent_vector.h"
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/partitioner.h>
@@ -122,11 +124,7 @@ class TrisSelector
   bool m_ExcludeTripleLines;
   int64_t* m_Triangles;
   int8_t* m_NodeTypes;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals>* selectedTris;
-#else
-  QVector<TriAreaAndNormals>* selectedTris;
-#endif
+  ThreadLocalAccumulator<std::vector<TriAreaAndNormals>>* selectedTris;
   int32_t m_PhaseOfInterest;
   QVector<LaueOps::Pointer> m_OrientationOps;
   uint32_t cryst;
@@ -141,11 +139,7 @@ class TrisSelector
 public:
   TrisSelector(bool __m_ExcludeTripleLines, int64_t* __m_Triangles, int8_t* __m_NodeTypes,
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals>* __selectedTris,
-#else
-               QVector<TriAreaAndNormals>* __selectedTris,
-#endif
+               ThreadLocalAccumulator<std::vector<TriAreaAndNormals>>* __selectedTris,
                int32_t __m_PhaseOfInterest, uint32_t* __m_CrystalStructures, float* __m_Eulers, int32_t* __m_Phases, int32_t* __m_FaceLabels, double* __m_FaceNormals, double* __m_FaceAreas)
   : m_ExcludeTripleLines(__m_ExcludeTripleLines)
   , m_Triangles(__m_Triangles)
@@ -170,6 +164,9 @@ public:
 
   void select(size_t start, size_t end) const
   {
+    // Every worker appends to its own list; the lists are gathered once all triangles are done
+    std::vector<TriAreaAndNormals>& localTris = selectedTris->local();
+
     float g1ea[3] = {0.0f, 0.0f, 0.0f};
     float g2ea[3] = {0.0f, 0.0f, 0.0f};
 
@@ -229,7 +226,7 @@ public:
       MatrixMath::Multiply3x3with3x1(g1, normal_lab, normal_grain1);
       MatrixMath::Multiply3x3with3x1(g2, normal_lab, normal_grain2);
 
-      (*selectedTris).push_back(TriAreaAndNormals(m_FaceAreas[triIdx], normal_grain1[0], normal_grain1[1], normal_grain1[2], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2]));
+      localTris.push_back(TriAreaAndNormals(m_FaceAreas[triIdx], normal_grain1[0], normal_grain1[1], normal_grain1[2], -normal_grain2[0], -normal_grain2[1], -normal_grain2[2]));
     }
   }
 
@@ -252,11 +249,7 @@ class ProbeDistrib
   QVector<float>* samplPtsX;
   QVector<float>* samplPtsY;
   QVector<float>* samplPtsZ;
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
-#else
-  QVector<TriAreaAndNormals> selectedTris;
-#endif
+  const std::vector<TriAreaAndNormals>& selectedTris;
   float limitDist;
   double totalFaceArea;
   int numDistinctGBs;
@@ -267,11 +260,7 @@ class ProbeDistrib
 
 public:
   ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
-#else
-               QVector<TriAreaAndNormals> __selectedTris,
-#endif
+               const std::vector<TriAreaAndNormals>& __selectedTris,
                float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
   : distribValues(__distribValues)
   , errorValues(__errorValues)
@@ -1026,10 +1015,8 @@ void FindGBPDMetricBased::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
-  tbb::concurrent_vector<GBPDMetricBased::TriAreaAndNormals> selectedTris(0);
-#else
-  QVector<GBPDMetricBased::TriAreaAndNormals> selectedTris(0);
 #endif
+  ThreadLocalAccumulator<std::vector<GBPDMetricBased::TriAreaAndNormals>> selectedTrisPerThread((std::vector<GBPDMetricBased::TriAreaAndNormals>()));
 
   size_t trisChunkSize = 50000;
   if(numMeshTris < trisChunkSize)
@@ -1054,19 +1041,28 @@ void FindGBPDMetricBased::execute()
     if(doParallel == true)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + trisChunkSize),
-                        GBPDMetricBased::TrisSelector(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTris, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels,
+                        GBPDMetricBased::TrisSelector(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTrisPerThread, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels,
                                                       m_FaceNormals, m_FaceAreas),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBPDMetricBased::TrisSelector serial(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTris, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels, m_FaceNormals,
+      GBPDMetricBased::TrisSelector serial(m_ExcludeTripleLines, m_Triangles, m_NodeTypes, &selectedTrisPerThread, m_PhaseOfInterest, m_CrystalStructures, m_Eulers, m_Phases, m_FaceLabels, m_FaceNormals,
                                            m_FaceAreas);
       serial.select(i, i + trisChunkSize);
     }
   }
 
+  // Gather the triangles every worker selected into one list
+  std::vector<GBPDMetricBased::TriAreaAndNormals> selectedTris;
+  {
+    size_t numSelectedTris = 0;
+    selectedTrisPerThread.combine([&](const std::vector<GBPDMetricBased::TriAreaAndNormals>& localTris) { numSelectedTris += localTris.size(); });
+    selectedTris.reserve(numSelectedTris);
+    selectedTrisPerThread.combine([&](const std::vector<GBPDMetricBased::TriAreaAndNormals>& localTris) { selectedTris.insert(selectedTris.end(), localTris.begin(), localTris.end()); });
+  }
+
   // ------------------------  find the number of distinct boundaries ------------------------------
   int32_t numDistinctGBs = 0;
   int32_t numFaceFeatures = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getNumberOfTuples();
@@ -35,6 +35,16 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -48,6 +58,173 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class implements a threaded algorithm that computes the
+ * kernel average misorientation for a slab of rows (all points sharing a y and z index) of an image.
+ * Since the misorientation of a pair of points does not depend on which of the two is the kernel
+ * center, each pair is only computed once for the "forward" half of the kernel and credited to both
+ * ends. Pairs reaching back into the rows below the slab are computed from a halo of rows so that
+ * slabs never write outside of their own range.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+public:
+  FindKernelAvgMisorientationsImpl(int32_t* featureIds, int32_t* cellPhases, float* quats, uint32_t* crystalStructures, int64_t dims[3], IntVec3_t kernelSize, float* kernelAverageMisorientations)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_KernelAverageMisorientations(kernelAverageMisorientations)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+
+    // Keep the offsets that point forward in memory order; their mirror images are covered by symmetry
+    for(int32_t j = 0; j <= kernelSize.z; j++)
+    {
+      for(int32_t k = -kernelSize.y; k <= kernelSize.y; k++)
+      {
+        for(int32_t l = -kernelSize.x; l <= kernelSize.x; l++)
+        {
+          if(j > 0 || k > 0 || (k == 0 && l > 0))
+          {
+            m_Offsets.push_back(l);
+            m_Offsets.push_back(k);
+            m_Offsets.push_back(j);
+          }
+        }
+      }
+    }
+    // Rows before a slab whose kernels still reach into the slab
+    m_HaloRows = static_cast<int64_t>(kernelSize.z) * m_Dims[1] + kernelSize.y;
+  }
+
+  virtual ~FindKernelAvgMisorientationsImpl()
+  {
+  }
+
+  void compute(int64_t startRow, int64_t endRow) const
+  {
+    int64_t xPoints = m_Dims[0];
+    int64_t yPoints = m_Dims[1];
+    int64_t zPoints = m_Dims[2];
+    int64_t startPoint = startRow * xPoints;
+    int64_t endPoint = endRow * xPoints;
+    size_t numOffsets = m_Offsets.size() / 3;
+
+    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+
+    // Every valid point starts out paired with itself, which contributes a misorientation of zero
+    std::vector<float> totalMisorientation(static_cast<size_t>(endPoint - startPoint), 0.0f);
+    std::vector<int32_t> numVoxels(static_cast<size_t>(endPoint - startPoint), 0);
+    for(int64_t point = startPoint; point < endPoint; point++)
+    {
+      if(isValid(point))
+      {
+        numVoxels[point - startPoint] = 1;
+      }
+    }
+
+    int64_t firstRow = std::max(startRow - m_HaloRows, static_cast<int64_t>(0));
+    for(int64_t rowIndex = firstRow; rowIndex < endRow; rowIndex++)
+    {
+      int64_t plane = rowIndex / yPoints;
+      int64_t row = rowIndex % yPoints;
+      for(int64_t col = 0; col < xPoints; col++)
+      {
+        int64_t point = rowIndex * xPoints + col;
+        int32_t featureId = m_FeatureIds[point];
+        if(featureId <= 0)
+        {
+          continue;
+        }
+        bool pointValid = isValid(point);
+        bool pointInSlab = (point >= startPoint);
+        for(size_t o = 0; o < numOffsets; o++)
+        {
+          int64_t nCol = col + m_Offsets[3 * o];
+          int64_t nRow = row + m_Offsets[3 * o + 1];
+          int64_t nPlane = plane + m_Offsets[3 * o + 2];
+          if(nCol < 0 || nCol > xPoints - 1 || nRow < 0 || nRow > yPoints - 1 || nPlane > zPoints - 1)
+          {
+            continue;
+          }
+          int64_t neighbor = (nPlane * yPoints + nRow) * xPoints + nCol;
+          bool neighborInSlab = (neighbor >= startPoint && neighbor < endPoint);
+          if(m_FeatureIds[neighbor] != featureId || (!pointInSlab && !neighborInSlab))
+          {
+            continue;
+          }
+          bool creditPoint = pointInSlab && pointValid;
+          bool creditNeighbor = neighborInSlab && isValid(neighbor);
+          if(!creditPoint && !creditNeighbor)
+          {
+            continue;
+          }
+
+          // The kernel center's crystal structure decides the symmetry, so only reuse the
+          // value for the other end when both points share it
+          uint32_t crystPoint = creditPoint ? m_CrystalStructures[m_CellPhases[point]] : m_CrystalStructures[m_CellPhases[neighbor]];
+          QuaternionMathF::Copy(quats[point], q1);
+          QuaternionMathF::Copy(quats[neighbor], q2);
+          float w = m_OrientationOps[crystPoint]->getMisoQuat(q1, q2, n1, n2, n3) * SIMPLib::Constants::k_180OverPi;
+          if(creditPoint)
+          {
+            totalMisorientation[point - startPoint] += w;
+            numVoxels[point - startPoint]++;
+          }
+          if(creditNeighbor)
+          {
+            uint32_t crystNeighbor = m_CrystalStructures[m_CellPhases[neighbor]];
+            if(crystNeighbor != crystPoint)
+            {
+              QuaternionMathF::Copy(quats[neighbor], q1);
+              QuaternionMathF::Copy(quats[point], q2);
+              w = m_OrientationOps[crystNeighbor]->getMisoQuat(q1, q2, n1, n2, n3) * SIMPLib::Constants::k_180OverPi;
+            }
+            totalMisorientation[neighbor - startPoint] += w;
+            numVoxels[neighbor - startPoint]++;
+          }
+        }
+      }
+    }
+
+    for(int64_t point = startPoint; point < endPoint; point++)
+    {
+      int32_t count = numVoxels[point - startPoint];
+      m_KernelAverageMisorientations[point] = (count == 0) ? 0.0f : totalMisorientation[point - startPoint] / static_cast<float>(count);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  bool isValid(int64_t point) const
+  {
+    return m_FeatureIds[point] > 0 && m_CellPhases[point] > 0;
+  }
+
+  int32_t* m_FeatureIds;
+  int32_t* m_CellPhases;
+  float* m_Quats;
+  uint32_t* m_CrystalStructures;
+  float* m_KernelAverageMisorientations;
+  int64_t m_Dims[3];
+  int64_t m_HaloRows;
+  std::vector<int32_t> m_Offsets;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -225,100 +402,30 @@ void FindKernelAvgMisorientations::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float w = 0.0f, totalmisorientation = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = Ebsd::CrystalStructure::UnknownCrystalStructure;
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+  int64_t dims[3] = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+
+  // Work on whole rows in memory order; a slab of rows is independent of every other slab
+  int64_t totalRows = dims[1] * dims[2];
 
-  int64_t xPoints = static_cast<int64_t>(udims[0]);
-  int64_t yPoints = static_cast<int64_t>(udims[1]);
-  int64_t zPoints = static_cast<int64_t>(udims[2]);
-  int64_t point = 0;
-  size_t neighbor = 0;
-  int64_t jStride = 0;
-  int64_t kStride = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
 
-  for(int64_t col = 0; col < xPoints; col++)
+  if(doParallel == true)
   {
-    for(int64_t row = 0; row < yPoints; row++)
-    {
-      for(int64_t plane = 0; plane < zPoints; plane++)
-      {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          QuaternionMathF::Copy(quats[point], q1);
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for(int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for(int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
-            {
-              kStride = k * xPoints;
-              for(int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if(plane + j < 0)
-                {
-                  good = false;
-                }
-                else if(plane + j > zPoints - 1)
-                {
-                  good = false;
-                }
-                else if(row + k < 0)
-                {
-                  good = false;
-                }
-                else if(row + k > yPoints - 1)
-                {
-                  good = false;
-                }
-                else if(col + l < 0)
-                {
-                  good = false;
-                }
-                else if(col + l > xPoints - 1)
-                {
-                  good = false;
-                }
-                if(good == true && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  w = std::numeric_limits<float>::max();
-                  QuaternionMathF::Copy(quats[neighbor], q2);
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
-                  totalmisorientation = totalmisorientation + w;
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if(numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
-        }
-        if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0.0f;
-        }
-      }
-    }
+    // Keep the slabs large compared to the halo of rows each slab has to revisit
+    int64_t haloRows = static_cast<int64_t>(m_KernelSize.z) * dims[1] + m_KernelSize.y;
+    int64_t grainSize = std::max(haloRows * 8, static_cast<int64_t>(64));
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, totalRows, grainSize),
+                      FindKernelAvgMisorientationsImpl(m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, dims, m_KernelSize, m_KernelAverageMisorientations), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindKernelAvgMisorientationsImpl serial(m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, dims, m_KernelSize, m_KernelAverageMisorientations);
+    serial.compute(0, totalRows);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
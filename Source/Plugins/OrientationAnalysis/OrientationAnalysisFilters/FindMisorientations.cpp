@@ -44,6 +44,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
+#include "OrientationLib/Utilities/FeatureMisorientationCache.h"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -232,40 +234,23 @@ void FindMisorientations::execute()
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
+  // The misorientations of every (feature, neighbor) entry are shared with the other filters that work on the same
+  // neighbor list, so they are only computed here if no earlier filter has done so for the current orientations
+  FeatureMisorientationCache::Pointer misorientations = FeatureMisorientationCache::Get(m_NeighborList.lock(), m_AvgQuatsPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock());
 
   std::vector<std::vector<float>> misorientationlists;
-
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float w = 0.0f;
-  size_t tempMisoList = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  uint32_t xtalType1 = 0, xtalType2 = 0;
-  int32_t nname = 0;
-
   misorientationlists.resize(totalFeatures);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    xtalType1 = m_CrystalStructures[m_FeaturePhases[i]];
-    misorientationlists[i].assign(neighborlist[i].size(), -1.0);
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    size_t offset = misorientations->getOffset(i);
+    size_t numNeighbors = misorientations->getNumberOfNeighbors(i);
+    size_t tempMisoList = numNeighbors;
+    misorientationlists[i].assign(numNeighbors, -1.0);
+    for(size_t j = 0; j < numNeighbors; j++)
     {
-      w = std::numeric_limits<float>::max();
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
-      xtalType2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      tempMisoList = neighborlist[i].size();
-      if(xtalType1 == xtalType2 && xtalType1 < m_OrientationOps.size())
+      if(misorientations->isValid(offset + j))
       {
-        w = m_OrientationOps[xtalType1]->getMisoQuat(q1, q2, n1, n2, n3);
-        misorientationlists[i][j] = w * SIMPLib::Constants::k_180OverPi;
+        misorientationlists[i][j] = misorientations->getAngle(offset + j) * SIMPLib::Constants::k_180OverPi;
         if(m_FindAvgMisors == true)
         {
           m_AvgMisorientations[i] += misorientationlists[i][j];
@@ -273,10 +258,7 @@ void FindMisorientations::execute()
       }
       else
       {
-        if(m_FindAvgMisors == true)
-        {
-          tempMisoList--;
-        }
+        tempMisoList--;
         misorientationlists[i][j] = NAN;
       }
     }
@@ -290,7 +272,6 @@ void FindMisorientations::execute()
       {
         m_AvgMisorientations[i] = NAN;
       }
-      tempMisoList = 0;
     }
   }
 
@@ -0,0 +1,556 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FindNeighborPatternSimilarity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisVersion.h"
+
+namespace
+{
+// Normalized patterns are padded to a multiple of this many values so the dot product runs in full SIMD lanes
+const size_t k_PatternAlignment = 8;
+// Size of the working set one column tile of the pair loop should fit into
+const size_t k_TileBytes = 1024 * 1024;
+// Upper bound for the normalized patterns one slab keeps in memory
+const size_t k_SlabBytes = 128 * 1024 * 1024;
+
+/**
+ * @brief dotProduct Returns the dot product of two padded pattern vectors. The eight partial sums are
+ * independent so the compiler can keep them in vector registers.
+ */
+inline float dotProduct(const float* a, const float* b, size_t count)
+{
+  float sums[k_PatternAlignment] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  for(size_t i = 0; i < count; i += k_PatternAlignment)
+  {
+    for(size_t k = 0; k < k_PatternAlignment; k++)
+    {
+      sums[k] += a[i + k] * b[i + k];
+    }
+  }
+  return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+}
+}
+
+/**
+ * @brief The FindNeighborPatternSimilarityImpl class implements a threaded algorithm that averages the
+ * normalized dot product between the pattern of every cell and the patterns of its kernel neighbors. The
+ * rows of a range are swept in slabs that are normalized into a padded float buffer; consecutive slabs
+ * share their halo rows, so every row is normalized once per range. Each pair of cells is compared once
+ * and credited to both of its ends.
+ */
+template <typename T> class FindNeighborPatternSimilarityImpl
+{
+public:
+  FindNeighborPatternSimilarityImpl(const T* patterns, size_t patternSize, int64_t dims[3], IntVec3_t kernelSize, bool subtractMean, float* similarity)
+  : m_Patterns(patterns)
+  , m_PatternSize(patternSize)
+  , m_SubtractMean(subtractMean)
+  , m_Similarity(similarity)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+    m_Stride = (patternSize + k_PatternAlignment - 1) / k_PatternAlignment * k_PatternAlignment;
+
+    // Keep the offsets that point forward in memory order; their mirror images are covered by symmetry
+    for(int32_t j = 0; j <= kernelSize.z; j++)
+    {
+      for(int32_t k = -kernelSize.y; k <= kernelSize.y; k++)
+      {
+        for(int32_t l = -kernelSize.x; l <= kernelSize.x; l++)
+        {
+          if(j > 0 || k > 0 || (k == 0 && l > 0))
+          {
+            m_Offsets.push_back(l);
+            m_Offsets.push_back(k);
+            m_Offsets.push_back(j);
+          }
+        }
+      }
+    }
+    // Rows on either side of a slab that hold the other end of a pair with a cell in the slab
+    m_HaloRows = static_cast<int64_t>(kernelSize.z) * m_Dims[1] + kernelSize.y;
+
+    // The buffer holds the slab and both of its halos. When the halos alone exceed the budget the slab is
+    // made as tall as one halo, so the buffer stays within three halos instead of shrinking the slab to a
+    // single row that would be swept past two halos' worth of buffered rows
+    size_t rowBytes = static_cast<size_t>(m_Dims[0]) * m_Stride * sizeof(float);
+    int64_t budgetRows = static_cast<int64_t>(k_SlabBytes / std::max(rowBytes, static_cast<size_t>(1)));
+    m_SlabRows = std::max(budgetRows - 2 * m_HaloRows, std::max(m_HaloRows, static_cast<int64_t>(1)));
+
+    size_t kernelRows = static_cast<size_t>(kernelSize.y + 1) * static_cast<size_t>(kernelSize.z + 1);
+    m_TileColumns = std::max(static_cast<int64_t>(k_TileBytes / (m_Stride * sizeof(float) * kernelRows)), static_cast<int64_t>(kernelSize.x + 1));
+  }
+
+  virtual ~FindNeighborPatternSimilarityImpl()
+  {
+  }
+
+  void compute(int64_t startRow, int64_t endRow) const
+  {
+    int64_t xPoints = m_Dims[0];
+    int64_t totalRows = m_Dims[1] * m_Dims[2];
+
+    // Normalized rows [bufferFirstRow, bufferLastRow); the trailing halo of one slab is the leading halo and
+    // first rows of the next, so those rows are moved to the front of the buffer instead of normalized again
+    std::vector<float> normalized;
+    std::vector<uint8_t> valid;
+    int64_t bufferFirstRow = 0;
+    int64_t bufferLastRow = 0;
+
+    // Split large ranges so the normalized slab stays within its memory budget
+    for(int64_t slabStart = startRow; slabStart < endRow; slabStart += m_SlabRows)
+    {
+      int64_t slabEnd = std::min(slabStart + m_SlabRows, endRow);
+      int64_t firstRow = std::max(slabStart - m_HaloRows, static_cast<int64_t>(0));
+      int64_t lastRow = std::min(slabEnd + m_HaloRows, totalRows);
+
+      size_t keptPoints = 0;
+      if(firstRow >= bufferFirstRow && firstRow < bufferLastRow)
+      {
+        size_t offset = static_cast<size_t>((firstRow - bufferFirstRow) * xPoints);
+        keptPoints = static_cast<size_t>((std::min(bufferLastRow, lastRow) - firstRow) * xPoints);
+        std::copy(normalized.begin() + offset * m_Stride, normalized.begin() + (offset + keptPoints) * m_Stride, normalized.begin());
+        std::copy(valid.begin() + offset, valid.begin() + offset + keptPoints, valid.begin());
+      }
+
+      // Every slot is m_Stride values long, so the padding past each pattern stays zero when slots are reused
+      size_t numBuffered = static_cast<size_t>((lastRow - firstRow) * xPoints);
+      normalized.resize(numBuffered * m_Stride, 0.0f);
+      valid.resize(numBuffered, 0);
+      int64_t firstPoint = firstRow * xPoints;
+      for(size_t i = keptPoints; i < numBuffered; i++)
+      {
+        valid[i] = normalizePattern(m_Patterns + (firstPoint + static_cast<int64_t>(i)) * static_cast<int64_t>(m_PatternSize), normalized.data() + i * m_Stride);
+      }
+      bufferFirstRow = firstRow;
+      bufferLastRow = lastRow;
+
+      computeSlab(slabStart, slabEnd, firstRow, normalized, valid);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  /**
+   * @brief computeSlab Averages the similarities of the cells in rows [startRow, endRow). The normalized
+   * patterns and their validity flags start at firstRow and cover both halos of the slab.
+   */
+  void computeSlab(int64_t startRow, int64_t endRow, int64_t firstRow, const std::vector<float>& normalized, const std::vector<uint8_t>& valid) const
+  {
+    int64_t xPoints = m_Dims[0];
+    int64_t yPoints = m_Dims[1];
+    int64_t zPoints = m_Dims[2];
+    int64_t startPoint = startRow * xPoints;
+    int64_t endPoint = endRow * xPoints;
+    int64_t firstPoint = firstRow * xPoints;
+    size_t numOffsets = m_Offsets.size() / 3;
+
+    std::vector<float> totalSimilarity(static_cast<size_t>(endPoint - startPoint), 0.0f);
+    std::vector<int32_t> numNeighbors(static_cast<size_t>(endPoint - startPoint), 0);
+
+    for(int64_t tileStart = 0; tileStart < xPoints; tileStart += m_TileColumns)
+    {
+      int64_t tileEnd = std::min(tileStart + m_TileColumns, xPoints);
+      for(int64_t rowIndex = firstRow; rowIndex < endRow; rowIndex++)
+      {
+        int64_t plane = rowIndex / yPoints;
+        int64_t row = rowIndex % yPoints;
+        for(int64_t col = tileStart; col < tileEnd; col++)
+        {
+          int64_t point = rowIndex * xPoints + col;
+          if(valid[point - firstPoint] == 0)
+          {
+            continue;
+          }
+          bool pointInSlab = (point >= startPoint);
+          const float* pointPattern = normalized.data() + (point - firstPoint) * m_Stride;
+          for(size_t o = 0; o < numOffsets; o++)
+          {
+            int64_t nCol = col + m_Offsets[3 * o];
+            int64_t nRow = row + m_Offsets[3 * o + 1];
+            int64_t nPlane = plane + m_Offsets[3 * o + 2];
+            if(nCol < 0 || nCol > xPoints - 1 || nRow < 0 || nRow > yPoints - 1 || nPlane > zPoints - 1)
+            {
+              continue;
+            }
+            int64_t neighbor = (nPlane * yPoints + nRow) * xPoints + nCol;
+            bool neighborInSlab = (neighbor >= startPoint && neighbor < endPoint);
+            if((!pointInSlab && !neighborInSlab) || valid[neighbor - firstPoint] == 0)
+            {
+              continue;
+            }
+
+            float value = dotProduct(pointPattern, normalized.data() + (neighbor - firstPoint) * m_Stride, m_Stride);
+            if(pointInSlab)
+            {
+              totalSimilarity[point - startPoint] += value;
+              numNeighbors[point - startPoint]++;
+            }
+            if(neighborInSlab)
+            {
+              totalSimilarity[neighbor - startPoint] += value;
+              numNeighbors[neighbor - startPoint]++;
+            }
+          }
+        }
+      }
+    }
+
+    for(int64_t point = startPoint; point < endPoint; point++)
+    {
+      int32_t count = numNeighbors[point - startPoint];
+      m_Similarity[point] = (count == 0) ? 0.0f : totalSimilarity[point - startPoint] / static_cast<float>(count);
+    }
+  }
+
+  /**
+   * @brief normalizePattern Writes the pattern, optionally shifted to zero mean, scaled to unit length into
+   * output. Returns 0 for a pattern without contrast, which has no defined similarity to anything.
+   */
+  uint8_t normalizePattern(const T* pattern, float* output) const
+  {
+    double mean = 0.0;
+    if(m_SubtractMean)
+    {
+      for(size_t i = 0; i < m_PatternSize; i++)
+      {
+        mean += static_cast<double>(pattern[i]);
+      }
+      mean /= static_cast<double>(m_PatternSize);
+    }
+
+    double sumSquares = 0.0;
+    for(size_t i = 0; i < m_PatternSize; i++)
+    {
+      double value = static_cast<double>(pattern[i]) - mean;
+      output[i] = static_cast<float>(value);
+      sumSquares += value * value;
+    }
+    if(sumSquares <= 0.0)
+    {
+      return 0;
+    }
+    float scale = static_cast<float>(1.0 / std::sqrt(sumSquares));
+    for(size_t i = 0; i < m_PatternSize; i++)
+    {
+      output[i] *= scale;
+    }
+    return 1;
+  }
+
+  const T* m_Patterns;
+  size_t m_PatternSize;
+  size_t m_Stride;
+  bool m_SubtractMean;
+  float* m_Similarity;
+  int64_t m_Dims[3];
+  std::vector<int32_t> m_Offsets;
+  int64_t m_HaloRows;
+  int64_t m_SlabRows;
+  int64_t m_TileColumns;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T> void findPatternSimilarity(IDataArray::Pointer inputData, int64_t dims[3], IntVec3_t kernelSize, bool subtractMean, float* similarity)
+{
+  typename DataArray<T>::Pointer patternsPtr = std::dynamic_pointer_cast<DataArray<T>>(inputData);
+  const T* patterns = patternsPtr->getPointer(0);
+  size_t patternSize = static_cast<size_t>(patternsPtr->getNumberOfComponents());
+
+  // Work on whole rows in memory order; a slab of rows is independent of every other slab
+  int64_t totalRows = dims[1] * dims[2];
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    int64_t haloRows = static_cast<int64_t>(kernelSize.z) * dims[1] + kernelSize.y;
+    int64_t grainSize = std::max(haloRows * 4, static_cast<int64_t>(8));
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, totalRows, grainSize), FindNeighborPatternSimilarityImpl<T>(patterns, patternSize, dims, kernelSize, subtractMean, similarity),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindNeighborPatternSimilarityImpl<T> serial(patterns, patternSize, dims, kernelSize, subtractMean, similarity);
+    serial.compute(0, totalRows);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindNeighborPatternSimilarity::FindNeighborPatternSimilarity()
+: m_PatternDataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "PatternData")
+, m_PatternSimilarityArrayName("PatternSimilarity")
+, m_SubtractPatternMean(true)
+, m_PatternSimilarity(nullptr)
+{
+  m_KernelSize.x = 1;
+  m_KernelSize.y = 1;
+  m_KernelSize.z = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindNeighborPatternSimilarity::~FindNeighborPatternSimilarity() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Kernel Radius", KernelSize, FilterParameter::Parameter, FindNeighborPatternSimilarity));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Subtract Pattern Mean", SubtractPatternMean, FilterParameter::Parameter, FindNeighborPatternSimilarity));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Pattern Data", PatternDataArrayPath, FilterParameter::RequiredArray, FindNeighborPatternSimilarity, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Pattern Similarity", PatternSimilarityArrayName, FilterParameter::CreatedArray, FindNeighborPatternSimilarity));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setPatternSimilarityArrayName(reader->readString("PatternSimilarityArrayName", getPatternSimilarityArrayName()));
+  setPatternDataArrayPath(reader->readDataArrayPath("PatternDataArrayPath", getPatternDataArrayPath()));
+  setKernelSize(reader->readIntVec3("KernelSize", getKernelSize()));
+  setSubtractPatternMean(reader->readValue("SubtractPatternMean", getSubtractPatternMean()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::initialize()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::dataCheck()
+{
+  setErrorCondition(0);
+  setWarningCondition(0);
+  DataArrayPath tempPath;
+
+  if(m_KernelSize.x < 0 || m_KernelSize.y < 0 || m_KernelSize.z < 0)
+  {
+    QString ss = QObject::tr("The kernel radius must not be negative");
+    setErrorCondition(-7800);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+  if(m_KernelSize.x == 0 && m_KernelSize.y == 0 && m_KernelSize.z == 0)
+  {
+    QString ss = QObject::tr("At least one component of the kernel radius must be greater than 0");
+    setErrorCondition(-7801);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getPatternDataArrayPath().getDataContainerName());
+
+  m_PatternDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, getPatternDataArrayPath());
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
+  if(m_PatternDataPtr.lock()->getNumberOfComponents() < 2)
+  {
+    QString ss = QObject::tr("The pattern data must hold a complete pattern, with more than one component, for every cell");
+    setErrorCondition(-7802);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  QVector<size_t> cDims(1, 1);
+  tempPath.update(getPatternDataArrayPath().getDataContainerName(), getPatternDataArrayPath().getAttributeMatrixName(), getPatternSimilarityArrayName());
+  m_PatternSimilarityPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(
+      this, tempPath, 0, cDims);                   /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_PatternSimilarityPtr.lock())     /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_PatternSimilarity = m_PatternSimilarityPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighborPatternSimilarity::execute()
+{
+  setErrorCondition(0);
+  setWarningCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_PatternDataArrayPath.getDataContainerName());
+  size_t udims[3] = {0, 0, 0};
+  std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+  int64_t dims[3] = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+
+  // The patterns may be stored as any primitive type; they are converted to float while being normalized
+  EXECUTE_FUNCTION_TEMPLATE(this, findPatternSimilarity, m_PatternDataPtr.lock(), m_PatternDataPtr.lock(), dims, m_KernelSize, m_SubtractPatternMean, m_PatternSimilarity);
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer FindNeighborPatternSimilarity::newFilterInstance(bool copyFilterParameters) const
+{
+  FindNeighborPatternSimilarity::Pointer filter = FindNeighborPatternSimilarity::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindNeighborPatternSimilarity::getCompiledLibraryName() const
+{
+  return OrientationAnalysisConstants::OrientationAnalysisBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindNeighborPatternSimilarity::getBrandingString() const
+{
+  return "OrientationAnalysis";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindNeighborPatternSimilarity::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << OrientationAnalysis::Version::Major() << "." << OrientationAnalysis::Version::Minor() << "." << OrientationAnalysis::Version::Patch();
+  return version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindNeighborPatternSimilarity::getGroupName() const
+{
+  return SIMPL::FilterGroups::StatisticsFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QUuid FindNeighborPatternSimilarity::getUuid()
+{
+  return QUuid("{e600a26f-ee4f-4e2d-8eb6-3560e17a874b}");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindNeighborPatternSimilarity::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::CrystallographyFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindNeighborPatternSimilarity::getHumanLabel() const
+{
+  return "Find Neighbor Pattern Similarity";
+}
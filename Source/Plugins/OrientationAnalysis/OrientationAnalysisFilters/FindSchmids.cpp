@@ -35,6 +35,13 @@
 
 #include "FindSchmids.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -50,6 +57,108 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The FindSchmidsImpl class implements a threaded algorithm that rotates the loading direction into the
+ * crystal frame of each feature and evaluates the Schmid factors of consecutive features that share a Laue
+ * class with one call to LaueOps::getSchmidFactorsAndSS().
+ */
+class FindSchmidsImpl
+{
+  QuatF* m_AvgQuats;
+  int32_t* m_FeaturePhases;
+  uint32_t* m_CrystalStructures;
+  float* m_SampleLoading;
+  float* m_Plane;
+  float* m_Direction;
+  bool m_OverrideSystem;
+  float* m_Schmids;
+  float* m_Phis;
+  float* m_Lambdas;
+  int32_t* m_Poles;
+  int32_t* m_SlipSystems;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+
+public:
+  FindSchmidsImpl(QuatF* avgQuats, int32_t* featurePhases, uint32_t* crystalStructures, float* sampleLoading, float* plane, float* direction, bool overrideSystem, float* schmids, float* phis,
+                  float* lambdas, int32_t* poles, int32_t* slipSystems)
+  : m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_SampleLoading(sampleLoading)
+  , m_Plane(plane)
+  , m_Direction(direction)
+  , m_OverrideSystem(overrideSystem)
+  , m_Schmids(schmids)
+  , m_Phis(phis)
+  , m_Lambdas(lambdas)
+  , m_Poles(poles)
+  , m_SlipSystems(slipSystems)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+  virtual ~FindSchmidsImpl()
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    size_t count = end - start;
+    std::vector<float> crystalLoading(3 * count, 0.0f);
+    std::vector<float> angleComps(2 * count, 0.0f);
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    FOrientArrayType om(9);
+    for(size_t i = start; i < end; i++)
+    {
+      FOrientTransformsType::qu2om(FOrientArrayType(m_AvgQuats[i]), om);
+      om.toGMatrix(g);
+      MatrixMath::Multiply3x3with3x1(g, m_SampleLoading, crystalLoading.data() + 3 * (i - start));
+    }
+
+    size_t i = start;
+    while(i < end)
+    {
+      uint32_t xtal = m_CrystalStructures[m_FeaturePhases[i]];
+      size_t runEnd = i + 1;
+      while(runEnd < end && m_CrystalStructures[m_FeaturePhases[runEnd]] == xtal)
+      {
+        runEnd++;
+      }
+      if(xtal < Ebsd::CrystalStructure::LaueGroupEnd)
+      {
+        float* loads = crystalLoading.data() + 3 * (i - start);
+        float* angles = angleComps.data() + 2 * (i - start);
+        if(!m_OverrideSystem)
+        {
+          m_OrientationOps[xtal]->getSchmidFactorsAndSS(loads, runEnd - i, m_Schmids + i, angles, m_SlipSystems + i);
+        }
+        else
+        {
+          m_OrientationOps[xtal]->getSchmidFactorsAndSS(loads, runEnd - i, m_Plane, m_Direction, m_Schmids + i, angles, m_SlipSystems + i);
+        }
+        for(size_t k = i; k < runEnd; k++)
+        {
+          if(nullptr != m_Phis)
+          {
+            m_Phis[k] = angles[2 * (k - i)];
+            m_Lambdas[k] = angles[2 * (k - i) + 1];
+          }
+          m_Poles[3 * k] = int32_t(loads[3 * (k - i)] * 100);
+          m_Poles[3 * k + 1] = int32_t(loads[3 * (k - i) + 1] * 100);
+          m_Poles[3 * k + 2] = int32_t(loads[3 * (k - i) + 2] * 100);
+        }
+      }
+      i = runEnd;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -295,18 +404,16 @@ void FindSchmids::execute()
     return;
   }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
   size_t totalFeatures = m_SchmidsPtr.lock()->getNumberOfTuples();
 
-  int32_t ss = 0;
-  QuatF q1 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float sampleLoading[3] = {0.0f, 0.0f, 0.0f};
-  float crystalLoading[3] = {0.0f, 0.0f, 0.0f};
-  float angleComps[2] = {0.0f, 0.0f};
-  float schmid = 0.0f;
-
   sampleLoading[0] = m_LoadingDirection.x;
   sampleLoading[1] = m_LoadingDirection.y;
   sampleLoading[2] = m_LoadingDirection.z;
@@ -327,38 +434,21 @@ void FindSchmids::execute()
     MatrixMath::Normalize3x1(direction);
   }
 
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    FOrientArrayType om(9);
-    FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-    om.toGMatrix(g);
-
-    MatrixMath::Multiply3x3with3x1(g, sampleLoading, crystalLoading);
-
-    uint32_t xtal = m_CrystalStructures[m_FeaturePhases[i]];
-    if(xtal < Ebsd::CrystalStructure::LaueGroupEnd)
-    {
-      if(!m_OverrideSystem)
-      {
-        m_OrientationOps[xtal]->getSchmidFactorAndSS(crystalLoading, schmid, angleComps, ss);
-      }
-      else
-      {
-        m_OrientationOps[xtal]->getSchmidFactorAndSS(crystalLoading, plane, direction, schmid, angleComps, ss);
-      }
+  float* phis = m_StoreAngleComponents ? m_Phis : nullptr;
+  float* lambdas = m_StoreAngleComponents ? m_Lambdas : nullptr;
 
-      m_Schmids[i] = schmid;
-      if(m_StoreAngleComponents == true)
-      {
-        m_Phis[i] = angleComps[0];
-        m_Lambdas[i] = angleComps[1];
-      }
-      m_Poles[3 * i] = int32_t(crystalLoading[0] * 100);
-      m_Poles[3 * i + 1] = int32_t(crystalLoading[1] * 100);
-      m_Poles[3 * i + 2] = int32_t(crystalLoading[2] * 100);
-      m_SlipSystems[i] = ss;
-    }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures),
+                      FindSchmidsImpl(avgQuats, m_FeaturePhases, m_CrystalStructures, sampleLoading, plane, direction, m_OverrideSystem, m_Schmids, phis, lambdas, m_Poles, m_SlipSystems),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindSchmidsImpl serial(avgQuats, m_FeaturePhases, m_CrystalStructures, sampleLoading, plane, direction, m_OverrideSystem, m_Schmids, phis, lambdas, m_Poles, m_SlipSystems);
+    serial.compute(1, totalFeatures);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
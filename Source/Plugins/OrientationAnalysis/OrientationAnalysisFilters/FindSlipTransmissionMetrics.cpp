@@ -35,6 +35,13 @@
 
 #include "FindSlipTransmissionMetrics.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -44,6 +51,100 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+/**
+ * @brief The FindSlipTransmissionMetricsImpl class implements a threaded algorithm that evaluates the slip
+ * transmission metrics between every feature and its neighbors. All neighbors of a feature that share its
+ * crystal structure are handed to LaueOps::getSlipTransmissionMetrics() as one batch.
+ */
+class FindSlipTransmissionMetricsImpl
+{
+  NeighborList<int32_t>& m_NeighborList;
+  QuatF* m_AvgQuats;
+  int32_t* m_FeaturePhases;
+  uint32_t* m_CrystalStructures;
+  std::vector<std::vector<float>>& m_F1Lists;
+  std::vector<std::vector<float>>& m_F1sptLists;
+  std::vector<std::vector<float>>& m_F7Lists;
+  std::vector<std::vector<float>>& m_mPrimeLists;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+
+public:
+  FindSlipTransmissionMetricsImpl(NeighborList<int32_t>& neighborList, QuatF* avgQuats, int32_t* featurePhases, uint32_t* crystalStructures, std::vector<std::vector<float>>& f1Lists,
+                                  std::vector<std::vector<float>>& f1sptLists, std::vector<std::vector<float>>& f7Lists, std::vector<std::vector<float>>& mPrimeLists)
+  : m_NeighborList(neighborList)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_F1Lists(f1Lists)
+  , m_F1sptLists(f1sptLists)
+  , m_F7Lists(f7Lists)
+  , m_mPrimeLists(mPrimeLists)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+  virtual ~FindSlipTransmissionMetricsImpl()
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    float LD[3] = {0.0f, 0.0f, 1.0f};
+    std::vector<int32_t> pairs;
+    std::vector<size_t> slots;
+    std::vector<float> mPrime, F1, F1spt, F7;
+
+    for(size_t i = start; i < end; i++)
+    {
+      std::vector<int32_t>& neighbors = m_NeighborList[i];
+      size_t numNeighbors = neighbors.size();
+      m_F1Lists[i].assign(numNeighbors, 0.0f);
+      m_F1sptLists[i].assign(numNeighbors, 0.0f);
+      m_F7Lists[i].assign(numNeighbors, 0.0f);
+      m_mPrimeLists[i].assign(numNeighbors, 0.0f);
+      if(m_FeaturePhases[i] <= 0)
+      {
+        continue;
+      }
+
+      uint32_t xtal = m_CrystalStructures[m_FeaturePhases[i]];
+      pairs.clear();
+      slots.clear();
+      for(size_t j = 0; j < numNeighbors; j++)
+      {
+        if(m_CrystalStructures[m_FeaturePhases[neighbors[j]]] == xtal)
+        {
+          pairs.push_back(neighbors[j]);
+          slots.push_back(j);
+        }
+      }
+      if(pairs.empty())
+      {
+        continue;
+      }
+
+      mPrime.resize(pairs.size());
+      F1.resize(pairs.size());
+      F1spt.resize(pairs.size());
+      F7.resize(pairs.size());
+      m_OrientationOps[xtal]->getSlipTransmissionMetrics(m_AvgQuats[i], m_AvgQuats, pairs.data(), pairs.size(), LD, true, mPrime.data(), F1.data(), F1spt.data(), F7.data());
+      for(size_t k = 0; k < slots.size(); k++)
+      {
+        m_mPrimeLists[i][slots[k]] = mPrime[k];
+        m_F1Lists[i][slots[k]] = F1[k];
+        m_F1sptLists[i][slots[k]] = F1spt[k];
+        m_F7Lists[i][slots[k]] = F7[k];
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -232,6 +333,11 @@ void FindSlipTransmissionMetrics::execute()
     return;
   }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
   // But since a pointer is difficult to use operators with we will now create a
@@ -239,54 +345,24 @@ void FindSlipTransmissionMetrics::execute()
   // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
 
-  std::vector<std::vector<float>> F1lists;
-  std::vector<std::vector<float>> F1sptlists;
-  std::vector<std::vector<float>> F7lists;
-  std::vector<std::vector<float>> mPrimelists;
+  std::vector<std::vector<float>> F1lists(totalFeatures);
+  std::vector<std::vector<float>> F1sptlists(totalFeatures);
+  std::vector<std::vector<float>> F7lists(totalFeatures);
+  std::vector<std::vector<float>> mPrimelists(totalFeatures);
 
-  float mprime = 0.0f, F1 = 0.0f, F1spt = 0.0f, F7 = 0.0f;
-  int32_t nname;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  float LD[3] = {0.0f, 0.0f, 1.0f};
-
-  F1lists.resize(totalFeatures);
-  F1sptlists.resize(totalFeatures);
-  F7lists.resize(totalFeatures);
-  mPrimelists.resize(totalFeatures);
-
-  for(size_t i = 1; i < totalFeatures; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    F1lists[i].assign(neighborlist[i].size(), 0.0f);
-    F1sptlists[i].assign(neighborlist[i].size(), 0.0f);
-    F7lists[i].assign(neighborlist[i].size(), 0.0f);
-    mPrimelists[i].assign(neighborlist[i].size(), 0.0f);
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
-    {
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[i], q1);
-      QuaternionMathF::Copy(avgQuats[nname], q1);
-      if(m_CrystalStructures[m_FeaturePhases[i]] == m_CrystalStructures[m_FeaturePhases[nname]] && m_FeaturePhases[i] > 0)
-      {
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getmPrime(q1, q2, LD, mprime);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1(q1, q2, LD, true, F1);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF1spt(q1, q2, LD, true, F1spt);
-        m_OrientationOps[m_CrystalStructures[m_FeaturePhases[i]]]->getF7(q1, q2, LD, true, F7);
-      }
-      else
-      {
-        mprime = 0.0f;
-        F1 = 0.0f;
-        F1spt = 0.0f;
-        F7 = 0.0f;
-      }
-      mPrimelists[i][j] = mprime;
-      F1lists[i][j] = F1;
-      F1sptlists[i][j] = F1spt;
-      F7lists[i][j] = F7;
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures),
+                      FindSlipTransmissionMetricsImpl(neighborlist, avgQuats, m_FeaturePhases, m_CrystalStructures, F1lists, F1sptlists, F7lists, mPrimelists), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindSlipTransmissionMetricsImpl serial(neighborlist, avgQuats, m_FeaturePhases, m_CrystalStructures, F1lists, F1sptlists, F7lists, mPrimelists);
+    serial.compute(1, totalFeatures);
   }
 
   for(size_t i = 1; i < totalFeatures; i++)
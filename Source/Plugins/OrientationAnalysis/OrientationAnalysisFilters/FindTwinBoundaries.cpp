@@ -35,6 +35,9 @@
 
 #include "FindTwinBoundaries.h"
 
+#include <unordered_map>
+#include <vector>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -59,34 +62,34 @@
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 /**
- * @brief The CalculateTwinBoundaryImpl class implements a threaded algorithm that determines whether a boundary is twin related and calculates
- * the reseptive incoherence.  The calculations are performed on a surface mesh.
+ * @brief The CalculateTwinBoundaryImpl class implements a threaded algorithm that determines whether the two features
+ * of a unique feature pair are twin related. When the coherence is requested it also stores, for every symmetric variant
+ * that satisfies the twin relation, the twin axis expressed in the sample frame, so that the incoherence of any face
+ * between the two features only requires the angle between that axis and the face normal.
  */
 class CalculateTwinBoundaryImpl
 {
   float m_AxisTol;
   float m_AngTol;
-  int32_t* m_Labels;
-  double* m_Normals;
+  const int32_t* m_FeaturePairs;
   int32_t* m_Phases;
   float* m_Quats;
-  bool* m_TwinBoundary;
-  float* m_TwinBoundaryIncoherence;
+  uint8_t* m_PairIsTwin;
+  std::vector<std::vector<float>>* m_PairTwinAxes;
   uint32_t* m_CrystalStructures;
   bool m_FindCoherence;
   QVector<LaueOps::Pointer> m_OrientationOps;
 
 public:
-  CalculateTwinBoundaryImpl(float angtol, float axistol, int32_t* Labels, double* Normals, float* Quats, int32_t* Phases, unsigned int* CrystalStructures, bool* TwinBoundary,
-                            float* TwinBoundaryIncoherence, bool FindCoherence)
+  CalculateTwinBoundaryImpl(float angtol, float axistol, const int32_t* FeaturePairs, float* Quats, int32_t* Phases, unsigned int* CrystalStructures, uint8_t* PairIsTwin,
+                            std::vector<std::vector<float>>* PairTwinAxes, bool FindCoherence)
   : m_AxisTol(axistol)
   , m_AngTol(angtol)
-  , m_Labels(Labels)
-  , m_Normals(Normals)
+  , m_FeaturePairs(FeaturePairs)
   , m_Phases(Phases)
   , m_Quats(Quats)
-  , m_TwinBoundary(TwinBoundary)
-  , m_TwinBoundaryIncoherence(TwinBoundaryIncoherence)
+  , m_PairIsTwin(PairIsTwin)
+  , m_PairTwinAxes(PairTwinAxes)
   , m_CrystalStructures(CrystalStructures)
   , m_FindCoherence(FindCoherence)
   {
@@ -100,102 +103,89 @@ public:
   void generate(size_t start, size_t end) const
   {
     int32_t feature1 = 0, feature2 = 0;
-    float normal[3] = {0.0f, 0.0f, 0.0f};
-    float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float g1t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
     float w = 0.0f;
     uint32_t phase1 = 0, phase2 = 0;
     QuatF q1 = QuaternionMathF::New();
     QuatF q2 = QuaternionMathF::New();
     float axisdiff111 = 0.0f, angdiff60 = 0.0f;
     float n[3] = {0.0f, 0.0f, 0.0f};
-    float incoherence = 0.0f;
     float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
 
     QuatF misq = QuaternionMathF::New();
     QuatF sym_q = QuaternionMathF::New();
     QuatF s1_misq = QuaternionMathF::New();
     QuatF s2_misq = QuaternionMathF::New();
+    QuatF sym_k = QuaternionMathF::New();
+    QuatF sym_j_inv = QuaternionMathF::New();
     QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
-    float xstl_norm[3] = {0.0f, 0.0f, 0.0f};
-    float s_xstl_norm[3] = {0.0f, 0.0f, 0.0f};
+    float xstl_axis[3] = {0.0f, 0.0f, 0.0f};
+    float sample_axis[3] = {0.0f, 0.0f, 0.0f};
 
     for(size_t i = start; i < end; i++)
     {
-      feature1 = m_Labels[2 * i];
-      feature2 = m_Labels[2 * i + 1];
-      if(m_FindCoherence)
-      {
-        normal[0] = m_Normals[3 * i];
-        normal[1] = m_Normals[3 * i + 1];
-        normal[2] = m_Normals[3 * i + 2];
-      }
-      if(feature1 > 0 && feature2 > 0 && m_Phases[feature1] == m_Phases[feature2])
-      {
-        w = std::numeric_limits<float>::max();
+      feature1 = m_FeaturePairs[2 * i];
+      feature2 = m_FeaturePairs[2 * i + 1];
+      w = std::numeric_limits<float>::max();
 
-        QuaternionMathF::Copy(quats[feature1], q1);
-        QuaternionMathF::Copy(quats[feature2], q2);
+      QuaternionMathF::Copy(quats[feature1], q1);
+      QuaternionMathF::Copy(quats[feature2], q2);
 
-        phase1 = m_CrystalStructures[m_Phases[feature1]];
-        phase2 = m_CrystalStructures[m_Phases[feature2]];
-        if(phase1 == phase2)
+      phase1 = m_CrystalStructures[m_Phases[feature1]];
+      phase2 = m_CrystalStructures[m_Phases[feature2]];
+      if(phase1 == phase2)
+      {
+        int32_t nsym = m_OrientationOps[phase1]->getNumSymOps();
+        QuaternionMathF::Conjugate(q2);
+        QuaternionMathF::Multiply(q1, q2, misq);
+        if(m_FindCoherence)
         {
-          int32_t nsym = m_OrientationOps[phase1]->getNumSymOps();
-          QuaternionMathF::Conjugate(q2);
-          QuaternionMathF::Multiply(q1, q2, misq);
           FOrientArrayType om(9);
           FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
           om.toGMatrix(g1);
+          MatrixMath::Transpose3x3(g1, g1t);
+        }
 
-          if(m_FindCoherence)
-          {
-            MatrixMath::Multiply3x3with3x1(g1, normal, xstl_norm);
-          }
+        for(int32_t j = 0; j < nsym; j++)
+        {
+          m_OrientationOps[phase1]->getQuatSymOp(j, sym_q);
+          QuaternionMathF::Multiply(misq, sym_q, s1_misq);
 
-          for(int32_t j = 0; j < nsym; j++)
+          for(int32_t k = 0; k < nsym; k++)
           {
-            m_OrientationOps[phase1]->getQuatSymOp(j, sym_q);
-            // calculate crystal direction parallel to normal
-            QuaternionMathF::Multiply(misq, sym_q, s1_misq);
-
-            if(m_FindCoherence)
+            // calculate the symmetric misorienation
+            m_OrientationOps[phase1]->getQuatSymOp(k, sym_k);
+            QuaternionMathF::Conjugate(sym_k);
+            QuaternionMathF::Multiply(sym_k, s1_misq, s2_misq);
+
+            FOrientArrayType ax(n1, n2, n3, w);
+            FOrientTransformsType::qu2ax(FOrientArrayType(s2_misq), ax);
+            ax.toAxisAngle(n1, n2, n3, w);
+
+            w = w * 180.0f / SIMPLib::Constants::k_Pi;
+            axisdiff111 = acosf(fabsf(n1) * 0.57735f + fabsf(n2) * 0.57735f + fabsf(n3) * 0.57735f);
+            angdiff60 = fabsf(w - 60.0f);
+            if(axisdiff111 < m_AxisTol && angdiff60 < m_AngTol)
             {
-              QuaternionMathF::MultiplyQuatVec(sym_q, xstl_norm, s_xstl_norm);
-            }
-
-            for(int32_t k = 0; k < nsym; k++)
-            {
-              // calculate the symmetric misorienation
-              m_OrientationOps[phase1]->getQuatSymOp(k, sym_q);
-              QuaternionMathF::Conjugate(sym_q);
-              QuaternionMathF::Multiply(sym_q, s1_misq, s2_misq);
-
-              FOrientArrayType ax(n1, n2, n3, w);
-              FOrientTransformsType::qu2ax(FOrientArrayType(s2_misq), ax);
-              ax.toAxisAngle(n1, n2, n3, w);
-
-              w = w * 180.0f / SIMPLib::Constants::k_Pi;
-              axisdiff111 = acosf(fabsf(n1) * 0.57735f + fabsf(n2) * 0.57735f + fabsf(n3) * 0.57735f);
-              angdiff60 = fabsf(w - 60.0f);
-              if(axisdiff111 < m_AxisTol && angdiff60 < m_AngTol)
+              m_PairIsTwin[i] = 1;
+              if(m_FindCoherence)
               {
+                // The incoherence is the angle between the twin axis and the crystal direction parallel to the face
+                // normal, rotated by symmetry operator j. Rotating the axis back through the inverse of operator j and
+                // the orientation of the first feature gives the same angle against the normal in the sample frame.
                 n[0] = n1;
                 n[1] = n2;
                 n[2] = n3;
-                m_TwinBoundary[i] = true;
-                if(m_FindCoherence)
-                {
-                  incoherence = 180.0f * acosf(GeometryMath::CosThetaBetweenVectors(n, s_xstl_norm)) / SIMPLib::Constants::k_Pi;
-                  if(incoherence > 90.0f)
-                  {
-                    incoherence = 180.0f - incoherence;
-                  }
-                  if(incoherence < m_TwinBoundaryIncoherence[i])
-                  {
-                    m_TwinBoundaryIncoherence[i] = incoherence;
-                  }
-                }
+                QuaternionMathF::Copy(sym_q, sym_j_inv);
+                QuaternionMathF::Conjugate(sym_j_inv);
+                QuaternionMathF::MultiplyQuatVec(sym_j_inv, n, xstl_axis);
+                MatrixMath::Multiply3x3with3x1(g1t, xstl_axis, sample_axis);
+                std::vector<float>& axes = (*m_PairTwinAxes)[i];
+                axes.push_back(sample_axis[0]);
+                axes.push_back(sample_axis[1]);
+                axes.push_back(sample_axis[2]);
               }
             }
           }
@@ -212,6 +202,84 @@ public:
 #endif
 };
 
+/**
+ * @brief The TwinBoundaryFaceImpl class implements a threaded algorithm that gathers the twin classification of each
+ * surface mesh face from the feature pair table and computes the incoherence of the twin boundary faces.
+ */
+class TwinBoundaryFaceImpl
+{
+  const int32_t* m_FacePairIndex;
+  const uint8_t* m_PairIsTwin;
+  const std::vector<std::vector<float>>* m_PairTwinAxes;
+  double* m_Normals;
+  bool* m_TwinBoundary;
+  float* m_TwinBoundaryIncoherence;
+  bool m_FindCoherence;
+
+public:
+  TwinBoundaryFaceImpl(const int32_t* FacePairIndex, const uint8_t* PairIsTwin, const std::vector<std::vector<float>>* PairTwinAxes, double* Normals, bool* TwinBoundary,
+                       float* TwinBoundaryIncoherence, bool FindCoherence)
+  : m_FacePairIndex(FacePairIndex)
+  , m_PairIsTwin(PairIsTwin)
+  , m_PairTwinAxes(PairTwinAxes)
+  , m_Normals(Normals)
+  , m_TwinBoundary(TwinBoundary)
+  , m_TwinBoundaryIncoherence(TwinBoundaryIncoherence)
+  , m_FindCoherence(FindCoherence)
+  {
+  }
+
+  virtual ~TwinBoundaryFaceImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    float axis[3] = {0.0f, 0.0f, 0.0f};
+    float incoherence = 0.0f;
+
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t pair = m_FacePairIndex[i];
+      if(pair < 0 || m_PairIsTwin[pair] == 0)
+      {
+        continue;
+      }
+      m_TwinBoundary[i] = true;
+      if(m_FindCoherence)
+      {
+        normal[0] = static_cast<float>(m_Normals[3 * i]);
+        normal[1] = static_cast<float>(m_Normals[3 * i + 1]);
+        normal[2] = static_cast<float>(m_Normals[3 * i + 2]);
+        const std::vector<float>& axes = (*m_PairTwinAxes)[pair];
+        for(size_t a = 0; a < axes.size(); a += 3)
+        {
+          axis[0] = axes[a];
+          axis[1] = axes[a + 1];
+          axis[2] = axes[a + 2];
+          incoherence = 180.0f * acosf(GeometryMath::CosThetaBetweenVectors(axis, normal)) / SIMPLib::Constants::k_Pi;
+          if(incoherence > 90.0f)
+          {
+            incoherence = 180.0f - incoherence;
+          }
+          if(incoherence < m_TwinBoundaryIncoherence[i])
+          {
+            m_TwinBoundaryIncoherence[i] = incoherence;
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -452,19 +520,54 @@ void FindTwinBoundaries::execute()
   float angtol = m_AngleTolerance;
   float axistol = static_cast<float>(m_AxisTolerance * M_PI / 180.0f);
 
+  // Many faces separate the same two features, so the twin relation is evaluated once per unique (ordered) feature
+  // pair and the faces only look their pair up afterwards
+  std::vector<int32_t> facePairIndex(numTriangles, -1);
+  std::vector<int32_t> featurePairs;
+  {
+    std::unordered_map<uint64_t, int32_t> pairIndices;
+    for(size_t i = 0; i < numTriangles; i++)
+    {
+      int32_t feature1 = m_SurfaceMeshFaceLabels[2 * i];
+      int32_t feature2 = m_SurfaceMeshFaceLabels[2 * i + 1];
+      if(feature1 <= 0 || feature2 <= 0 || m_FeaturePhases[feature1] != m_FeaturePhases[feature2])
+      {
+        continue;
+      }
+      uint64_t key = (static_cast<uint64_t>(feature1) << 32) | static_cast<uint32_t>(feature2);
+      auto inserted = pairIndices.insert(std::make_pair(key, static_cast<int32_t>(featurePairs.size() / 2)));
+      if(inserted.second)
+      {
+        featurePairs.push_back(feature1);
+        featurePairs.push_back(feature2);
+      }
+      facePairIndex[i] = inserted.first->second;
+    }
+  }
+  size_t numPairs = featurePairs.size() / 2;
+
+  std::vector<uint8_t> pairIsTwin(numPairs, 0);
+  std::vector<std::vector<float>> pairTwinAxes(m_FindCoherence ? numPairs : 0);
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), CalculateTwinBoundaryImpl(angtol, axistol, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_FeaturePhases,
-                                                                                             m_CrystalStructures, m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundaryIncoherence, m_FindCoherence),
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPairs),
+                      CalculateTwinBoundaryImpl(angtol, axistol, featurePairs.data(), m_AvgQuats, m_FeaturePhases, m_CrystalStructures, pairIsTwin.data(), &pairTwinAxes, m_FindCoherence),
+                      tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
+                      TwinBoundaryFaceImpl(facePairIndex.data(), pairIsTwin.data(), &pairTwinAxes, m_SurfaceMeshFaceNormals, m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundaryIncoherence,
+                                           m_FindCoherence),
                       tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateTwinBoundaryImpl serial(angtol, axistol, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceMeshTwinBoundary,
-                                     m_SurfaceMeshTwinBoundaryIncoherence, m_FindCoherence);
-    serial.generate(0, numTriangles);
+    CalculateTwinBoundaryImpl serial(angtol, axistol, featurePairs.data(), m_AvgQuats, m_FeaturePhases, m_CrystalStructures, pairIsTwin.data(), &pairTwinAxes, m_FindCoherence);
+    serial.generate(0, numPairs);
+    TwinBoundaryFaceImpl faceSerial(facePairIndex.data(), pairIsTwin.data(), &pairTwinAxes, m_SurfaceMeshFaceNormals, m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundaryIncoherence,
+                                    m_FindCoherence);
+    faceSerial.generate(0, numTriangles);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -35,7 +35,9 @@
 
 #include "FindTwinBoundarySchmidFactors.h"
 
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
@@ -61,6 +63,81 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+namespace
+{
+// The four {111} twin planes in the upper hemisphere, indexed by the signs of the x and y components of
+// the boundary normal, and the three <110> shear directions that lie in each of them.
+const float k_TwinPlanes[4][3] = {{1.0f, 1.0f, 1.0f}, {1.0f, -1.0f, 1.0f}, {-1.0f, 1.0f, 1.0f}, {-1.0f, -1.0f, 1.0f}};
+const float k_TwinDirections[4][3][3] = {{{1.0f, -1.0f, 0.0f}, {-1.0f, 0.0f, 1.0f}, {0.0f, -1.0f, 1.0f}},
+                                         {{1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 1.0f}, {-1.0f, 0.0f, 1.0f}},
+                                         {{1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 1.0f}, {0.0f, -1.0f, 1.0f}},
+                                         {{1.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 1.0f}, {1.0f, -1.0f, 0.0f}}};
+const size_t k_NumTwinSchmidFactors = 12;
+}
+
+/**
+ * @brief The CalculateFeatureTwinSchmidFactorsImpl class implements a threaded algorithm that computes, once
+ * per feature, the orientation matrix and the Schmid factors of all twin systems for the loading direction,
+ * so the boundary faces only have to pick the plane their normal belongs to.
+ */
+class CalculateFeatureTwinSchmidFactorsImpl
+{
+  float* m_Quats;
+  float* m_LoadDir;
+  float* m_FeatureMatrices;
+  float* m_FeatureSchmidFactors;
+
+public:
+  CalculateFeatureTwinSchmidFactorsImpl(float* LoadingDir, float* Quats, float* FeatureMatrices, float* FeatureSchmidFactors)
+  : m_Quats(Quats)
+  , m_LoadDir(LoadingDir)
+  , m_FeatureMatrices(FeatureMatrices)
+  , m_FeatureSchmidFactors(FeatureSchmidFactors)
+  {
+  }
+  virtual ~CalculateFeatureTwinSchmidFactorsImpl()
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+    float crystalLoading[3] = {0.0f, 0.0f, 0.0f};
+    float n[3] = {0.0f, 0.0f, 0.0f};
+    float b[3] = {0.0f, 0.0f, 0.0f};
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    FOrientArrayType om(9);
+
+    for(size_t i = start; i < end; i++)
+    {
+      FOrientTransformsType::qu2om(FOrientArrayType(quats[i]), om);
+      om.toGMatrix(g);
+      ::memcpy(m_FeatureMatrices + 9 * i, &g[0][0], 9 * sizeof(float));
+      // calculate crystal direction parallel to loading direction
+      MatrixMath::Multiply3x3with3x1(g, m_LoadDir, crystalLoading);
+
+      for(size_t p = 0; p < 4; p++)
+      {
+        n[0] = k_TwinPlanes[p][0], n[1] = k_TwinPlanes[p][1], n[2] = k_TwinPlanes[p][2];
+        float cosPhi = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, n));
+        for(size_t d = 0; d < 3; d++)
+        {
+          b[0] = k_TwinDirections[p][d][0], b[1] = k_TwinDirections[p][d][1], b[2] = k_TwinDirections[p][d][2];
+          float cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
+          m_FeatureSchmidFactors[k_NumTwinSchmidFactors * i + 3 * p + d] = cosPhi * cosLambda;
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 /**
  * @brief The CalculateTwinBoundarySchmidFactorsImpl class implements a threaded algorithm that computes the
  * Schmid factors across twin boundaries.
@@ -69,22 +146,20 @@ class CalculateTwinBoundarySchmidFactorsImpl
 {
   int32_t* m_Labels;
   double* m_Normals;
-  float* m_Quats;
   bool* m_TwinBoundary;
   float* m_TwinBoundarySchmidFactors;
-  float* m_LoadDir;
-  QVector<LaueOps::Pointer> m_OrientationOps;
+  float* m_FeatureMatrices;
+  float* m_FeatureSchmidFactors;
 
 public:
-  CalculateTwinBoundarySchmidFactorsImpl(float* LoadingDir, int32_t* Labels, double* Normals, float* Quats, bool* TwinBoundary, float* TwinBoundarySchmidFactors)
+  CalculateTwinBoundarySchmidFactorsImpl(int32_t* Labels, double* Normals, bool* TwinBoundary, float* TwinBoundarySchmidFactors, float* FeatureMatrices, float* FeatureSchmidFactors)
   : m_Labels(Labels)
   , m_Normals(Normals)
-  , m_Quats(Quats)
   , m_TwinBoundary(TwinBoundary)
   , m_TwinBoundarySchmidFactors(TwinBoundarySchmidFactors)
-  , m_LoadDir(LoadingDir)
+  , m_FeatureMatrices(FeatureMatrices)
+  , m_FeatureSchmidFactors(FeatureSchmidFactors)
   {
-    m_OrientationOps = LaueOps::getOrientationOpsQVector();
   }
   virtual ~CalculateTwinBoundarySchmidFactorsImpl()
   {
@@ -93,16 +168,7 @@ public:
   void generate(size_t start, size_t end) const
   {
     int32_t feature1 = 0, feature2 = 0, feature = 0;
-    float normal[3] = {0.0f, 0.0f, 0.0f};
-    float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-    float schmid1 = 0.0f, schmid2 = 0.0f, schmid3 = 0.0f;
-    QuatF q1 = QuaternionMathF::New();
-    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
     float n[3] = {0.0f, 0.0f, 0.0f};
-    float b[3] = {0.0f, 0.0f, 0.0f};
-    float crystalLoading[3] = {0.0f, 0.0f, 0.0f};
-    float cosPhi = 0.0f, cosLambda = 0.0f;
 
     for(size_t i = start; i < end; i++)
     {
@@ -110,10 +176,6 @@ public:
       {
         feature1 = m_Labels[2 * i];
         feature2 = m_Labels[2 * i + 1];
-        normal[0] = m_Normals[3 * i];
-        normal[1] = m_Normals[3 * i + 1];
-        normal[2] = m_Normals[3 * i + 2];
-        schmid1 = 0.0f, schmid2 = 0.0f, schmid3 = 0.0f;
         if(feature1 > feature2)
         {
           feature = feature1;
@@ -123,86 +185,39 @@ public:
           feature = feature2;
         }
 
-        QuaternionMathF::Copy(quats[feature], q1);
         // calculate crystal direction parallel to normal
-        FOrientArrayType om(9);
-        FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-        om.toGMatrix(g1);
-        MatrixMath::Multiply3x3with3x1(g1, normal, n);
-        // calculate crystal direction parallel to loading direction
-        MatrixMath::Multiply3x3with3x1(g1, m_LoadDir, crystalLoading);
-
+        const float* g = m_FeatureMatrices + 9 * feature;
+        n[0] = static_cast<float>(g[0] * m_Normals[3 * i] + g[1] * m_Normals[3 * i + 1] + g[2] * m_Normals[3 * i + 2]);
+        n[1] = static_cast<float>(g[3] * m_Normals[3 * i] + g[4] * m_Normals[3 * i + 1] + g[5] * m_Normals[3 * i + 2]);
+        n[2] = static_cast<float>(g[6] * m_Normals[3 * i] + g[7] * m_Normals[3 * i + 1] + g[8] * m_Normals[3 * i + 2]);
         if(n[2] < 0.0f)
         {
-          n[0] = -n[0], n[1] = -n[1], n[2] = -n[2];
+          n[0] = -n[0], n[1] = -n[1];
         }
+
+        int32_t plane = -1;
         if(n[0] > 0.0f && n[1] > 0.0f)
         {
-          n[0] = 1.0f, n[1] = 1.0f, n[2] = 1.0f;
-          cosPhi = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, n));
-          b[0] = 1.0f, b[1] = -1.0f, b[2] = 0.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid1 = cosPhi * cosLambda;
-          b[0] = -1.0f, b[1] = 0.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid2 = cosPhi * cosLambda;
-          b[0] = 0.0f, b[1] = -1.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid3 = cosPhi * cosLambda;
-          m_TwinBoundarySchmidFactors[3 * i] = schmid1;
-          m_TwinBoundarySchmidFactors[3 * i + 1] = schmid2;
-          m_TwinBoundarySchmidFactors[3 * i + 2] = schmid3;
+          plane = 0;
         }
         else if(n[0] > 0.0f && n[1] < 0.0f)
         {
-          n[0] = 1.0f, n[1] = -1.0f, n[2] = 1.0f;
-          cosPhi = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, n));
-          b[0] = 1.0f, b[1] = 1.0f, b[2] = 0.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid1 = cosPhi * cosLambda;
-          b[0] = 0.0f, b[1] = 1.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid2 = cosPhi * cosLambda;
-          b[0] = -1.0f, b[1] = 0.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid3 = cosPhi * cosLambda;
-          m_TwinBoundarySchmidFactors[3 * i] = schmid1;
-          m_TwinBoundarySchmidFactors[3 * i + 1] = schmid2;
-          m_TwinBoundarySchmidFactors[3 * i + 2] = schmid3;
+          plane = 1;
         }
         else if(n[0] < 0.0f && n[1] > 0.0f)
         {
-          n[0] = -1.0f, n[1] = 1.0f, n[2] = 1.0f;
-          cosPhi = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, n));
-          b[0] = 1.0f, b[1] = 1.0f, b[2] = 0.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid1 = cosPhi * cosLambda;
-          b[0] = 1.0f, b[1] = 0.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid2 = cosPhi * cosLambda;
-          b[0] = 0.0f, b[1] = -1.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid3 = cosPhi * cosLambda;
-          m_TwinBoundarySchmidFactors[3 * i] = schmid1;
-          m_TwinBoundarySchmidFactors[3 * i + 1] = schmid2;
-          m_TwinBoundarySchmidFactors[3 * i + 2] = schmid3;
+          plane = 2;
         }
         else if(n[0] < 0.0f && n[1] < 0.0f)
         {
-          n[0] = -1.0f, n[1] = -1.0f, n[2] = 1.0f;
-          cosPhi = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, n));
-          b[0] = 1.0f, b[1] = 0.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid1 = cosPhi * cosLambda;
-          b[0] = 0.0f, b[1] = 1.0f, b[2] = 1.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid2 = cosPhi * cosLambda;
-          b[0] = 1.0f, b[1] = -1.0f, b[2] = 0.0f;
-          cosLambda = fabsf(GeometryMath::CosThetaBetweenVectors(crystalLoading, b));
-          schmid3 = cosPhi * cosLambda;
-          m_TwinBoundarySchmidFactors[3 * i] = schmid1;
-          m_TwinBoundarySchmidFactors[3 * i + 1] = schmid2;
-          m_TwinBoundarySchmidFactors[3 * i + 2] = schmid3;
+          plane = 3;
+        }
+        if(plane >= 0)
+        {
+          const float* schmids = m_FeatureSchmidFactors + k_NumTwinSchmidFactors * feature + 3 * plane;
+          m_TwinBoundarySchmidFactors[3 * i] = schmids[0];
+          m_TwinBoundarySchmidFactors[3 * i + 1] = schmids[1];
+          m_TwinBoundarySchmidFactors[3 * i + 2] = schmids[2];
         }
       }
       else
@@ -474,17 +489,26 @@ void FindTwinBoundarySchmidFactors::execute()
   LoadingDir[1] = m_LoadingDir.y;
   LoadingDir[2] = m_LoadingDir.z;
 
+  size_t numFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
+  std::vector<float> featureMatrices(9 * numFeatures, 0.0f);
+  std::vector<float> featureSchmidFactors(k_NumTwinSchmidFactors * numFeatures, 0.0f);
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), CalculateTwinBoundarySchmidFactorsImpl(LoadingDir, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats,
-                                                                                                          m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundarySchmidFactors),
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), CalculateFeatureTwinSchmidFactorsImpl(LoadingDir, m_AvgQuats, featureMatrices.data(), featureSchmidFactors.data()),
+                      tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles), CalculateTwinBoundarySchmidFactorsImpl(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_SurfaceMeshTwinBoundary,
+                                                                                                          m_SurfaceMeshTwinBoundarySchmidFactors, featureMatrices.data(), featureSchmidFactors.data()),
                       tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateTwinBoundarySchmidFactorsImpl serial(LoadingDir, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundarySchmidFactors);
+    CalculateFeatureTwinSchmidFactorsImpl features(LoadingDir, m_AvgQuats, featureMatrices.data(), featureSchmidFactors.data());
+    features.generate(0, numFeatures);
+    CalculateTwinBoundarySchmidFactorsImpl serial(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_SurfaceMeshTwinBoundary, m_SurfaceMeshTwinBoundarySchmidFactors, featureMatrices.data(),
+                                                  featureSchmidFactors.data());
     serial.generate(0, numTriangles);
   }
 
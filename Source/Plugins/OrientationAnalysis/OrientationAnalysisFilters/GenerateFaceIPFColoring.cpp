@@ -42,17 +42,20 @@
 #endif
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Utilities/ColorTable.h"
 
 #include "OrientationLib/LaueOps/CubicLowOps.h"
 #include "OrientationLib/LaueOps/CubicOps.h"
 #include "OrientationLib/LaueOps/HexagonalLowOps.h"
 #include "OrientationLib/LaueOps/HexagonalOps.h"
+#include "OrientationLib/LaueOps/IPFColorLookupTable.h"
 #include "OrientationLib/LaueOps/MonoclinicOps.h"
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
 #include "OrientationLib/LaueOps/TetragonalLowOps.h"
@@ -60,6 +63,7 @@
 #include "OrientationLib/LaueOps/TriclinicOps.h"
 #include "OrientationLib/LaueOps/TrigonalLowOps.h"
 #include "OrientationLib/LaueOps/TrigonalOps.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "EbsdLib/EbsdConstants.h"
 
@@ -68,7 +72,8 @@
 
 /**
  * @brief The CalculateNormalsImpl class implements a threaded algorithm that computes the IPF colors for the given list of
- * surface mesh labels
+ * surface mesh labels. When the orientation matrices of the features and the color lookup tables are supplied, the colors
+ * are read from the tables instead of being computed with LaueOps::generateIPFColor().
  */
 class CalculateFaceIPFColorsImpl
 {
@@ -78,21 +83,44 @@ class CalculateFaceIPFColorsImpl
   float* m_Eulers;
   uint8_t* m_Colors;
   uint32_t* m_CrystalStructures;
+  const float* m_FeatureMatrices;
+  QVector<IPFColorLookupTable::Pointer> m_Tables;
 
 public:
-  CalculateFaceIPFColorsImpl(int32_t* labels, int32_t* phases, double* normals, float* eulers, uint8_t* colors, uint32_t* crystalStructures)
+  CalculateFaceIPFColorsImpl(int32_t* labels, int32_t* phases, double* normals, float* eulers, uint8_t* colors, uint32_t* crystalStructures, const float* featureMatrices = nullptr,
+                             QVector<IPFColorLookupTable::Pointer> tables = QVector<IPFColorLookupTable::Pointer>())
   : m_Labels(labels)
   , m_Phases(phases)
   , m_Normals(normals)
   , m_Eulers(eulers)
   , m_Colors(colors)
   , m_CrystalStructures(crystalStructures)
+  , m_FeatureMatrices(featureMatrices)
+  , m_Tables(tables)
   {
   }
   virtual ~CalculateFaceIPFColorsImpl()
   {
   }
 
+  /**
+   * @brief lookupColor Reads the color of one side of a face from the lookup table of its Laue class
+   * @param feature The feature on this side of the face
+   * @param crystalStructure The Laue class of the feature
+   * @param face The face index
+   * @param sign 1 for the first feature of the face, -1 for the second one whose outward normal is flipped
+   * @param rgb Receives the color
+   */
+  void lookupColor(int32_t feature, uint32_t crystalStructure, size_t face, float sign, uint8_t* rgb) const
+  {
+    const float* g = m_FeatureMatrices + 9 * feature;
+    float normal[3] = {sign * static_cast<float>(m_Normals[3 * face]), sign * static_cast<float>(m_Normals[3 * face + 1]), sign * static_cast<float>(m_Normals[3 * face + 2])};
+    float crystalDir[3] = {g[0] * normal[0] + g[1] * normal[1] + g[2] * normal[2], g[3] * normal[0] + g[4] * normal[1] + g[5] * normal[2],
+                           g[6] * normal[0] + g[7] * normal[1] + g[8] * normal[2]};
+    MatrixMath::Normalize3x1(crystalDir);
+    m_Tables[crystalStructure]->getColor(crystalDir, rgb, false);
+  }
+
   void generate(size_t start, size_t end) const
   {
     // Create 1 of every type of Ops class. This condenses the code below
@@ -139,7 +167,11 @@ public:
       if(phase1 > 0)
       {
         // Make sure we are using a valid Euler Angles with valid crystal symmetry
-        if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
+        if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd && nullptr != m_FeatureMatrices)
+        {
+          lookupColor(feature1, m_CrystalStructures[phase1], i, 1.0f, m_Colors + 6 * i);
+        }
+        else if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
         {
           dEuler[0] = m_Eulers[3 * feature1 + 0];
           dEuler[1] = m_Eulers[3 * feature1 + 1];
@@ -165,7 +197,11 @@ public:
       if(phase2 > 0)
       {
         // Make sure we are using a valid Euler Angles with valid crystal symmetry
-        if(m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
+        if(m_CrystalStructures[phase2] < Ebsd::CrystalStructure::LaueGroupEnd && nullptr != m_FeatureMatrices)
+        {
+          lookupColor(feature2, m_CrystalStructures[phase2], i, -1.0f, m_Colors + 6 * i + 3);
+        }
+        else if(m_CrystalStructures[phase2] < Ebsd::CrystalStructure::LaueGroupEnd)
         {
           dEuler[0] = m_Eulers[3 * feature2 + 0];
           dEuler[1] = m_Eulers[3 * feature2 + 1];
@@ -174,7 +210,7 @@ public:
           refDir[1] = -m_Normals[3 * i + 1];
           refDir[2] = -m_Normals[3 * i + 2];
 
-          argb = ops[m_CrystalStructures[phase1]]->generateIPFColor(dEuler, refDir, false);
+          argb = ops[m_CrystalStructures[phase2]]->generateIPFColor(dEuler, refDir, false);
           m_Colors[6 * i + 3] = RgbColor::dRed(argb);
           m_Colors[6 * i + 4] = RgbColor::dGreen(argb);
           m_Colors[6 * i + 5] = RgbColor::dBlue(argb);
@@ -211,6 +247,7 @@ GenerateFaceIPFColoring::GenerateFaceIPFColoring()
 , m_FeaturePhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases)
 , m_CrystalStructuresArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures)
 , m_SurfaceMeshFaceIPFColorsArrayName(SIMPL::FaceData::SurfaceMeshFaceIPFColors)
+, m_UseLookupTable(false)
 , m_SurfaceMeshFaceLabels(nullptr)
 , m_SurfaceMeshFaceNormals(nullptr)
 , m_FeatureEulerAngles(nullptr)
@@ -231,6 +268,7 @@ GenerateFaceIPFColoring::~GenerateFaceIPFColoring() = default;
 void GenerateFaceIPFColoring::setupFilterParameters()
 {
   FilterParameterVector parameters;
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Color Lookup Table", UseLookupTable, FilterParameter::Parameter, GenerateFaceIPFColoring));
   parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 2, AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
@@ -277,6 +315,7 @@ void GenerateFaceIPFColoring::readFilterParameters(AbstractFilterParametersReade
   setFeatureEulerAnglesArrayPath(reader->readDataArrayPath("FeatureEulerAnglesArrayPath", getFeatureEulerAnglesArrayPath()));
   setSurfaceMeshFaceNormalsArrayPath(reader->readDataArrayPath("SurfaceMeshFaceNormalsArrayPath", getSurfaceMeshFaceNormalsArrayPath()));
   setSurfaceMeshFaceLabelsArrayPath(reader->readDataArrayPath("SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath()));
+  setUseLookupTable(reader->readValue("UseLookupTable", getUseLookupTable()));
   reader->closeFilterGroup();
 }
 
@@ -415,6 +454,34 @@ void GenerateFaceIPFColoring::execute()
 
   int64_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
+  // With the lookup tables every face only needs the orientation matrix of its features, which is computed
+  // once per feature, and the tables of the Laue classes in use, which are built before the threads start
+  std::vector<float> featureMatrices;
+  QVector<IPFColorLookupTable::Pointer> tables;
+  if(m_UseLookupTable)
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    tables.resize(ops.size());
+    size_t numEnsembles = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
+    for(size_t phase = 0; phase < numEnsembles; phase++)
+    {
+      uint32_t crystalStructure = m_CrystalStructures[phase];
+      if(crystalStructure < Ebsd::CrystalStructure::LaueGroupEnd && nullptr == tables[crystalStructure])
+      {
+        tables[crystalStructure] = IPFColorLookupTable::GetLookupTable(ops[crystalStructure].get());
+      }
+    }
+
+    size_t numFeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
+    featureMatrices.resize(9 * numFeatures, 0.0f);
+    for(size_t feature = 0; feature < numFeatures; feature++)
+    {
+      FOrientArrayType om(featureMatrices.data() + 9 * feature, 9);
+      FOrientTransformsType::eu2om(FOrientArrayType(m_FeatureEulerAngles + 3 * feature, 3), om);
+    }
+  }
+  const float* matricesPtr = m_UseLookupTable ? featureMatrices.data() : nullptr;
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   bool doParallel = true;
 #endif
@@ -423,13 +490,15 @@ void GenerateFaceIPFColoring::execute()
   if(doParallel == true)
   {
     tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateFaceIPFColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures),
+                      CalculateFaceIPFColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures,
+                                                 matricesPtr, tables),
                       tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateFaceIPFColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures);
+    CalculateFaceIPFColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures, matricesPtr,
+                                      tables);
     serial.generate(0, numTriangles);
   }
 
@@ -35,6 +35,8 @@
 
 #include "GenerateIPFColors.h"
 
+#include <limits>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -44,6 +46,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -51,6 +54,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Utilities/ColorTable.h"
 
+#include "OrientationLib/LaueOps/IPFColorLookupTable.h"
 #include "OrientationLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
@@ -60,12 +64,15 @@
 
 /**
  * @brief The GenerateIPFColorsImpl class implements a threaded algorithm that computes the IPF
- * colors for each element in a geometry
+ * colors for each element in a geometry. When the lookup tables are used, consecutive elements of the
+ * same Laue class are handed to LaueOps::generateIPFColors() as one batch, together with the table of
+ * that Laue class that was fetched before the threads started.
  */
 class GenerateIPFColorsImpl
 {
 public:
-  GenerateIPFColorsImpl(GenerateIPFColors* filter, FloatVec3_t referenceDir, float* eulers, int32_t* phases, uint32_t* crystalStructures, int32_t numPhases, bool* goodVoxels, uint8_t* colors)
+  GenerateIPFColorsImpl(GenerateIPFColors* filter, FloatVec3_t referenceDir, float* eulers, int32_t* phases, uint32_t* crystalStructures, int32_t numPhases, bool* goodVoxels, uint8_t* colors,
+                        bool useLookupTable, QVector<IPFColorLookupTable::Pointer> tables = QVector<IPFColorLookupTable::Pointer>())
   : m_Filter(filter)
   , m_ReferenceDir(referenceDir)
   , m_CellEulerAngles(eulers)
@@ -74,6 +81,8 @@ public:
   , m_NumPhases(numPhases)
   , m_GoodVoxels(goodVoxels)
   , m_CellIPFColors(colors)
+  , m_UseLookupTable(useLookupTable)
+  , m_Tables(tables)
   {
   }
 
@@ -83,6 +92,12 @@ public:
 
   void convert(size_t start, size_t end) const
   {
+    if(m_UseLookupTable)
+    {
+      convertWithLookupTables(start, end);
+      return;
+    }
+
     QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
     double refDir[3] = {m_ReferenceDir.x, m_ReferenceDir.y, m_ReferenceDir.z};
     double dEuler[3] = {0.0, 0.0, 0.0};
@@ -123,6 +138,49 @@ public:
     }
   }
 
+  void convertWithLookupTables(size_t start, size_t end) const
+  {
+    float refDir[3] = {m_ReferenceDir.x, m_ReferenceDir.y, m_ReferenceDir.z};
+    const uint32_t noBatch = std::numeric_limits<uint32_t>::max();
+    uint32_t batchStructure = noBatch;
+    size_t batchStart = start;
+
+    for(size_t i = start; i <= end; i++)
+    {
+      // Elements that can not be colored, or that start a new Laue class, end the current batch
+      uint32_t crystalStructure = noBatch;
+      if(i < end)
+      {
+        int32_t phase = m_CellPhases[i];
+        bool calcIPF = (nullptr == m_GoodVoxels) || m_GoodVoxels[i];
+        if(phase >= m_NumPhases)
+        {
+          m_Filter->incrementPhaseWarningCount();
+        }
+        else if(calcIPF && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd)
+        {
+          crystalStructure = m_CrystalStructures[phase];
+        }
+      }
+
+      if(crystalStructure != batchStructure)
+      {
+        if(batchStructure != noBatch)
+        {
+          LaueOps::generateIPFColors(m_Tables[batchStructure].get(), m_CellEulerAngles + 3 * batchStart, i - batchStart, refDir, m_CellIPFColors + 3 * batchStart);
+        }
+        batchStructure = crystalStructure;
+        batchStart = i;
+      }
+      if(i < end && crystalStructure == noBatch)
+      {
+        m_CellIPFColors[3 * i] = 0;
+        m_CellIPFColors[3 * i + 1] = 0;
+        m_CellIPFColors[3 * i + 2] = 0;
+      }
+    }
+  }
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   void operator()(const tbb::blocked_range<size_t>& r) const
   {
@@ -138,6 +196,8 @@ private:
   int32_t m_NumPhases = 0;
   bool* m_GoodVoxels;
   uint8_t* m_CellIPFColors;
+  bool m_UseLookupTable = false;
+  QVector<IPFColorLookupTable::Pointer> m_Tables;
 };
 
 // -----------------------------------------------------------------------------
@@ -150,6 +210,7 @@ GenerateIPFColors::GenerateIPFColors()
 , m_UseGoodVoxels(false)
 , m_GoodVoxelsArrayPath("", "", "")
 , m_CellIPFColorsArrayName(SIMPL::CellData::IPFColor)
+, m_UseLookupTable(false)
 , m_CellPhases(nullptr)
 , m_CellEulerAngles(nullptr)
 , m_CrystalStructures(nullptr)
@@ -177,6 +238,7 @@ void GenerateIPFColors::setupFilterParameters()
 
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Apply to Good Elements Only (Bad Elements Will Be Black)", UseGoodVoxels, FilterParameter::Parameter, GenerateIPFColors, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Color Lookup Table", UseLookupTable, FilterParameter::Parameter, GenerateIPFColors));
   parameters.push_back(SeparatorFilterParameter::New("Element Data", FilterParameter::RequiredArray));
   DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Category::Any);
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Euler Angles", CellEulerAnglesArrayPath, FilterParameter::RequiredArray, GenerateIPFColors, req));
@@ -208,6 +270,7 @@ void GenerateIPFColors::readFilterParameters(AbstractFilterParametersReader* rea
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setCellIPFColorsArrayName(reader->readString("CellIPFColorsArrayName", getCellIPFColorsArrayName()));
   setReferenceDir(reader->readFloatVec3("ReferenceDir", getReferenceDir()));
+  setUseLookupTable(reader->readValue("UseLookupTable", getUseLookupTable()));
   reader->closeFilterGroup();
 }
 
@@ -330,6 +393,22 @@ void GenerateIPFColors::execute()
   FloatVec3_t normRefDir = m_ReferenceDir; // Make a copy of the reference Direction
   MatrixMath::Normalize3x1(normRefDir.x, normRefDir.y, normRefDir.z);
 
+  // Fetch the lookup tables of every Laue class in use up front so the worker threads only read them
+  QVector<IPFColorLookupTable::Pointer> tables;
+  if(m_UseLookupTable)
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    tables.resize(ops.size());
+    for(int32_t phase = 0; phase < numPhases; phase++)
+    {
+      uint32_t crystalStructure = m_CrystalStructures[phase];
+      if(crystalStructure < Ebsd::CrystalStructure::LaueGroupEnd && nullptr == tables[crystalStructure])
+      {
+        tables[crystalStructure] = IPFColorLookupTable::GetLookupTable(ops[crystalStructure].get());
+      }
+    }
+  }
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
@@ -339,12 +418,13 @@ void GenerateIPFColors::execute()
   if(doParallel == true)
   {
     tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints),
-                      GenerateIPFColorsImpl(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors), tbb::auto_partitioner());
+                      GenerateIPFColorsImpl(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors, m_UseLookupTable, tables),
+                      tbb::auto_partitioner());
   }
   else
 #endif
   {
-    GenerateIPFColorsImpl serial(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors);
+    GenerateIPFColorsImpl serial(this, normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, numPhases, m_GoodVoxels, m_CellIPFColors, m_UseLookupTable, tables);
     serial.convert(0, totalPoints);
   }
 
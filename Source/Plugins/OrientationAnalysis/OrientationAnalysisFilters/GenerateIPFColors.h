@@ -56,6 +56,7 @@ class OrientationAnalysis_EXPORT GenerateIPFColors : public AbstractFilter
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
     PYB11_PROPERTY(QString CellIPFColorsArrayName READ getCellIPFColorsArrayName WRITE setCellIPFColorsArrayName)
+    PYB11_PROPERTY(bool UseLookupTable READ getUseLookupTable WRITE setUseLookupTable)
 public:
   SIMPL_SHARED_POINTERS(GenerateIPFColors)
   SIMPL_FILTER_NEW_MACRO(GenerateIPFColors)
@@ -84,6 +85,9 @@ public:
   SIMPL_FILTER_PARAMETER(QString, CellIPFColorsArrayName)
   Q_PROPERTY(QString CellIPFColorsArrayName READ getCellIPFColorsArrayName WRITE setCellIPFColorsArrayName)
 
+  SIMPL_FILTER_PARAMETER(bool, UseLookupTable)
+  Q_PROPERTY(bool UseLookupTable READ getUseLookupTable WRITE setUseLookupTable)
+
   /**
    * @brief incrementPhaseWarningCount
    */
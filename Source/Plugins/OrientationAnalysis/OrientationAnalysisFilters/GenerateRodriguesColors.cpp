@@ -35,6 +35,13 @@
 
 #include "GenerateRodriguesColors.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -62,6 +69,68 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The GenerateRodriguesColorsImpl class implements a threaded algorithm that computes the Rodrigues
+ * colors for each element in a geometry
+ */
+class GenerateRodriguesColorsImpl
+{
+public:
+  GenerateRodriguesColorsImpl(float* eulers, int32_t* phases, uint32_t* crystalStructures, bool* goodVoxels, uint8_t* colors)
+  : m_CellEulerAngles(eulers)
+  , m_CellPhases(phases)
+  , m_CrystalStructures(crystalStructures)
+  , m_GoodVoxels(goodVoxels)
+  , m_CellRodriguesColors(colors)
+  {
+  }
+
+  virtual ~GenerateRodriguesColorsImpl()
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    QVector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsQVector();
+    float rodValues[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    FOrientArrayType rod(rodValues, 4);
+    SIMPL::Rgb argb = 0x00000000;
+    size_t index = 0;
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t phase = m_CellPhases[i];
+      index = i * 3;
+      m_CellRodriguesColors[index] = 0;
+      m_CellRodriguesColors[index + 1] = 0;
+      m_CellRodriguesColors[index + 2] = 0;
+
+      // Make sure we are using a valid Euler Angles with valid crystal symmetry
+      if((nullptr == m_GoodVoxels || m_GoodVoxels[i]) && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd)
+      {
+        FOrientTransformsType::eu2ro(FOrientArrayType(m_CellEulerAngles + index, 3), rod);
+
+        argb = ops[m_CrystalStructures[phase]]->generateRodriguesColor(rod[0], rod[1], rod[2]);
+        m_CellRodriguesColors[index] = RgbColor::dRed(argb);
+        m_CellRodriguesColors[index + 1] = RgbColor::dGreen(argb);
+        m_CellRodriguesColors[index + 2] = RgbColor::dBlue(argb);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  float* m_CellEulerAngles;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  bool* m_GoodVoxels;
+  uint8_t* m_CellRodriguesColors;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -223,52 +292,25 @@ void GenerateRodriguesColors::execute()
     return;
   }
 
-  int64_t totalPoints = m_CellEulerAnglesPtr.lock()->getNumberOfTuples();
+  size_t totalPoints = m_CellEulerAnglesPtr.lock()->getNumberOfTuples();
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  bool missingGoodVoxels = true;
-  if(nullptr != m_GoodVoxels)
+  // Write the Rodrigues Coloring Cell Data
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    missingGoodVoxels = false;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), GenerateRodriguesColorsImpl(m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellRodriguesColors),
+                      tbb::auto_partitioner());
   }
-
-  // Create 1 of every type of Ops class. This condenses the code below
-  QVector<LaueOps::Pointer> ops;
-  ops.push_back(HexagonalOps::New());
-  ops.push_back(CubicOps::New());
-  ops.push_back(HexagonalLowOps::New());
-  ops.push_back(CubicLowOps::New());
-  ops.push_back(TriclinicOps::New());
-  ops.push_back(MonoclinicOps::New());
-  ops.push_back(OrthoRhombicOps::New());
-  ops.push_back(TetragonalLowOps::New());
-  ops.push_back(TetragonalOps::New());
-  ops.push_back(TrigonalLowOps::New());
-  ops.push_back(TrigonalOps::New());
-
-  int phase;
-  size_t index = 0;
-  SIMPL::Rgb argb = 0x00000000;
-
-  // Write the IPF Coloring Cell Data
-  for(int64_t i = 0; i < totalPoints; i++)
+  else
+#endif
   {
-    phase = m_CellPhases[i];
-    index = i * 3;
-    m_CellRodriguesColors[index] = 0;
-    m_CellRodriguesColors[index + 1] = 0;
-    m_CellRodriguesColors[index + 2] = 0;
-
-    // Make sure we are using a valid Euler Angles with valid crystal symmetry
-    if((missingGoodVoxels == true || m_GoodVoxels[i] == true) && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd)
-    {
-      FOrientArrayType rod(4);
-      FOrientTransformsType::eu2ro(FOrientArrayType(m_CellEulerAngles + index, 3), rod);
-
-      argb = ops[m_CrystalStructures[phase]]->generateRodriguesColor(rod[0], rod[1], rod[2]);
-      m_CellRodriguesColors[index] = RgbColor::dRed(argb);
-      m_CellRodriguesColors[index + 1] = RgbColor::dGreen(argb);
-      m_CellRodriguesColors[index + 2] = RgbColor::dBlue(argb);
-    }
+    GenerateRodriguesColorsImpl serial(m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellRodriguesColors);
+    serial.convert(0, totalPoints);
   }
 
   /* Let the GUI know we are done with this filter */
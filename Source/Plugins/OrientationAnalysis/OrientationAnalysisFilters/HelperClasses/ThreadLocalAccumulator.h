@@ -0,0 +1,101 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+/**
+ * @brief The ThreadLocalAccumulator class gives every worker thread its own copy of an
+ * accumulator (a histogram, a list of selected triangles, ...) so that a parallel loop can
+ * add to it without locks, atomics or intermediate per-item buffers. The per-thread copies
+ * are created lazily from an exemplar the first time a thread asks for one, and are folded
+ * together with combine() once the loop has finished. When the parallel algorithms are not
+ * available there is exactly one copy.
+ */
+template <typename T>
+class ThreadLocalAccumulator
+{
+public:
+  explicit ThreadLocalAccumulator(const T& exemplar)
+  : m_Locals(exemplar)
+  {
+  }
+
+  /**
+   * @brief local Returns the copy owned by the calling thread
+   * @return
+   */
+  T& local()
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    return m_Locals.local();
+#else
+    return m_Locals;
+#endif
+  }
+
+  /**
+   * @brief combine Calls func once for every copy that was handed out. Must not be
+   * called while a parallel loop is still adding to the accumulator.
+   * @param func Callable taking a reference to one thread's accumulator
+   */
+  template <typename Func>
+  void combine(Func func)
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    m_Locals.combine_each(func);
+#else
+    func(m_Locals);
+#endif
+  }
+
+private:
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::enumerable_thread_specific<T> m_Locals;
+#else
+  T m_Locals;
+#endif
+
+public:
+  ThreadLocalAccumulator(const ThreadLocalAccumulator&) = delete;            // Copy Constructor Not Implemented
+  ThreadLocalAccumulator(ThreadLocalAccumulator&&) = delete;                 // Move Constructor Not Implemented
+  ThreadLocalAccumulator& operator=(const ThreadLocalAccumulator&) = delete; // Copy Assignment Not Implemented
+  ThreadLocalAccumulator& operator=(ThreadLocalAccumulator&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,12 +35,14 @@
 
 #include "NeighborOrientationCorrelation.h"
 
+#include <algorithm>
 #include <vector>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/atomic.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_group.h>
 #include <tbb/task_scheduler_init.h>
 #include <tbb/tick_count.h>
@@ -57,53 +59,206 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
-class NeighborOrientationCorrelationTransferDataImpl
+namespace
 {
-public:
-  NeighborOrientationCorrelationTransferDataImpl() = delete;
-  NeighborOrientationCorrelationTransferDataImpl(const NeighborOrientationCorrelationTransferDataImpl&) = default; // Copy Constructor Not Implemented
-
-  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, size_t totalPoints, const std::vector<int64_t>& bestNeighbor, AttributeMatrix* attrMat,
-                                                 int32_t voxelArrayIndex)
-  : m_Filter(filter)
-  , m_TotalPoints(totalPoints)
-  , m_BestNeighbor(bestNeighbor)
-  , m_AttrMat(attrMat)
-  , m_VoxelArrayIndex(voxelArrayIndex)
+/**
+ * @brief transferTypedTuples Copies tuple sources[k] to tuple destinations[k] for every k when the array is a
+ * DataArray<T>. All source tuples are read before any destination is written because a voxel can be both.
+ * @return false if the array is not a DataArray<T>
+ */
+template <typename T> bool transferTypedTuples(IDataArray::Pointer array, const std::vector<int64_t>& destinations, const std::vector<int64_t>& sources)
+{
+  typename DataArray<T>::Pointer typedArray = std::dynamic_pointer_cast<DataArray<T>>(array);
+  if(nullptr == typedArray.get())
   {
+    return false;
   }
+  size_t numComps = static_cast<size_t>(typedArray->getNumberOfComponents());
+  T* data = typedArray->getPointer(0);
+  std::vector<T> buffer(destinations.size() * numComps);
+  for(size_t k = 0; k < sources.size(); k++)
+  {
+    std::copy(data + sources[k] * numComps, data + (sources[k] + 1) * numComps, buffer.begin() + k * numComps);
+  }
+  for(size_t k = 0; k < destinations.size(); k++)
+  {
+    std::copy(buffer.begin() + k * numComps, buffer.begin() + (k + 1) * numComps, data + destinations[k] * numComps);
+  }
+  return true;
+}
 
-  ~NeighborOrientationCorrelationTransferDataImpl() = default;
+/**
+ * @brief transferTuples Copies tuple sources[k] to tuple destinations[k] for every k
+ */
+void transferTuples(IDataArray::Pointer array, const std::vector<int64_t>& destinations, const std::vector<int64_t>& sources)
+{
+  if(transferTypedTuples<float>(array, destinations, sources) || transferTypedTuples<int32_t>(array, destinations, sources) || transferTypedTuples<uint8_t>(array, destinations, sources) ||
+     transferTypedTuples<bool>(array, destinations, sources) || transferTypedTuples<double>(array, destinations, sources) || transferTypedTuples<int8_t>(array, destinations, sources) ||
+     transferTypedTuples<int16_t>(array, destinations, sources) || transferTypedTuples<uint16_t>(array, destinations, sources) || transferTypedTuples<uint32_t>(array, destinations, sources) ||
+     transferTypedTuples<int64_t>(array, destinations, sources) || transferTypedTuples<uint64_t>(array, destinations, sources))
+  {
+    return;
+  }
+  // Any other kind of array goes through its generic interface, reading from an unmodified copy
+  IDataArray::Pointer original = array->deepCopy();
+  for(size_t k = 0; k < destinations.size(); k++)
+  {
+    array->copyFromArray(static_cast<size_t>(destinations[k]), original, static_cast<size_t>(sources[k]), 1);
+  }
+}
+}
 
-  void operator()() const
+/**
+ * @brief The NeighborOrientationCorrelationImpl class implements a threaded algorithm that picks, for every voxel
+ * below the minimum confidence index, the face neighbor that agrees in orientation with another of its face
+ * neighbors. Cell data is read through the source map, which holds for every voxel the voxel whose original values
+ * it currently carries, so the cell arrays themselves only need to be updated once at the very end.
+ */
+class NeighborOrientationCorrelationImpl
+{
+public:
+  NeighborOrientationCorrelationImpl(float* confidenceIndex, float* quats, int32_t* cellPhases, uint32_t* crystalStructures, const int64_t* source, bool confidenceIndexMapped, bool quatsMapped,
+                                     bool cellPhasesMapped, int64_t dims[3], float minConfidence, float misorientationTolerance, int64_t* bestNeighbor)
+  : m_ConfidenceIndex(confidenceIndex)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Source(source)
+  , m_ConfidenceIndexMapped(confidenceIndexMapped)
+  , m_QuatsMapped(quatsMapped)
+  , m_CellPhasesMapped(cellPhasesMapped)
+  , m_MinConfidence(minConfidence)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_BestNeighbor(bestNeighbor)
   {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
 
-    QVector<QString> voxelArrayNames = m_AttrMat->getAttributeArrayNames().toVector();
+  virtual ~NeighborOrientationCorrelationImpl()
+  {
+  }
 
-    size_t progIncrement = static_cast<size_t>(m_TotalPoints / 50);
-    size_t prog = 1;
-    for(size_t i = 0; i < m_TotalPoints; i++)
+  void compute(size_t start, size_t end) const
+  {
+    int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    int32_t neighborSimCount[6] = {0, 0, 0, 0, 0, 0};
+
+    for(size_t i = start; i < end; i++)
     {
-      if(i > prog)
+      if(m_ConfidenceIndex[m_ConfidenceIndexMapped ? m_Source[i] : i] >= m_MinConfidence)
       {
-        prog = prog + progIncrement;
-        m_Filter->updateProgress(progIncrement);
+        continue;
       }
-      int64_t neighbor = m_BestNeighbor[i];
-      if(neighbor != -1)
+      int64_t column = static_cast<int64_t>(i) % m_Dims[0];
+      int64_t row = (static_cast<int64_t>(i) / m_Dims[0]) % m_Dims[1];
+      int64_t plane = static_cast<int64_t>(i) / (m_Dims[0] * m_Dims[1]);
+      bool inside[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+
+      for(size_t j = 0; j < 6; j++)
       {
-        IDataArray::Pointer p = m_AttrMat->getAttributeArray(voxelArrayNames[m_VoxelArrayIndex]);
-        p->copyTuple(neighbor, i);
+        neighborSimCount[j] = 0;
+      }
+      for(size_t j = 0; j < 6; j++)
+      {
+        if(!inside[j])
+        {
+          continue;
+        }
+        int64_t neighbor = static_cast<int64_t>(i) + neighpoints[j];
+        int32_t phase = m_CellPhases[m_CellPhasesMapped ? m_Source[neighbor] : neighbor];
+        for(size_t k = j + 1; k < 6; k++)
+        {
+          if(!inside[k])
+          {
+            continue;
+          }
+          int64_t neighbor2 = static_cast<int64_t>(i) + neighpoints[k];
+          int32_t phase2 = m_CellPhases[m_CellPhasesMapped ? m_Source[neighbor2] : neighbor2];
+          if(phase2 != phase || phase2 <= 0)
+          {
+            continue;
+          }
+          QuaternionMathF::Copy(quats[m_QuatsMapped ? m_Source[neighbor2] : neighbor2], q1);
+          QuaternionMathF::Copy(quats[m_QuatsMapped ? m_Source[neighbor] : neighbor], q2);
+          float w = m_OrientationOps[m_CrystalStructures[phase2]]->getMisoQuat(q1, q2, n1, n2, n3);
+          if(w < m_MisorientationTolerance)
+          {
+            neighborSimCount[j]++;
+            neighborSimCount[k]++;
+          }
+        }
+      }
+      for(size_t j = 0; j < 6; j++)
+      {
+        if(inside[j] && neighborSimCount[j] > 0)
+        {
+          m_BestNeighbor[i] = static_cast<int64_t>(i) + neighpoints[j];
+        }
       }
     }
   }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_ConfidenceIndex;
+  float* m_Quats;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  const int64_t* m_Source;
+  bool m_ConfidenceIndexMapped;
+  bool m_QuatsMapped;
+  bool m_CellPhasesMapped;
+  int64_t m_Dims[3];
+  float m_MinConfidence;
+  float m_MisorientationTolerance;
+  int64_t* m_BestNeighbor;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+};
+
+/**
+ * @brief The NeighborOrientationCorrelationTransferDataImpl class copies the final values of the corrected voxels
+ * into one cell array.
+ */
+class NeighborOrientationCorrelationTransferDataImpl
+{
+public:
+  NeighborOrientationCorrelationTransferDataImpl() = delete;
+  NeighborOrientationCorrelationTransferDataImpl(const NeighborOrientationCorrelationTransferDataImpl&) = default; // Copy Constructor Not Implemented
+
+  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, const std::vector<int64_t>& destinations, const std::vector<int64_t>& sources, IDataArray::Pointer array)
+  : m_Filter(filter)
+  , m_Destinations(&destinations)
+  , m_Sources(&sources)
+  , m_Array(array)
+  {
+  }
+
+  ~NeighborOrientationCorrelationTransferDataImpl() = default;
+
+  void operator()() const
+  {
+    transferTuples(m_Array, *m_Destinations, *m_Sources);
+    m_Filter->updateProgress(1);
+  }
+
 private:
   NeighborOrientationCorrelation* m_Filter = nullptr;
-  size_t m_TotalPoints = 0;
-  std::vector<int64_t> m_BestNeighbor;
-  AttributeMatrix* m_AttrMat = nullptr;
-  int32_t m_VoxelArrayIndex = 0;
+  const std::vector<int64_t>* m_Destinations = nullptr;
+  const std::vector<int64_t>* m_Sources = nullptr;
+  IDataArray::Pointer m_Array;
 
   void operator=(const NeighborOrientationCorrelationTransferDataImpl&) = delete; // Move assignment Not Implemented
 };
@@ -289,32 +444,25 @@ void NeighborOrientationCorrelation::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  size_t count = 1;
-  int32_t best = 0;
-  bool good = true;
-  bool good2 = true;
-  int64_t neighbor = 0;
-  int64_t neighbor2 = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int64_t>(-dims[0]);
-  neighpoints[2] = static_cast<int64_t>(-1);
-  neighpoints[3] = static_cast<int64_t>(1);
-  neighpoints[4] = static_cast<int64_t>(dims[0]);
-  neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
-
-  float w = std::numeric_limits<float>::max();
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  std::vector<int32_t> neighborDiffCount(totalPoints, 0);
-  std::vector<int32_t> neighborSimCount(6, 0);
+  // source[i] is the voxel whose original cell data voxel i carries after the corrections so far. Each level
+  // only updates this map; the cell arrays are copied once after the last level.
+  std::vector<int64_t> source(totalPoints, 0);
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    source[i] = static_cast<int64_t>(i);
+  }
   std::vector<int64_t> bestNeighbor(totalPoints, -1);
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+
+  // Only arrays in the corrected attribute matrix change between levels
+  QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
+  QString dcName = m_ConfidenceIndexArrayPath.getDataContainerName();
+  bool quatsMapped = (m_QuatsArrayPath.getDataContainerName() == dcName && m_QuatsArrayPath.getAttributeMatrixName() == attrMatName);
+  bool cellPhasesMapped = (m_CellPhasesArrayPath.getDataContainerName() == dcName && m_CellPhasesArrayPath.getAttributeMatrixName() == attrMatName);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
   const int32_t startLevel = 6;
   for(int32_t currentLevel = startLevel; currentLevel > m_Level; currentLevel--)
@@ -324,215 +472,37 @@ void NeighborOrientationCorrelation::execute()
       break;
     }
 
-    int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      if(int64_t(i) > prog)
-      {
-        progressInt = static_cast<int64_t>((static_cast<float>(i) / totalPoints) * 100.0f);
-        QString ss = QObject::tr("Level %1 of %2 || Processing Data %3%").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level).arg(progressInt);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-        prog = prog + progIncrement;
-      }
+    QString ss = QObject::tr("Level %1 of %2 || Processing Data").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
-      if(m_ConfidenceIndex[i] < m_MinConfidence)
-      {
-        count = 0;
-        column = static_cast<int64_t>(i % dims[0]);
-        row = (i / dims[0]) % dims[1];
-        plane = i / (dims[0] * dims[1]);
-        for(size_t j = 0; j < 6; j++)
-        {
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good == true)
-          {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            QuaternionMathF::Copy(quats[i], q1);
-
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            QuaternionMathF::Copy(quats[neighbor], q2);
-
-            if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-            {
-              w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-            }
-            if(w > misorientationToleranceR)
-            {
-              neighborDiffCount[i]++;
-            }
-            for(size_t k = j + 1; k < 6; k++)
-            {
-              good2 = true;
-              neighbor2 = int64_t(i) + neighpoints[k];
-              if(k == 0 && plane == 0)
-              {
-                good2 = false;
-              }
-              if(k == 5 && plane == (dims[2] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 1 && row == 0)
-              {
-                good2 = false;
-              }
-              if(k == 4 && row == (dims[1] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 2 && column == 0)
-              {
-                good2 = false;
-              }
-              if(k == 3 && column == (dims[0] - 1))
-              {
-                good2 = false;
-              }
-              if(good2 == true)
-              {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                QuaternionMathF::Copy(quats[neighbor2], q1);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                QuaternionMathF::Copy(quats[neighbor], q2);
-                if(m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
-                {
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                }
-                if(w < misorientationToleranceR)
-                {
-                  neighborSimCount[j]++;
-                  neighborSimCount[k]++;
-                }
-              }
-            }
-          }
-        }
-        for(size_t j = 0; j < 6; j++)
-        {
-          best = 0;
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good == true)
-          {
-            if(neighborSimCount[j] > best)
-            {
-              best = neighborSimCount[j];
-              bestNeighbor[i] = neighbor;
-            }
-            neighborSimCount[j] = 0;
-          }
-        }
-      }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints),
+                        NeighborOrientationCorrelationImpl(m_ConfidenceIndex, m_Quats, m_CellPhases, m_CrystalStructures, source.data(), true, quatsMapped, cellPhasesMapped, dims, m_MinConfidence,
+                                                           misorientationToleranceR, bestNeighbor.data()),
+                        tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      NeighborOrientationCorrelationImpl serial(m_ConfidenceIndex, m_Quats, m_CellPhases, m_CrystalStructures, source.data(), true, quatsMapped, cellPhasesMapped, dims, m_MinConfidence,
+                                                misorientationToleranceR, bestNeighbor.data());
+      serial.compute(0, totalPoints);
     }
-    QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
 
     if(getCancel())
     {
       return;
     }
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::task_scheduler_init init;
-    bool doParallel = true;
-#endif
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    // The idea for this parallel section is to parallelize over each Data Array that
-    // will need it's data adjusted. This should go faster than before by about 2x.
-    // Better speed up could be achieved if we had better data locality.
-    m_Progress = 0;
-    m_TotalProgress = 0;
-    if(doParallel == true)
-    {
-      std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-      AttributeMatrix* attrMat = m->getAttributeMatrix(attrMatName).get();
-      QVector<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames().toVector();
-      m_TotalProgress = voxelArrayNames.size() * totalPoints; // Total number of points to update
-      // Create and run all the tasks
-      for(int32_t voxelArray = 0; voxelArray < voxelArrayNames.size(); voxelArray++)
-      {
-        g->run(NeighborOrientationCorrelationTransferDataImpl(this, totalPoints, bestNeighbor, attrMat, voxelArray));
-      }
-      // Wait for them to complete.
-      g->wait();
-      
-    }
-    else
-#endif
+    // Same order as copying the tuples in place: a voxel picks up the current values of its best neighbor, which
+    // are already the corrected ones if that neighbor comes earlier
+    for(size_t i = 0; i < totalPoints; i++)
     {
-      QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-      progIncrement = static_cast<int64_t>(totalPoints / 100);
-      prog = 1;
-      progressInt = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      if(bestNeighbor[i] != -1)
       {
-        if(int64_t(i) > prog)
-        {
-          progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
-          QString ss = QObject::tr("Level %1 of %2 || Copying Data %3%").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level).arg(progressInt);
-          notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-          prog = prog + progIncrement;
-        }
-        neighbor = bestNeighbor[i];
-        if(neighbor != -1)
-        {
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-            p->copyTuple(neighbor, i);
-          }
-        }
+        source[i] = source[bestNeighbor[i]];
       }
     }
 
@@ -545,6 +515,48 @@ void NeighborOrientationCorrelation::execute()
     return;
   }
 
+  std::vector<int64_t> destinations;
+  std::vector<int64_t> sources;
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(source[i] != static_cast<int64_t>(i))
+    {
+      destinations.push_back(static_cast<int64_t>(i));
+      sources.push_back(source[i]);
+    }
+  }
+
+  AttributeMatrix::Pointer attrMat = m->getAttributeMatrix(attrMatName);
+  QList<QString> voxelArrayNames = attrMat->getAttributeArrayNames();
+  m_Progress = 0;
+  m_TotalProgress = static_cast<size_t>(voxelArrayNames.size());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // Each cell array is updated by its own task
+  if(doParallel == true)
+  {
+    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
+    for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+    {
+      g->run(NeighborOrientationCorrelationTransferDataImpl(this, destinations, sources, attrMat->getAttributeArray(*iter)));
+    }
+    // Wait for them to complete.
+    g->wait();
+  }
+  else
+#endif
+  {
+    for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+    {
+      NeighborOrientationCorrelationTransferDataImpl serial(this, destinations, sources, attrMat->getAttributeArray(*iter));
+      serial();
+    }
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
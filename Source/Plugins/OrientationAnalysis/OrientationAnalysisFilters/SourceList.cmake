@@ -36,6 +36,7 @@ set(_PublicFilters
   FindFeatureReferenceMisorientations
   FindKernelAvgMisorientations
   FindMisorientations
+  FindNeighborPatternSimilarity
   FindSchmids
   FindSlipTransmissionMetrics
   FindTwinBoundaries
@@ -105,6 +106,8 @@ foreach(f ${_PrivateFilters} )
 endforeach()
 
 
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} HelperClasses/ThreadLocalAccumulator.h)
+
 if(1)
   ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} IPFLegendHelpers/IPFLegendPainter.h)
   ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} IPFLegendHelpers/IPFLegendPainter.cpp)
@@ -0,0 +1,257 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindNeighborPatternSimilarityTest
+{
+public:
+  FindNeighborPatternSimilarityTest()
+  {
+  }
+  virtual ~FindNeighborPatternSimilarityTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighborPatternSimilarity Filter from the FilterManager
+    QString filtName = "FindNeighborPatternSimilarity";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborPatternSimilarityTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the pattern of the cell, optionally shifted to zero mean, scaled to unit length into output and
+  // returns false for a pattern without contrast
+  // -----------------------------------------------------------------------------
+  bool NormalizePattern(const UInt16ArrayType::Pointer& patterns, size_t cell, bool subtractMean, std::vector<double>& output)
+  {
+    size_t patternSize = static_cast<size_t>(patterns->getNumberOfComponents());
+    output.assign(patternSize, 0.0);
+    double mean = 0.0;
+    if(subtractMean)
+    {
+      for(size_t i = 0; i < patternSize; i++)
+      {
+        mean += static_cast<double>(patterns->getComponent(cell, i));
+      }
+      mean /= static_cast<double>(patternSize);
+    }
+    double sumSquares = 0.0;
+    for(size_t i = 0; i < patternSize; i++)
+    {
+      output[i] = static_cast<double>(patterns->getComponent(cell, i)) - mean;
+      sumSquares += output[i] * output[i];
+    }
+    if(sumSquares <= 0.0)
+    {
+      return false;
+    }
+    for(size_t i = 0; i < patternSize; i++)
+    {
+      output[i] /= std::sqrt(sumSquares);
+    }
+    return true;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Serial reference: the average normalized dot product over every neighbor in the kernel box, skipping
+  // patterns without contrast
+  // -----------------------------------------------------------------------------
+  float ReferenceSimilarity(const UInt16ArrayType::Pointer& patterns, const int64_t dims[3], const IntVec3_t& kernelSize, bool subtractMean, size_t cell)
+  {
+    std::vector<double> pattern;
+    std::vector<double> neighborPattern;
+    if(!NormalizePattern(patterns, cell, subtractMean, pattern))
+    {
+      return 0.0f;
+    }
+    int64_t x = static_cast<int64_t>(cell) % dims[0];
+    int64_t y = (static_cast<int64_t>(cell) / dims[0]) % dims[1];
+    int64_t z = static_cast<int64_t>(cell) / (dims[0] * dims[1]);
+    double total = 0.0;
+    int32_t count = 0;
+    for(int64_t k = z - kernelSize.z; k <= z + kernelSize.z; k++)
+    {
+      for(int64_t j = y - kernelSize.y; j <= y + kernelSize.y; j++)
+      {
+        for(int64_t i = x - kernelSize.x; i <= x + kernelSize.x; i++)
+        {
+          if(i < 0 || j < 0 || k < 0 || i >= dims[0] || j >= dims[1] || k >= dims[2] || (i == x && j == y && k == z))
+          {
+            continue;
+          }
+          if(!NormalizePattern(patterns, static_cast<size_t>((k * dims[1] + j) * dims[0] + i), subtractMean, neighborPattern))
+          {
+            continue;
+          }
+          double dot = 0.0;
+          for(size_t c = 0; c < pattern.size(); c++)
+          {
+            dot += pattern[c] * neighborPattern[c];
+          }
+          total += dot;
+          count++;
+        }
+      }
+    }
+    return (count == 0) ? 0.0f : static_cast<float>(total / count);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesSerialReference()
+  {
+    size_t dims[3] = {23, 17, 11};
+    int64_t idims[3] = {23, 17, 11};
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+
+    // Smoothly varying patterns with a little deterministic noise, and every 29th pattern flat so the cells
+    // without contrast are exercised as well
+    QVector<size_t> cDims(1, 12);
+    UInt16ArrayType::Pointer patterns = UInt16ArrayType::CreateArray(totalPoints, cDims, "PatternData");
+    uint32_t state = 12345;
+    for(size_t cell = 0; cell < totalPoints; cell++)
+    {
+      for(size_t c = 0; c < 12; c++)
+      {
+        state = state * 1664525u + 1013904223u;
+        double smooth = 100.0 + 50.0 * std::sin(0.3 * static_cast<double>(cell % dims[0]) + 0.7 * static_cast<double>(c)) + 20.0 * std::cos(0.2 * static_cast<double>(cell / dims[0]));
+        uint16_t value = static_cast<uint16_t>(smooth) + static_cast<uint16_t>(state >> 28);
+        patterns->setComponent(cell, c, (cell % 29 == 0) ? 77 : value);
+      }
+    }
+    cellAttrMat->addAttributeArray("PatternData", patterns);
+
+    // A planar kernel and two kernels whose halos span several planes
+    int32_t kernelRadii[3][3] = {{1, 1, 0}, {2, 1, 1}, {1, 2, 2}};
+    for(const auto& radius : kernelRadii)
+    {
+      IntVec3_t kernelSize;
+      kernelSize.x = radius[0];
+      kernelSize.y = radius[1];
+      kernelSize.z = radius[2];
+      for(int32_t subtractMean = 0; subtractMean < 2; subtractMean++)
+      {
+        FilterManager* fm = FilterManager::Instance();
+        IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindNeighborPatternSimilarity");
+        DREAM3D_REQUIRE(factory.get() != nullptr);
+        AbstractFilter::Pointer filter = factory->create();
+        filter->setDataContainerArray(dca);
+
+        QVariant var;
+        var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "PatternData"));
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("PatternDataArrayPath", var), true)
+        QString similarityName = QString("PatternSimilarity_%1_%2_%3_%4").arg(kernelSize.x).arg(kernelSize.y).arg(kernelSize.z).arg(subtractMean);
+        var.setValue(similarityName);
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("PatternSimilarityArrayName", var), true)
+        var.setValue(kernelSize);
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("KernelSize", var), true)
+        var.setValue(subtractMean == 1);
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("SubtractPatternMean", var), true)
+
+        filter->execute();
+        DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+        FloatArrayType::Pointer similarity = cellAttrMat->getAttributeArrayAs<FloatArrayType>(similarityName);
+        DREAM3D_REQUIRE_VALID_POINTER(similarity.get())
+        for(size_t cell = 0; cell < totalPoints; cell++)
+        {
+          float expected = ReferenceSimilarity(patterns, idims, kernelSize, subtractMean == 1, cell);
+          DREAM3D_REQUIRE(std::fabs(similarity->getValue(cell) - expected) < 1.0E-5f)
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesSerialReference());
+  }
+
+private:
+  FindNeighborPatternSimilarityTest(const FindNeighborPatternSimilarityTest&); // Copy Constructor Not Implemented
+  void operator=(const FindNeighborPatternSimilarityTest&);                    // Move assignment Not Implemented
+};
@@ -173,7 +173,6 @@ protected:
 
 private:
   bool* m_AlreadyChecked;
-  int32_t* m_Neighbors;
 
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
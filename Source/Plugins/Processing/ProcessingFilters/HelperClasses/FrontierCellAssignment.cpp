@@ -0,0 +1,480 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FrontierCellAssignment.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataArrays/StringDataArray.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Returns the face neighbor belonging to the most frequent source Feature around the
+// given Cell. The neighbors are visited in the order -Z, -Y, -X, +X, +Y, +Z and the first
+// neighbor to reach a new maximum count wins, which is exactly the tie breaking of the
+// original whole-volume sweep.
+// -----------------------------------------------------------------------------
+int64_t findBestNeighbor(const int32_t* featureIds, const int64_t* dims, int32_t minSourceFeatureId, int64_t index)
+{
+  const int64_t column = index % dims[0];
+  const int64_t row = (index / dims[0]) % dims[1];
+  const int64_t plane = index / (dims[0] * dims[1]);
+
+  const int64_t neighpoints[6] = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
+  const bool inBounds[6] = {plane > 0, row > 0, column > 0, column < dims[0] - 1, row < dims[1] - 1, plane < dims[2] - 1};
+
+  int32_t features[6] = {0, 0, 0, 0, 0, 0};
+  int32_t counts[6] = {0, 0, 0, 0, 0, 0};
+  int32_t numFeatures = 0;
+  int32_t most = 0;
+  int64_t best = -1;
+  for(int32_t l = 0; l < 6; l++)
+  {
+    if(!inBounds[l])
+    {
+      continue;
+    }
+    int64_t neighpoint = index + neighpoints[l];
+    int32_t feature = featureIds[neighpoint];
+    if(feature < minSourceFeatureId)
+    {
+      continue;
+    }
+    int32_t f = 0;
+    while(f < numFeatures && features[f] != feature)
+    {
+      f++;
+    }
+    if(f == numFeatures)
+    {
+      features[f] = feature;
+      numFeatures++;
+    }
+    counts[f]++;
+    if(counts[f] > most)
+    {
+      most = counts[f];
+      best = neighpoint;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief The FindFrontierImpl class collects the unassigned Cells that touch a source Cell,
+ * one Z slab at a time so that each slab's list is already in memory order.
+ */
+class FindFrontierImpl
+{
+public:
+  FindFrontierImpl(const int32_t* featureIds, const int64_t* dims, int32_t minSourceFeatureId, std::vector<std::vector<int64_t>>* slabs)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_MinSourceFeatureId(minSourceFeatureId)
+  , m_Slabs(slabs)
+  {
+  }
+  virtual ~FindFrontierImpl() = default;
+
+  void compute(int64_t zStart, int64_t zEnd) const
+  {
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    for(int64_t z = zStart; z < zEnd; z++)
+    {
+      std::vector<int64_t>& slab = (*m_Slabs)[z];
+      for(int64_t index = z * sliceSize; index < (z + 1) * sliceSize; index++)
+      {
+        if(m_FeatureIds[index] < 0 && findBestNeighbor(m_FeatureIds, m_Dims, m_MinSourceFeatureId, index) >= 0)
+        {
+          slab.push_back(index);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  const int64_t* m_Dims;
+  int32_t m_MinSourceFeatureId;
+  std::vector<std::vector<int64_t>>* m_Slabs;
+};
+
+/**
+ * @brief The ChooseNeighborsImpl class picks the source neighbor of every frontier Cell. Only
+ * the Feature Ids are read, so all choices of one iteration see the same state.
+ */
+class ChooseNeighborsImpl
+{
+public:
+  ChooseNeighborsImpl(const int32_t* featureIds, const int64_t* dims, int32_t minSourceFeatureId, const int64_t* frontier, int64_t* choices)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_MinSourceFeatureId(minSourceFeatureId)
+  , m_Frontier(frontier)
+  , m_Choices(choices)
+  {
+  }
+  virtual ~ChooseNeighborsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      m_Choices[t] = findBestNeighbor(m_FeatureIds, m_Dims, m_MinSourceFeatureId, m_Frontier[t]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  const int64_t* m_Dims;
+  int32_t m_MinSourceFeatureId;
+  const int64_t* m_Frontier;
+  int64_t* m_Choices;
+};
+
+/**
+ * @brief The ApplyChoicesImpl class moves the Feature Id of the chosen neighbor into each
+ * frontier Cell and records the original Cell that the data will be gathered from. A chosen
+ * neighbor is never itself part of the frontier, so the writes never alias the reads.
+ */
+class ApplyChoicesImpl
+{
+public:
+  ApplyChoicesImpl(int32_t* featureIds, const int64_t* frontier, const int64_t* choices, int64_t* sources)
+  : m_FeatureIds(featureIds)
+  , m_Frontier(frontier)
+  , m_Choices(choices)
+  , m_Sources(sources)
+  {
+  }
+  virtual ~ApplyChoicesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      int64_t neighbor = m_Choices[t];
+      if(neighbor < 0)
+      {
+        continue;
+      }
+      int64_t index = m_Frontier[t];
+      m_FeatureIds[index] = m_FeatureIds[neighbor];
+      m_Sources[index] = (m_Sources[neighbor] >= 0) ? m_Sources[neighbor] : neighbor;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds;
+  const int64_t* m_Frontier;
+  const int64_t* m_Choices;
+  int64_t* m_Sources;
+};
+
+/**
+ * @brief The GatherTuplesImpl class copies the raw bytes of each source tuple into its
+ * reassigned Cell. Sources are never reassigned themselves, so the copies are independent.
+ */
+class GatherTuplesImpl
+{
+public:
+  GatherTuplesImpl(uint8_t* data, size_t tupleBytes, const int64_t* destinations, const int64_t* sources)
+  : m_Data(data)
+  , m_TupleBytes(tupleBytes)
+  , m_Destinations(destinations)
+  , m_Sources(sources)
+  {
+  }
+  virtual ~GatherTuplesImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      size_t destination = static_cast<size_t>(m_Destinations[t]);
+      size_t source = static_cast<size_t>(m_Sources[destination]);
+      ::memcpy(m_Data + destination * m_TupleBytes, m_Data + source * m_TupleBytes, m_TupleBytes);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  uint8_t* m_Data;
+  size_t m_TupleBytes;
+  const int64_t* m_Destinations;
+  const int64_t* m_Sources;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FrontierCellAssignment::FrontierCellAssignment(int32_t* featureIds, size_t dims[3], int32_t minSourceFeatureId)
+: m_FeatureIds(featureIds)
+, m_MinSourceFeatureId(minSourceFeatureId)
+{
+  m_Dims[0] = static_cast<int64_t>(dims[0]);
+  m_Dims[1] = static_cast<int64_t>(dims[1]);
+  m_Dims[2] = static_cast<int64_t>(dims[2]);
+  m_TotalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FrontierCellAssignment::~FrontierCellAssignment() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FrontierCellAssignment::getNumberOfIterations() const
+{
+  return m_NumberOfIterations;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t FrontierCellAssignment::getSource(size_t index) const
+{
+  if(index >= m_Sources.size())
+  {
+    return -1;
+  }
+  return m_Sources[index];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FrontierCellAssignment::findInitialFrontier()
+{
+  std::vector<std::vector<int64_t>> slabs(static_cast<size_t>(m_Dims[2]));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, m_Dims[2]), FindFrontierImpl(m_FeatureIds, m_Dims, m_MinSourceFeatureId, &slabs), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindFrontierImpl serial(m_FeatureIds, m_Dims, m_MinSourceFeatureId, &slabs);
+    serial.compute(0, m_Dims[2]);
+  }
+
+  size_t frontierSize = 0;
+  for(const auto& slab : slabs)
+  {
+    frontierSize += slab.size();
+  }
+  m_Frontier.clear();
+  m_Frontier.reserve(frontierSize);
+  for(const auto& slab : slabs)
+  {
+    m_Frontier.insert(m_Frontier.end(), slab.begin(), slab.end());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FrontierCellAssignment::advanceFrontier(const std::vector<int64_t>& choices)
+{
+  std::vector<int64_t> next;
+  next.reserve(m_Frontier.size());
+
+  const int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+  for(size_t t = 0; t < m_Frontier.size(); t++)
+  {
+    if(choices[t] < 0)
+    {
+      continue;
+    }
+    int64_t index = m_Frontier[t];
+    int64_t column = index % m_Dims[0];
+    int64_t row = (index / m_Dims[0]) % m_Dims[1];
+    int64_t plane = index / (m_Dims[0] * m_Dims[1]);
+    const bool inBounds[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+    for(int32_t l = 0; l < 6; l++)
+    {
+      if(inBounds[l] && m_FeatureIds[index + neighpoints[l]] < 0)
+      {
+        next.push_back(index + neighpoints[l]);
+      }
+    }
+  }
+
+  // Keep the frontier sorted so that each iteration walks the volume in memory order
+  std::sort(next.begin(), next.end());
+  next.erase(std::unique(next.begin(), next.end()), next.end());
+  m_Frontier.swap(next);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FrontierCellAssignment::assign()
+{
+  m_Sources.assign(static_cast<size_t>(m_TotalPoints), -1);
+  m_Destinations.clear();
+  m_NumberOfIterations = 0;
+
+  findInitialFrontier();
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+#endif
+
+  std::vector<int64_t> choices;
+  while(!m_Frontier.empty())
+  {
+    m_NumberOfIterations++;
+    size_t count = m_Frontier.size();
+    choices.assign(count, -1);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, count), ChooseNeighborsImpl(m_FeatureIds, m_Dims, m_MinSourceFeatureId, m_Frontier.data(), choices.data()), tbb::auto_partitioner());
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, count), ApplyChoicesImpl(m_FeatureIds, m_Frontier.data(), choices.data(), m_Sources.data()), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      ChooseNeighborsImpl chooser(m_FeatureIds, m_Dims, m_MinSourceFeatureId, m_Frontier.data(), choices.data());
+      chooser.compute(0, count);
+      ApplyChoicesImpl applier(m_FeatureIds, m_Frontier.data(), choices.data(), m_Sources.data());
+      applier.compute(0, count);
+    }
+
+    for(size_t t = 0; t < count; t++)
+    {
+      if(choices[t] >= 0)
+      {
+        m_Destinations.push_back(m_Frontier[t]);
+      }
+    }
+
+    advanceFrontier(choices);
+  }
+
+  return m_Destinations.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FrontierCellAssignment::copyCellData(const AttributeMatrix::Pointer& cellAttrMat)
+{
+  if(m_Destinations.empty() || nullptr == cellAttrMat.get())
+  {
+    return;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+#endif
+
+  size_t count = m_Destinations.size();
+  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  for(const auto& voxelArrayName : voxelArrayNames)
+  {
+    IDataArray::Pointer p = cellAttrMat->getAttributeArray(voxelArrayName);
+    void* voidPtr = p->getVoidPointer(0);
+
+    // Arrays whose tuples are not plain contiguous values fall back to the per tuple copy
+    if(nullptr == voidPtr || TemplateHelpers::CanDynamicCast<StringDataArray>()(p))
+    {
+      for(size_t t = 0; t < count; t++)
+      {
+        size_t destination = static_cast<size_t>(m_Destinations[t]);
+        p->copyTuple(static_cast<size_t>(m_Sources[destination]), destination);
+      }
+      continue;
+    }
+
+    uint8_t* data = reinterpret_cast<uint8_t*>(voidPtr);
+    size_t tupleBytes = p->getTypeSize() * static_cast<size_t>(p->getNumberOfComponents());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, count), GatherTuplesImpl(data, tupleBytes, m_Destinations.data(), m_Sources.data()), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      GatherTuplesImpl serial(data, tupleBytes, m_Destinations.data(), m_Sources.data());
+      serial.compute(0, count);
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+/**
+ * @brief The FrontierCellAssignment class grows the surrounding Features into every Cell of an
+ * ImageGeom whose Feature Id is negative. It is the shared engine behind the "assign bad points"
+ * step of MinSize, MinNeighbors and FillBadData.
+ *
+ * Each iteration reproduces one sweep of the original algorithm: every unassigned Cell picks the
+ * face neighbor whose Feature occurs most often among its 6 face neighbors, using only the state
+ * from the previous iteration. Instead of sweeping the whole volume, only the active frontier
+ * (unassigned Cells touching an assigned Cell) is visited, and it is processed in parallel in
+ * memory order. The Feature Ids are updated as the front advances, but the remaining Cell arrays
+ * are left untouched until copyCellData() performs a single gather from the original source Cell
+ * of every reassigned Cell.
+ */
+class FrontierCellAssignment
+{
+public:
+  /**
+   * @brief FrontierCellAssignment
+   * @param featureIds Cell Feature Ids; negative values mark Cells to be reassigned
+   * @param dims Dimensions of the ImageGeom
+   * @param minSourceFeatureId Smallest Feature Id that may be grown into unassigned Cells
+   */
+  FrontierCellAssignment(int32_t* featureIds, size_t dims[3], int32_t minSourceFeatureId);
+  virtual ~FrontierCellAssignment();
+
+  /**
+   * @brief assign Advances the front until no unassigned Cell touches an assigned Cell. Only
+   * the Feature Ids array is modified.
+   * @return Number of Cells that were reassigned
+   */
+  size_t assign();
+
+  /**
+   * @brief copyCellData Copies, for every array in the supplied Cell AttributeMatrix, the tuple
+   * of each reassigned Cell's source Cell into the reassigned Cell
+   * @param cellAttrMat Cell AttributeMatrix that owns the Feature Ids array
+   */
+  void copyCellData(const AttributeMatrix::Pointer& cellAttrMat);
+
+  /**
+   * @brief getNumberOfIterations Returns how many sweeps the last call to assign() needed
+   * @return
+   */
+  size_t getNumberOfIterations() const;
+
+  /**
+   * @brief getSource Returns the Cell whose data was copied into the given Cell, or -1 if the
+   * Cell was not reassigned
+   * @param index Cell index
+   * @return
+   */
+  int64_t getSource(size_t index) const;
+
+protected:
+  /**
+   * @brief findInitialFrontier Collects, in memory order, all unassigned Cells that have at least
+   * one source face neighbor
+   */
+  void findInitialFrontier();
+
+  /**
+   * @brief advanceFrontier Replaces the frontier with the unassigned face neighbors of the Cells
+   * reassigned in the current iteration
+   * @param choices Chosen neighbor for each Cell of the current frontier
+   */
+  void advanceFrontier(const std::vector<int64_t>& choices);
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  int64_t m_Dims[3] = {0, 0, 0};
+  int64_t m_TotalPoints = 0;
+  int32_t m_MinSourceFeatureId = 0;
+  size_t m_NumberOfIterations = 0;
+
+  std::vector<int64_t> m_Frontier;
+  std::vector<int64_t> m_Sources;
+  std::vector<int64_t> m_Destinations;
+
+public:
+  FrontierCellAssignment(const FrontierCellAssignment&) = delete;            // Copy Constructor Not Implemented
+  FrontierCellAssignment(FrontierCellAssignment&&) = delete;                 // Move Constructor Not Implemented
+  FrontierCellAssignment& operator=(const FrontierCellAssignment&) = delete; // Copy Assignment Not Implemented
+  FrontierCellAssignment& operator=(FrontierCellAssignment&&) = delete;      // Move Assignment Not Implemented
+};
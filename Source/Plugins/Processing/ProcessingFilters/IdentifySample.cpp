@@ -34,6 +34,16 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "IdentifySample.h"
 
+#include <algorithm>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
@@ -45,11 +55,378 @@
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
+namespace
+{
+/**
+ * @brief The VoxelRun struct is a run of consecutive Cells along X, [start, start + length), that share the
+ * same mask value. The row of the run is implied by RunLabels::rowOffsets.
+ */
+struct VoxelRun
+{
+  uint32_t start;
+  uint32_t length;
+};
+
+/**
+ * @brief The RunLabels struct holds the runs of every X row of the volume. While labeling, components is the
+ * union-find forest that connects the runs; afterwards it holds the component number of every run.
+ * Components are numbered in the order of their lowest run index (and therefore of their lowest Cell
+ * index), and sizes holds the number of Cells in each component.
+ */
+struct RunLabels
+{
+  std::vector<int64_t> rowOffsets;
+  std::vector<VoxelRun> runs;
+  std::vector<uint32_t> components;
+  std::vector<uint64_t> sizes;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint32_t findRoot(uint32_t* parents, uint32_t run)
+{
+  while(parents[run] != run)
+  {
+    parents[run] = parents[parents[run]];
+    run = parents[run];
+  }
+  return run;
+}
+
+// -----------------------------------------------------------------------------
+// Joins two runs, always keeping the lower run index as the root
+// -----------------------------------------------------------------------------
+void unionRuns(uint32_t* parents, uint32_t run0, uint32_t run1)
+{
+  run0 = findRoot(parents, run0);
+  run1 = findRoot(parents, run1);
+  if(run0 < run1)
+  {
+    parents[run1] = run0;
+  }
+  else if(run1 < run0)
+  {
+    parents[run0] = run1;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Joins every pair of overlapping runs between two rows that are face neighbors
+// -----------------------------------------------------------------------------
+void mergeRows(const VoxelRun* runs, const int64_t* rowOffsets, int64_t row0, int64_t row1, uint32_t* parents)
+{
+  int64_t i = rowOffsets[row0];
+  int64_t iEnd = rowOffsets[row0 + 1];
+  int64_t j = rowOffsets[row1];
+  int64_t jEnd = rowOffsets[row1 + 1];
+  while(i < iEnd && j < jEnd)
+  {
+    uint32_t iEndX = runs[i].start + runs[i].length;
+    uint32_t jEndX = runs[j].start + runs[j].length;
+    if(runs[i].start < jEndX && runs[j].start < iEndX)
+    {
+      unionRuns(parents, static_cast<uint32_t>(i), static_cast<uint32_t>(j));
+    }
+    if(iEndX < jEndX)
+    {
+      i++;
+    }
+    else
+    {
+      j++;
+    }
+  }
+}
+}
+
+/**
+ * @brief The FindRunsImpl class implements a threaded algorithm that extracts the runs of Cells along X that
+ * match a given mask value. With no run storage it only counts the runs of each row.
+ */
+class FindRunsImpl
+{
+  const bool* m_Mask;
+  bool m_Value;
+  int64_t m_XPoints;
+  int64_t* m_RowOffsets;
+  VoxelRun* m_Runs;
+
+public:
+  FindRunsImpl(const bool* mask, bool value, int64_t xPoints, int64_t* rowOffsets, VoxelRun* runs)
+  : m_Mask(mask)
+  , m_Value(value)
+  , m_XPoints(xPoints)
+  , m_RowOffsets(rowOffsets)
+  , m_Runs(runs)
+  {
+  }
+  virtual ~FindRunsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t row = start; row < end; row++)
+    {
+      const bool* mask = m_Mask + row * m_XPoints;
+      int64_t count = 0;
+      int64_t x = 0;
+      while(x < m_XPoints)
+      {
+        if(mask[x] != m_Value)
+        {
+          x++;
+          continue;
+        }
+        int64_t runStart = x;
+        while(x < m_XPoints && mask[x] == m_Value)
+        {
+          x++;
+        }
+        if(nullptr != m_Runs)
+        {
+          m_Runs[m_RowOffsets[row] + count].start = static_cast<uint32_t>(runStart);
+          m_Runs[m_RowOffsets[row] + count].length = static_cast<uint32_t>(x - runStart);
+        }
+        count++;
+      }
+      if(nullptr == m_Runs)
+      {
+        m_RowOffsets[row + 1] = count;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The LabelSlabsImpl class implements a threaded algorithm that connects the runs inside each slab
+ * of Z planes. Slabs own disjoint ranges of runs, so they can be labeled concurrently; the runs that
+ * straddle two slabs are joined afterwards.
+ */
+class LabelSlabsImpl
+{
+  const VoxelRun* m_Runs;
+  const int64_t* m_RowOffsets;
+  uint32_t* m_Parents;
+  const int64_t* m_SlabPlanes;
+  int64_t m_YPoints;
+  bool m_SliceBySlice;
+
+public:
+  LabelSlabsImpl(const VoxelRun* runs, const int64_t* rowOffsets, uint32_t* parents, const int64_t* slabPlanes, int64_t yPoints, bool sliceBySlice)
+  : m_Runs(runs)
+  , m_RowOffsets(rowOffsets)
+  , m_Parents(parents)
+  , m_SlabPlanes(slabPlanes)
+  , m_YPoints(yPoints)
+  , m_SliceBySlice(sliceBySlice)
+  {
+  }
+  virtual ~LabelSlabsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      for(int64_t plane = m_SlabPlanes[slab]; plane < m_SlabPlanes[slab + 1]; plane++)
+      {
+        for(int64_t y = 0; y < m_YPoints; y++)
+        {
+          int64_t row = plane * m_YPoints + y;
+          for(int64_t run = m_RowOffsets[row]; run < m_RowOffsets[row + 1]; run++)
+          {
+            m_Parents[run] = static_cast<uint32_t>(run);
+          }
+          if(y > 0)
+          {
+            mergeRows(m_Runs, m_RowOffsets, row, row - 1, m_Parents);
+          }
+          if(!m_SliceBySlice && plane > m_SlabPlanes[slab])
+          {
+            mergeRows(m_Runs, m_RowOffsets, row, row - m_YPoints, m_Parents);
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The AssignRunsImpl class implements a threaded algorithm that writes a mask value into every
+ * run whose component has been selected
+ */
+class AssignRunsImpl
+{
+  const RunLabels& m_Labels;
+  const std::vector<uint8_t>& m_Selected;
+  bool m_Value;
+  int64_t m_XPoints;
+  bool* m_Mask;
+
+public:
+  AssignRunsImpl(const RunLabels& labels, const std::vector<uint8_t>& selected, bool value, int64_t xPoints, bool* mask)
+  : m_Labels(labels)
+  , m_Selected(selected)
+  , m_Value(value)
+  , m_XPoints(xPoints)
+  , m_Mask(mask)
+  {
+  }
+  virtual ~AssignRunsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t row = start; row < end; row++)
+    {
+      bool* mask = m_Mask + row * m_XPoints;
+      for(int64_t run = m_Labels.rowOffsets[row]; run < m_Labels.rowOffsets[row + 1]; run++)
+      {
+        if(m_Selected[m_Labels.components[run]] != 0)
+        {
+          const VoxelRun& voxelRun = m_Labels.runs[run];
+          std::fill(mask + voxelRun.start, mask + voxelRun.start + voxelRun.length, m_Value);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Labels the face connected components of the Cells whose mask equals value. Runs are found row by
+// row, joined slab by slab and then across slab boundaries; the components are numbered and their
+// sizes accumulated while the forest is flattened. In slice-by-slice mode no two Z planes are joined.
+// Returns false if the runs cannot be addressed with 32 bit indices.
+// -----------------------------------------------------------------------------
+bool labelComponents(const bool* mask, bool value, const int64_t dims[3], bool sliceBySlice, RunLabels& labels)
+{
+  size_t numRows = static_cast<size_t>(dims[1] * dims[2]);
+  labels.rowOffsets.assign(numRows + 1, 0);
+  int64_t numSlabs = 1;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlabs = std::min(dims[2], static_cast<int64_t>(4 * init.default_num_threads()));
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), FindRunsImpl(mask, value, dims[0], labels.rowOffsets.data(), nullptr), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindRunsImpl serial(mask, value, dims[0], labels.rowOffsets.data(), nullptr);
+    serial.compute(0, numRows);
+  }
+
+  for(size_t row = 0; row < numRows; row++)
+  {
+    labels.rowOffsets[row + 1] += labels.rowOffsets[row];
+  }
+  size_t numRuns = static_cast<size_t>(labels.rowOffsets[numRows]);
+  if(numRuns > std::numeric_limits<uint32_t>::max() || dims[0] > std::numeric_limits<uint32_t>::max())
+  {
+    return false;
+  }
+  labels.runs.resize(numRuns);
+  labels.components.resize(numRuns);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), FindRunsImpl(mask, value, dims[0], labels.rowOffsets.data(), labels.runs.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindRunsImpl serial(mask, value, dims[0], labels.rowOffsets.data(), labels.runs.data());
+    serial.compute(0, numRows);
+  }
+
+  std::vector<int64_t> slabPlanes(numSlabs + 1, 0);
+  for(int64_t slab = 0; slab <= numSlabs; slab++)
+  {
+    slabPlanes[slab] = slab * dims[2] / numSlabs;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs),
+                      LabelSlabsImpl(labels.runs.data(), labels.rowOffsets.data(), labels.components.data(), slabPlanes.data(), dims[1], sliceBySlice), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    LabelSlabsImpl serial(labels.runs.data(), labels.rowOffsets.data(), labels.components.data(), slabPlanes.data(), dims[1], sliceBySlice);
+    serial.compute(0, numSlabs);
+  }
+
+  // Join the first plane of every slab to the last plane of the slab below it
+  if(!sliceBySlice)
+  {
+    for(int64_t slab = 1; slab < numSlabs; slab++)
+    {
+      int64_t plane = slabPlanes[slab];
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        int64_t row = plane * dims[1] + y;
+        mergeRows(labels.runs.data(), labels.rowOffsets.data(), row, row - dims[1], labels.components.data());
+      }
+    }
+  }
+
+  // Every parent has a lower index than its child, so a single ascending sweep numbers each root and
+  // hands every other run the number its parent has already received
+  labels.sizes.clear();
+  for(size_t run = 0; run < numRuns; run++)
+  {
+    uint32_t parent = labels.components[run];
+    if(parent == run)
+    {
+      labels.components[run] = static_cast<uint32_t>(labels.sizes.size());
+      labels.sizes.push_back(0);
+    }
+    else
+    {
+      labels.components[run] = labels.components[parent];
+    }
+    labels.sizes[labels.components[run]] += labels.runs[run].length;
+  }
+  return true;
+}
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 IdentifySample::IdentifySample()
 : m_FillHoles(false)
+, m_SliceBySlice(false)
 , m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
 , m_GoodVoxels(nullptr)
 {
@@ -66,6 +443,7 @@ void IdentifySample::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Fill Holes in Largest Feature", FillHoles, FilterParameter::Parameter, IdentifySample));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Process Data Slice-By-Slice", SliceBySlice, FilterParameter::Parameter, IdentifySample));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -82,6 +460,7 @@ void IdentifySample::readFilterParameters(AbstractFilterParametersReader* reader
 {
   reader->openFilterGroup(this, index);
   setFillHoles(reader->readValue("FillHoles", getFillHoles()));
+  setSliceBySlice(reader->readValue("SliceBySlice", getSliceBySlice()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   reader->closeFilterGroup();
 }
@@ -139,7 +518,6 @@ void IdentifySample::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_GoodVoxelsArrayPath.getDataContainerName());
-  int64_t totalPoints = static_cast<int64_t>(m_GoodVoxelsPtr.lock()->getNumberOfTuples());
 
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -148,169 +526,124 @@ void IdentifySample::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  int64_t xp = dims[0];
-  int64_t yp = dims[1];
-  int64_t zp = dims[2];
-
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
-  std::vector<int64_t> currentvlist;
-  std::vector<bool> checked(totalPoints, false);
-  std::vector<bool> sample(totalPoints, false);
-  int64_t biggestBlock = 0;
-  size_t count = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-  int64_t index = 0;
-
-  // In this loop over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
-  // are flipped to be called 'bad' voxels or 'not sample'
-  for(int64_t i = 0; i < totalPoints; i++)
-  {
-    if(checked[i] == false && m_GoodVoxels[i] == true)
+  int64_t numRows = dims[1] * dims[2];
+  RunLabels labels;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // In this pass over the data we are finding the biggest contiguous set of GoodVoxels (per slice when
+  // working slice by slice) and calling that the 'sample'. All GoodVoxels that do not touch the 'sample'
+  // are flipped to be called 'bad' voxels or 'not sample'. Ties go to the set that starts last.
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Largest Feature");
+  if(!labelComponents(m_GoodVoxels, true, dims, m_SliceBySlice, labels))
+  {
+    QString ss = QObject::tr("The mask has too many runs of Cells to be labeled");
+    setErrorCondition(-7000);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Components are numbered in run order, so the run that carries the next unseen number is the first
+  // run of its component
+  int64_t numGroups = m_SliceBySlice ? dims[2] : 1;
+  std::vector<uint64_t> biggestBlock(numGroups, 0);
+  std::vector<int64_t> biggestComponent(numGroups, -1);
+  uint32_t nextComponent = 0;
+  for(int64_t row = 0; row < numRows; row++)
+  {
+    int64_t group = m_SliceBySlice ? row / dims[1] : 0;
+    for(int64_t run = labels.rowOffsets[row]; run < labels.rowOffsets[row + 1]; run++)
     {
-      currentvlist.push_back(i);
-      count = 0;
-      while(count < currentvlist.size())
+      if(labels.components[run] != nextComponent)
       {
-        index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for(int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (zp - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && row == (yp - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && column == (xp - 1))
-          {
-            good = 0;
-          }
-          if(good == 1 && checked[neighbor] == false && m_GoodVoxels[neighbor] == true)
-          {
-            currentvlist.push_back(neighbor);
-            checked[neighbor] = true;
-          }
-        }
-        count++;
+        continue;
       }
-      if(static_cast<int64_t>(currentvlist.size()) >= biggestBlock)
+      if(labels.sizes[nextComponent] >= biggestBlock[group])
       {
-        biggestBlock = currentvlist.size();
-        sample.assign(totalPoints, false);
-        for(int64_t j = 0; j < biggestBlock; j++)
-        {
-          sample[currentvlist[j]] = true;
-        }
+        biggestBlock[group] = labels.sizes[nextComponent];
+        biggestComponent[group] = nextComponent;
       }
-      currentvlist.clear();
+      nextComponent++;
     }
   }
-  for(int64_t i = 0; i < totalPoints; i++)
+
+  std::vector<uint8_t> selected(labels.sizes.size(), 1);
+  for(int64_t group = 0; group < numGroups; group++)
   {
-    if(sample[i] == false && m_GoodVoxels[i] == true)
+    if(biggestComponent[group] >= 0)
     {
-      m_GoodVoxels[i] = false;
+      selected[biggestComponent[group]] = 0;
     }
   }
-  sample.clear();
-  checked.assign(totalPoints, false);
 
-  // In this loop we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), AssignRunsImpl(labels, selected, false, dims[0], m_GoodVoxels), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    AssignRunsImpl serial(labels, selected, false, dims[0], m_GoodVoxels);
+    serial.compute(0, numRows);
+  }
+
+  // In this pass we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
   // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
   if(m_FillHoles == true)
   {
-    bool touchesBoundary = false;
-    for(int64_t i = 0; i < totalPoints; i++)
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Filling Holes");
+    if(!labelComponents(m_GoodVoxels, false, dims, m_SliceBySlice, labels))
+    {
+      QString ss = QObject::tr("The mask has too many runs of Cells to be labeled");
+      setErrorCondition(-7000);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    if(getCancel())
     {
-      if(checked[i] == false && m_GoodVoxels[i] == false)
+      return;
+    }
+
+    selected.assign(labels.sizes.size(), 1);
+    for(int64_t row = 0; row < numRows; row++)
+    {
+      int64_t y = row % dims[1];
+      int64_t plane = row / dims[1];
+      bool rowOnBoundary = (y == 0 || y == dims[1] - 1);
+      if(!m_SliceBySlice && (plane == 0 || plane == dims[2] - 1))
       {
-        currentvlist.push_back(i);
-        count = 0;
-        touchesBoundary = false;
-        while(count < currentvlist.size())
-        {
-          index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
-          if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
-          {
-            touchesBoundary = true;
-          }
-          for(int32_t j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (zp - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (yp - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (xp - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && checked[neighbor] == false && m_GoodVoxels[neighbor] == false)
-            {
-              currentvlist.push_back(neighbor);
-              checked[neighbor] = true;
-            }
-          }
-          count++;
-        }
-        if(touchesBoundary == false)
+        rowOnBoundary = true;
+      }
+      for(int64_t run = labels.rowOffsets[row]; run < labels.rowOffsets[row + 1]; run++)
+      {
+        const VoxelRun& voxelRun = labels.runs[run];
+        if(rowOnBoundary || voxelRun.start == 0 || voxelRun.start + voxelRun.length == dims[0])
         {
-          for(size_t j = 0; j < currentvlist.size(); j++)
-          {
-            m_GoodVoxels[currentvlist[j]] = true;
-          }
+          selected[labels.components[run]] = 0;
         }
-        currentvlist.clear();
       }
     }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), AssignRunsImpl(labels, selected, true, dims[0], m_GoodVoxels), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      AssignRunsImpl serial(labels, selected, true, dims[0], m_GoodVoxels);
+      serial.compute(0, numRows);
+    }
   }
-  checked.clear();
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
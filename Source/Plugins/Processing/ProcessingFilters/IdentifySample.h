@@ -52,6 +52,7 @@ class Processing_EXPORT IdentifySample : public AbstractFilter
   Q_OBJECT
     PYB11_CREATE_BINDINGS(IdentifySample SUPERCLASS AbstractFilter)
     PYB11_PROPERTY(bool FillHoles READ getFillHoles WRITE setFillHoles)
+    PYB11_PROPERTY(bool SliceBySlice READ getSliceBySlice WRITE setSliceBySlice)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
 public:
   SIMPL_SHARED_POINTERS(IdentifySample)
@@ -63,6 +64,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, FillHoles)
   Q_PROPERTY(bool FillHoles READ getFillHoles WRITE setFillHoles)
 
+  SIMPL_FILTER_PARAMETER(bool, SliceBySlice)
+  Q_PROPERTY(bool SliceBySlice READ getSliceBySlice WRITE setSliceBySlice)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, GoodVoxelsArrayPath)
   Q_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
 
@@ -194,8 +194,6 @@ protected:
   QVector<bool> remove_smallfeatures();
 
 private:
-  int32_t* m_Neighbors = nullptr;
-
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeaturePhases)
   DEFINE_DATAARRAY_VARIABLE(int32_t, NumCells)
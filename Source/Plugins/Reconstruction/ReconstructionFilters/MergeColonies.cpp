@@ -415,7 +415,16 @@ bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighbor
     uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
     if(phase1 == phase2 && (phase1 == Ebsd::CrystalStructure::Hexagonal_High))
     {
-      w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+      int64_t entry = (nullptr != m_MisorientationCache.get()) ? m_MisorientationCache->findEntry(referenceFeature, neighborFeature) : -1;
+      if(entry >= 0)
+      {
+        w = m_MisorientationCache->getAngle(static_cast<size_t>(entry));
+        m_MisorientationCache->getAxis(static_cast<size_t>(entry), n1, n2, n3);
+      }
+      else
+      {
+        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+      }
 
       FOrientArrayType ax(n1, n2, n3, w);
       FOrientArrayType rod(4);
@@ -621,7 +630,14 @@ void MergeColonies::execute()
 
   m_AxisToleranceRad = m_AxisTolerance * SIMPLib::Constants::k_Pi / 180.0f;
 
+  // Look the misorientations between contiguous neighbors up instead of computing them one pair at a time while the
+  // groups grow; the table is shared with the other filters that work on the same neighbor list
+  QVector<size_t> cDims(1, 1);
+  NeighborList<int32_t>::Pointer neighborList = getDataContainerArray()->getPrereqArrayFromPath<NeighborList<int32_t>, AbstractFilter>(this, getContiguousNeighborListArrayPath(), cDims);
+  m_MisorientationCache = FeatureMisorientationCache::Get(neighborList, m_AvgQuatsPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock());
+
   GroupFeatures::execute();
+  m_MisorientationCache = FeatureMisorientationCache::NullPointer();
 
   size_t totalFeatures = m_ActivePtr.lock()->getNumberOfTuples();
   if(totalFeatures < 2)
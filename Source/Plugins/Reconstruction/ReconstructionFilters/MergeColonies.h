@@ -40,6 +40,7 @@
 #include "SIMPLib/SIMPLib.h"
 
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Utilities/FeatureMisorientationCache.h"
 
 #include "Reconstruction/ReconstructionFilters/GroupFeatures.h"
 
@@ -231,6 +232,7 @@ private:
   DEFINE_DATAARRAY_VARIABLE(bool, Active)
 
   QVector<LaueOps::Pointer> m_OrientationOps;
+  FeatureMisorientationCache::Pointer m_MisorientationCache;
 
   float m_AxisToleranceRad;
 
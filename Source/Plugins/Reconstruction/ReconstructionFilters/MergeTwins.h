@@ -40,6 +40,7 @@
 #include "SIMPLib/SIMPLib.h"
 
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Utilities/FeatureMisorientationCache.h"
 
 #include "Reconstruction/ReconstructionFilters/GroupFeatures.h"
 
@@ -206,6 +207,7 @@ private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureParentIds)
 
   QVector<LaueOps::Pointer> m_OrientationOps;
+  FeatureMisorientationCache::Pointer m_MisorientationCache;
 
   float m_AxisToleranceRad = 0.0f;
 
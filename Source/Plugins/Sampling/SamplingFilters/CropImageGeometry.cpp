@@ -35,7 +35,21 @@
 
 #include "CropImageGeometry.h"
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
@@ -51,6 +65,92 @@
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
+/**
+ * @brief The CropImageGeometryImpl class copies the cropped region of one Cell array one X row
+ * at a time. Plain arrays are moved with a single memmove per row; when the source and
+ * destination are the same array the rows are compacted toward the front of the array, which
+ * is safe because a destination row never starts after its source row. The filter is asked for
+ * cancellation before, and told about the progress after, every Z plane.
+ */
+class CropImageGeometryImpl
+{
+public:
+  CropImageGeometryImpl(CropImageGeometry* filter, IDataArray::Pointer source, IDataArray::Pointer destination, int64_t srcDims[3], int64_t cropMin[3], int64_t cropDims[3])
+  : m_Filter(filter)
+  , m_Source(source)
+  , m_Destination(destination)
+  {
+    for(size_t i = 0; i < 3; i++)
+    {
+      m_SrcDims[i] = srcDims[i];
+      m_CropMin[i] = cropMin[i];
+      m_CropDims[i] = cropDims[i];
+    }
+    m_Contiguous = (nullptr != m_Source->getVoidPointer(0) && nullptr != m_Destination->getVoidPointer(0) && !TemplateHelpers::CanDynamicCast<StringDataArray>()(m_Source));
+    m_TupleBytes = m_Source->getTypeSize() * static_cast<size_t>(m_Source->getNumberOfComponents());
+  }
+  virtual ~CropImageGeometryImpl() = default;
+
+  void compute(int64_t zStart, int64_t zEnd) const
+  {
+    uint8_t* srcData = m_Contiguous ? reinterpret_cast<uint8_t*>(m_Source->getVoidPointer(0)) : nullptr;
+    uint8_t* destData = m_Contiguous ? reinterpret_cast<uint8_t*>(m_Destination->getVoidPointer(0)) : nullptr;
+    size_t rowBytes = static_cast<size_t>(m_CropDims[0]) * m_TupleBytes;
+    bool inPlace = (m_Source == m_Destination);
+
+    for(int64_t z = zStart; z < zEnd; z++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      for(int64_t y = 0; y < m_CropDims[1]; y++)
+      {
+        size_t srcIndex = static_cast<size_t>(((z + m_CropMin[2]) * m_SrcDims[1] + (y + m_CropMin[1])) * m_SrcDims[0] + m_CropMin[0]);
+        size_t destIndex = static_cast<size_t>((z * m_CropDims[1] + y) * m_CropDims[0]);
+        if(m_Contiguous)
+        {
+          ::memmove(destData + destIndex * m_TupleBytes, srcData + srcIndex * m_TupleBytes, rowBytes);
+        }
+        else if(inPlace)
+        {
+          for(int64_t x = 0; x < m_CropDims[0]; x++)
+          {
+            m_Destination->copyTuple(srcIndex + x, destIndex + x);
+          }
+        }
+        else
+        {
+          m_Destination->copyFromArray(destIndex, m_Source, srcIndex, static_cast<size_t>(m_CropDims[0]));
+        }
+      }
+      m_Filter->updateProgress(1);
+    }
+  }
+
+  void operator()() const
+  {
+    compute(0, m_CropDims[2]);
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  CropImageGeometry* m_Filter = nullptr;
+  IDataArray::Pointer m_Source;
+  IDataArray::Pointer m_Destination;
+  int64_t m_SrcDims[3] = {0, 0, 0};
+  int64_t m_CropMin[3] = {0, 0, 0};
+  int64_t m_CropDims[3] = {0, 0, 0};
+  bool m_Contiguous = false;
+  size_t m_TupleBytes = 0;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -401,7 +501,8 @@ void CropImageGeometry::execute()
   // if(getErrorCondition() < 0) { return; }
 
   DataContainer::Pointer srcCellDataContainer = getDataContainerArray()->getPrereqDataContainer(this, getCellAttributeMatrixPath().getDataContainerName());
-  AttributeMatrix::Pointer cellAttrMat = srcCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
+  AttributeMatrix::Pointer srcCellAttrMat = srcCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
+  AttributeMatrix::Pointer cellAttrMat = srcCellAttrMat;
   DataContainer::Pointer destCellDataContainer = srcCellDataContainer;
 
   if(m_SaveAsNewDataContainer == true)
@@ -416,19 +517,15 @@ void CropImageGeometry::execute()
 
     destCellDataContainer->getGeometryAs<ImageGeom>()->setOrigin(ox, oy, oz);
     destCellDataContainer->getGeometryAs<ImageGeom>()->setResolution(rx, ry, rz);
-
-    AttributeMatrix::Pointer cellAttrMatCopy = cellAttrMat->deepCopy(false);
-    destCellDataContainer->addAttributeMatrix(cellAttrMatCopy->getName(), cellAttrMatCopy);
-    cellAttrMat = destCellDataContainer->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
   }
 
-  if(nullptr == destCellDataContainer.get() || nullptr == cellAttrMat.get() || getErrorCondition() < 0)
+  if(nullptr == destCellDataContainer.get() || nullptr == srcCellAttrMat.get() || getErrorCondition() < 0)
   {
     return;
   }
 
   // No matter where the AM is (same DC or new DC), we have the correct DC and AM pointers...now it's time to crop
-  int64_t totalPoints = cellAttrMat->getNumberOfTuples();
+  int64_t totalPoints = srcCellAttrMat->getNumberOfTuples();
 
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = srcCellDataContainer->getGeometryAs<ImageGeom>()->getDimensions();
@@ -485,36 +582,93 @@ void CropImageGeometry::execute()
   int64_t YP = ((m_YMax - m_YMin) + 1);
   int64_t ZP = ((m_ZMax - m_ZMin) + 1);
 
-  int64_t col = 0, row = 0, plane = 0;
-  int64_t colold = 0, rowold = 0, planeold = 0;
-  int64_t index = 0;
-  int64_t index_old = 0;
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for(int64_t i = 0; i < ZP; i++)
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = XP;
+  tDims[1] = YP;
+  tDims[2] = ZP;
+
+  // When writing into a new Data Container only the cropped region is allocated; the full size
+  // source Attribute Matrix is never duplicated
+  if(m_SaveAsNewDataContainer == true)
+  {
+    cellAttrMat = AttributeMatrix::New(tDims, srcCellAttrMat->getName(), srcCellAttrMat->getType());
+    size_t newTotalPoints = static_cast<size_t>(XP * YP * ZP);
+    QList<QString> srcArrayNames = srcCellAttrMat->getAttributeArrayNames();
+    for(const auto& srcArrayName : srcArrayNames)
+    {
+      IDataArray::Pointer srcArray = srcCellAttrMat->getAttributeArray(srcArrayName);
+      IDataArray::Pointer destArray = srcArray->createNewArray(newTotalPoints, srcArray->getComponentDimensions(), srcArray->getName(), true);
+      cellAttrMat->addAttributeArray(destArray->getName(), destArray);
+    }
+    destCellDataContainer->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+  }
+
+  int64_t srcDims[3] = {dims[0], dims[1], dims[2]};
+  int64_t cropMin[3] = {m_XMin, m_YMin, m_ZMin};
+  int64_t cropDims[3] = {XP, YP, ZP};
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  QList<QString> voxelArrayNames = srcCellAttrMat->getAttributeArrayNames();
+  m_PlanesCompleted = 0;
+  m_TotalPlanes = static_cast<size_t>(voxelArrayNames.size()) * static_cast<size_t>(ZP);
+  m_ProgIncrement = std::max(m_TotalPlanes / 100, static_cast<size_t>(1));
+  m_IncCount = 0;
+  if(m_SaveAsNewDataContainer == true)
   {
-    if(getCancel())
+    // Every destination row is independent, so each array is copied in parallel over Z slabs
+    for(const auto& voxelArrayName : voxelArrayNames)
     {
-      break;
+      if(getCancel())
+      {
+        break;
+      }
+      QString ss = QObject::tr("Cropping Volume || Copying Array '%1'").arg(voxelArrayName);
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      CropImageGeometryImpl impl(this, srcCellAttrMat->getAttributeArray(voxelArrayName), cellAttrMat->getAttributeArray(voxelArrayName), srcDims, cropMin, cropDims);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<int64_t>(0, ZP), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.compute(0, ZP);
+      }
     }
-    QString ss = QObject::tr("Cropping Volume || Slice %1 of %2 Complete").arg(i).arg(ZP);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    planeold = (i + m_ZMin) * (srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints() * srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
-    plane = (i * XP * YP);
-    for(int64_t j = 0; j < YP; j++)
+  }
+  else
+  {
+    // Compacting in place must walk the rows in increasing order, so the parallelism is over the arrays;
+    // every task checks for cancellation and reports its progress between Z planes
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      std::shared_ptr<tbb::task_group> g(new tbb::task_group);
+      for(const auto& voxelArrayName : voxelArrayNames)
+      {
+        IDataArray::Pointer p = cellAttrMat->getAttributeArray(voxelArrayName);
+        g->run(CropImageGeometryImpl(this, p, p, srcDims, cropMin, cropDims));
+      }
+      g->wait();
+    }
+    else
+#endif
     {
-      rowold = (j + m_YMin) * srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints();
-      row = (j * XP);
-      for(int64_t k = 0; k < XP; k++)
+      for(const auto& voxelArrayName : voxelArrayNames)
       {
-        colold = (k + m_XMin);
-        col = k;
-        index_old = planeold + rowold + colold;
-        index = plane + row + col;
-        for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+        if(getCancel())
         {
-          IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-          p->copyTuple(index_old, index);
+          break;
         }
+        QString ss = QObject::tr("Cropping Volume || Compacting Array '%1'").arg(voxelArrayName);
+        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+        IDataArray::Pointer p = cellAttrMat->getAttributeArray(voxelArrayName);
+        CropImageGeometryImpl(this, p, p, srcDims, cropMin, cropDims)();
       }
     }
   }
@@ -524,10 +678,6 @@ void CropImageGeometry::execute()
   }
   destCellDataContainer->getGeometryAs<ImageGeom>()->setDimensions(static_cast<size_t>(XP), static_cast<size_t>(YP), static_cast<size_t>(ZP));
   totalPoints = destCellDataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  QVector<size_t> tDims(3, 0);
-  tDims[0] = XP;
-  tDims[1] = YP;
-  tDims[2] = ZP;
   cellAttrMat->setTupleDimensions(tDims); // THIS WILL CAUSE A RESIZE of all the underlying data arrays.
 
   if(m_RenumberFeatures == true)
@@ -611,6 +761,23 @@ void CropImageGeometry::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CropImageGeometry::updateProgress(size_t numPlanes)
+{
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  m_PlanesCompleted += numPlanes;
+  m_IncCount += numPlanes;
+  if(m_IncCount >= m_ProgIncrement && m_TotalPlanes > 0)
+  {
+    m_IncCount = 0;
+    QString ss = QObject::tr("Cropping Volume || %1% Completed").arg(100 * m_PlanesCompleted / m_TotalPlanes);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
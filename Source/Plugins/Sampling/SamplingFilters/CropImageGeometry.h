@@ -85,6 +85,13 @@ public:
   FloatVec3_t getCurrentVolumeDataContainerResolutions();
   Q_PROPERTY(FloatVec3_t CurrentVolumeDataContainerResolutions READ getCurrentVolumeDataContainerResolutions)
 
+  /**
+   * @brief updateProgress Reports that the copy of some Z planes of a Cell array has finished. May be
+   * called from the worker threads.
+   * @param numPlanes Number of Z planes that were copied
+   */
+  void updateProgress(size_t numPlanes);
+
   SIMPL_FILTER_PARAMETER(int, XMin)
   Q_PROPERTY(int XMin READ getXMin WRITE setXMin)
 
@@ -233,6 +240,11 @@ private:
   FloatVec3_t m_NewResolution;
   FloatVec3_t m_NewOrigin;
 
+  size_t m_PlanesCompleted = 0;
+  size_t m_TotalPlanes = 0;
+  size_t m_ProgIncrement = 0;
+  size_t m_IncCount = 0;
+
 public:
   CropImageGeometry(const CropImageGeometry&) = delete; // Copy Constructor Not Implemented
   CropImageGeometry(CropImageGeometry&&) = delete;      // Move Constructor Not Implemented
@@ -52,81 +52,23 @@ BetaOps::BetaOps()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int BetaOps::calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs)
+int BetaOps::calculateParametersFromMoments(const DistributionMoments& moments, std::vector<float>& params)
 {
   int err = 0;
-  float avg = 0;
-  float stddev = 0;
   float alpha = 0;
   float beta = 0;
-  if(data.size() > 1)
+  if(moments.getCount() > 1)
   {
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+    float avg = static_cast<float>(moments.getMean());
+    float stddev = static_cast<float>(moments.getVariance());
+    if(stddev != 0)
     {
-      avg = avg + data[i];
+      alpha = avg * (((avg * (1 - avg)) / stddev) - 1);
+      beta = (1 - avg) * (((avg * (1 - avg)) / stddev) - 1);
     }
-    avg = avg / float(data.size());
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      stddev = stddev + ((avg - data[i]) * (avg - data[i]));
-    }
-    stddev = stddev / float(data.size());
-    alpha = avg * (((avg * (1 - avg)) / stddev) - 1);
-    beta = (1 - avg) * (((avg * (1 - avg)) / stddev) - 1);
-  }
-  else
-  {
-    alpha = 0;
-    beta = 0;
-  }
-  outputs->setValue(0, alpha);
-  outputs->setValue(1, beta);
-  return err;
-}
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int BetaOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs)
-{
-  int err = 0;
-  float avg = 0;
-  float stddev = 0;
-  float alpha = 0;
-  float beta = 0;
-  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-  {
-    avg = 0;
-    stddev = 0;
-    if(data[i].size() > 1)
-    {
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        avg = avg + data[i][j];
-      }
-      avg = avg / float(data[i].size());
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        stddev = stddev + ((avg - data[i][j]) * (avg - data[i][j]));
-      }
-      stddev = stddev / float(data[i].size());
-      if(stddev == 0)
-      {
-        alpha = 0;
-        beta = 0;
-      }
-      else
-      {
-        alpha = avg * (((avg * (1 - avg)) / stddev) - 1);
-        beta = (1 - avg) * (((avg * (1 - avg)) / stddev) - 1);
-      }
-    }
-    else
-    {
-      alpha = 0;
-      beta = 0;
-    }
-    outputs[0]->setValue(i, alpha);
-    outputs[1]->setValue(i, beta);
   }
+  params.resize(2);
+  params[0] = alpha;
+  params[1] = beta;
   return err;
 }
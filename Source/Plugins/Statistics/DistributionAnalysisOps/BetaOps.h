@@ -57,8 +57,7 @@ class BetaOps : public DistributionAnalysisOps
     virtual ~BetaOps();
 
 
-    int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs);
-    int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs);
+    int calculateParametersFromMoments(const DistributionMoments& moments, std::vector<float>& params) override;
 
   protected:
     BetaOps();
@@ -50,6 +50,42 @@ DistributionAnalysisOps::DistributionAnalysisOps()
 // -----------------------------------------------------------------------------
 DistributionAnalysisOps::~DistributionAnalysisOps() = default;
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DistributionAnalysisOps::calculateParameters(const DistributionMoments& moments, FloatArrayType::Pointer outputs)
+{
+  std::vector<float> params;
+  int err = calculateParametersFromMoments(moments, params);
+  for(std::vector<float>::size_type j = 0; j < params.size(); j++)
+  {
+    outputs->setValue(j, params[j]);
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DistributionAnalysisOps::calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs)
+{
+  int err = 0;
+  std::vector<float> params;
+  for(std::vector<DistributionMoments>::size_type i = 0; i < moments.size(); i++)
+  {
+    int binErr = calculateParametersFromMoments(moments[i], params);
+    if(binErr < 0)
+    {
+      err = binErr;
+    }
+    for(std::vector<float>::size_type j = 0; j < params.size(); j++)
+    {
+      outputs[j]->setValue(i, params[j]);
+    }
+  }
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
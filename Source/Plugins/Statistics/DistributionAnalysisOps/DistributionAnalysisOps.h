@@ -43,7 +43,7 @@
 #include "SIMPLib/StatsData/StatsData.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 
-#include "DistributionAnalysisOps/DistributionAnalysisOps.h"
+#include "DistributionAnalysisOps/DistributionMoments.h"
 
 
 /*
@@ -57,8 +57,26 @@ class DistributionAnalysisOps
 //   SIMPL_STATIC_NEW_MACRO(DistributionAnalysisOps)
     virtual ~DistributionAnalysisOps();
 
-    virtual int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs) = 0;
-    virtual int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs) = 0;
+    /**
+     * @brief calculateParametersFromMoments Fits the distribution to a set of values given only their moments
+     * @param moments Summary of the values to fit
+     * @param params Receives the distribution parameters, in the order of the output arrays
+     * @return
+     */
+    virtual int calculateParametersFromMoments(const DistributionMoments& moments, std::vector<float>& params) = 0;
+
+    /**
+     * @brief requiresLogMoments Returns whether the fit reads the moments of the logarithms of the values, so the
+     * DistributionMoments handed to it must be created with logs
+     * @return
+     */
+    virtual bool requiresLogMoments() const
+    {
+      return false;
+    }
+
+    int calculateParameters(const DistributionMoments& moments, FloatArrayType::Pointer outputs);
+    int calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs);
 
     static void determineMaxAndMinValues(std::vector<float>& data, float& max, float& min);
     static void determineBinNumbers(float& max, float& min, float& numbins, FloatArrayType::Pointer binnumbers);
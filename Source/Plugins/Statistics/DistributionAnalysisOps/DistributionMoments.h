@@ -0,0 +1,228 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief The DistributionMoments class is a streaming summary of a set of values that holds everything the
+ * DistributionAnalysisOps fits need: the count, the mean and variance of the values and, when asked for at
+ * construction, of their logarithms, the extremes and the first value seen. Only the log-normal and power law
+ * fits read the log moments, so the other fits do not pay for a logarithm per value. Values are folded in one at a time with addValue() and two summaries
+ * of disjoint sets can be combined with merge(), so a fit never needs a copy of the values themselves and
+ * partial summaries built by separate threads can be joined afterwards. Means and variances are updated with
+ * Welford's recurrence (and Chan's pairwise formula when merging) to avoid the cancellation of a naive sum of
+ * squares.
+ */
+class DistributionMoments
+{
+public:
+  DistributionMoments() = default;
+
+  /**
+   * @brief DistributionMoments Creates an empty summary
+   * @param withLogs Whether the mean and variance of the logarithms of the values are tracked as well
+   */
+  explicit DistributionMoments(bool withLogs)
+  : m_WithLogs(withLogs)
+  {
+  }
+
+  /**
+   * @brief addValue Folds one value into the summary
+   * @param value
+   */
+  void addValue(float value)
+  {
+    m_Count++;
+    if(m_Count == 1)
+    {
+      m_First = value;
+      m_Minimum = value;
+      m_Maximum = value;
+    }
+    else if(value < m_Minimum)
+    {
+      m_Minimum = value;
+    }
+    else if(value > m_Maximum)
+    {
+      m_Maximum = value;
+    }
+
+    double n = static_cast<double>(m_Count);
+    double delta = static_cast<double>(value) - m_Mean;
+    m_Mean += delta / n;
+    m_M2 += delta * (static_cast<double>(value) - m_Mean);
+
+    if(m_WithLogs)
+    {
+      double logValue = std::log(static_cast<double>(value));
+      double logDelta = logValue - m_LogMean;
+      m_LogMean += logDelta / n;
+      m_LogM2 += logDelta * (logValue - m_LogMean);
+    }
+  }
+
+  /**
+   * @brief merge Folds a summary of a disjoint set of values into this one. The first value of the result
+   * is the first value of this summary unless it is empty.
+   * @param other
+   */
+  void merge(const DistributionMoments& other)
+  {
+    if(other.m_Count == 0)
+    {
+      return;
+    }
+    if(m_Count == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    double nA = static_cast<double>(m_Count);
+    double nB = static_cast<double>(other.m_Count);
+    double n = nA + nB;
+
+    double delta = other.m_Mean - m_Mean;
+    m_Mean += delta * nB / n;
+    m_M2 += other.m_M2 + delta * delta * nA * nB / n;
+
+    if(m_WithLogs)
+    {
+      double logDelta = other.m_LogMean - m_LogMean;
+      m_LogMean += logDelta * nB / n;
+      m_LogM2 += other.m_LogM2 + logDelta * logDelta * nA * nB / n;
+    }
+
+    if(other.m_Minimum < m_Minimum)
+    {
+      m_Minimum = other.m_Minimum;
+    }
+    if(other.m_Maximum > m_Maximum)
+    {
+      m_Maximum = other.m_Maximum;
+    }
+    m_Count += other.m_Count;
+  }
+
+  size_t getCount() const
+  {
+    return m_Count;
+  }
+
+  double getMean() const
+  {
+    return m_Mean;
+  }
+
+  /**
+   * @brief getVariance Returns the population variance of the values
+   * @return
+   */
+  double getVariance() const
+  {
+    return (m_Count > 0) ? m_M2 / static_cast<double>(m_Count) : 0.0;
+  }
+
+  bool getWithLogs() const
+  {
+    return m_WithLogs;
+  }
+
+  /**
+   * @brief getLogMean Returns the mean of the logarithms of the values; only valid for a summary created with logs
+   * @return
+   */
+  double getLogMean() const
+  {
+    return m_LogMean;
+  }
+
+  /**
+   * @brief getLogVariance Returns the population variance of the logarithms of the values; only valid for a
+   * summary created with logs
+   * @return
+   */
+  double getLogVariance() const
+  {
+    return (m_Count > 0) ? m_LogM2 / static_cast<double>(m_Count) : 0.0;
+  }
+
+  float getMinimum() const
+  {
+    return m_Minimum;
+  }
+
+  float getMaximum() const
+  {
+    return m_Maximum;
+  }
+
+  float getFirstValue() const
+  {
+    return m_First;
+  }
+
+  /**
+   * @brief getSumOfLogRatiosToMinimum Returns the sum of log(value / minimum) over all values; only valid for a
+   * summary created with logs
+   * @return
+   */
+  double getSumOfLogRatiosToMinimum() const
+  {
+    if(m_Count == 0)
+    {
+      return 0.0;
+    }
+    double sum = static_cast<double>(m_Count) * (m_LogMean - std::log(static_cast<double>(m_Minimum)));
+    // Rounding can push the sum of a nearly constant set slightly below zero
+    return (sum > 0.0) ? sum : 0.0;
+  }
+
+private:
+  bool m_WithLogs = false;
+  size_t m_Count = 0;
+  double m_Mean = 0.0;
+  double m_M2 = 0.0;
+  double m_LogMean = 0.0;
+  double m_LogM2 = 0.0;
+  float m_Minimum = 0.0f;
+  float m_Maximum = 0.0f;
+  float m_First = 0.0f;
+};
@@ -52,77 +52,31 @@ LogNormalOps::LogNormalOps()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int LogNormalOps::calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs)
+bool LogNormalOps::requiresLogMoments() const
 {
-  int err = 0;
-  float avg = 0;
-  float stddev = 0;
-  if(data.size() > 1)
-  {
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      avg = avg + log(data[i]);
-    }
-    avg = avg / float(data.size());
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      stddev = stddev + ((avg - log(data[i])) * (avg - log(data[i])));
-    }
-    stddev = stddev / float(data.size());
-    stddev = sqrt(stddev);
-  }
-  else if(data.size() == 1)
-  {
-    avg = data[0];
-    stddev = 0;
-  }
-  else
-  {
-    avg = 0;
-    stddev = 0;
-  }
-  outputs->setValue(0, avg);
-  outputs->setValue(1, stddev);
-  return err;
+  return true;
 }
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int LogNormalOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs)
+int LogNormalOps::calculateParametersFromMoments(const DistributionMoments& moments, std::vector<float>& params)
 {
   int err = 0;
   float avg = 0;
   float stddev = 0;
-  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+  if(moments.getCount() > 1)
+  {
+    avg = static_cast<float>(moments.getLogMean());
+    stddev = static_cast<float>(sqrt(moments.getLogVariance()));
+  }
+  else if(moments.getCount() == 1)
   {
-    avg = 0;
+    avg = moments.getFirstValue();
     stddev = 0;
-    if(data[i].size() > 1)
-    {
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        avg = avg + log(data[i][j]);
-      }
-      avg = avg / float(data[i].size());
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        stddev = stddev + ((avg - log(data[i][j])) * (avg - log(data[i][j])));
-      }
-      stddev = stddev / float(data[i].size());
-      stddev = sqrt(stddev);
-    }
-    else if(data[i].size() == 1)
-    {
-      avg = data[i][0];
-      stddev = 0;
-    }
-    else
-    {
-      avg = 0;
-      stddev = 0;
-    }
-    outputs[0]->setValue(i, avg);
-    outputs[1]->setValue(i, stddev);
   }
+  params.resize(2);
+  params[0] = avg;
+  params[1] = stddev;
   return err;
 }
@@ -58,8 +58,9 @@ class LogNormalOps : public DistributionAnalysisOps
     virtual ~LogNormalOps();
 
 
-    int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs);
-    int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs);
+    int calculateParametersFromMoments(const DistributionMoments& moments, std::vector<float>& params) override;
+
+    bool requiresLogMoments() const override;
 
   protected:
     LogNormalOps();
@@ -54,73 +54,41 @@ PowerLawOps::PowerLawOps()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int PowerLawOps::calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs)
+bool PowerLawOps::requiresLogMoments() const
 {
-  int err = 0;
-  float alpha = 0;
-  float min = std::numeric_limits<float>::max();
-  if(data.size() > 1)
-  {
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      if(data[i] < min)
-      {
-        min = data[i];
-      }
-    }
-    for(std::vector<float>::size_type i = 0; i < data.size(); i++)
-    {
-      alpha = alpha + log(data[i] / min);
-    }
-    alpha = 1.0f / alpha;
-    alpha = 1 + (alpha * data.size());
-  }
-  else
-  {
-    min = 0;
-    alpha = 0;
-  }
-  outputs->setValue(0, alpha);
-  outputs->setValue(1, min);
-  return err;
+  return true;
 }
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int PowerLawOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs)
+int PowerLawOps::calculateParametersFromMoments(const DistributionMoments& moments, std::vector<float>& params)
 {
   int err = 0;
   float alpha = 0;
-  float min;
-  for(std::vector<float>::size_type i = 0; i < data.size(); i++)
+  float min = 0;
+  if(moments.getCount() > 1)
   {
-    if(data[i].size() > 1)
+    min = moments.getMinimum();
+    if(min <= 0.0f)
     {
-      min = std::numeric_limits<float>::max();
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        if(data[i][j] < min)
-        {
-          min = data[i][j];
-        }
-      }
-      for(std::vector<float>::size_type j = 0; j < data[i].size(); j++)
-      {
-        alpha = alpha + log(data[i][j] / min);
-      }
-      if(alpha != 0.0f)
-      {
-        alpha = 1.0f / alpha;
-      }
-      alpha = 1.0f + (alpha * data[i].size());
+      // log(value / min) is undefined for a minimum of zero (an all zero set has always produced a NaN
+      // exponent) and the logarithms of negative values do not exist either
+      alpha = std::numeric_limits<float>::quiet_NaN();
     }
     else
     {
-      min = 0;
-      alpha = 0;
+      // A constant set has no tail to fit; its exponent is reported as 1
+      float sumLogRatios = static_cast<float>(moments.getSumOfLogRatiosToMinimum());
+      if(sumLogRatios != 0.0f)
+      {
+        alpha = 1.0f / sumLogRatios;
+      }
+      alpha = 1.0f + (alpha * moments.getCount());
     }
-    outputs[0]->setValue(i, alpha);
-    outputs[1]->setValue(i, min);
   }
+  params.resize(2);
+  params[0] = alpha;
+  params[1] = min;
   return err;
 }
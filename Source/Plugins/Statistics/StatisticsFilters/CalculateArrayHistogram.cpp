@@ -46,6 +46,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "Statistics/StatisticsConstants.h"
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
 #include "Statistics/StatisticsVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -248,7 +249,6 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
 
   T* inputArrayPtr = inputDataPtr->getPointer(0);
   size_t numPoints = inputDataPtr->getNumberOfTuples();
-  int32_t bin = 0;
   float min = std::numeric_limits<float>::max();
   float max = -1.0 * std::numeric_limits<float>::max();
   if(userRange)
@@ -258,20 +258,12 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
   }
   else
   {
-    for(size_t i = 0; i < numPoints; i++) // min and max in the input array
-    {
-      if(static_cast<float>(inputArrayPtr[i]) > max)
-      {
-        max = static_cast<float>(inputArrayPtr[i]);
-      }
-      if(static_cast<float>(inputArrayPtr[i]) < min)
-      {
-        min = static_cast<float>(inputArrayPtr[i]);
-      }
-    }
+    StreamingHistogram::RangeSketch<T> range = StreamingHistogram::FindRange(inputArrayPtr, 0, numPoints);
+    min = range.getMin();
+    max = range.getMax();
   }
 
-  float increment = (max - min) / (numberOfBins);
+  StreamingHistogram::BinLayout layout(min, max, numberOfBins);
   if(numberOfBins == 1) // if one bin, just set the first element to total number of points
   {
     newDataArrayPtr[0] = max;
@@ -279,23 +271,18 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
   }
   else
   {
-    for(size_t i = 0; i < numPoints; i++) // sort into bins to create the histogram
+    StreamingHistogram::BinCounter<T> counter = StreamingHistogram::Accumulate(0, numPoints, StreamingHistogram::BinCounter<T>(inputArrayPtr, layout));
+    const std::vector<uint64_t>& counts = counter.getCounts();
+    for(int32_t i = 0; i < numberOfBins; i++)
     {
-      bin = size_t((inputArrayPtr[i] - min) / increment); // find bin for this input array value
-      if((bin >= 0) && (bin < numberOfBins))              // make certain bin is in range
-      {
-        newDataArrayPtr[bin * 2 + 1]++; // increment histogram element corresponding to this input array value
-      }
-      else
-      {
-        overflow++;
-      }
+      newDataArrayPtr[i * 2 + 1] = static_cast<double>(counts[i]);
     }
+    overflow = static_cast<int>(counter.getOverflow());
   }
 
   for(int32_t i = 0; i < numberOfBins; i++)
   {
-    newDataArrayPtr[i * 2] = min + increment * (i + 1);
+    newDataArrayPtr[i * 2] = layout.getUpperEdge(i);
   }
 }
 
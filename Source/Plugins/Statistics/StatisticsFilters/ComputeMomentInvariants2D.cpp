@@ -17,6 +17,7 @@
 
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsFilters/util/MomentInvariants2D.h"
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
 #include "Statistics/StatisticsVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -165,6 +166,96 @@ void ComputeMomentInvariants2D::preflight()
   setInPreflight(false);             // Inform the system this filter is NOT in preflight mode anymore.
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+namespace
+{
+/**
+ * @brief The PixelSumsAccumulator class sums, for every Feature, the products y^p * x^q (p, q <= max order) of the
+ * integer coordinates of its pixels, measured from the corner of the Feature's bounding box. Each index is one
+ * row of the volume, so any stack of slices is split evenly across threads.
+ */
+class PixelSumsAccumulator
+{
+public:
+  PixelSumsAccumulator(const int32_t* featureIds, const size_t* volDims, const uint32_t* featureRect, size_t numFeatures, size_t maxOrder)
+  : m_FeatureIds(featureIds)
+  , m_XPoints(volDims[0])
+  , m_YPoints(volDims[1])
+  , m_FeatureRect(featureRect)
+  , m_NumFeatures(numFeatures)
+  , m_MDim(maxOrder + 1)
+  , m_Sums(numFeatures * m_MDim * m_MDim, 0.0)
+  , m_XPowers(m_MDim, 1.0)
+  , m_YPowers(m_MDim, 1.0)
+  {
+  }
+
+  void addIndex(size_t row)
+  {
+    size_t y = row % m_YPoints;
+    const int32_t* featureIds = m_FeatureIds + row * m_XPoints;
+    for(size_t x = 0; x < m_XPoints; x++)
+    {
+      int32_t featureId = featureIds[x];
+      if(featureId <= 0 || static_cast<size_t>(featureId) >= m_NumFeatures)
+      {
+        continue;
+      }
+      const uint32_t* corner = m_FeatureRect + 6 * featureId;
+      double dx = static_cast<double>(x) - static_cast<double>(corner[0]);
+      double dy = static_cast<double>(y) - static_cast<double>(corner[1]);
+      for(size_t n = 1; n < m_MDim; n++)
+      {
+        m_XPowers[n] = m_XPowers[n - 1] * dx;
+        m_YPowers[n] = m_YPowers[n - 1] * dy;
+      }
+      double* sums = &(m_Sums[featureId * m_MDim * m_MDim]);
+      for(size_t p = 0; p < m_MDim; p++)
+      {
+        for(size_t q = 0; q < m_MDim; q++)
+        {
+          sums[p * m_MDim + q] += m_YPowers[p] * m_XPowers[q];
+        }
+      }
+    }
+  }
+
+  void merge(const PixelSumsAccumulator& other)
+  {
+    for(size_t i = 0; i < m_Sums.size(); i++)
+    {
+      m_Sums[i] += other.m_Sums[i];
+    }
+  }
+
+  MomentInvariants2D::DoubleMatrixType getPixelSums(size_t featureId) const
+  {
+    MomentInvariants2D::DoubleMatrixType pixelSums(m_MDim, m_MDim);
+    for(size_t p = 0; p < m_MDim; p++)
+    {
+      for(size_t q = 0; q < m_MDim; q++)
+      {
+        pixelSums(p, q) = m_Sums[(featureId * m_MDim + p) * m_MDim + q];
+      }
+    }
+    return pixelSums;
+  }
+
+private:
+  const int32_t* m_FeatureIds;
+  size_t m_XPoints;
+  size_t m_YPoints;
+  const uint32_t* m_FeatureRect;
+  size_t m_NumFeatures;
+  size_t m_MDim;
+  std::vector<double> m_Sums;
+  std::vector<double> m_XPowers;
+  std::vector<double> m_YPowers;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -194,18 +285,17 @@ void ComputeMomentInvariants2D::execute()
 //  static const double k_Pi14 = std::pow(SIMPLib::Constants::k_Pi, 0.25);
 //  static const double k_Root2 = std::sqrt(2.0);
 
-  // This loop SHOULD be parallelized
+  size_t max_order = 2;
+
+  // Sum the pixel coordinate powers of every Feature in one pass over the volume, split by rows across threads
+  PixelSumsAccumulator exemplar(m_FeatureIds, volDims, m_FeatureRect, static_cast<size_t>(numFeatures), max_order);
+  PixelSumsAccumulator pixelSums = StreamingHistogram::Accumulate(0, volDims[1] * volDims[2], exemplar);
 
   for(int32_t featureId = 1; featureId < numFeatures; featureId++)
   {
     uint32_t* corner = m_FeatureRectPtr.lock()->getTuplePointer(featureId);
     MomentInvariants2D moments;
-    size_t max_order = 2;
-    //size_t mDim = max_order + 1;
 
-    // Figure the largest X || Y dimension so we can create a square matrix
-    uint32_t xDim = corner[3] - corner[0] + 1;
-    uint32_t yDim = corner[4] - corner[1] + 1;
     uint32_t zDim = corner[5] - corner[2] + 1;
 
     if(zDim != 1)
@@ -218,35 +308,7 @@ void ComputeMomentInvariants2D::execute()
       continue;
     }
 
-    size_t dim = xDim; // Assume XDim is the largest value
-    if(yDim > xDim)
-    {
-      dim = yDim; // Nope, YDim is largest
-    }
-
-    MomentInvariants2D::DoubleMatrixType input2D(dim, dim);
-    input2D.setZero();
-
-    uint32_t height = 0;
-
-    for(uint32_t y = corner[1]; y <= corner[4]; y++)
-    {
-      for(uint32_t x = corner[0]; x <= corner[3]; x++)
-      {
-        size_t index =  (volDims[1] * volDims[0] * height) + (volDims[0] * y) + x;
-        if( *(m_FeatureIds + index) == featureId)
-        {
-          input2D(y - corner[1], x - corner[0]) = 1;
-        }
-        else
-        {
-          input2D(y - corner[1], x - corner[0]) = 0;
-        }
-      }
-    }
-
-    size_t inputDims[2] = { dim, dim };
-    MomentInvariants2D::DoubleMatrixType m2D = moments.computeMomentInvariants(input2D, inputDims, max_order);
+    MomentInvariants2D::DoubleMatrixType m2D = moments.computeMomentInvariantsFromPixelSums(pixelSums.getPixelSums(featureId), max_order);
     //std::cout << "Central Moments=\n" << m2D << std::endl;
     // compute the second order moment invariants
     double omega1 = 2.0 * (m2D(0,0)* m2D(0,0)) / (m2D(0,2) + m2D(2,0));
@@ -35,6 +35,16 @@
 
 #include "FindEllipsoidError.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -43,8 +53,14 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -266,6 +282,7 @@ void FindEllipsoidError::execute()
 
   if(m->getGeometryAs<ImageGeom>()->getXPoints() > 1 && m->getGeometryAs<ImageGeom>()->getYPoints() > 1 && m->getGeometryAs<ImageGeom>()->getZPoints() > 1)
   {
+    find_error3D();
   }
   if(m->getGeometryAs<ImageGeom>()->getXPoints() == 1 || m->getGeometryAs<ImageGeom>()->getYPoints() == 1 || m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
   {
@@ -278,96 +295,389 @@ void FindEllipsoidError::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindEllipsoidError::find_error2D()
+namespace
 {
-  size_t numfeatures = m_NumCellsPtr.lock()->getNumberOfTuples();
-  std::vector<std::vector<size_t>> featureCellList(numfeatures);
-  std::vector<size_t> numInsideIdeal(numfeatures, 0); // Create a list for the ideal ellipses
-  std::vector<size_t> numOutsideIdeal(numfeatures, 0);
-
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t xPoints = m->getGeometryAs<ImageGeom>()->getXPoints();
-  size_t yPoints = m->getGeometryAs<ImageGeom>()->getYPoints();
-  size_t zPoints = m->getGeometryAs<ImageGeom>()->getZPoints();
-
-  float xRes = 0.0f;
-  float yRes = 0.0f;
-  float zRes = 0.0f;
-  std::tie(xRes, yRes, zRes) = m->getGeometryAs<ImageGeom>()->getResolution();
-
-  float xsquared, ysquared, asquared, bsquared, xc, yc, theta;
-  int32_t xcoord, ycoord;
-
-  size_t totalPoints = xPoints * yPoints * zPoints;
-
-  for(size_t k = 0; k < totalPoints; k++)
+/**
+ * @brief The FeatureCellCountImpl class implements a threaded algorithm that counts the cells of every Feature
+ * within each slab of the cell range; every slab owns one row of the count table
+ */
+class FeatureCellCountImpl
+{
+  const int32_t* m_FeatureIds;
+  size_t m_TotalPoints;
+  size_t m_NumFeatures;
+  size_t m_NumSlabs;
+  size_t* m_Counts;
+
+public:
+  FeatureCellCountImpl(const int32_t* featureIds, size_t totalPoints, size_t numFeatures, size_t numSlabs, size_t* counts)
+  : m_FeatureIds(featureIds)
+  , m_TotalPoints(totalPoints)
+  , m_NumFeatures(numFeatures)
+  , m_NumSlabs(numSlabs)
+  , m_Counts(counts)
   {
-    featureCellList[m_FeatureIds[k]].push_back(k);
+  }
+  virtual ~FeatureCellCountImpl() = default;
 
-    //        //calculate the x and y coordinate for each cell in the actual feature
-    //        xcoord = int(k % xPoints);
-    //        ycoord = int(k/xPoints) % yPoints;
-    //        for (size_t i = 1; i<numfeatures; i++)
-    //        {
-    //            theta = -m_AxisEulerAngles[3*i]; //only need the first angle in 2D
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      size_t* counts = m_Counts + slab * m_NumFeatures;
+      size_t first = slab * m_TotalPoints / m_NumSlabs;
+      size_t last = (slab + 1) * m_TotalPoints / m_NumSlabs;
+      for(size_t k = first; k < last; k++)
+      {
+        int32_t featureId = m_FeatureIds[k];
+        if(featureId >= 0 && static_cast<size_t>(featureId) < m_NumFeatures)
+        {
+          counts[featureId]++;
+        }
+      }
+    }
+  }
 
-    //            //Get the centroids (in pixels) for the ideal ellipse
-    //            xc = m_Centroids[3*i]/xRes;
-    //            yc = m_Centroids[3*i + 1]/yRes;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The FeatureCellScatterImpl class implements a threaded algorithm that writes the index of every cell
+ * into the list of its Feature, starting each slab at the write position that the prefix sum of the counts
+ * reserved for it
+ */
+class FeatureCellScatterImpl
+{
+  const int32_t* m_FeatureIds;
+  size_t m_TotalPoints;
+  size_t m_NumFeatures;
+  size_t m_NumSlabs;
+  size_t* m_Cursors;
+  size_t* m_Cells;
+
+public:
+  FeatureCellScatterImpl(const int32_t* featureIds, size_t totalPoints, size_t numFeatures, size_t numSlabs, size_t* cursors, size_t* cells)
+  : m_FeatureIds(featureIds)
+  , m_TotalPoints(totalPoints)
+  , m_NumFeatures(numFeatures)
+  , m_NumSlabs(numSlabs)
+  , m_Cursors(cursors)
+  , m_Cells(cells)
+  {
+  }
+  virtual ~FeatureCellScatterImpl() = default;
 
-    //            //Get the axis lengths for the ideal ellipse
-    //            asquared = (m_AxisLengths[3*i]*m_AxisLengths[3*i])/(xRes*xRes);
-    //            bsquared = m_AxisLengths[3*i+1]*m_AxisLengths[3*i+1]/(yRes*yRes);
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      size_t* cursors = m_Cursors + slab * m_NumFeatures;
+      size_t first = slab * m_TotalPoints / m_NumSlabs;
+      size_t last = (slab + 1) * m_TotalPoints / m_NumSlabs;
+      for(size_t k = first; k < last; k++)
+      {
+        int32_t featureId = m_FeatureIds[k];
+        if(featureId >= 0 && static_cast<size_t>(featureId) < m_NumFeatures)
+        {
+          m_Cells[cursors[featureId]++] = k;
+        }
+      }
+    }
+  }
 
-    //            //rotate and translate the current x, y pair into where the ideal ellipse is
-    //            xsquared = ((xcoord-xc)*cosf(theta)-(ycoord-yc)*sinf(theta))*((xcoord-xc)*cosf(theta)-(ycoord-yc)*sinf(theta));
-    //            ysquared = ((xcoord-xc)*sinf(theta)+(ycoord-yc)*cosf(theta))*((xcoord-xc)*sinf(theta)+(ycoord-yc)*cosf(theta));
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief buildFeatureCellLists Gathers the cells of every Feature into compressed row lists with a counting sort:
+ * the cells of Feature i are cells[offsets[i]] to cells[offsets[i + 1] - 1] in increasing order. Cells with a
+ * Feature Id outside [0, numFeatures) are left out.
+ * @param featureIds
+ * @param totalPoints
+ * @param numFeatures
+ * @param offsets
+ * @param cells
+ */
+void buildFeatureCellLists(const int32_t* featureIds, size_t totalPoints, size_t numFeatures, std::vector<size_t>& offsets, std::vector<size_t>& cells)
+{
+  // Every slab owns a row of numFeatures counts. With millions of Features that table would outgrow the cell lists
+  // themselves, so the number of slabs is capped to keep it within a quarter of the cell lists
+  size_t numSlabs = StreamingHistogram::NumberOfSlabs(totalPoints);
+  size_t maxSlabs = std::max<size_t>(1, totalPoints / (4 * std::max<size_t>(numFeatures, 1)));
+  numSlabs = std::min(numSlabs, maxSlabs);
+  std::vector<size_t> counts(numSlabs * numFeatures, 0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs), FeatureCellCountImpl(featureIds, totalPoints, numFeatures, numSlabs, counts.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FeatureCellCountImpl serial(featureIds, totalPoints, numFeatures, numSlabs, counts.data());
+    serial.compute(0, numSlabs);
+  }
 
-    //            if( (xsquared/asquared + ysquared/bsquared) < 1 )
-    //            {
-    //                m_IdealFeatureIds[k] = i;
-    //            }
+  // Turn the counts into the write position of every (Feature, slab) pair, Feature major so that the
+  // slabs of a Feature follow each other and its cells stay in increasing order
+  offsets.assign(numFeatures + 1, 0);
+  size_t total = 0;
+  for(size_t i = 0; i < numFeatures; i++)
+  {
+    offsets[i] = total;
+    for(size_t slab = 0; slab < numSlabs; slab++)
+    {
+      size_t count = counts[slab * numFeatures + i];
+      counts[slab * numFeatures + i] = total;
+      total += count;
+    }
+  }
+  offsets[numFeatures] = total;
+  cells.resize(total);
 
-    //        }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs), FeatureCellScatterImpl(featureIds, totalPoints, numFeatures, numSlabs, counts.data(), cells.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FeatureCellScatterImpl serial(featureIds, totalPoints, numFeatures, numSlabs, counts.data(), cells.data());
+    serial.compute(0, numSlabs);
   }
+}
 
-  for(size_t i = 1; i < numfeatures; i++)
+/**
+ * @brief The EllipsoidErrorImpl class implements a threaded algorithm that, for every Feature, counts the cells
+ * that fall outside the ellipse (2D) or ellipsoid (3D) fitted to it by FindShapes and stores their fraction of
+ * the Feature's cells as its error
+ */
+class EllipsoidErrorImpl
+{
+  const size_t* m_Offsets;
+  const size_t* m_Cells;
+  size_t m_Dims[3];
+  float m_Res[3];
+  float m_Origin[3];
+  bool m_Is3D;
+  float* m_Centroids;
+  float* m_AxisLengths;
+  float* m_AxisEulerAngles;
+  int32_t* m_NumCells;
+  float* m_EllipsoidError;
+
+public:
+  EllipsoidErrorImpl(const size_t* offsets, const size_t* cells, const size_t* dims, const float* res, const float* origin, bool is3D, float* centroids, float* axisLengths, float* axisEulerAngles, int32_t* numCells,
+                     float* ellipsoidError)
+  : m_Offsets(offsets)
+  , m_Cells(cells)
+  , m_Is3D(is3D)
+  , m_Centroids(centroids)
+  , m_AxisLengths(axisLengths)
+  , m_AxisEulerAngles(axisEulerAngles)
+  , m_NumCells(numCells)
+  , m_EllipsoidError(ellipsoidError)
   {
-    theta = -m_AxisEulerAngles[3 * i]; // only need the first angle in 2D
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = dims[d];
+      m_Res[d] = res[d];
+      m_Origin[d] = origin[d];
+    }
+  }
+  virtual ~EllipsoidErrorImpl() = default;
+
+  /**
+   * @brief countOutside2D Counts the cells of Feature i outside its ellipse in the XY plane, in units of pixels
+   * @param i
+   * @return
+   */
+  size_t countOutside2D(size_t i) const
+  {
+    float theta = -m_AxisEulerAngles[3 * i]; // only need the first angle in 2D
+    float cosTheta = cosf(theta);
+    float sinTheta = sinf(theta);
 
     // Get the centroids (in pixels) for the ideal ellipse
-    xc = m_Centroids[3 * i] / xRes;
-    yc = m_Centroids[3 * i + 1] / yRes;
+    float xc = m_Centroids[3 * i] / m_Res[0];
+    float yc = m_Centroids[3 * i + 1] / m_Res[1];
 
     // Get the axis lengths for the ideal ellipse
-    asquared = (m_AxisLengths[3 * i] * m_AxisLengths[3 * i]) / (xRes * xRes);
-    bsquared = m_AxisLengths[3 * i + 1] * m_AxisLengths[3 * i + 1] / (yRes * yRes);
+    float asquared = (m_AxisLengths[3 * i] * m_AxisLengths[3 * i]) / (m_Res[0] * m_Res[0]);
+    float bsquared = m_AxisLengths[3 * i + 1] * m_AxisLengths[3 * i + 1] / (m_Res[1] * m_Res[1]);
 
-    // iterate over all the cells in each feature
-    for(size_t j = 0; j < featureCellList[i].size(); j++)
+    size_t numOutside = 0;
+    for(size_t j = m_Offsets[i]; j < m_Offsets[i + 1]; j++)
     {
       // calculate the x and y coordinate for each cell in the actual feature
-      xcoord = int(featureCellList[i][j] % xPoints);
-      ycoord = int(featureCellList[i][j] / xPoints) % yPoints;
+      int32_t xcoord = int(m_Cells[j] % m_Dims[0]);
+      int32_t ycoord = int(m_Cells[j] / m_Dims[0]) % m_Dims[1];
 
       // rotate and translate the current x, y pair into where the ideal ellipse is
-      xsquared = ((xcoord - xc) * cosf(theta) - (ycoord - yc) * sinf(theta)) * ((xcoord - xc) * cosf(theta) - (ycoord - yc) * sinf(theta));
-      ysquared = ((xcoord - xc) * sinf(theta) + (ycoord - yc) * cosf(theta)) * ((xcoord - xc) * sinf(theta) + (ycoord - yc) * cosf(theta));
+      float xrot = (xcoord - xc) * cosTheta - (ycoord - yc) * sinTheta;
+      float yrot = (xcoord - xc) * sinTheta + (ycoord - yc) * cosTheta;
+      float xsquared = xrot * xrot;
+      float ysquared = yrot * yrot;
 
-      if((xsquared / asquared + ysquared / bsquared) < 1)
+      if(!((xsquared / asquared + ysquared / bsquared) < 1))
       {
-        numInsideIdeal[i]++;
+        numOutside++;
       }
-      else
+    }
+    return numOutside;
+  }
+
+  /**
+   * @brief countOutside3D Counts the cells of Feature i outside its ellipsoid, in physical units
+   * @param i
+   * @return
+   */
+  size_t countOutside3D(size_t i) const
+  {
+    float ga[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    FOrientArrayType om(9, 0.0);
+    FOrientTransformsType::eu2om(FOrientArrayType(&(m_AxisEulerAngles[3 * i]), 3), om);
+    om.toGMatrix(ga);
+
+    float radius1 = m_AxisLengths[3 * i];
+    float radius2 = m_AxisLengths[3 * i + 1];
+    float radius3 = m_AxisLengths[3 * i + 2];
+
+    size_t xyPoints = m_Dims[0] * m_Dims[1];
+    float coords[3] = {0.0f, 0.0f, 0.0f};
+    float coordsRotated[3] = {0.0f, 0.0f, 0.0f};
+    size_t numOutside = 0;
+    for(size_t j = m_Offsets[i]; j < m_Offsets[i + 1]; j++)
+    {
+      size_t cell = m_Cells[j];
+      // the centroids include the origin of the geometry
+      coords[0] = float(cell % m_Dims[0]) * m_Res[0] + m_Origin[0] - m_Centroids[3 * i];
+      coords[1] = float((cell / m_Dims[0]) % m_Dims[1]) * m_Res[1] + m_Origin[1] - m_Centroids[3 * i + 1];
+      coords[2] = float(cell / xyPoints) * m_Res[2] + m_Origin[2] - m_Centroids[3 * i + 2];
+
+      // rotate the cell into the reference frame of the ideal ellipsoid
+      MatrixMath::Multiply3x3with3x1(ga, coords, coordsRotated);
+      float axis1comp = coordsRotated[0] / radius1;
+      float axis2comp = coordsRotated[1] / radius2;
+      float axis3comp = coordsRotated[2] / radius3;
+
+      if(!((axis1comp * axis1comp + axis2comp * axis2comp + axis3comp * axis3comp) < 1))
       {
-        numOutsideIdeal[i]++;
+        numOutside++;
       }
     }
+    return numOutside;
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      size_t numOutside = m_Is3D ? countOutside3D(i) : countOutside2D(i);
+      m_EllipsoidError[i] = float(numOutside) / float(m_NumCells[i]);
+    }
+  }
 
-    m_EllipsoidError[i] = float(numOutsideIdeal[i]) / float(m_NumCells[i]);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief findEllipsoidError Gathers the cells of every Feature and evaluates the fraction of them that lie outside
+ * the ellipse (2D) or ellipsoid (3D) fitted to the Feature
+ */
+void findEllipsoidError(const int32_t* featureIds, const size_t* dims, const float* res, const float* origin, bool is3D, float* centroids, float* axisLengths, float* axisEulerAngles, int32_t* numCells,
+                        float* ellipsoidError, size_t numfeatures)
+{
+  if(numfeatures < 2)
+  {
+    return;
+  }
+
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  std::vector<size_t> featureCellOffsets;
+  std::vector<size_t> featureCells;
+  buildFeatureCellLists(featureIds, totalPoints, numfeatures, featureCellOffsets, featureCells);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numfeatures),
+                      EllipsoidErrorImpl(featureCellOffsets.data(), featureCells.data(), dims, res, origin, is3D, centroids, axisLengths, axisEulerAngles, numCells, ellipsoidError), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    EllipsoidErrorImpl serial(featureCellOffsets.data(), featureCells.data(), dims, res, origin, is3D, centroids, axisLengths, axisEulerAngles, numCells, ellipsoidError);
+    serial.compute(1, numfeatures);
   }
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindEllipsoidError::find_error2D()
+{
+  size_t numfeatures = m_NumCellsPtr.lock()->getNumberOfTuples();
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  size_t dims[3] = {0, 0, 0};
+  std::tie(dims[0], dims[1], dims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+
+  float res[3] = {0.0f, 0.0f, 0.0f};
+  std::tie(res[0], res[1], res[2]) = m->getGeometryAs<ImageGeom>()->getResolution();
+
+  float origin[3] = {0.0f, 0.0f, 0.0f};
+  m->getGeometryAs<ImageGeom>()->getOrigin(origin);
+
+  findEllipsoidError(m_FeatureIds, dims, res, origin, false, m_Centroids, m_AxisLengths, m_AxisEulerAngles, m_NumCells, m_EllipsoidError, numfeatures);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindEllipsoidError::find_error3D()
+{
+  size_t numfeatures = m_NumCellsPtr.lock()->getNumberOfTuples();
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  size_t dims[3] = {0, 0, 0};
+  std::tie(dims[0], dims[1], dims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
+
+  float res[3] = {0.0f, 0.0f, 0.0f};
+  std::tie(res[0], res[1], res[2]) = m->getGeometryAs<ImageGeom>()->getResolution();
+
+  float origin[3] = {0.0f, 0.0f, 0.0f};
+  m->getGeometryAs<ImageGeom>()->getOrigin(origin);
 
-  std::cout << "done" << std::endl;
+  findEllipsoidError(m_FeatureIds, dims, res, origin, true, m_Centroids, m_AxisLengths, m_AxisEulerAngles, m_NumCells, m_EllipsoidError, numfeatures);
 }
 
 // -----------------------------------------------------------------------------
@@ -202,8 +202,16 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief find_error2D Computes the fraction of the cells of every Feature that lie outside its fitted ellipse
+   */
   void find_error2D();
 
+  /**
+   * @brief find_error3D Computes the fraction of the cells of every Feature that lie outside its fitted ellipsoid
+   */
+  void find_error3D();
+
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(float, AxisEulerAngles)
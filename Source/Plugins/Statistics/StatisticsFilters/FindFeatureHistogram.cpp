@@ -46,6 +46,7 @@
 #include "Statistics/DistributionAnalysisOps/BetaOps.h"
 #include "Statistics/DistributionAnalysisOps/LogNormalOps.h"
 #include "Statistics/DistributionAnalysisOps/PowerLawOps.h"
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -189,49 +190,78 @@ void FindFeatureHistogram::preflight()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T> void findHistogram(IDataArray::Pointer inputData, int32_t* ensembleArray, int32_t* eIds, int NumberOfBins, bool removeBiasedFeatures, bool* biasedFeatures)
+namespace
 {
-  typename DataArray<T>::Pointer featureArray = std::dynamic_pointer_cast<DataArray<T>>(inputData);
-  if(nullptr == featureArray)
+/**
+ * @brief The EnsembleBinCounter class counts, for every Ensemble, the Features whose value falls into each bin
+ */
+template <typename T> class EnsembleBinCounter
+{
+public:
+  EnsembleBinCounter(const T* data, const int32_t* eIds, const bool* biasedFeatures, const StreamingHistogram::BinLayout& layout, size_t numEnsembles)
+  : m_Data(data)
+  , m_EnsembleIds(eIds)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_Layout(layout)
+  , m_Counts(numEnsembles * static_cast<size_t>(layout.getNumberOfBins()), 0)
   {
-    return;
   }
 
-  T* fPtr = featureArray->getPointer(0);
-  size_t numfeatures = featureArray->getNumberOfTuples();
-
-  int32_t bin;
-  int32_t ensemble;
-  float min = 1000000.0f;
-  float max = 0.0f;
-  float value;
-  for(size_t i = 1; i < numfeatures; i++)
+  void addIndex(size_t i)
   {
-    value = fPtr[i];
-    if(value > max)
-    {
-      max = value;
-    }
-    if(value < min)
+    if(nullptr == m_BiasedFeatures || m_BiasedFeatures[i] == false)
     {
-      min = value;
+      m_Counts[static_cast<size_t>(m_Layout.getNumberOfBins()) * m_EnsembleIds[i] + m_Layout.clampBin(m_Data[i])]++;
     }
   }
-  float stepsize = (max - min) / NumberOfBins;
 
-  for(size_t i = 1; i < numfeatures; i++)
+  void merge(const EnsembleBinCounter& other)
   {
-    if(removeBiasedFeatures == false || biasedFeatures[i] == false)
+    for(size_t j = 0; j < m_Counts.size(); j++)
     {
-      ensemble = eIds[i];
-      bin = (fPtr[i] - min) / stepsize;
-      if(bin >= NumberOfBins)
-      {
-        bin = NumberOfBins - 1;
-      }
-      ensembleArray[(NumberOfBins * ensemble) + bin]++;
+      m_Counts[j] += other.m_Counts[j];
     }
   }
+
+  const std::vector<int32_t>& getCounts() const
+  {
+    return m_Counts;
+  }
+
+private:
+  const T* m_Data;
+  const int32_t* m_EnsembleIds;
+  const bool* m_BiasedFeatures;
+  StreamingHistogram::BinLayout m_Layout;
+  std::vector<int32_t> m_Counts;
+};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T> void findHistogram(IDataArray::Pointer inputData, int32_t* ensembleArray, int32_t* eIds, size_t numEnsembles, int NumberOfBins, bool removeBiasedFeatures, bool* biasedFeatures)
+{
+  typename DataArray<T>::Pointer featureArray = std::dynamic_pointer_cast<DataArray<T>>(inputData);
+  if(nullptr == featureArray)
+  {
+    return;
+  }
+
+  T* fPtr = featureArray->getPointer(0);
+  size_t numfeatures = featureArray->getNumberOfTuples();
+
+  // The bins span the values of all Features, biased or not
+  StreamingHistogram::RangeSketch<T> range = StreamingHistogram::FindRange(fPtr, 1, numfeatures);
+  StreamingHistogram::BinLayout layout(range.getMin(), range.getMax(), NumberOfBins);
+
+  EnsembleBinCounter<T> exemplar(fPtr, eIds, removeBiasedFeatures ? biasedFeatures : nullptr, layout, numEnsembles);
+  EnsembleBinCounter<T> counter = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+  const std::vector<int32_t>& counts = counter.getCounts();
+  for(size_t j = 0; j < counts.size(); j++)
+  {
+    ensembleArray[j] += counts[j];
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -260,51 +290,53 @@ void FindFeatureHistogram::execute()
     return;
   }
 
+  size_t numEnsembles = m_NewEnsembleArrayPtr.lock()->getNumberOfTuples();
+
   QString dType = inputData->getTypeAsString();
   IDataArray::Pointer p = IDataArray::NullPointer();
   if(dType.compare("int8_t") == 0)
   {
-    findHistogram<int8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint8_t") == 0)
   {
-    findHistogram<uint8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int16_t") == 0)
   {
-    findHistogram<int16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint16_t") == 0)
   {
-    findHistogram<uint16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int32_t") == 0)
   {
-    findHistogram<int32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint32_t") == 0)
   {
-    findHistogram<uint32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int64_t") == 0)
   {
-    findHistogram<int64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint64_t") == 0)
   {
-    findHistogram<uint64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("float") == 0)
   {
-    findHistogram<float>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<float>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("double") == 0)
   {
-    findHistogram<double>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<double>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("bool") == 0)
   {
-    findHistogram<bool>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<bool>(inputData, m_NewEnsembleArray, m_FeaturePhases, numEnsembles, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
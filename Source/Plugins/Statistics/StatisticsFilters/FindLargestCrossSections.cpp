@@ -44,6 +44,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Statistics/StatisticsConstants.h"
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
 #include "Statistics/StatisticsVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -169,6 +170,87 @@ void FindLargestCrossSections::preflight()
   setInPreflight(false);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+namespace
+{
+/**
+ * @brief The CrossSectionAccumulator class finds, for every Feature, the largest number of voxels it has in a
+ * single slice. Each index is one slice; the voxel counts of a slice are reset only for the Features that
+ * actually appear in it, so a slice costs time proportional to its voxels and not to the number of Features.
+ */
+class CrossSectionAccumulator
+{
+public:
+  CrossSectionAccumulator(const int32_t* featureIds, size_t numFeatures, size_t inPlane1, size_t inPlane2, size_t stride1, size_t stride2, size_t stride3)
+  : m_FeatureIds(featureIds)
+  , m_InPlane1(inPlane1)
+  , m_InPlane2(inPlane2)
+  , m_Stride1(stride1)
+  , m_Stride2(stride2)
+  , m_Stride3(stride3)
+  , m_Counts(numFeatures, 0)
+  , m_LargestCounts(numFeatures, 0)
+  {
+  }
+
+  void addIndex(size_t slice)
+  {
+    size_t istride = slice * m_Stride1;
+    for(size_t k = 0; k < m_InPlane2; k++)
+    {
+      size_t kstride = istride + k * m_Stride3;
+      for(size_t j = 0; j < m_InPlane1; j++)
+      {
+        int32_t gnum = m_FeatureIds[kstride + j * m_Stride2];
+        if(m_Counts[gnum] == 0)
+        {
+          m_Touched.push_back(gnum);
+        }
+        m_Counts[gnum]++;
+      }
+    }
+    for(int32_t gnum : m_Touched)
+    {
+      if(m_Counts[gnum] > m_LargestCounts[gnum])
+      {
+        m_LargestCounts[gnum] = m_Counts[gnum];
+      }
+      m_Counts[gnum] = 0;
+    }
+    m_Touched.clear();
+  }
+
+  void merge(const CrossSectionAccumulator& other)
+  {
+    for(size_t g = 0; g < m_LargestCounts.size(); g++)
+    {
+      if(other.m_LargestCounts[g] > m_LargestCounts[g])
+      {
+        m_LargestCounts[g] = other.m_LargestCounts[g];
+      }
+    }
+  }
+
+  size_t getLargestCount(size_t feature) const
+  {
+    return m_LargestCounts[feature];
+  }
+
+private:
+  const int32_t* m_FeatureIds;
+  size_t m_InPlane1;
+  size_t m_InPlane2;
+  size_t m_Stride1;
+  size_t m_Stride2;
+  size_t m_Stride3;
+  std::vector<size_t> m_Counts;
+  std::vector<size_t> m_LargestCounts;
+  std::vector<int32_t> m_Touched;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -178,14 +260,9 @@ void FindLargestCrossSections::find_crosssections()
 
   size_t numfeatures = m_LargestCrossSectionsPtr.lock()->getNumberOfTuples();
 
-  DoubleArrayType::Pointer m_FeatureCounts = DoubleArrayType::CreateArray(numfeatures, "_INTERNAL_USE_ONLY_FeatureCounts");
-  double* featurecounts = m_FeatureCounts->getPointer(0);
-
   size_t outPlane = 0, inPlane1 = 0, inPlane2 = 0;
   float res_scalar = 0.0f, area = 0.0f;
   size_t stride1 = 0, stride2 = 0, stride3 = 0;
-  size_t istride = 0, jstride = 0, kstride = 0;
-  size_t point = 0, gnum = 0;
 
   float xRes = 0.0f;
   float yRes = 0.0f;
@@ -223,31 +300,17 @@ void FindLargestCrossSections::find_crosssections()
     stride2 = inPlane1;
     stride3 = inPlane1 * inPlane2;
   }
-  for(size_t i = 0; i < outPlane; i++)
+  // Every slice is counted independently, so the slices are split across threads and only the
+  // per-Feature maxima of the threads are merged
+  CrossSectionAccumulator exemplar(m_FeatureIds, numfeatures, inPlane1, inPlane2, stride1, stride2, stride3);
+  CrossSectionAccumulator crossSections = StreamingHistogram::Accumulate(0, outPlane, exemplar);
+
+  for(size_t g = 1; g < numfeatures; g++)
   {
-    for(size_t g = 0; g < numfeatures * 1; g++)
-    {
-      featurecounts[g] = 0.0f;
-    }
-    istride = i * stride1;
-    for(size_t j = 0; j < inPlane1; j++)
-    {
-      jstride = j * stride2;
-      for(size_t k = 0; k < inPlane2; k++)
-      {
-        kstride = k * stride3;
-        point = istride + jstride + kstride;
-        gnum = m_FeatureIds[point];
-        featurecounts[gnum]++;
-      }
-    }
-    for(size_t g = 1; g < numfeatures; g++)
+    area = static_cast<float>(crossSections.getLargestCount(g) * static_cast<double>(res_scalar));
+    if(area > m_LargestCrossSections[g])
     {
-      area = featurecounts[g] * res_scalar;
-      if(area > m_LargestCrossSections[g])
-      {
-        m_LargestCrossSections[g] = area;
-      }
+      m_LargestCrossSections[g] = area;
     }
   }
 }
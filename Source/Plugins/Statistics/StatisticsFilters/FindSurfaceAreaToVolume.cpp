@@ -35,6 +35,9 @@
 
 #include "FindSurfaceAreaToVolume.h"
 
+#include <atomic>
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -44,9 +47,74 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "Common/VoxelFaceNeighbors.hpp"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
+/**
+ * @brief The ExposedFacesVisitor class counts, per Feature and per face orientation, the Cell faces of one
+ * slab that are shared with a different Feature. Integer counts make the total area exact and independent
+ * of how the volume was split into slabs. All slabs add into one shared set of counts; a visitor keeps the
+ * counts of the run of Cells it is in and only adds them when the run ends, so the slabs rarely meet there.
+ */
+class ExposedFacesVisitor
+{
+  const int32_t* m_FeatureIds;
+  int64_t m_Offsets[6];
+  std::atomic<uint64_t>* m_FaceCounts;
+  int32_t m_Feature;
+  uint64_t m_RunCounts[3];
+
+public:
+  ExposedFacesVisitor(const int32_t* featureIds, const int64_t dims[3], std::atomic<uint64_t>* faceCounts)
+  : m_FeatureIds(featureIds)
+  , m_FaceCounts(faceCounts)
+  , m_Feature(0)
+  {
+    VoxelFaceNeighbors::NeighborOffsets(dims, m_Offsets);
+    m_RunCounts[0] = m_RunCounts[1] = m_RunCounts[2] = 0;
+  }
+
+  template <bool Interior> void visit(int64_t index, uint8_t faceMask)
+  {
+    int32_t feature = m_FeatureIds[index];
+    if(feature <= 0)
+    {
+      return;
+    }
+    if(feature != m_Feature)
+    {
+      flush();
+      m_Feature = feature;
+    }
+    // Axis normal to each face, in the -Z, -Y, -X, +X, +Y, +Z face order
+    const int32_t axis[6] = {2, 1, 0, 0, 1, 2};
+    for(int32_t l = 0; l < 6; l++)
+    {
+      if(Interior || (faceMask & (1 << l)) != 0)
+      {
+        m_RunCounts[axis[l]] += (m_FeatureIds[index + m_Offsets[l]] != feature) ? 1 : 0;
+      }
+    }
+  }
+
+  /**
+   * @brief flush Adds the counts of the current run to the shared counts; must be called once the slab is done
+   */
+  void flush()
+  {
+    for(size_t a = 0; a < 3; a++)
+    {
+      if(m_RunCounts[a] != 0)
+      {
+        m_FaceCounts[3 * m_Feature + a].fetch_add(m_RunCounts[a], std::memory_order_relaxed);
+        m_RunCounts[a] = 0;
+      }
+    }
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -228,89 +296,26 @@ void FindSurfaceAreaToVolume::execute()
   ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
   std::tie(xRes, yRes, zRes) = imageGeom->getResolution();
 
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
+  int64_t dims[3] = {
+      static_cast<int64_t>(imageGeom->getXPoints()), static_cast<int64_t>(imageGeom->getYPoints()), static_cast<int64_t>(imageGeom->getZPoints()),
+  };
 
   float voxelVol = xRes * yRes * zRes;
 
-  std::vector<float> featureSurfaceArea(static_cast<size_t>(numFeatures), 0.0f);
+  std::vector<std::atomic<uint64_t>> faceCounts(3 * static_cast<size_t>(numFeatures));
+  std::vector<ExposedFacesVisitor> visitors(VoxelFaceNeighbors::NumberOfSlabs(dims), ExposedFacesVisitor(m_FeatureIds, dims, faceCounts.data()));
+  VoxelFaceNeighbors::Enumerate(dims, visitors);
+  for(size_t s = 0; s < visitors.size(); s++)
+  {
+    visitors[s].flush();
+  }
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -xPoints * yPoints;
-  neighpoints[1] = -xPoints;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
-
-  int32_t feature = 0;
-  float onsurf = 0.0f;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  int64_t zStride = 0, yStride = 0;
-  for(int64_t i = 0; i < zPoints; i++)
+  // Faces normal to X are YZ faces, faces normal to Y are XZ faces and faces normal to Z are XY faces
+  const double faceAreas[3] = {static_cast<double>(yRes) * zRes, static_cast<double>(zRes) * xRes, static_cast<double>(xRes) * yRes};
+  std::vector<float> featureSurfaceArea(static_cast<size_t>(numFeatures), 0.0f);
+  for(size_t i = 1; i < static_cast<size_t>(numFeatures); i++)
   {
-    zStride = i * xPoints * yPoints;
-    for(int64_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(int64_t k = 0; k < xPoints; k++)
-      {
-        onsurf = 0.0f;
-        feature = m_FeatureIds[zStride + yStride + k];
-        if(feature > 0)
-        {
-          for(int32_t l = 0; l < 6; l++)
-          {
-            good = true;
-            neighbor = zStride + yStride + k + neighpoints[l];
-            if(l == 0 && i == 0)
-            {
-              good = false;
-            }
-            if(l == 5 && i == (zPoints - 1))
-            {
-              good = false;
-            }
-            if(l == 1 && j == 0)
-            {
-              good = false;
-            }
-            if(l == 4 && j == (yPoints - 1))
-            {
-              good = false;
-            }
-            if(l == 2 && k == 0)
-            {
-              good = false;
-            }
-            if(l == 3 && k == (xPoints - 1))
-            {
-              good = false;
-            }
-            if(good && m_FeatureIds[neighbor] != feature)
-            {
-              if(l == 0 || l == 5) // XY face shared
-              {
-                onsurf = onsurf + xRes * yRes;
-              }
-              if(l == 1 || l == 4) // YZ face shared
-              {
-                onsurf = onsurf + yRes * zRes;
-              }
-              if(l == 2 || l == 3) // XZ face shared
-              {
-                onsurf = onsurf + zRes * xRes;
-              }
-            }
-          }
-        }
-
-        featureSurfaceArea[m_FeatureIds[zStride + yStride + k]] = featureSurfaceArea[m_FeatureIds[zStride + yStride + k]] + onsurf;
-      }
-    }
+    featureSurfaceArea[i] = static_cast<float>(faceCounts[3 * i + 0] * faceAreas[0] + faceCounts[3 * i + 1] * faceAreas[1] + faceCounts[3 * i + 2] * faceAreas[2]);
   }
 
   const float thirdRootPi = std::pow(SIMPLib::Constants::k_Pif, 0.333333f);
@@ -47,6 +47,7 @@
 #include "Statistics/DistributionAnalysisOps/BetaOps.h"
 #include "Statistics/DistributionAnalysisOps/LogNormalOps.h"
 #include "Statistics/DistributionAnalysisOps/PowerLawOps.h"
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -227,6 +228,59 @@ void FitCorrelatedFeatureData::preflight()
   setInPreflight(false);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+namespace
+{
+/**
+ * @brief The BinnedMomentsAccumulator class gathers the DistributionMoments of the Feature values of every
+ * (Ensemble, correlation bin) pair
+ */
+template <typename T> class BinnedMomentsAccumulator
+{
+public:
+  BinnedMomentsAccumulator(const T* data, const int32_t* eIds, const int32_t* binIds, const bool* biasedFeatures, size_t numEnsembles, size_t numBins, bool withLogs)
+  : m_Data(data)
+  , m_EnsembleIds(eIds)
+  , m_BinIds(binIds)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_NumBins(numBins)
+  , m_Moments(numEnsembles * numBins, DistributionMoments(withLogs))
+  {
+  }
+
+  void addIndex(size_t i)
+  {
+    if(nullptr == m_BiasedFeatures || m_BiasedFeatures[i] == false)
+    {
+      m_Moments[m_NumBins * m_EnsembleIds[i] + m_BinIds[i]].addValue(static_cast<float>(m_Data[i]));
+    }
+  }
+
+  void merge(const BinnedMomentsAccumulator& other)
+  {
+    for(size_t j = 0; j < m_Moments.size(); j++)
+    {
+      m_Moments[j].merge(other.m_Moments[j]);
+    }
+  }
+
+  const std::vector<DistributionMoments>& getMoments() const
+  {
+    return m_Moments;
+  }
+
+private:
+  const T* m_Data;
+  const int32_t* m_EnsembleIds;
+  const int32_t* m_BinIds;
+  const bool* m_BiasedFeatures;
+  size_t m_NumBins;
+  std::vector<DistributionMoments> m_Moments;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -267,34 +321,25 @@ void fitData(IDataArray::Pointer inputData, float* ensembleArray, int32_t* eIds,
   T* fPtr = featureArray->getPointer(0);
   int32_t* bPtr = binArray->getPointer(0);
 
-  // float max;
-  // float min;
   std::vector<VectorOfFloatArray> dist;
-  std::vector<std::vector<std::vector<float>>> values;
 
   size_t numfeatures = featureArray->getNumberOfTuples();
 
   dist.resize(numEnsembles);
-  values.resize(numEnsembles);
 
   for(int64_t i = 1; i < numEnsembles; i++)
   {
     dist[i] = sData->CreateCorrelatedDistributionArrays(dType, numBins);
-    values[i].resize(numBins);
   }
 
-  int32_t ensemble;
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(removeBiasedFeatures == false || biasedFeatures[i] == false)
-    {
-      ensemble = eIds[i];
-      values[ensemble][bPtr[i]].push_back(static_cast<float>(fPtr[i]));
-    }
-  }
+  BinnedMomentsAccumulator<T> exemplar(fPtr, eIds, bPtr, removeBiasedFeatures ? biasedFeatures : nullptr, numEnsembles, numBins, distributionAnalysis[dType]->requiresLogMoments());
+  BinnedMomentsAccumulator<T> accumulator = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+  const std::vector<DistributionMoments>& moments = accumulator.getMoments();
+
   for(int64_t i = 1; i < numEnsembles; i++)
   {
-    distributionAnalysis[dType]->calculateCorrelatedParameters(values[i], dist[i]);
+    std::vector<DistributionMoments> ensembleMoments(moments.begin() + numBins * i, moments.begin() + numBins * (i + 1));
+    distributionAnalysis[dType]->calculateCorrelatedParameters(ensembleMoments, dist[i]);
     for(int j = 0; j < numBins; j++)
     {
       for(int k = 0; k < numComp; k++)
@@ -323,27 +368,13 @@ template <typename T> Int32ArrayType::Pointer binData(typename DataArray<T>::Poi
   typename DataArray<int32_t>::Pointer binArray = DataArray<int32_t>::CreateArray(numfeatures, "binIds");
   int32_t* bPtr = binArray->getPointer(0);
 
-  float max = -100000000.0;
-  float min = 100000000.0;
+  StreamingHistogram::RangeSketch<T> range = StreamingHistogram::FindRange(fPtr, 1, numfeatures);
 
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(static_cast<T>(fPtr[i]) < min)
-    {
-      min = static_cast<T>(fPtr[i]);
-    }
-    if(static_cast<T>(fPtr[i]) > max)
-    {
-      max = static_cast<T>(fPtr[i]);
-    }
-  }
   // to make sure the max value feature doesn't walk off the end of the array, add a small value to the max
-  max += 0.000001f;
-
-  float step = (max - min) / numBins;
+  StreamingHistogram::BinLayout layout(range.getMin(), range.getMax() + 0.000001f, static_cast<int32_t>(numBins));
   for(size_t i = 1; i < numfeatures; i++)
   {
-    bPtr[i] = (fPtr[i] - min) / step;
+    bPtr[i] = layout.clampBin(fPtr[i]);
   }
   return binArray;
 }
@@ -48,6 +48,7 @@
 #include "Statistics/DistributionAnalysisOps/LogNormalOps.h"
 #include "Statistics/DistributionAnalysisOps/PowerLawOps.h"
 #include "Statistics/StatisticsConstants.h"
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
 #include "Statistics/StatisticsVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -205,6 +206,54 @@ void FitFeatureData::preflight()
   setInPreflight(false);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+namespace
+{
+/**
+ * @brief The EnsembleMomentsAccumulator class gathers the DistributionMoments of the Feature values of every Ensemble
+ */
+template <typename T> class EnsembleMomentsAccumulator
+{
+public:
+  EnsembleMomentsAccumulator(const T* data, const int32_t* eIds, const bool* biasedFeatures, size_t numEnsembles, bool withLogs)
+  : m_Data(data)
+  , m_EnsembleIds(eIds)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_Moments(numEnsembles, DistributionMoments(withLogs))
+  {
+  }
+
+  void addIndex(size_t i)
+  {
+    if(nullptr == m_BiasedFeatures || m_BiasedFeatures[i] == false)
+    {
+      m_Moments[m_EnsembleIds[i]].addValue(static_cast<float>(m_Data[i]));
+    }
+  }
+
+  void merge(const EnsembleMomentsAccumulator& other)
+  {
+    for(size_t j = 0; j < m_Moments.size(); j++)
+    {
+      m_Moments[j].merge(other.m_Moments[j]);
+    }
+  }
+
+  const std::vector<DistributionMoments>& getMoments() const
+  {
+    return m_Moments;
+  }
+
+private:
+  const T* m_Data;
+  const int32_t* m_EnsembleIds;
+  const bool* m_BiasedFeatures;
+  std::vector<DistributionMoments> m_Moments;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -239,30 +288,22 @@ template <typename T> void fitData(IDataArray::Pointer inDataPtr, float* ensembl
   T* fPtr = inputDataPtr->getPointer(0);
 
   std::vector<FloatArrayType::Pointer> dist;
-  std::vector<std::vector<float>> values;
 
   size_t numfeatures = inputDataPtr->getNumberOfTuples();
 
   dist.resize(numEnsembles);
-  values.resize(numEnsembles);
 
   for(size_t i = 1; i < numEnsembles; i++)
   {
     dist[i] = sData->CreateDistributionArrays(dType);
   }
 
-  int32_t ensemble = 0;
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(removeBiasedFeatures == false || biasedFeatures[i] == false)
-    {
-      ensemble = eIds[i];
-      values[ensemble].push_back(static_cast<float>(fPtr[i]));
-    }
-  }
+  EnsembleMomentsAccumulator<T> exemplar(fPtr, eIds, removeBiasedFeatures ? biasedFeatures : nullptr, numEnsembles, distributionAnalysis[dType]->requiresLogMoments());
+  EnsembleMomentsAccumulator<T> accumulator = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+  const std::vector<DistributionMoments>& moments = accumulator.getMoments();
   for(size_t i = 1; i < numEnsembles; i++)
   {
-    distributionAnalysis[dType]->calculateParameters(values[i], dist[i]);
+    distributionAnalysis[dType]->calculateParameters(moments[i], dist[i]);
     for(int32_t j = 0; j < numComp; j++)
     {
       FloatArrayType::Pointer data = dist[i];
@@ -35,6 +35,18 @@
 
 #include "GenerateEnsembleStatistics.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/PhaseType.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -55,9 +67,11 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "Statistics/DistributionAnalysisOps/BetaOps.h"
+#include "Statistics/DistributionAnalysisOps/DistributionMoments.h"
 #include "Statistics/DistributionAnalysisOps/LogNormalOps.h"
 #include "Statistics/DistributionAnalysisOps/PowerLawOps.h"
 #include "Statistics/StatisticsConstants.h"
+#include "Statistics/StatisticsFilters/util/StreamingHistogram.h"
 #include "Statistics/StatisticsVersion.h"
 
 #include "EbsdLib/EbsdConstants.h"
@@ -684,265 +698,664 @@ void GenerateEnsembleStatistics::preflight()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherSizeStats()
+namespace
 {
-  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+/**
+ * @brief isSizeCorrelatedPhase Returns true for the phase types whose statistics are correlated with Feature size
+ * @param phaseType
+ * @return
+ */
+bool isSizeCorrelatedPhase(PhaseType::EnumType phaseType)
+{
+  return phaseType == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || phaseType == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
+         phaseType == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation);
+}
 
-  float maxdiam = 0.0f;
-  float mindiam = 0.0f;
-  float totalUnbiasedVolume = 0.0f;
-  QVector<VectorOfFloatArray> sizedist;
-  std::vector<std::vector<std::vector<float>>> values;
+/**
+ * @brief getFeatureSizeBins Reads the Feature size binning that gatherSizeStats() stored for an Ensemble
+ * @param statsData
+ * @param phaseType
+ * @param minDiameter
+ * @param binStep
+ * @param numBins
+ * @return False if the Ensemble holds no size correlated statistics
+ */
+bool getFeatureSizeBins(const StatsData::Pointer& statsData, PhaseType::EnumType phaseType, float& minDiameter, float& binStep, size_t& numBins)
+{
+  FloatArrayType::Pointer binNumbers;
+  if(phaseType == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
+  {
+    PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsData);
+    binNumbers = pp->getBinNumbers();
+    minDiameter = pp->getMinFeatureDiameter();
+    binStep = pp->getBinStepSize();
+  }
+  else if(phaseType == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
+  {
+    PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsData);
+    binNumbers = pp->getBinNumbers();
+    minDiameter = pp->getMinFeatureDiameter();
+    binStep = pp->getBinStepSize();
+  }
+  else if(phaseType == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+  {
+    TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsData);
+    binNumbers = tp->getBinNumbers();
+    minDiameter = tp->getMinFeatureDiameter();
+    binStep = tp->getBinStepSize();
+  }
+  if(nullptr == binNumbers.get())
+  {
+    return false;
+  }
+  numBins = binNumbers->getSize();
+  return numBins > 0;
+}
 
-  FloatArrayType::Pointer binnumbers;
-  size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
-  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+/**
+ * @brief The FeatureSizeAccumulator class sums the volume of the Features of every Ensemble and gathers the
+ * DistributionMoments of the unbiased Feature diameters
+ */
+class FeatureSizeAccumulator
+{
+public:
+  FeatureSizeAccumulator(const float* diameters, const int32_t* featurePhases, const bool* biasedFeatures, size_t numEnsembles, bool withLogs)
+  : m_Diameters(diameters)
+  , m_FeaturePhases(featurePhases)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_Moments(numEnsembles, DistributionMoments(withLogs))
+  , m_Volumes(numEnsembles, 0.0)
+  {
+  }
 
-  std::vector<float> fractions(numensembles, 0.0f);
-  sizedist.resize(numensembles);
-  values.resize(numensembles);
+  void addIndex(size_t i)
+  {
+    float diameter = m_Diameters[i];
+    int32_t phase = m_FeaturePhases[i];
+    if(m_BiasedFeatures[i] == false)
+    {
+      m_Moments[phase].addValue(diameter);
+    }
+    m_Volumes[phase] += (1.0 / 6.0) * SIMPLib::Constants::k_Pi * diameter * diameter * diameter;
+  }
 
-  for(size_t i = 1; i < numensembles; i++)
+  void merge(const FeatureSizeAccumulator& other)
   {
-    sizedist[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_SizeDistributionFitType, 1);
-    values[i].resize(1);
+    for(size_t j = 0; j < m_Moments.size(); j++)
+    {
+      m_Moments[j].merge(other.m_Moments[j]);
+      m_Volumes[j] += other.m_Volumes[j];
+    }
   }
 
-  float vol = 0.0f;
-  for(size_t i = 1; i < numfeatures; i++)
+  const DistributionMoments& getMoments(size_t phase) const
   {
-    if(m_BiasedFeatures[i] == false)
+    return m_Moments[phase];
+  }
+
+  double getVolume(size_t phase) const
+  {
+    return m_Volumes[phase];
+  }
+
+private:
+  const float* m_Diameters;
+  const int32_t* m_FeaturePhases;
+  const bool* m_BiasedFeatures;
+  std::vector<DistributionMoments> m_Moments;
+  std::vector<double> m_Volumes;
+};
+
+/**
+ * @brief The SizeCorrelatedMomentsAccumulator class gathers, for every Ensemble and every Feature size bin, the
+ * DistributionMoments of each component of an unbiased Feature array. Ensembles with no size bins are skipped and
+ * diameters beyond the last bin are counted in the last bin.
+ */
+template <typename T> class SizeCorrelatedMomentsAccumulator
+{
+public:
+  SizeCorrelatedMomentsAccumulator(const T* data, size_t numComponents, const float* diameters, const int32_t* featurePhases, const bool* biasedFeatures, const std::vector<float>& minDiameters,
+                                   const std::vector<float>& binSteps, const std::vector<size_t>& numBins, bool withLogs)
+  : m_Data(data)
+  , m_NumComponents(numComponents)
+  , m_Diameters(diameters)
+  , m_FeaturePhases(featurePhases)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_MinDiameters(minDiameters.data())
+  , m_BinSteps(binSteps.data())
+  , m_NumBins(numBins.data())
+  , m_Offsets(numBins.size(), 0)
+  {
+    size_t totalBins = 0;
+    for(size_t j = 0; j < numBins.size(); j++)
     {
-      values[m_FeaturePhases[i]][0].push_back(m_EquivalentDiameters[i]);
+      m_Offsets[j] = totalBins;
+      totalBins += numBins[j];
     }
-    vol = (1.0f / 6.0f) * SIMPLib::Constants::k_Pi * m_EquivalentDiameters[i] * m_EquivalentDiameters[i] * m_EquivalentDiameters[i];
-    fractions[m_FeaturePhases[i]] = fractions[m_FeaturePhases[i]] + vol;
-    totalUnbiasedVolume = totalUnbiasedVolume + vol;
+    m_Moments.resize(totalBins * m_NumComponents, DistributionMoments(withLogs));
   }
-  for(size_t i = 1; i < numensembles; i++)
+
+  void addIndex(size_t i)
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Matrix))
+    int32_t phase = m_FeaturePhases[i];
+    if(m_BiasedFeatures[i] == true || m_NumBins[phase] == 0)
     {
-      MatrixStatsData::Pointer pp = std::dynamic_pointer_cast<MatrixStatsData>(statsDataArray[i]);
-      pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
+      return;
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
+    float position = (m_Diameters[i] - m_MinDiameters[phase]) / m_BinSteps[phase];
+    size_t bin = (position > 0.0f) ? static_cast<size_t>(position) : 0;
+    bin = std::min(bin, m_NumBins[phase] - 1);
+    DistributionMoments* moments = &(m_Moments[(m_Offsets[phase] + bin) * m_NumComponents]);
+    for(size_t c = 0; c < m_NumComponents; c++)
     {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
-      pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
-      int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
-      pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
-      binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
-      DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
-      pp->setBinNumbers(binnumbers);
+      moments[c].addValue(static_cast<float>(m_Data[m_NumComponents * i + c]));
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
+  }
+
+  void merge(const SizeCorrelatedMomentsAccumulator& other)
+  {
+    for(size_t j = 0; j < m_Moments.size(); j++)
     {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
-      pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
-      int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
-      pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
-      binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
-      DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
-      pp->setBinNumbers(binnumbers);
+      m_Moments[j].merge(other.m_Moments[j]);
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+  }
+
+  /**
+   * @brief getMoments Returns the moments of one component in every size bin of an Ensemble
+   * @param phase
+   * @param component
+   * @return
+   */
+  std::vector<DistributionMoments> getMoments(size_t phase, size_t component) const
+  {
+    std::vector<DistributionMoments> moments(m_NumBins[phase]);
+    for(size_t bin = 0; bin < moments.size(); bin++)
     {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      tp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
-      tp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
-      int numbins = int(maxdiam / m_SizeCorrelationResolution) + 1;
-      tp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
-      binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
-      DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
-      tp->setBinNumbers(binnumbers);
+      moments[bin] = m_Moments[(m_Offsets[phase] + bin) * m_NumComponents + component];
+    }
+    return moments;
+  }
+
+private:
+  const T* m_Data;
+  size_t m_NumComponents;
+  const float* m_Diameters;
+  const int32_t* m_FeaturePhases;
+  const bool* m_BiasedFeatures;
+  const float* m_MinDiameters;
+  const float* m_BinSteps;
+  const size_t* m_NumBins;
+  std::vector<size_t> m_Offsets;
+  std::vector<DistributionMoments> m_Moments;
+};
+
+/**
+ * @brief The FeatureOdfBinsImpl class implements a threaded algorithm that finds the ODF bin of the Euler angles
+ * of every Feature. Consecutive Features with the same Laue class are handed to LaueOps::getOdfBins() as one batch;
+ * Features with a negative Laue index are skipped and get the bin -1.
+ */
+class FeatureOdfBinsImpl
+{
+  const float* m_Eulers;
+  const int32_t* m_LaueIndices;
+  int32_t* m_Bins;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+
+public:
+  FeatureOdfBinsImpl(const float* eulers, const int32_t* laueIndices, int32_t* bins)
+  : m_Eulers(eulers)
+  , m_LaueIndices(laueIndices)
+  , m_Bins(bins)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+  virtual ~FeatureOdfBinsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    size_t i = start;
+    while(i < end)
+    {
+      int32_t laueIndex = m_LaueIndices[i];
+      size_t runEnd = i + 1;
+      while(runEnd < end && m_LaueIndices[runEnd] == laueIndex)
+      {
+        runEnd++;
+      }
+      if(laueIndex >= 0)
+      {
+        m_OrientationOps[laueIndex]->getOdfBins(m_Eulers + 3 * i, runEnd - i, m_Bins + i);
+      }
+      else
+      {
+        std::fill(m_Bins + i, m_Bins + runEnd, -1);
+      }
+      i = runEnd;
     }
   }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief findFeatureOdfBins Fills bins with the ODF bin of every Feature, see FeatureOdfBinsImpl
+ * @param eulers
+ * @param laueIndices
+ * @param bins
+ */
+void findFeatureOdfBins(const float* eulers, const std::vector<int32_t>& laueIndices, std::vector<int32_t>& bins)
+{
+  size_t numfeatures = laueIndices.size();
+  bins.resize(numfeatures);
+  if(numfeatures == 0)
+  {
+    return;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numfeatures), FeatureOdfBinsImpl(eulers, laueIndices.data(), bins.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FeatureOdfBinsImpl serial(eulers, laueIndices.data(), bins.data());
+    serial.compute(0, numfeatures);
+  }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherAspectRatioStats()
+/**
+ * @brief The EnsembleBinAccumulator class sums, for every Ensemble, the weight of the Features that fall into each
+ * bin along with the total weight of the Ensemble. Excluded Features are skipped and, without a weight array, every
+ * Feature weighs one.
+ */
+class EnsembleBinAccumulator
 {
-  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+public:
+  EnsembleBinAccumulator(const int32_t* bins, const float* weights, const int32_t* featurePhases, const bool* excludedFeatures, const std::vector<size_t>& numBins)
+  : m_Bins(bins)
+  , m_Weights(weights)
+  , m_FeaturePhases(featurePhases)
+  , m_ExcludedFeatures(excludedFeatures)
+  , m_Histograms(numBins.size())
+  , m_Totals(numBins.size(), 0.0)
+  {
+    for(size_t j = 0; j < numBins.size(); j++)
+    {
+      m_Histograms[j].resize(numBins[j], 0.0);
+    }
+  }
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> boveras;
-  QVector<VectorOfFloatArray> coveras;
-  std::vector<std::vector<std::vector<float>>> bvalues;
-  std::vector<std::vector<std::vector<float>>> cvalues;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
-  size_t numfeatures = m_AspectRatiosPtr.lock()->getNumberOfTuples();
-  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+  void addIndex(size_t i)
+  {
+    if(m_ExcludedFeatures[i] == true)
+    {
+      return;
+    }
+    int32_t phase = m_FeaturePhases[i];
+    double weight = (nullptr == m_Weights) ? 1.0 : static_cast<double>(m_Weights[i]);
+    m_Totals[phase] += weight;
+    int32_t bin = m_Bins[i];
+    if(bin >= 0 && static_cast<size_t>(bin) < m_Histograms[phase].size())
+    {
+      m_Histograms[phase][bin] += weight;
+    }
+  }
 
-  boveras.resize(numensembles);
-  coveras.resize(numensembles);
-  bvalues.resize(numensembles);
-  cvalues.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
-  for(size_t i = 1; i < numensembles; i++)
+  void merge(const EnsembleBinAccumulator& other)
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
+    for(size_t j = 0; j < m_Histograms.size(); j++)
     {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      for(size_t k = 0; k < m_Histograms[j].size(); k++)
+      {
+        m_Histograms[j][k] += other.m_Histograms[j][k];
+      }
+      m_Totals[j] += other.m_Totals[j];
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
+  }
+
+  /**
+   * @brief copyNormalizedHistogram Writes the histogram of an Ensemble divided by its total weight into array
+   * @param phase
+   * @param array
+   */
+  void copyNormalizedHistogram(size_t phase, FloatArrayType::Pointer array) const
+  {
+    const std::vector<double>& histogram = m_Histograms[phase];
+    double total = m_Totals[phase];
+    for(size_t k = 0; k < histogram.size(); k++)
     {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      array->setValue(k, (total > 0.0) ? static_cast<float>(histogram[k] / total) : 0.0f);
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+  }
+
+private:
+  const int32_t* m_Bins;
+  const float* m_Weights;
+  const int32_t* m_FeaturePhases;
+  const bool* m_ExcludedFeatures;
+  std::vector<std::vector<double>> m_Histograms;
+  std::vector<double> m_Totals;
+};
+
+/**
+ * @brief The MisorientationBinAccumulator class sums, for every Ensemble, the shared surface area of the boundaries
+ * between Features of the same Laue class into misorientation bins. A boundary is counted from the Feature with the
+ * lower Id, or from every side that touches a surface Feature. The misorientations of all counted boundaries of a
+ * Feature are handed to LaueOps::getMisoBins() as one batch.
+ */
+class MisorientationBinAccumulator
+{
+public:
+  MisorientationBinAccumulator(NeighborList<int32_t>& neighborList, NeighborList<float>& sharedSurfaceAreaList, QuatF* avgQuats, const int32_t* featurePhases, const uint32_t* crystalStructures,
+                               const bool* surfaceFeatures, const std::vector<size_t>& numBins)
+  : m_NeighborList(neighborList)
+  , m_SharedSurfaceAreaList(sharedSurfaceAreaList)
+  , m_AvgQuats(avgQuats)
+  , m_FeaturePhases(featurePhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_SurfaceFeatures(surfaceFeatures)
+  , m_Histograms(numBins.size())
+  , m_Totals(numBins.size(), 0.0)
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+    for(size_t j = 0; j < numBins.size(); j++)
     {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      boveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      coveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      bvalues[i].resize(tp->getBinNumbers()->getSize());
-      cvalues[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
+      m_Histograms[j].resize(numBins[j], 0.0);
     }
   }
-  for(size_t i = 1; i < numfeatures; i++)
+
+  void addIndex(size_t i)
   {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+    int32_t phase = m_FeaturePhases[i];
+    if(m_Histograms[phase].empty())
+    {
+      return;
+    }
+
+    uint32_t xtal = m_CrystalStructures[phase];
+    std::vector<int32_t>& neighbors = m_NeighborList[i];
+    std::vector<float>& areas = m_SharedSurfaceAreaList[i];
+    m_AxisAngles.clear();
+    m_Areas.clear();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    for(size_t j = 0; j < neighbors.size(); j++)
     {
-      if(m_BiasedFeatures[i] == false)
+      int32_t nname = neighbors[j];
+      if((static_cast<size_t>(nname) > i || m_SurfaceFeatures[nname] == true) && m_CrystalStructures[m_FeaturePhases[nname]] == xtal)
       {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        bvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i]);
-        cvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i + 1]);
+        float w = m_OrientationOps[xtal]->getMisoQuat(m_AvgQuats[i], m_AvgQuats[nname], n1, n2, n3);
+        m_AxisAngles.push_back(n1);
+        m_AxisAngles.push_back(n2);
+        m_AxisAngles.push_back(n3);
+        m_AxisAngles.push_back(w);
+        m_Areas.push_back(areas[j]);
       }
     }
+    if(m_Areas.empty())
+    {
+      return;
+    }
+
+    m_MisoBins.resize(m_Areas.size());
+    m_OrientationOps[xtal]->getMisoBins(m_AxisAngles.data(), m_Areas.size(), m_MisoBins.data());
+    std::vector<double>& histogram = m_Histograms[phase];
+    for(size_t k = 0; k < m_Areas.size(); k++)
+    {
+      int32_t bin = m_MisoBins[k];
+      if(bin >= 0 && static_cast<size_t>(bin) < histogram.size())
+      {
+        histogram[bin] += m_Areas[k];
+      }
+      m_Totals[phase] += m_Areas[k];
+    }
   }
-  for(size_t i = 1; i < numensembles; i++)
+
+  void merge(const MisorientationBinAccumulator& other)
   {
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
+    for(size_t j = 0; j < m_Histograms.size(); j++)
     {
-      PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
-      pp->setFeatureSize_BOverA(boveras[i]);
-      pp->setFeatureSize_COverA(coveras[i]);
+      for(size_t k = 0; k < m_Histograms[j].size(); k++)
+      {
+        m_Histograms[j][k] += other.m_Histograms[j][k];
+      }
+      m_Totals[j] += other.m_Totals[j];
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
+  }
+
+  /**
+   * @brief copyNormalizedHistogram Writes the histogram of an Ensemble divided by its total boundary area into array
+   * @param phase
+   * @param array
+   */
+  void copyNormalizedHistogram(size_t phase, FloatArrayType::Pointer array) const
+  {
+    const std::vector<double>& histogram = m_Histograms[phase];
+    double total = m_Totals[phase];
+    for(size_t k = 0; k < histogram.size(); k++)
     {
-      PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
-      pp->setFeatureSize_BOverA(boveras[i]);
-      pp->setFeatureSize_COverA(coveras[i]);
+      array->setValue(k, (total > 0.0) ? static_cast<float>(histogram[k] / total) : 0.0f);
     }
-    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
+  }
+
+  double getTotal(size_t phase) const
+  {
+    return m_Totals[phase];
+  }
+
+private:
+  NeighborList<int32_t>& m_NeighborList;
+  NeighborList<float>& m_SharedSurfaceAreaList;
+  QuatF* m_AvgQuats;
+  const int32_t* m_FeaturePhases;
+  const uint32_t* m_CrystalStructures;
+  const bool* m_SurfaceFeatures;
+  QVector<LaueOps::Pointer> m_OrientationOps;
+  std::vector<std::vector<double>> m_Histograms;
+  std::vector<double> m_Totals;
+  std::vector<float> m_AxisAngles;
+  std::vector<float> m_Areas;
+  std::vector<int32_t> m_MisoBins;
+};
+
+/**
+ * @brief The PrecipitateBoundaryAccumulator class counts, for every precipitate Ensemble, its Features and the
+ * Features among them that touch at least two Features of another non-matrix Ensemble
+ */
+class PrecipitateBoundaryAccumulator
+{
+public:
+  PrecipitateBoundaryAccumulator(NeighborList<int32_t>& neighborList, const int32_t* featurePhases, const PhaseType::EnumType* phaseTypes, size_t numEnsembles)
+  : m_NeighborList(neighborList)
+  , m_FeaturePhases(featurePhases)
+  , m_PhaseTypes(phaseTypes)
+  , m_BoundaryPPT(numEnsembles, 0)
+  , m_TotalNumPPT(numEnsembles, 0)
+  {
+  }
+
+  void addIndex(size_t i)
+  {
+    int32_t phase = m_FeaturePhases[i];
+    if(m_PhaseTypes[phase] != static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
-      TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
-      tp->setFeatureSize_BOverA(boveras[i]);
-      tp->setFeatureSize_COverA(coveras[i]);
+      return;
+    }
+    m_TotalNumPPT[phase]++;
+
+    // Currently counts something as on the boundary if it has at least two neighbors of a different
+    // non-matrix phase. Might want to specify which phase in the future.
+    std::vector<int32_t>& neighbors = m_NeighborList[i];
+    int32_t count = 0;
+    for(size_t j = 0; j < neighbors.size(); j++)
+    {
+      int32_t neighborPhase = m_FeaturePhases[neighbors[j]];
+      if(phase != neighborPhase && m_PhaseTypes[neighborPhase] != static_cast<PhaseType::EnumType>(PhaseType::Type::Matrix))
+      {
+        count++;
+      }
+    }
+    if(count >= 2)
+    {
+      m_BoundaryPPT[phase]++;
     }
   }
+
+  void merge(const PrecipitateBoundaryAccumulator& other)
+  {
+    for(size_t j = 0; j < m_TotalNumPPT.size(); j++)
+    {
+      m_BoundaryPPT[j] += other.m_BoundaryPPT[j];
+      m_TotalNumPPT[j] += other.m_TotalNumPPT[j];
+    }
+  }
+
+  float getBoundaryFraction(size_t phase) const
+  {
+    return static_cast<float>(m_BoundaryPPT[phase]) / static_cast<float>(m_TotalNumPPT[phase]);
+  }
+
+private:
+  NeighborList<int32_t>& m_NeighborList;
+  const int32_t* m_FeaturePhases;
+  const PhaseType::EnumType* m_PhaseTypes;
+  std::vector<int32_t> m_BoundaryPPT;
+  std::vector<int32_t> m_TotalNumPPT;
+};
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherOmega3Stats()
+void GenerateEnsembleStatistics::gatherSizeStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> omega3s;
-  std::vector<std::vector<std::vector<float>>> values;
-  QVector<float> mindiams;
-  QVector<float> binsteps;
-  size_t numfeatures = m_Omega3sPtr.lock()->getNumberOfTuples();
+  size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
-  omega3s.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
+  FeatureSizeAccumulator exemplar(m_EquivalentDiameters, m_FeaturePhases, m_BiasedFeatures, numensembles, m_DistributionAnalysis[m_SizeDistributionFitType]->requiresLogMoments());
+  FeatureSizeAccumulator sizes = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+
+  double totalUnbiasedVolume = 0.0;
+  for(size_t i = 0; i < numensembles; i++)
+  {
+    totalUnbiasedVolume += sizes.getVolume(i);
+  }
+
   for(size_t i = 1; i < numensembles; i++)
   {
+    float phaseFraction = static_cast<float>(sizes.getVolume(i) / totalUnbiasedVolume);
+    if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Matrix))
+    {
+      MatrixStatsData::Pointer pp = std::dynamic_pointer_cast<MatrixStatsData>(statsDataArray[i]);
+      pp->setPhaseFraction(phaseFraction);
+    }
+    if(isSizeCorrelatedPhase(m_PhaseTypes[i]) == false)
+    {
+      continue;
+    }
+
+    const DistributionMoments& diameters = sizes.getMoments(i);
+    VectorOfFloatArray sizedist = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_SizeDistributionFitType, 1);
+    m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(std::vector<DistributionMoments>(1, diameters), sizedist);
+
+    // Same sentinels as DistributionAnalysisOps::determineMaxAndMinValues() for an Ensemble without unbiased Features
+    float maxdiam = std::numeric_limits<float>::min();
+    float mindiam = std::numeric_limits<float>::max();
+    if(diameters.getCount() > 0)
+    {
+      maxdiam = std::max(maxdiam, diameters.getMaximum());
+      mindiam = diameters.getMinimum();
+    }
+    int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
+    FloatArrayType::Pointer binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber);
+    DistributionAnalysisOps::determineBinNumbers(maxdiam, mindiam, m_SizeCorrelationResolution, binnumbers);
+
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      pp->setPhaseFraction(phaseFraction);
+      pp->setFeatureSizeDistribution(sizedist);
+      pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
+      pp->setBinNumbers(binnumbers);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      pp->setPhaseFraction(phaseFraction);
+      pp->setFeatureSizeDistribution(sizedist);
+      pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
+      pp->setBinNumbers(binnumbers);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      omega3s[i] = tp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
+      tp->setPhaseFraction(phaseFraction);
+      tp->setFeatureSizeDistribution(sizedist);
+      tp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
+      tp->setBinNumbers(binnumbers);
     }
   }
-  for(size_t i = 1; i < numfeatures; i++)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateEnsembleStatistics::gatherAspectRatioStats()
+{
+  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+
+  size_t numfeatures = m_AspectRatiosPtr.lock()->getNumberOfTuples();
+  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+
+  std::vector<float> mindiams(numensembles, 0.0f);
+  std::vector<float> binsteps(numensembles, 1.0f);
+  std::vector<size_t> numbins(numensembles, 0);
+  for(size_t i = 1; i < numensembles; i++)
   {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(m_BiasedFeatures[i] == false)
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(m_Omega3s[i]);
-      }
-    }
+    getFeatureSizeBins(statsDataArray[i], m_PhaseTypes[i], mindiams[i], binsteps[i], numbins[i]);
   }
+
+  SizeCorrelatedMomentsAccumulator<float> exemplar(m_AspectRatios, 2, m_EquivalentDiameters, m_FeaturePhases, m_BiasedFeatures, mindiams, binsteps, numbins,
+                                                   m_DistributionAnalysis[m_AspectRatioDistributionFitType]->requiresLogMoments());
+  SizeCorrelatedMomentsAccumulator<float> aspectRatios = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+
   for(size_t i = 1; i < numensembles; i++)
   {
+    if(numbins[i] == 0)
+    {
+      continue;
+    }
+    VectorOfFloatArray boveras = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, numbins[i]);
+    VectorOfFloatArray coveras = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, numbins[i]);
+    m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(aspectRatios.getMoments(i, 0), boveras);
+    m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(aspectRatios.getMoments(i, 1), coveras);
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
-      pp->setFeatureSize_Omegas(omega3s[i]);
+      pp->setFeatureSize_BOverA(boveras);
+      pp->setFeatureSize_COverA(coveras);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
-      pp->setFeatureSize_Omegas(omega3s[i]);
+      pp->setFeatureSize_BOverA(boveras);
+      pp->setFeatureSize_COverA(coveras);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
-      tp->setFeatureSize_Omegas(omega3s[i]);
+      tp->setFeatureSize_BOverA(boveras);
+      tp->setFeatureSize_COverA(coveras);
     }
   }
 }
@@ -950,81 +1363,95 @@ void GenerateEnsembleStatistics::gatherOmega3Stats()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void GenerateEnsembleStatistics::gatherNeighborhoodStats()
+void GenerateEnsembleStatistics::gatherOmega3Stats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
-  QVector<VectorOfFloatArray> neighborhoods;
-  std::vector<std::vector<std::vector<float>>> values;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
-  size_t numfeatures = m_NeighborhoodsPtr.lock()->getNumberOfTuples();
+  size_t numfeatures = m_Omega3sPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
-  neighborhoods.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
+  std::vector<float> mindiams(numensembles, 0.0f);
+  std::vector<float> binsteps(numensembles, 1.0f);
+  std::vector<size_t> numbins(numensembles, 0);
   for(size_t i = 1; i < numensembles; i++)
   {
+    getFeatureSizeBins(statsDataArray[i], m_PhaseTypes[i], mindiams[i], binsteps[i], numbins[i]);
+  }
+
+  SizeCorrelatedMomentsAccumulator<float> exemplar(m_Omega3s, 1, m_EquivalentDiameters, m_FeaturePhases, m_BiasedFeatures, mindiams, binsteps, numbins,
+                                                   m_DistributionAnalysis[m_Omega3DistributionFitType]->requiresLogMoments());
+  SizeCorrelatedMomentsAccumulator<float> omega3Moments = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+
+  for(size_t i = 1; i < numensembles; i++)
+  {
+    if(numbins[i] == 0)
+    {
+      continue;
+    }
+    VectorOfFloatArray omega3s = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, numbins[i]);
+    m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(omega3Moments.getMoments(i, 0), omega3s);
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      pp->setFeatureSize_Omegas(omega3s);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      pp->setFeatureSize_Omegas(omega3s);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      neighborhoods[i] = tp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
+      tp->setFeatureSize_Omegas(omega3s);
     }
   }
+}
 
-  for(size_t i = 1; i < numfeatures; i++)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GenerateEnsembleStatistics::gatherNeighborhoodStats()
+{
+  StatsDataArray& statsDataArray = *(m_StatsDataArray);
+
+  size_t numfeatures = m_NeighborhoodsPtr.lock()->getNumberOfTuples();
+  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+
+  std::vector<float> mindiams(numensembles, 0.0f);
+  std::vector<float> binsteps(numensembles, 1.0f);
+  std::vector<size_t> numbins(numensembles, 0);
+  for(size_t i = 1; i < numensembles; i++)
   {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) || m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-      m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(m_BiasedFeatures[i] == false)
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(static_cast<float>(m_Neighborhoods[i]));
-      }
-    }
+    getFeatureSizeBins(statsDataArray[i], m_PhaseTypes[i], mindiams[i], binsteps[i], numbins[i]);
   }
+
+  SizeCorrelatedMomentsAccumulator<int32_t> exemplar(m_Neighborhoods, 1, m_EquivalentDiameters, m_FeaturePhases, m_BiasedFeatures, mindiams, binsteps, numbins,
+                                                     m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->requiresLogMoments());
+  SizeCorrelatedMomentsAccumulator<int32_t> neighborhoodMoments = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+
   for(size_t i = 1; i < numensembles; i++)
   {
+    if(numbins[i] == 0)
+    {
+      continue;
+    }
+    VectorOfFloatArray neighborhoods = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, numbins[i]);
+    m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(neighborhoodMoments.getMoments(i, 0), neighborhoods);
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
-      pp->setFeatureSize_Neighbors(neighborhoods[i]);
+      pp->setFeatureSize_Neighbors(neighborhoods);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
-      pp->setFeatureSize_Clustering(neighborhoods[i]);
+      pp->setFeatureSize_Clustering(neighborhoods);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
-      tp->setFeatureSize_Neighbors(neighborhoods[i]);
+      tp->setFeatureSize_Neighbors(neighborhoods);
     }
   }
 }
@@ -1036,73 +1463,59 @@ void GenerateEnsembleStatistics::gatherODFStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   size_t numfeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  int32_t phase = 0;
-  std::vector<float> totalvol;
-  std::vector<FloatArrayType::Pointer> eulerodf;
 
-  totalvol.resize(numensembles);
-  eulerodf.resize(numensembles);
-  uint64_t dims = 0;
+  // Only the hexagonal and cubic high symmetry Laue classes carry an ODF
+  std::vector<size_t> numbins(numensembles, 0);
   for(size_t i = 1; i < numensembles; i++)
   {
-    totalvol[i] = 0;
     if(m_CrystalStructures[i] == Ebsd::CrystalStructure::Hexagonal_High)
     {
-      dims = 36 * 36 * 12;
-      eulerodf[i] = FloatArrayType::CreateArray(dims, SIMPL::StringConstants::ODF);
-      for(uint64_t j = 0; j < dims; j++)
-      {
-        eulerodf[i]->setValue(j, 0.0);
-      }
+      numbins[i] = 36 * 36 * 12;
     }
     else if(m_CrystalStructures[i] == Ebsd::CrystalStructure::Cubic_High)
     {
-      dims = 18 * 18 * 18;
-      eulerodf[i] = FloatArrayType::CreateArray(dims, SIMPL::StringConstants::ODF);
-      for(uint64_t j = 0; j < dims; j++)
-      {
-        eulerodf[i]->setValue(j, 0.0);
-      }
+      numbins[i] = 18 * 18 * 18;
     }
   }
+
+  std::vector<int32_t> laueIndices(numfeatures, -1);
   for(size_t i = 1; i < numfeatures; i++)
   {
-    if(m_SurfaceFeatures[i] == false)
+    if(m_SurfaceFeatures[i] == false && numbins[m_FeaturePhases[i]] > 0)
     {
-      totalvol[m_FeaturePhases[i]] = totalvol[m_FeaturePhases[i]] + m_Volumes[i];
+      laueIndices[i] = static_cast<int32_t>(m_CrystalStructures[m_FeaturePhases[i]]);
     }
   }
-  for(size_t i = 1; i < numfeatures; i++)
+  std::vector<int32_t> bins;
+  findFeatureOdfBins(m_FeatureEulerAngles, laueIndices, bins);
+
+  EnsembleBinAccumulator exemplar(bins.data(), m_Volumes, m_FeaturePhases, m_SurfaceFeatures, numbins);
+  EnsembleBinAccumulator odfs = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+
+  for(size_t i = 1; i < numensembles; i++)
   {
-    if(m_SurfaceFeatures[i] == false)
+    FloatArrayType::Pointer eulerodf;
+    if(numbins[i] > 0)
     {
-      phase = m_CrystalStructures[m_FeaturePhases[i]];
-      FOrientArrayType eu(&(m_FeatureEulerAngles[3 * i]), 3); // Wrap the pointer
-      FOrientArrayType rod(4);
-      OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-      bin = m_OrientationOps[phase]->getOdfBin(rod);
-      eulerodf[m_FeaturePhases[i]]->setValue(bin, (eulerodf[m_FeaturePhases[i]]->getValue(bin) + (m_Volumes[i] / totalvol[m_FeaturePhases[i]])));
+      eulerodf = FloatArrayType::CreateArray(numbins[i], SIMPL::StringConstants::ODF);
+      odfs.copyNormalizedHistogram(i, eulerodf);
     }
-  }
-  for(size_t i = 1; i < numensembles; i++)
-  {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      pp->setODF(eulerodf[i]);
+      pp->setODF(eulerodf);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      pp->setODF(eulerodf[i]);
+      pp->setODF(eulerodf);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      tp->setODF(eulerodf[i]);
+      tp->setODF(eulerodf);
     }
   }
 }
@@ -1121,96 +1534,54 @@ void GenerateEnsembleStatistics::gatherMDFStats()
   // And we do the same for the SharedSurfaceArea list
   NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
 
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  int32_t mbin = 0;
-  float w = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   size_t numfeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  uint32_t phase1 = 0, phase2 = 0;
-  QVector<float> totalSurfaceArea;
-  QVector<FloatArrayType::Pointer> misobin;
-  int32_t numbins = 0;
 
-  misobin.resize(numensembles);
-  totalSurfaceArea.resize(numensembles);
+  // Only the hexagonal and cubic high symmetry Laue classes carry an MDF
+  std::vector<size_t> numbins(numensembles, 0);
   for(size_t i = 1; i < numensembles; ++i)
   {
-    totalSurfaceArea[i] = 0;
     if(Ebsd::CrystalStructure::Hexagonal_High == m_CrystalStructures[i])
     {
-      numbins = 36 * 36 * 12;
-      misobin[i] = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::MisorientationBins);
+      numbins[i] = 36 * 36 * 12;
     }
     else if(Ebsd::CrystalStructure::Cubic_High == m_CrystalStructures[i])
     {
-      numbins = 18 * 18 * 18;
-      misobin[i] = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::MisorientationBins);
-    }
-    // Now initialize all bins to 0.0
-    for(int32_t j = 0; j < numbins; j++)
-    {
-      misobin[i]->setValue(j, 0.0);
-    }
-  }
-  int32_t nname = 0;
-  float nsa = 0.0f;
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
-    {
-      w = 10000.0f;
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
-      phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      if(phase1 == phase2)
-      {
-        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-      }
-      if(phase1 == phase2)
-      {
-        FOrientArrayType rod(4);
-        FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-
-        if((nname > i || m_SurfaceFeatures[nname] == true))
-        {
-          mbin = m_OrientationOps[phase1]->getMisoBin(rod);
-          nsa = neighborsurfacearealist[i][j];
-          misobin[m_FeaturePhases[i]]->setValue(mbin, (misobin[m_FeaturePhases[i]]->getValue(mbin) + nsa));
-          totalSurfaceArea[m_FeaturePhases[i]] = totalSurfaceArea[m_FeaturePhases[i]] + nsa;
-        }
-      }
+      numbins[i] = 18 * 18 * 18;
     }
   }
 
+  MisorientationBinAccumulator exemplar(neighborlist, neighborsurfacearealist, avgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceFeatures, numbins);
+  MisorientationBinAccumulator mdfs = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
+
   for(size_t i = 1; i < numensembles; i++)
   {
-    for(size_t j = 0; j < misobin[i]->getSize(); j++)
+    FloatArrayType::Pointer misobin;
+    if(numbins[i] > 0)
     {
-      misobin[i]->setValue(j, (misobin[i]->getValue(j) / totalSurfaceArea[i]));
+      misobin = FloatArrayType::CreateArray(numbins[i], SIMPL::StringConstants::MisorientationBins);
+      mdfs.copyNormalizedHistogram(i, misobin);
     }
+    float totalSurfaceArea = static_cast<float>(mdfs.getTotal(i));
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      pp->setMisorientationBins(misobin[i]);
-      pp->setBoundaryArea(totalSurfaceArea[i]);
+      pp->setMisorientationBins(misobin);
+      pp->setBoundaryArea(totalSurfaceArea);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      pp->setMisorientationBins(misobin[i]);
-      pp->setBoundaryArea(totalSurfaceArea[i]);
+      pp->setMisorientationBins(misobin);
+      pp->setBoundaryArea(totalSurfaceArea);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      tp->setMisorientationBins(misobin[i]);
-      tp->setBoundaryArea(totalSurfaceArea[i]);
+      tp->setMisorientationBins(misobin);
+      tp->setBoundaryArea(totalSurfaceArea);
     }
   }
 }
@@ -1222,57 +1593,43 @@ void GenerateEnsembleStatistics::gatherAxisODFStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  int32_t bin = 0;
-  QVector<FloatArrayType::Pointer> axisodf;
-  QVector<float> totalaxes;
   size_t numfeatures = m_AxisEulerAnglesPtr.lock()->getNumberOfTuples();
   size_t numXTals = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  axisodf.resize(numXTals);
-  totalaxes.resize(numXTals);
-  for(size_t i = 1; i < numXTals; i++)
-  {
-    totalaxes[i] = 0.0;
-    axisodf[i] = FloatArrayType::CreateArray((36 * 36 * 36), SIMPL::StringConstants::AxisOrientation);
-    for(int32_t j = 0; j < (36 * 36 * 36); j++)
-    {
-      axisodf[i]->setValue(j, 0.0);
-    }
-  }
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(m_BiasedFeatures[i] == false)
-    {
-      totalaxes[m_FeaturePhases[i]]++;
-    }
-  }
+
+  // The axis orientations are binned with the orthorhombic Laue class for every Ensemble
+  std::vector<size_t> numbins(numXTals, 36 * 36 * 36);
+  std::vector<int32_t> laueIndices(numfeatures, -1);
   for(size_t i = 1; i < numfeatures; i++)
   {
     if(m_BiasedFeatures[i] == false)
     {
-      FOrientArrayType rod(4);
-      FOrientTransformsType::eu2ro(FOrientArrayType(&(m_AxisEulerAngles[3 * i]), 3), rod);
-      m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getODFFZRod(rod);
-      bin = m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getOdfBin(rod);
-      axisodf[m_FeaturePhases[i]]->setValue(bin, (axisodf[m_FeaturePhases[i]]->getValue(bin) + static_cast<float>((1.0 / totalaxes[m_FeaturePhases[i]]))));
+      laueIndices[i] = static_cast<int32_t>(Ebsd::CrystalStructure::OrthoRhombic);
     }
   }
+  std::vector<int32_t> bins;
+  findFeatureOdfBins(m_AxisEulerAngles, laueIndices, bins);
+
+  EnsembleBinAccumulator exemplar(bins.data(), nullptr, m_FeaturePhases, m_BiasedFeatures, numbins);
+  EnsembleBinAccumulator axisodfs = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
 
   for(size_t i = 1; i < numXTals; i++)
   {
+    FloatArrayType::Pointer axisodf = FloatArrayType::CreateArray(numbins[i], SIMPL::StringConstants::AxisOrientation);
+    axisodfs.copyNormalizedHistogram(i, axisodf);
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      pp->setAxisOrientation(axisodf[i]);
+      pp->setAxisOrientation(axisodf);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      pp->setAxisOrientation(axisodf[i]);
+      pp->setAxisOrientation(axisodf);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      tp->setAxisOrientation(axisodf[i]);
+      tp->setAxisOrientation(axisodf);
     }
   }
 }
@@ -1327,40 +1684,16 @@ void GenerateEnsembleStatistics::calculatePPTBoundaryFrac()
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
-  std::vector<int32_t> boundaryPPT(numensembles, 0);
-  std::vector<int32_t> totalNumPPT(numensembles, 0);
-  std::vector<float> PPTBoundaryFrac(numensembles, 0);
-  int32_t count = 0;
+
+  PrecipitateBoundaryAccumulator exemplar(neighborlist, m_FeaturePhases, m_PhaseTypes, numensembles);
+  PrecipitateBoundaryAccumulator boundaries = StreamingHistogram::Accumulate(1, numfeatures, exemplar);
 
   for(size_t k = 1; k < numensembles; k++)
   {
-    if (m_PhaseTypes[k] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
+    if(m_PhaseTypes[k] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
-      for(size_t i = 1; i < numfeatures; i++)
-      {
-        if(m_FeaturePhases[i] == k)
-        {
-          totalNumPPT[k]++;
-
-          for(size_t j = 0; j < neighborlist[i].size(); j++)
-          {
-            if(m_FeaturePhases[i] != m_FeaturePhases[neighborlist[i][j]] &&
-              m_PhaseTypes[m_FeaturePhases[neighborlist[i][j]]] != static_cast<PhaseType::EnumType>(PhaseType::Type::Matrix)) // Currently counts something as on the boundary if it has at least two neighbors of a different
-                                                                                                                                   // non-matrix phase. Might want to specify which phase in the future.
-            {
-              count++;
-            }
-          }
-          if(count >= 2)
-          {
-            boundaryPPT[k]++;
-          }
-          count = 0;
-        }
-      }
-      PPTBoundaryFrac[k] = (float)boundaryPPT[k] / (float)totalNumPPT[k];
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[k]);
-      pp->setPrecipBoundaryFraction(PPTBoundaryFrac[k]);
+      pp->setPrecipBoundaryFraction(boundaries.getBoundaryFraction(k));
     }
   }
 }
@@ -1441,40 +1774,64 @@ void GenerateEnsembleStatistics::execute()
     m_StatsDataArray->fillArrayWithNewStatsData(m_PhaseTypesPtr.lock()->getNumberOfTuples(), m_PhaseTypes);
   }
 
+  // The size correlated statistics read the Feature size bins, so the size statistics come first. All other
+  // statistics only touch their own members of the StatsData and run as independent tasks.
   if(m_ComputeSizeDistribution == true)
   {
     gatherSizeStats();
   }
+
+  std::vector<std::function<void()>> gathers;
   if(m_ComputeAspectRatioDistribution == true)
   {
-    gatherAspectRatioStats();
+    gathers.push_back([this] { gatherAspectRatioStats(); });
   }
   if(m_ComputeOmega3Distribution == true)
   {
-    gatherOmega3Stats();
+    gathers.push_back([this] { gatherOmega3Stats(); });
   }
   if(m_ComputeNeighborhoodDistribution == true)
   {
-    gatherNeighborhoodStats();
+    gathers.push_back([this] { gatherNeighborhoodStats(); });
   }
   if(m_CalculateODF == true)
   {
-    gatherODFStats();
+    gathers.push_back([this] { gatherODFStats(); });
   }
   if(m_CalculateMDF == true)
   {
-    gatherMDFStats();
+    gathers.push_back([this] { gatherMDFStats(); });
   }
   if(m_CalculateAxisODF == true)
   {
-    gatherAxisODFStats();
+    gathers.push_back([this] { gatherAxisODFStats(); });
   }
   if(m_IncludeRadialDistFunc == true)
   {
-    gatherRadialDistFunc();
+    gathers.push_back([this] { gatherRadialDistFunc(); });
   }
+  gathers.push_back([this] { calculatePPTBoundaryFrac(); });
 
-  calculatePPTBoundaryFrac();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel == true)
+  {
+    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
+    for(const std::function<void()>& gather : gathers)
+    {
+      g->run(gather);
+    }
+    g->wait(); // Wait for all the threads to complete before moving on.
+  }
+  else
+#endif
+  {
+    for(const std::function<void()>& gather : gathers)
+    {
+      gather();
+    }
+  }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -35,6 +35,8 @@
 
 #include "QuiltCellData.h"
 
+#include <algorithm>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -45,6 +47,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#include "Statistics/StatisticsFilters/util/SummedAreaTable.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -260,76 +264,50 @@ void QuiltCellData::preflight()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T> float quiltData(IDataArray::Pointer inputData, int64_t xc, int64_t yc, int64_t zc, IntVec3_t pSize, int64_t xDim, int64_t yDim, int64_t zDim)
+template <typename T> bool initializeQuiltTable(IDataArray::Pointer inputData, size_t dims[3], size_t zBegin, size_t zEnd, SummedAreaTable& table)
 {
-  float value = 0.0;
   typename DataArray<T>::Pointer cellArray = std::dynamic_pointer_cast<DataArray<T>>(inputData);
   if(nullptr == cellArray)
   {
-    return 0.0;
-  }
-
-  T* cPtr = cellArray->getPointer(0);
-
-  int64_t zStride = 0, yStride = 0;
-  float count = 0;
-
-  int xRangeMin = -floorf((float)pSize.x / 2.0f);
-  int xRangeMax = floorf((float)pSize.x / 2.0f);
-  int yRangeMin = -floorf((float)pSize.y / 2.0f);
-  int yRangeMax = floorf((float)pSize.y / 2.0f);
-  int zRangeMin = -floorf((float)pSize.z / 2.0f);
-  int zRangeMax = floorf((float)pSize.z / 2.0f);
-
-  if(pSize.x == 1)
-  {
-    xRangeMin = 0;
-    xRangeMax = 1;
-  }
-
-  if(pSize.y == 1)
-  {
-    yRangeMin = 0;
-    yRangeMax = 1;
+    return false;
   }
+  table.initialize(cellArray->getPointer(0), dims[0], dims[1], dims[2], false, zBegin, zEnd);
+  return true;
+}
 
-  if(pSize.z == 1)
+// -----------------------------------------------------------------------------
+// Returns the half open offsets [rangeMin, rangeMax) of a patch of the given size around its center cell
+// -----------------------------------------------------------------------------
+void patchRange(int size, int64_t& rangeMin, int64_t& rangeMax)
+{
+  rangeMin = -floorf((float)size / 2.0f);
+  rangeMax = floorf((float)size / 2.0f);
+  if(size == 1)
   {
-    zRangeMin = 0;
-    zRangeMax = 1;
+    rangeMin = 0;
+    rangeMax = 1;
   }
+}
 
-  for(int64_t k = zRangeMin; k < zRangeMax; k++)
-  {
-    if((zc + k) >= 0 && (zc + k) < zDim)
-    {
-      zStride = ((zc + k) * xDim * yDim);
-      for(int64_t j = yRangeMin; j < yRangeMax; j++)
-      {
-        if((yc + j) >= 0 && (yc + j) < yDim)
-        {
-          yStride = ((yc + j) * xDim);
-          for(int64_t i = xRangeMin; i < xRangeMax; i++)
-          {
-            if((xc + i) >= 0 && (xc + i) < xDim)
-            {
-              value += cPtr[zStride + yStride + (xc + i)];
-              count++;
-            }
-          }
-        }
-      }
-    }
-  }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float quiltData(const SummedAreaTable& table, int64_t xc, int64_t yc, int64_t zc, IntVec3_t pSize)
+{
+  int64_t xRangeMin = 0, xRangeMax = 0;
+  int64_t yRangeMin = 0, yRangeMax = 0;
+  int64_t zRangeMin = 0, zRangeMax = 0;
+  patchRange(pSize.x, xRangeMin, xRangeMax);
+  patchRange(pSize.y, yRangeMin, yRangeMax);
+  patchRange(pSize.z, zRangeMin, zRangeMax);
+
+  size_t count = table.windowCount(xc + xRangeMin, xc + xRangeMax, yc + yRangeMin, yc + yRangeMax, zc + zRangeMin, zc + zRangeMax);
   if(count == 0)
   {
-    value = 0;
-  }
-  else
-  {
-    value /= count;
+    return 0.0f;
   }
-  return value;
+  double value = table.windowSum(xc + xRangeMin, xc + xRangeMax, yc + yRangeMin, yc + yRangeMax, zc + zRangeMin, zc + zRangeMax);
+  return static_cast<float>(value / static_cast<double>(count));
 }
 
 // -----------------------------------------------------------------------------
@@ -365,13 +343,63 @@ void QuiltCellData::execute()
 
   QString dType = inputData->getTypeAsString();
 
-  int64_t dims[3] = {0, 0, 0};
-  dims[0] = static_cast<int64_t>(dcDims[0]);
-  dims[1] = static_cast<int64_t>(dcDims[1]);
-  dims[2] = static_cast<int64_t>(dcDims[2]);
+  // Overlapping patches would read the same cells many times, so the cell data is integrated once and every
+  // patch average is then read from the summed area table in constant time. Every patch is centered on plane
+  // zc = 0, so the table only needs to cover the planes that patch reaches instead of the whole volume.
+  const int64_t zc = 0;
+  int64_t zRangeMin = 0, zRangeMax = 0;
+  patchRange(m_PatchSize.z, zRangeMin, zRangeMax);
+  size_t zBegin = static_cast<size_t>(std::max<int64_t>(zc + zRangeMin, 0));
+  size_t zEnd = static_cast<size_t>(std::max<int64_t>(zc + zRangeMax, 0));
+  SummedAreaTable table;
+  bool initialized = false;
+  if(dType.compare("int8_t") == 0)
+  {
+    initialized = initializeQuiltTable<int8_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("uint8_t") == 0)
+  {
+    initialized = initializeQuiltTable<uint8_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("int16_t") == 0)
+  {
+    initialized = initializeQuiltTable<int16_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("uint16_t") == 0)
+  {
+    initialized = initializeQuiltTable<uint16_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("int32_t") == 0)
+  {
+    initialized = initializeQuiltTable<int32_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("uint32_t") == 0)
+  {
+    initialized = initializeQuiltTable<uint32_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("int64_t") == 0)
+  {
+    initialized = initializeQuiltTable<int64_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("uint64_t") == 0)
+  {
+    initialized = initializeQuiltTable<uint64_t>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("float") == 0)
+  {
+    initialized = initializeQuiltTable<float>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("double") == 0)
+  {
+    initialized = initializeQuiltTable<double>(inputData, dcDims, zBegin, zEnd, table);
+  }
+  else if(dType.compare("bool") == 0)
+  {
+    initialized = initializeQuiltTable<bool>(inputData, dcDims, zBegin, zEnd, table);
+  }
 
   int64_t zStride = 0, yStride = 0;
-  int64_t xc = 0, yc = 0, zc = 0;
+  int64_t xc = 0, yc = 0;
   for(size_t k = 0; k < dc2Dims[2]; k++)
   {
     zStride = (k * dc2Dims[0] * dc2Dims[1]);
@@ -383,51 +411,7 @@ void QuiltCellData::execute()
         xc = i * m_QuiltStep.x + m_QuiltStep.x / 2;
         yc = j * m_QuiltStep.y + m_QuiltStep.y / 2;
         // zc = k * m_QuiltStep.z + m_QuiltStep.z / 2;
-        zc = 0;
-        if(dType.compare("int8_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int8_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint8_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint8_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("int16_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int16_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint16_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint16_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("int32_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int32_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint32_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint32_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("int64_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<int64_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("uint64_t") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<uint64_t>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("float") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<float>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("double") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<double>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
-        else if(dType.compare("bool") == 0)
-        {
-          m_OutputArray[zStride + yStride + i] = quiltData<bool>(inputData, xc, yc, zc, m_PatchSize, dims[0], dims[1], dims[2]);
-        }
+        m_OutputArray[zStride + yStride + i] = initialized ? quiltData(table, xc, yc, zc, m_PatchSize) : 0.0f;
       }
     }
   }
@@ -194,6 +194,63 @@ MomentInvariants2D::DoubleMatrixType MomentInvariants2D::computeMomentInvariants
   return mnknew;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MomentInvariants2D::DoubleMatrixType MomentInvariants2D::computeMomentInvariantsFromPixelSums(const DoubleMatrixType& pixelSums, size_t max_order)
+{
+  int mDim = static_cast<int>(max_order + 1);
+
+  DoubleMatrixType bn = binomial(max_order);
+
+  // center of mass of the pixel centers; pixelSums(0,0) is the area of the object in units of pixels
+  double yc = pixelSums(1, 0) / pixelSums(0, 0);
+  double xc = pixelSums(0, 1) / pixelSums(0, 0);
+
+  // shift the sums to the center of mass using the binomial theorem
+  DoubleMatrixType centered(mDim, mDim);
+  centered.setZero();
+  for(int p = 0; p < mDim; p++)
+  {
+    for(int q = 0; q < mDim; q++)
+    {
+      for(int k = 0; k < p + 1; k++)
+      {
+        for(int l = 0; l < q + 1; l++)
+        {
+          centered(p, q) += std::pow(-1.0, (p + q - k - l)) * std::pow(yc, (p - k)) * std::pow(xc, (q - l)) * bn(p, k) * bn(q, l) * pixelSums(k, l);
+        }
+      }
+    }
+  }
+
+  // moments of a unit square about its center: the integral of t^k over [-1/2, 1/2]
+  std::vector<double> square(mDim, 0.0);
+  for(int k = 0; k < mDim; k += 2)
+  {
+    square[k] = 1.0 / ((k + 1.0) * std::pow(2.0, k));
+  }
+
+  // integrate every pixel as a unit square around its center
+  DoubleMatrixType mnknew(mDim, mDim);
+  mnknew.setZero();
+  for(int p = 0; p < mDim; p++)
+  {
+    for(int q = 0; q < mDim; q++)
+    {
+      for(int k = 0; k < p + 1; k++)
+      {
+        for(int l = 0; l < q + 1; l++)
+        {
+          mnknew(p, q) += bn(p, k) * bn(q, l) * square[k] * square[l] * centered(p - k, q - l);
+        }
+      }
+    }
+  }
+
+  return mnknew;
+}
+
 #if 0
 // -----------------------------------------------------------------------------
 //
@@ -76,6 +76,16 @@ class MomentInvariants2D
      */
     DoubleMatrixType computeMomentInvariants(DoubleMatrixType &input, size_t* inputDims, size_t max_order);
 
+    /**
+     * @brief computeMomentInvariantsFromPixelSums Computes the same central moments as computeMomentInvariants() from the
+     * sums of the powers of the integer pixel coordinates of the object instead of from an image of it. Each pixel is
+     * integrated as a unit square around its coordinates, so the result does not depend on the origin of the coordinates.
+     * @param pixelSums (max_order + 1) x (max_order + 1) matrix whose (p, q) entry is the sum of y^p * x^q over all pixels
+     * @param max_order
+     * @return
+     */
+    DoubleMatrixType computeMomentInvariantsFromPixelSums(const DoubleMatrixType& pixelSums, size_t max_order);
+
 #if 0
     /**
      * @brief binomial
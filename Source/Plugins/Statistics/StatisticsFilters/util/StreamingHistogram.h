@@ -0,0 +1,364 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The StreamingHistogram namespace holds a small engine for histograms and other per-bin summaries of
+ * large arrays. The index range is split into one contiguous slab per thread, every slab is streamed through its
+ * own copy of an accumulator, and the copies are merged back in slab order. An accumulator is any copyable class
+ * with an addIndex(size_t) method that folds one element into it and a merge(const Accumulator&) method that folds
+ * in the accumulator of the following slab; neither ever sees a copy of the values it summarizes.
+ */
+namespace StreamingHistogram
+{
+/**
+ * @brief NumberOfSlabs Returns how many slabs Accumulate() splits a range of numValues indices into
+ * @param numValues
+ * @return
+ */
+inline size_t NumberOfSlabs(size_t numValues)
+{
+  size_t numSlabs = 1;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  numSlabs = static_cast<size_t>(std::max(init.default_num_threads(), 1));
+#endif
+  return std::max(std::min(numSlabs, numValues), static_cast<size_t>(1));
+}
+
+/**
+ * @brief The SlabImpl class implements a threaded algorithm that streams each slab of an index range through
+ * the accumulator of that slab
+ */
+template <typename AccumulatorType> class SlabImpl
+{
+  size_t m_Start;
+  size_t m_End;
+  size_t m_NumSlabs;
+  AccumulatorType* m_Accumulators;
+
+public:
+  SlabImpl(size_t start, size_t end, size_t numSlabs, AccumulatorType* accumulators)
+  : m_Start(start)
+  , m_End(end)
+  , m_NumSlabs(numSlabs)
+  , m_Accumulators(accumulators)
+  {
+  }
+  virtual ~SlabImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    size_t numValues = m_End - m_Start;
+    for(size_t slab = start; slab < end; slab++)
+    {
+      AccumulatorType& accumulator = m_Accumulators[slab];
+      size_t first = m_Start + slab * numValues / m_NumSlabs;
+      size_t last = m_Start + (slab + 1) * numValues / m_NumSlabs;
+      for(size_t i = first; i < last; i++)
+      {
+        accumulator.addIndex(i);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief Accumulate Streams the indices [start, end) through copies of exemplar, one per slab, and returns
+ * the merged result. Since the slabs are merged in order the result does not depend on the thread count
+ * beyond floating point rounding.
+ * @param start
+ * @param end
+ * @param exemplar Empty accumulator that every slab starts from
+ * @return
+ */
+template <typename AccumulatorType> AccumulatorType Accumulate(size_t start, size_t end, const AccumulatorType& exemplar)
+{
+  if(end <= start)
+  {
+    return exemplar;
+  }
+
+  size_t numSlabs = NumberOfSlabs(end - start);
+  std::vector<AccumulatorType> accumulators(numSlabs, exemplar);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs), SlabImpl<AccumulatorType>(start, end, numSlabs, accumulators.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SlabImpl<AccumulatorType> serial(start, end, numSlabs, accumulators.data());
+    serial.compute(0, numSlabs);
+  }
+
+  for(size_t slab = 1; slab < numSlabs; slab++)
+  {
+    accumulators[0].merge(accumulators[slab]);
+  }
+  return accumulators[0];
+}
+
+/**
+ * @brief The RangeSketch class is the accumulator of the first pass of an automatically binned histogram: it
+ * finds the smallest and largest value of an array, compared as floats
+ */
+template <typename T> class RangeSketch
+{
+public:
+  explicit RangeSketch(const T* data)
+  : m_Data(data)
+  , m_Min(std::numeric_limits<float>::max())
+  , m_Max(-std::numeric_limits<float>::max())
+  {
+  }
+
+  void addIndex(size_t i)
+  {
+    float value = static_cast<float>(m_Data[i]);
+    if(value > m_Max)
+    {
+      m_Max = value;
+    }
+    if(value < m_Min)
+    {
+      m_Min = value;
+    }
+  }
+
+  void merge(const RangeSketch& other)
+  {
+    m_Min = std::min(m_Min, other.m_Min);
+    m_Max = std::max(m_Max, other.m_Max);
+  }
+
+  float getMin() const
+  {
+    return m_Min;
+  }
+
+  float getMax() const
+  {
+    return m_Max;
+  }
+
+private:
+  const T* m_Data;
+  float m_Min;
+  float m_Max;
+};
+
+/**
+ * @brief FindRange Runs the sketch pass over the indices [start, end) of data
+ * @param data
+ * @param start
+ * @param end
+ * @return
+ */
+template <typename T> RangeSketch<T> FindRange(const T* data, size_t start, size_t end)
+{
+  return Accumulate(start, end, RangeSketch<T>(data));
+}
+
+/**
+ * @brief The BinLayout class describes numBins equal width bins that start at min. Bin i covers the left closed,
+ * right open interval [min + i * increment, min + (i + 1) * increment).
+ */
+class BinLayout
+{
+public:
+  BinLayout(float min, float max, int32_t numBins)
+  : m_Min(min)
+  , m_Increment((max - min) / numBins)
+  , m_NumBins(numBins)
+  {
+  }
+
+  float getMin() const
+  {
+    return m_Min;
+  }
+
+  float getIncrement() const
+  {
+    return m_Increment;
+  }
+
+  int32_t getNumberOfBins() const
+  {
+    return m_NumBins;
+  }
+
+  /**
+   * @brief getUpperEdge Returns the right (open) end of a bin
+   * @param bin
+   * @return
+   */
+  float getUpperEdge(int32_t bin) const
+  {
+    return m_Min + m_Increment * (bin + 1);
+  }
+
+  /**
+   * @brief findBin Returns the bin that holds value, or -1 when value lies outside of all bins. The bin
+   * position is truncated toward zero, so a value that sits just below a minimum that was rounded to float
+   * still lands in the first bin. When the bins have zero width only values equal to the minimum are binned.
+   * @param value
+   * @return
+   */
+  template <typename T> int32_t findBin(T value) const
+  {
+    if(m_Increment == 0.0f)
+    {
+      return (value == m_Min) ? 0 : -1;
+    }
+    auto position = (value - m_Min) / m_Increment;
+    if(position > -1 && position < m_NumBins)
+    {
+      return static_cast<int32_t>(position);
+    }
+    return -1;
+  }
+
+  /**
+   * @brief clampBin Returns the bin that holds value, with values outside of all bins (and every value
+   * when the bins have zero width) moved into the first or last bin
+   * @param value
+   * @return
+   */
+  template <typename T> int32_t clampBin(T value) const
+  {
+    auto position = (value - m_Min) / m_Increment;
+    if(position >= m_NumBins)
+    {
+      return m_NumBins - 1;
+    }
+    if(position > 0)
+    {
+      return static_cast<int32_t>(position);
+    }
+    return 0;
+  }
+
+private:
+  float m_Min;
+  float m_Increment;
+  int32_t m_NumBins;
+};
+
+/**
+ * @brief The BinCounter class counts the values of an array that fall into each bin of a BinLayout and
+ * how many fall outside of all of them
+ */
+template <typename T> class BinCounter
+{
+public:
+  BinCounter(const T* data, const BinLayout& layout)
+  : m_Data(data)
+  , m_Layout(layout)
+  , m_Counts(static_cast<size_t>(layout.getNumberOfBins()), 0)
+  , m_Overflow(0)
+  {
+  }
+
+  void addIndex(size_t i)
+  {
+    int32_t bin = m_Layout.findBin(m_Data[i]);
+    if(bin >= 0)
+    {
+      m_Counts[bin]++;
+    }
+    else
+    {
+      m_Overflow++;
+    }
+  }
+
+  void merge(const BinCounter& other)
+  {
+    for(size_t bin = 0; bin < m_Counts.size(); bin++)
+    {
+      m_Counts[bin] += other.m_Counts[bin];
+    }
+    m_Overflow += other.m_Overflow;
+  }
+
+  const std::vector<uint64_t>& getCounts() const
+  {
+    return m_Counts;
+  }
+
+  uint64_t getOverflow() const
+  {
+    return m_Overflow;
+  }
+
+private:
+  const T* m_Data;
+  BinLayout m_Layout;
+  std::vector<uint64_t> m_Counts;
+  uint64_t m_Overflow;
+};
+}
@@ -0,0 +1,199 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The SummedAreaTable class is an integral volume of a scalar cell array: each entry holds the sum of all
+ * values in the box from the origin to that cell, in double precision. Once built in a single pass over the data,
+ * the sum, sum of squares and number of cells inside any axis aligned window are available in constant time
+ * regardless of the window size, which makes moving window statistics (mean, variance) independent of the
+ * window size. The table stores one extra zero plane along each axis so that no boundary checks are needed.
+ * When only a few planes of the volume are ever read, the table can be restricted to that slab of planes so its
+ * memory follows the slab instead of the whole volume; windows are then clipped to the slab.
+ */
+class SummedAreaTable
+{
+  public:
+    SummedAreaTable() = default;
+    virtual ~SummedAreaTable() = default;
+
+    /**
+     * @brief initialize Builds the table for the given cell data
+     * @param data Scalar cell data with x varying fastest
+     * @param xDim Number of cells along X
+     * @param yDim Number of cells along Y
+     * @param zDim Number of cells along Z
+     * @param withSquares Whether to also build the table of the squared values needed for windowSumOfSquares()
+     */
+    template <typename T> void initialize(const T* data, size_t xDim, size_t yDim, size_t zDim, bool withSquares)
+    {
+      initialize(data, xDim, yDim, zDim, withSquares, 0, zDim);
+    }
+
+    /**
+     * @brief initialize Builds the table for the planes [zBegin, zEnd) of the given cell data only
+     * @param data Scalar cell data of the whole volume with x varying fastest
+     * @param xDim Number of cells along X
+     * @param yDim Number of cells along Y
+     * @param zDim Number of cells along Z
+     * @param withSquares Whether to also build the table of the squared values needed for windowSumOfSquares()
+     * @param zBegin First plane of the slab
+     * @param zEnd One past the last plane of the slab; clamped to zDim
+     */
+    template <typename T> void initialize(const T* data, size_t xDim, size_t yDim, size_t zDim, bool withSquares, size_t zBegin, size_t zEnd)
+    {
+      zEnd = zEnd > zDim ? zDim : zEnd;
+      zBegin = zBegin > zEnd ? zEnd : zBegin;
+      size_t slabDim = zEnd - zBegin;
+      m_Dims[0] = static_cast<int64_t>(xDim);
+      m_Dims[1] = static_cast<int64_t>(yDim);
+      m_Dims[2] = static_cast<int64_t>(zEnd);
+      m_ZBegin = static_cast<int64_t>(zBegin);
+      size_t tableSize = (xDim + 1) * (yDim + 1) * (slabDim + 1);
+      m_Sums.assign(tableSize, 0.0);
+      m_SumsOfSquares.clear();
+      if(withSquares)
+      {
+        m_SumsOfSquares.assign(tableSize, 0.0);
+      }
+
+      // S(x,y,z) = S(x,y,z-1) + S(x,y-1,z) - S(x,y-1,z-1) + (sum of the row of z up to x)
+      size_t rowStride = xDim + 1;
+      size_t sliceStride = rowStride * (yDim + 1);
+      const T* value = data + zBegin * xDim * yDim;
+      for(size_t z = 1; z <= slabDim; z++)
+      {
+        for(size_t y = 1; y <= yDim; y++)
+        {
+          double rowSum = 0.0;
+          double rowSumOfSquares = 0.0;
+          size_t index = z * sliceStride + y * rowStride + 1;
+          for(size_t x = 1; x <= xDim; x++, index++, value++)
+          {
+            double v = static_cast<double>(*value);
+            rowSum += v;
+            m_Sums[index] = m_Sums[index - sliceStride] + m_Sums[index - rowStride] - m_Sums[index - rowStride - sliceStride] + rowSum;
+            if(withSquares)
+            {
+              rowSumOfSquares += v * v;
+              m_SumsOfSquares[index] = m_SumsOfSquares[index - sliceStride] + m_SumsOfSquares[index - rowStride] - m_SumsOfSquares[index - rowStride - sliceStride] + rowSumOfSquares;
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief windowCount Returns the number of cells of the half open window [xMin,xMax) x [yMin,yMax) x [zMin,zMax)
+     * after clipping it to the volume
+     */
+    size_t windowCount(int64_t xMin, int64_t xMax, int64_t yMin, int64_t yMax, int64_t zMin, int64_t zMax) const
+    {
+      if(!clip(xMin, xMax, yMin, yMax, zMin, zMax))
+      {
+        return 0;
+      }
+      return static_cast<size_t>((xMax - xMin) * (yMax - yMin) * (zMax - zMin));
+    }
+
+    /**
+     * @brief windowSum Returns the sum of the values of the half open window [xMin,xMax) x [yMin,yMax) x [zMin,zMax)
+     * after clipping it to the volume
+     */
+    double windowSum(int64_t xMin, int64_t xMax, int64_t yMin, int64_t yMax, int64_t zMin, int64_t zMax) const
+    {
+      if(!clip(xMin, xMax, yMin, yMax, zMin, zMax))
+      {
+        return 0.0;
+      }
+      return boxSum(m_Sums, xMin, xMax, yMin, yMax, zMin, zMax);
+    }
+
+    /**
+     * @brief windowSumOfSquares Returns the sum of the squared values of the half open window
+     * [xMin,xMax) x [yMin,yMax) x [zMin,zMax) after clipping it to the volume. The table must have been
+     * initialized with withSquares set.
+     */
+    double windowSumOfSquares(int64_t xMin, int64_t xMax, int64_t yMin, int64_t yMax, int64_t zMin, int64_t zMax) const
+    {
+      if(m_SumsOfSquares.empty() || !clip(xMin, xMax, yMin, yMax, zMin, zMax))
+      {
+        return 0.0;
+      }
+      return boxSum(m_SumsOfSquares, xMin, xMax, yMin, yMax, zMin, zMax);
+    }
+
+  protected:
+    /**
+     * @brief clip Clips the window to the volume (or the slab the table was built for) and returns false if nothing
+     * is left of it
+     */
+    bool clip(int64_t& xMin, int64_t& xMax, int64_t& yMin, int64_t& yMax, int64_t& zMin, int64_t& zMax) const
+    {
+      xMin = xMin < 0 ? 0 : xMin;
+      yMin = yMin < 0 ? 0 : yMin;
+      zMin = zMin < m_ZBegin ? m_ZBegin : zMin;
+      xMax = xMax > m_Dims[0] ? m_Dims[0] : xMax;
+      yMax = yMax > m_Dims[1] ? m_Dims[1] : yMax;
+      zMax = zMax > m_Dims[2] ? m_Dims[2] : zMax;
+      return xMin < xMax && yMin < yMax && zMin < zMax;
+    }
+
+    /**
+     * @brief boxSum Inclusion-exclusion over the eight corners of a clipped window
+     */
+    double boxSum(const std::vector<double>& table, int64_t xMin, int64_t xMax, int64_t yMin, int64_t yMax, int64_t zMin, int64_t zMax) const
+    {
+      int64_t rowStride = m_Dims[0] + 1;
+      int64_t sliceStride = rowStride * (m_Dims[1] + 1);
+      int64_t z0 = (zMin - m_ZBegin) * sliceStride;
+      int64_t z1 = (zMax - m_ZBegin) * sliceStride;
+      int64_t y0 = yMin * rowStride;
+      int64_t y1 = yMax * rowStride;
+      return (table[z1 + y1 + xMax] - table[z1 + y1 + xMin] - table[z1 + y0 + xMax] + table[z1 + y0 + xMin]) -
+             (table[z0 + y1 + xMax] - table[z0 + y1 + xMin] - table[z0 + y0 + xMax] + table[z0 + y0 + xMin]);
+    }
+
+  private:
+    int64_t m_Dims[3] = {0, 0, 0};
+    int64_t m_ZBegin = 0;
+    std::vector<double> m_Sums;
+    std::vector<double> m_SumsOfSquares;
+};
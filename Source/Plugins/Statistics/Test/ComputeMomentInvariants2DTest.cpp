@@ -322,6 +322,71 @@ public:
     // std::cout << "normalized moment invariants: " << omega1 << "\t" << omega2 << std::endl;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestComputeMomentsFromPixelSums()
+  {
+    MomentInvariants2D moments;
+    size_t max_order = 2;
+    size_t mDim = max_order + 1;
+
+    // The same 3x3 square as TestComputeMoments2D(), given as sums of y^p * x^q over its pixel coordinates
+    MomentInvariants2D::DoubleMatrixType pixelSums(mDim, mDim);
+    pixelSums.setZero();
+    for(size_t y = 1; y <= 3; y++)
+    {
+      for(size_t x = 1; x <= 3; x++)
+      {
+        for(size_t p = 0; p < mDim; p++)
+        {
+          for(size_t q = 0; q < mDim; q++)
+          {
+            pixelSums(p, q) += std::pow(static_cast<double>(y), p) * std::pow(static_cast<double>(x), q);
+          }
+        }
+      }
+    }
+    MomentInvariants2D::DoubleMatrixType centralMoments = moments.computeMomentInvariantsFromPixelSums(pixelSums, max_order);
+
+    MomentInvariants2D::DoubleMatrixType idealCentralMoments(3, 3);
+    idealCentralMoments << 9.0, 0.0, 6.75, 0.0, 0.0, 0.0, 6.75, 0.0, 5.0625;
+    MomentInvariants2D::DoubleMatrixType diff = centralMoments - idealCentralMoments;
+    DREAM3D_REQUIRE(diff.cwiseAbs().maxCoeff() < 0.000001)
+
+    // An L shaped object must give the same central moments as the image based computation
+    MomentInvariants2D::DoubleMatrixType input2D(4, 4);
+    input2D << 1, 0, 0, 0,
+        /*Row*/ 1, 0, 0, 0,
+        /*Row*/ 1, 1, 0, 0,
+        /*Row*/ 1, 1, 1, 1;
+    size_t inputDims[2] = {4, 4};
+    MomentInvariants2D::DoubleMatrixType imageMoments = moments.computeMomentInvariants(input2D, inputDims, max_order);
+
+    pixelSums.setZero();
+    for(size_t y = 0; y < 4; y++)
+    {
+      for(size_t x = 0; x < 4; x++)
+      {
+        if(input2D(y, x) == 0.0)
+        {
+          continue;
+        }
+        for(size_t p = 0; p < mDim; p++)
+        {
+          for(size_t q = 0; q < mDim; q++)
+          {
+            // Offset the coordinates; the central moments must not depend on the origin
+            pixelSums(p, q) += std::pow(static_cast<double>(y + 100), p) * std::pow(static_cast<double>(x + 7), q);
+          }
+        }
+      }
+    }
+    centralMoments = moments.computeMomentInvariantsFromPixelSums(pixelSums, max_order);
+    diff = centralMoments - imageMoments;
+    DREAM3D_REQUIRE(diff.cwiseAbs().maxCoeff() < 0.000001)
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -332,6 +397,7 @@ public:
     DREAM3D_REGISTER_TEST(TestBinomial());
     DREAM3D_REGISTER_TEST(TestBigX());
     DREAM3D_REGISTER_TEST(TestComputeMoments2D());
+    DREAM3D_REGISTER_TEST(TestComputeMomentsFromPixelSums());
 
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
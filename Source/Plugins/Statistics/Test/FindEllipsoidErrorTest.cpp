@@ -0,0 +1,264 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FindEllipsoidErrorTest
+{
+
+public:
+  FindEllipsoidErrorTest()
+  {
+  }
+  virtual ~FindEllipsoidErrorTest()
+  {
+  }
+
+  /**
+   * @brief The Ellipsoid struct describes an ideal ellipsoid the way FindShapes reports it: the centroid and the
+   * semi-axis lengths in physical units and the Bunge Euler angles of the axes in radians
+   */
+  struct Ellipsoid
+  {
+    float centroid[3];
+    float axes[3];
+    float euler[3];
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindEllipsoidError Filter from the FilterManager
+    QString filtName = "FindEllipsoidError";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindEllipsoidErrorTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Returns the sum of the squared normalized coordinates of the point in the frame of the ellipsoid, with every
+  // semi-axis scaled by the given factor; the point is inside when the result is below 1
+  // -----------------------------------------------------------------------------
+  double EllipsoidDistance(const Ellipsoid& ellipsoid, double scale, const double point[3])
+  {
+    double c1 = std::cos(ellipsoid.euler[0]), s1 = std::sin(ellipsoid.euler[0]);
+    double c = std::cos(ellipsoid.euler[1]), s = std::sin(ellipsoid.euler[1]);
+    double c2 = std::cos(ellipsoid.euler[2]), s2 = std::sin(ellipsoid.euler[2]);
+    // Passive Bunge rotation from the sample frame into the frame of the ellipsoid axes
+    double g[3][3] = {{c1 * c2 - s1 * s2 * c, s1 * c2 + c1 * s2 * c, s2 * s}, {-c1 * s2 - s1 * c2 * c, -s1 * s2 + c1 * c2 * c, c2 * s}, {s1 * s, -c1 * s, c}};
+    double d[3] = {point[0] - ellipsoid.centroid[0], point[1] - ellipsoid.centroid[1], point[2] - ellipsoid.centroid[2]};
+    double distance = 0.0;
+    for(size_t r = 0; r < 3; r++)
+    {
+      double component = (g[r][0] * d[0] + g[r][1] * d[1] + g[r][2] * d[2]) / (scale * ellipsoid.axes[r]);
+      distance += component * component;
+    }
+    return distance;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestEllipsoidError3D(float originX, float originY, float originZ)
+  {
+    size_t dims[3] = {40, 30, 24};
+    float res[3] = {0.5f, 0.75f, 1.0f};
+    float origin[3] = {originX, originY, originZ};
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    // Feature 1 is a voxelized copy of its ellipsoid, slightly shrunk so no cell sits on the surface. Feature 2 fills an
+    // ellipsoid 1.3 times larger than the one it is compared against, so roughly 1 - 1 / 1.3^3 of its cells are outside.
+    Ellipsoid ellipsoids[3] = {{{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}},
+                               {{6.0f, 7.0f, 6.0f}, {5.0f, 3.5f, 2.5f}, {0.4f, 0.7f, 1.1f}},
+                               {{14.0f, 15.0f, 17.0f}, {3.0f, 2.5f, 2.0f}, {2.2f, 1.3f, 0.3f}}};
+    double fillScale[3] = {0.0, 0.95, 1.3};
+
+    // Like the centroids computed by FindFeatureCentroids, those of the ellipsoids include the origin of the geometry
+    for(int32_t i = 1; i < 3; i++)
+    {
+      for(int32_t c = 0; c < 3; c++)
+      {
+        ellipsoids[i].centroid[c] += origin[c];
+      }
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims);
+    image->setResolution(res);
+    image->setOrigin(origin);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+    tDims = QVector<size_t>(1, 3);
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::FeatureIds);
+    featureIds->initializeWithZeros();
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    Int32ArrayType::Pointer numCells = Int32ArrayType::CreateArray(3, cDims, SIMPL::FeatureData::NumCells);
+    numCells->initializeWithZeros();
+    featAttrMat->addAttributeArray(SIMPL::FeatureData::NumCells, numCells);
+
+    cDims[0] = 3;
+    FloatArrayType::Pointer centroids = FloatArrayType::CreateArray(3, cDims, SIMPL::FeatureData::Centroids);
+    FloatArrayType::Pointer axisLengths = FloatArrayType::CreateArray(3, cDims, SIMPL::FeatureData::AxisLengths);
+    FloatArrayType::Pointer axisEulerAngles = FloatArrayType::CreateArray(3, cDims, SIMPL::FeatureData::AxisEulerAngles);
+    for(int32_t i = 0; i < 3; i++)
+    {
+      for(int32_t c = 0; c < 3; c++)
+      {
+        centroids->setComponent(i, c, ellipsoids[i].centroid[c]);
+        axisLengths->setComponent(i, c, ellipsoids[i].axes[c]);
+        axisEulerAngles->setComponent(i, c, ellipsoids[i].euler[c]);
+      }
+    }
+    featAttrMat->addAttributeArray(SIMPL::FeatureData::Centroids, centroids);
+    featAttrMat->addAttributeArray(SIMPL::FeatureData::AxisLengths, axisLengths);
+    featAttrMat->addAttributeArray(SIMPL::FeatureData::AxisEulerAngles, axisEulerAngles);
+
+    // Cells are located at index * resolution + origin, the same convention the filter uses
+    size_t numOutside[3] = {0, 0, 0};
+    size_t numOnSurface[3] = {0, 0, 0};
+    for(size_t k = 0; k < totalPoints; k++)
+    {
+      double point[3] = {(k % dims[0]) * res[0] + origin[0], ((k / dims[0]) % dims[1]) * res[1] + origin[1], (k / (dims[0] * dims[1])) * res[2] + origin[2]};
+      for(int32_t i = 1; i < 3; i++)
+      {
+        if(EllipsoidDistance(ellipsoids[i], fillScale[i], point) < 1.0)
+        {
+          featureIds->setValue(k, i);
+          numCells->setValue(i, numCells->getValue(i) + 1);
+          double distance = EllipsoidDistance(ellipsoids[i], 1.0, point);
+          numOutside[i] += (distance >= 1.0) ? 1 : 0;
+          numOnSurface[i] += (std::fabs(distance - 1.0) < 1.0E-4) ? 1 : 0;
+        }
+      }
+    }
+    DREAM3D_REQUIRE(numCells->getValue(1) > 100)
+    DREAM3D_REQUIRE(numCells->getValue(2) > 100)
+    DREAM3D_REQUIRE_EQUAL(numOutside[1], 0)
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindEllipsoidError");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellFeatureAttributeMatrixName", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("CentroidsArrayPath", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::NumCells));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NumCellsArrayPath", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::AxisLengths));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("AxisLengthsArrayPath", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::AxisEulerAngles));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("AxisEulerAnglesArrayPath", var), true)
+    var.setValue(QString("EllipsoidError"));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("EllipsoidErrorArrayName", var), true)
+    var.setValue(false);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("WriteIdealEllipseFeatureIds", var), true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+    FloatArrayType::Pointer error = featAttrMat->getAttributeArrayAs<FloatArrayType>("EllipsoidError");
+    DREAM3D_REQUIRE_VALID_POINTER(error.get())
+
+    // The shrunk voxelization lies entirely inside its ellipsoid
+    DREAM3D_REQUIRE_EQUAL(error->getValue(1), 0.0f)
+
+    // The grown one matches the brute force count up to cells that sit on the surface, and the analytic volume ratio
+    float expected = static_cast<float>(numOutside[2]) / static_cast<float>(numCells->getValue(2));
+    float tolerance = static_cast<float>(numOnSurface[2] + 1) / static_cast<float>(numCells->getValue(2));
+    DREAM3D_REQUIRE(std::fabs(error->getValue(2) - expected) <= tolerance)
+    DREAM3D_REQUIRE(std::fabs(error->getValue(2) - (1.0f - 1.0f / (1.3f * 1.3f * 1.3f))) < 0.05f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestEllipsoidError3D(0.0f, 0.0f, 0.0f));
+    DREAM3D_REGISTER_TEST(TestEllipsoidError3D(-12.5f, 3.25f, 40.0f));
+  }
+
+private:
+  FindEllipsoidErrorTest(const FindEllipsoidErrorTest&); // Copy Constructor Not Implemented
+  void operator=(const FindEllipsoidErrorTest&);         // Move assignment Not Implemented
+};
@@ -0,0 +1,203 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FindSurfaceAreaToVolumeTest
+{
+
+public:
+  FindSurfaceAreaToVolumeTest()
+  {
+  }
+  virtual ~FindSurfaceAreaToVolumeTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindSurfaceAreaToVolume Filter from the FilterManager
+    QString filtName = "FindSurfaceAreaToVolume";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindSurfaceAreaToVolumeTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Sets the Feature of every Cell of the box [min, max] of the volume
+  // -----------------------------------------------------------------------------
+  void FillBox(Int32ArrayType::Pointer featureIds, Int32ArrayType::Pointer numCells, const size_t dims[3], const size_t min[3], const size_t max[3], int32_t feature)
+  {
+    for(size_t z = min[2]; z <= max[2]; z++)
+    {
+      for(size_t y = min[1]; y <= max[1]; y++)
+      {
+        for(size_t x = min[0]; x <= max[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          numCells->setValue(featureIds->getValue(index), numCells->getValue(featureIds->getValue(index)) - 1);
+          featureIds->setValue(index, feature);
+          numCells->setValue(feature, numCells->getValue(feature) + 1);
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSurfaceAreaToVolume()
+  {
+    size_t dims[3] = {12, 10, 8};
+    float res[3] = {0.5f, 1.0f, 2.0f};
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims);
+    image->setResolution(res);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, cellAttrMat);
+    tDims = QVector<size_t>(1, 4);
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::FeatureIds);
+    featureIds->initializeWithValue(1);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    Int32ArrayType::Pointer numCells = Int32ArrayType::CreateArray(4, cDims, SIMPL::FeatureData::NumCells);
+    numCells->initializeWithZeros();
+    numCells->setValue(1, static_cast<int32_t>(totalPoints));
+    featAttrMat->addAttributeArray(SIMPL::FeatureData::NumCells, numCells);
+
+    // Feature 2 is a 3 x 4 x 2 Cell box buried in Feature 1; Feature 3 is a 1 x 2 x 2 Cell box on the +X side of the
+    // volume, whose faces on the outside of the volume are not part of its surface
+    const size_t min2[3] = {2, 2, 2}, max2[3] = {4, 5, 3};
+    FillBox(featureIds, numCells, dims, min2, max2, 2);
+    const size_t min3[3] = {11, 6, 5}, max3[3] = {11, 7, 6};
+    FillBox(featureIds, numCells, dims, min3, max3, 3);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindSurfaceAreaToVolume");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::NumCells));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NumCellsArrayPath", var), true)
+    var.setValue(QString("SurfaceAreaVolumeRatio"));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceAreaVolumeRatioArrayName", var), true)
+    var.setValue(QString("Sphericity"));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("SphericityArrayName", var), true)
+    var.setValue(true);
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("CalculateSphericity", var), true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+    FloatArrayType::Pointer ratio = featAttrMat->getAttributeArrayAs<FloatArrayType>("SurfaceAreaVolumeRatio");
+    DREAM3D_REQUIRE_VALID_POINTER(ratio.get())
+    FloatArrayType::Pointer sphericity = featAttrMat->getAttributeArrayAs<FloatArrayType>("Sphericity");
+    DREAM3D_REQUIRE_VALID_POINTER(sphericity.get())
+
+    // Faces normal to X have an area of 2, faces normal to Y an area of 1 and faces normal to Z an area of 0.5
+    const float xFace = res[1] * res[2];
+    const float yFace = res[2] * res[0];
+    const float zFace = res[0] * res[1];
+    const float cellVolume = res[0] * res[1] * res[2];
+    const float area[4] = {0.0f, 0.0f, 2 * (4 * 2) * xFace + 2 * (3 * 2) * yFace + 2 * (3 * 4) * zFace, (2 * 2) * xFace + 2 * (1 * 2) * yFace + 2 * (1 * 2) * zFace};
+    const float thirdRootPi = std::pow(SIMPLib::Constants::k_Pif, 0.333333f);
+    for(int32_t i = 2; i < 4; i++)
+    {
+      float volume = numCells->getValue(i) * cellVolume;
+      DREAM3D_REQUIRE(std::fabs(ratio->getValue(i) - area[i] / volume) < 1.0E-5f)
+      DREAM3D_REQUIRE(std::fabs(sphericity->getValue(i) - thirdRootPi * std::pow(6.0f * volume, 0.66666f) / area[i]) < 1.0E-5f)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSurfaceAreaToVolume());
+  }
+
+private:
+  FindSurfaceAreaToVolumeTest(const FindSurfaceAreaToVolumeTest&); // Copy Constructor Not Implemented
+  void operator=(const FindSurfaceAreaToVolumeTest&);              // Move assignment Not Implemented
+};
@@ -0,0 +1,276 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FitFeatureDataTest
+{
+
+public:
+  FitFeatureDataTest()
+  {
+  }
+  virtual ~FitFeatureDataTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FitFeatureData Filter from the FilterManager
+    QString filtName = "FitFeatureData";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FitFeatureDataTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a Feature attribute matrix whose phase 1 values are all zero, whose phase 2 values are all 2.5 and whose
+  // phase 3 values are spread over (0, 1), next to an empty Ensemble attribute matrix for the fits
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateDataContainerArray(std::vector<float>& spreadValues)
+  {
+    spreadValues = {0.15f, 0.22f, 0.31f, 0.38f, 0.47f, 0.55f, 0.64f, 0.71f, 0.83f, 0.9f};
+    size_t numFeatures = 1 + 2 * 5 + spreadValues.size();
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::DataContainerName);
+    dca->addDataContainer(dc);
+
+    QVector<size_t> tDims(1, numFeatures);
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featAttrMat);
+    tDims[0] = 4;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName, ensembleAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    FloatArrayType::Pointer values = FloatArrayType::CreateArray(numFeatures, cDims, "Values");
+    values->initializeWithZeros();
+    featAttrMat->addAttributeArray("Values", values);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::Phases);
+    phases->initializeWithZeros();
+    featAttrMat->addAttributeArray(SIMPL::FeatureData::Phases, phases);
+
+    size_t feature = 1;
+    for(size_t i = 0; i < 5; i++, feature++)
+    {
+      phases->setValue(feature, 1);
+    }
+    for(size_t i = 0; i < 5; i++, feature++)
+    {
+      phases->setValue(feature, 2);
+      values->setValue(feature, 2.5f);
+    }
+    for(size_t i = 0; i < spreadValues.size(); i++, feature++)
+    {
+      phases->setValue(feature, 3);
+      values->setValue(feature, spreadValues[i]);
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  FloatArrayType::Pointer RunFit(DataContainerArray::Pointer dca, unsigned int distributionType, const QString& fitName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FitFeatureData");
+    AbstractFilter::Pointer filter = factory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, "Values"));
+    filter->setProperty("SelectedFeatureArrayPath", var);
+    var.setValue(distributionType);
+    filter->setProperty("DistributionType", var);
+    var.setValue(false);
+    filter->setProperty("RemoveBiasedFeatures", var);
+    var.setValue(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases));
+    filter->setProperty("FeaturePhasesArrayPath", var);
+    var.setValue(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+    filter->setProperty("NewEnsembleArrayArray", var);
+
+    filter->execute();
+    if(filter->getErrorCondition() < 0)
+    {
+      return FloatArrayType::NullPointer();
+    }
+
+    AttributeMatrix::Pointer ensembleAttrMat = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+    return ensembleAttrMat->getAttributeArrayAs<FloatArrayType>("Values" + fitName + "Fit");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPowerLawFit()
+  {
+    std::vector<float> spreadValues;
+    DataContainerArray::Pointer dca = CreateDataContainerArray(spreadValues);
+    FloatArrayType::Pointer fit = RunFit(dca, static_cast<unsigned int>(SIMPL::DistributionType::Power), "PowerLaw");
+    DREAM3D_REQUIRE_VALID_POINTER(fit.get())
+
+    // log(value / min) is undefined for an all zero set, which has always produced a NaN exponent
+    DREAM3D_REQUIRE(std::isnan(fit->getComponent(1, 0)))
+    DREAM3D_REQUIRE_EQUAL(fit->getComponent(1, 1), 0.0f)
+
+    // A constant set has no tail to fit and reports an exponent of 1
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(2, 0) - 1.0f) < 1.0E-5f)
+    DREAM3D_REQUIRE_EQUAL(fit->getComponent(2, 1), 2.5f)
+
+    double sumLogRatios = 0.0;
+    for(size_t i = 0; i < spreadValues.size(); i++)
+    {
+      sumLogRatios += std::log(spreadValues[i] / spreadValues[0]);
+    }
+    float alpha = static_cast<float>(1.0 + spreadValues.size() / sumLogRatios);
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(3, 0) - alpha) < 1.0E-3f * alpha)
+    DREAM3D_REQUIRE_EQUAL(fit->getComponent(3, 1), spreadValues[0])
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLogNormalFit()
+  {
+    std::vector<float> spreadValues;
+    DataContainerArray::Pointer dca = CreateDataContainerArray(spreadValues);
+    FloatArrayType::Pointer fit = RunFit(dca, static_cast<unsigned int>(SIMPL::DistributionType::LogNormal), "LogNormal");
+    DREAM3D_REQUIRE_VALID_POINTER(fit.get())
+
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(2, 0) - std::log(2.5f)) < 1.0E-5f)
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(2, 1)) < 1.0E-3f)
+
+    double avg = 0.0;
+    for(size_t i = 0; i < spreadValues.size(); i++)
+    {
+      avg += std::log(spreadValues[i]);
+    }
+    avg /= spreadValues.size();
+    double variance = 0.0;
+    for(size_t i = 0; i < spreadValues.size(); i++)
+    {
+      variance += (std::log(spreadValues[i]) - avg) * (std::log(spreadValues[i]) - avg);
+    }
+    variance /= spreadValues.size();
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(3, 0) - static_cast<float>(avg)) < 1.0E-5f)
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(3, 1) - static_cast<float>(std::sqrt(variance))) < 1.0E-5f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestBetaFit()
+  {
+    std::vector<float> spreadValues;
+    DataContainerArray::Pointer dca = CreateDataContainerArray(spreadValues);
+    FloatArrayType::Pointer fit = RunFit(dca, static_cast<unsigned int>(SIMPL::DistributionType::Beta), "Beta");
+    DREAM3D_REQUIRE_VALID_POINTER(fit.get())
+
+    // Sets without any spread leave both shape parameters at zero
+    DREAM3D_REQUIRE_EQUAL(fit->getComponent(1, 0), 0.0f)
+    DREAM3D_REQUIRE_EQUAL(fit->getComponent(1, 1), 0.0f)
+    DREAM3D_REQUIRE_EQUAL(fit->getComponent(2, 0), 0.0f)
+    DREAM3D_REQUIRE_EQUAL(fit->getComponent(2, 1), 0.0f)
+
+    double avg = 0.0;
+    for(size_t i = 0; i < spreadValues.size(); i++)
+    {
+      avg += spreadValues[i];
+    }
+    avg /= spreadValues.size();
+    double variance = 0.0;
+    for(size_t i = 0; i < spreadValues.size(); i++)
+    {
+      variance += (spreadValues[i] - avg) * (spreadValues[i] - avg);
+    }
+    variance /= spreadValues.size();
+    double alpha = avg * (((avg * (1 - avg)) / variance) - 1);
+    double beta = (1 - avg) * (((avg * (1 - avg)) / variance) - 1);
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(3, 0) - static_cast<float>(alpha)) < 1.0E-3f * alpha)
+    DREAM3D_REQUIRE(std::fabs(fit->getComponent(3, 1) - static_cast<float>(beta)) < 1.0E-3f * beta)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestPowerLawFit());
+    DREAM3D_REGISTER_TEST(TestLogNormalFit());
+    DREAM3D_REGISTER_TEST(TestBetaFit());
+  }
+
+private:
+  FitFeatureDataTest(const FitFeatureDataTest&); // Copy Constructor Not Implemented
+  void operator=(const FitFeatureDataTest&);     // Move assignment Not Implemented
+};
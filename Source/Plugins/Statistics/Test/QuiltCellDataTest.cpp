@@ -0,0 +1,261 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include <algorithm>
+#include <cmath>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+#include "StatisticsFilters/util/SummedAreaTable.h"
+
+class QuiltCellDataTest
+{
+
+public:
+  QuiltCellDataTest()
+  {
+  }
+  virtual ~QuiltCellDataTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the QuiltCellData Filter from the FilterManager
+    QString filtName = "QuiltCellData";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The Statistics Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Returns the average of the cells of the clipped half open window, or 0 if the window holds no cells
+  // -----------------------------------------------------------------------------
+  double BruteForceAverage(const std::vector<float>& data, const size_t dims[3], int64_t xMin, int64_t xMax, int64_t yMin, int64_t yMax, int64_t zMin, int64_t zMax)
+  {
+    double sum = 0.0;
+    size_t count = 0;
+    for(int64_t z = std::max<int64_t>(zMin, 0); z < std::min<int64_t>(zMax, dims[2]); z++)
+    {
+      for(int64_t y = std::max<int64_t>(yMin, 0); y < std::min<int64_t>(yMax, dims[1]); y++)
+      {
+        for(int64_t x = std::max<int64_t>(xMin, 0); x < std::min<int64_t>(xMax, dims[0]); x++)
+        {
+          sum += data[(z * dims[1] + y) * dims[0] + x];
+          count++;
+        }
+      }
+    }
+    return (count == 0) ? 0.0 : sum / static_cast<double>(count);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<float> CreateCellValues(const size_t dims[3])
+  {
+    std::vector<float> data(dims[0] * dims[1] * dims[2]);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<float>((i * 37) % 101) - 50.0f;
+    }
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSummedAreaTableSlab()
+  {
+    size_t dims[3] = {5, 4, 6};
+    std::vector<float> data = CreateCellValues(dims);
+
+    SummedAreaTable full;
+    full.initialize(data.data(), dims[0], dims[1], dims[2], true);
+    SummedAreaTable slab;
+    slab.initialize(data.data(), dims[0], dims[1], dims[2], true, 2, 4);
+
+    for(int64_t zMin = -1; zMin <= 6; zMin++)
+    {
+      for(int64_t zMax = zMin + 1; zMax <= 7; zMax++)
+      {
+        double expected = BruteForceAverage(data, dims, -1, 3, 1, 5, zMin, zMax);
+        size_t count = full.windowCount(-1, 3, 1, 5, zMin, zMax);
+        double average = (count == 0) ? 0.0 : full.windowSum(-1, 3, 1, 5, zMin, zMax) / static_cast<double>(count);
+        DREAM3D_REQUIRE(std::abs(average - expected) < 1.0E-9)
+
+        // The slab only sees the planes it was built for
+        expected = BruteForceAverage(data, dims, -1, 3, 1, 5, std::max<int64_t>(zMin, 2), std::min<int64_t>(zMax, 4));
+        count = slab.windowCount(-1, 3, 1, 5, zMin, zMax);
+        average = (count == 0) ? 0.0 : slab.windowSum(-1, 3, 1, 5, zMin, zMax) / static_cast<double>(count);
+        DREAM3D_REQUIRE(std::abs(average - expected) < 1.0E-9)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(const size_t dims[3], const std::vector<float>& values)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims_in[3] = {dims[0], dims[1], dims[2]};
+    igeom->setDimensions(dims_in);
+    dc->setGeometry(igeom);
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = dims[0];
+    tDims[1] = dims[1];
+    tDims[2] = dims[2];
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(values.size(), "Data", true);
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      data->setValue(i, values[i]);
+    }
+    cellAM->addAttributeArray(data->getName(), data);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestQuiltCellData()
+  {
+    size_t dims[3] = {9, 8, 5};
+    std::vector<float> values = CreateCellValues(dims);
+
+    IntVec3_t steps[2] = {{2, 2, 2}, {3, 2, 1}};
+    IntVec3_t patches[3] = {{3, 3, 3}, {4, 1, 5}, {1, 2, 2}};
+    for(const IntVec3_t& step : steps)
+    {
+      for(const IntVec3_t& patch : patches)
+      {
+        DataContainerArray::Pointer dca = CreateTestData(dims, values);
+
+        FilterManager* fm = FilterManager::Instance();
+        IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("QuiltCellData");
+        AbstractFilter::Pointer filter = filterFactory->create();
+        filter->setDataContainerArray(dca);
+
+        QVariant variant;
+        variant.setValue(DataArrayPath("Test", "CellData", "Data"));
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("SelectedCellArrayPath", variant), true)
+        variant.setValue(step);
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("QuiltStep", variant), true)
+        variant.setValue(patch);
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("PatchSize", variant), true)
+        variant.setValue(QString("Quilted"));
+        DREAM3D_REQUIRE_EQUAL(filter->setProperty("OutputDataContainerName", variant), true)
+
+        filter->execute();
+        DREAM3D_REQUIRE(filter->getErrorCondition() >= 0)
+
+        DataContainer::Pointer quilted = dca->getDataContainer("Quilted");
+        size_t outDims[3] = {0, 0, 0};
+        std::tie(outDims[0], outDims[1], outDims[2]) = quilted->getGeometryAs<ImageGeom>()->getDimensions();
+        FloatArrayType::Pointer output = quilted->getAttributeMatrix(filter->property("OutputAttributeMatrixName").toString())
+                                             ->getAttributeArrayAs<FloatArrayType>(filter->property("OutputArrayName").toString());
+        DREAM3D_REQUIRE_VALID_POINTER(output.get())
+
+        // Every patch is centered on plane 0, exactly like the per-voxel loop the filter used to run
+        int32_t half[3] = {patch.x / 2, patch.y / 2, patch.z / 2};
+        int64_t rangeMin[3] = {patch.x == 1 ? 0 : -half[0], patch.y == 1 ? 0 : -half[1], patch.z == 1 ? 0 : -half[2]};
+        int64_t rangeMax[3] = {patch.x == 1 ? 1 : half[0], patch.y == 1 ? 1 : half[1], patch.z == 1 ? 1 : half[2]};
+        for(size_t k = 0; k < outDims[2]; k++)
+        {
+          for(size_t j = 0; j < outDims[1]; j++)
+          {
+            for(size_t i = 0; i < outDims[0]; i++)
+            {
+              int64_t xc = i * step.x + step.x / 2;
+              int64_t yc = j * step.y + step.y / 2;
+              int64_t zc = 0;
+              double expected = BruteForceAverage(values, dims, xc + rangeMin[0], xc + rangeMax[0], yc + rangeMin[1], yc + rangeMax[1], zc + rangeMin[2], zc + rangeMax[2]);
+              float value = output->getValue((k * outDims[1] + j) * outDims[0] + i);
+              DREAM3D_REQUIRE(std::abs(value - static_cast<float>(expected)) < 1.0E-4f)
+            }
+          }
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestSummedAreaTableSlab());
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestQuiltCellData());
+  }
+
+private:
+  QuiltCellDataTest(const QuiltCellDataTest&); // Copy Constructor Not Implemented
+  void operator=(const QuiltCellDataTest&);    // Move assignment Not Implemented
+};
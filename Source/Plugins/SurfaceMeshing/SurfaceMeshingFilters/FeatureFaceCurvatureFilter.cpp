@@ -49,6 +49,8 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleTopology.h"
+
 #include "CalculateTriangleGroupCurvatures.h"
 
 // -----------------------------------------------------------------------------
@@ -362,11 +364,7 @@ void FeatureFaceCurvatureFilter::execute()
 
   // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
   // assert if the data is NOT in the SurfaceMesh Data Container
-  ElementDynamicList::Pointer vertLinks = triangleGeom->getElementsContainingVert();
-  if(nullptr == vertLinks.get())
-  {
-    triangleGeom->findElementsContainingVert();
-  }
+  TriangleTopology::CacheElementsContainingVert(triangleGeom);
 
   // get the QMap from the SharedFeatureFaces filter
   SharedFeatureFaces_t sharedFeatureFaces;
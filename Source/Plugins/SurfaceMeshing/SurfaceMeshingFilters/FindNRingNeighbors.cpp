@@ -36,6 +36,8 @@
 
 #include "FindNRingNeighbors.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleTopology.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -83,16 +85,12 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
   m_NRingTriangles.clear();
 
   // Make sure we have the proper connectivity built
-  ElementDynamicList::Pointer node2TrianglePtr = triangleGeom->getElementsContainingVert();
-  if(node2TrianglePtr.get() == nullptr)
+  err = TriangleTopology::CacheElementsContainingVert(triangleGeom);
+  if(err < 0)
   {
-    err = triangleGeom->findElementsContainingVert();
-    if(err < 0)
-    {
-      return err;
-    }
-    node2TrianglePtr = triangleGeom->getElementsContainingVert();
+    return err;
   }
+  ElementDynamicList::Pointer node2TrianglePtr = triangleGeom->getElementsContainingVert();
 
   // Figure out these boolean values for a sanity check
   bool check0 = faceLabels[m_TriangleId * 2] == m_RegionId0 && faceLabels[m_TriangleId * 2 + 1] == m_RegionId1;
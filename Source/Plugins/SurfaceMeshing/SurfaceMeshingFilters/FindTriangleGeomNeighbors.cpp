@@ -35,8 +35,6 @@
 
 #include "FindTriangleGeomNeighbors.h"
 
-#include <QtCore/QDateTime>
-
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -47,6 +45,7 @@
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleTopology.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -167,124 +166,29 @@ void FindTriangleGeomNeighbors::execute()
     return;
   }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FaceLabelsArrayPath.getDataContainerName());
   size_t totalFaces = m_FaceLabelsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
-  int32_t feature1 = 0;
-  int32_t feature2 = 0;
-  int32_t nnum = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
-  for(size_t i = 1; i < totalFeatures; i++)
-  {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-  }
+  // The feature adjacency comes back sorted and unique, which is exactly the
+  // content of each feature's neighbor list
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Neighbors || Determining Neighbor Lists");
+  TriangleTopology::CSRList featureNeighbors;
+  TriangleTopology::FindFeatureNeighbors(m_FaceLabels, static_cast<int64_t>(totalFaces), static_cast<int32_t>(totalFeatures), featureNeighbors);
 
-  for(size_t j = 0; j < totalFaces; j++)
+  if(getCancel())
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalFaces) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-	feature1 = m_FaceLabels[2 * j];
-	feature2 = m_FaceLabels[2 * j + 1];
-	if (feature1 > 0)
-	{
-		if (feature2 > 0)
-		{
-			nnum = m_NumNeighbors[feature1];
-			neighborlist[feature1].push_back(feature2);
-			nnum++;
-			m_NumNeighbors[feature1] = nnum;
-		}
-	}
-	if (feature2 > 0)
-	{
-		if (feature1 > 0)
-		{
-			nnum = m_NumNeighbors[feature2];
-			neighborlist[feature2].push_back(feature1);
-			nnum++;
-			m_NumNeighbors[feature2] = nnum;
-		}
-	}
+    return;
   }
 
   // We do this to create new set of NeighborList objects
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key();    // get the neighbor feature
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+    const int64_t* neighbors = featureNeighbors.getElementListPointer(i);
+    int64_t numneighs = featureNeighbors.getNumberOfElements(i);
+    m_NumNeighbors[i] = static_cast<int32_t>(numneighs);
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(neighbors, neighbors + numneighs));
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
 
@@ -35,6 +35,13 @@
 
 #include "FindTriangleGeomShapes.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -48,6 +55,92 @@
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleTopology.h"
+
+/**
+ * @brief The FindTriangleGeomMomentsImpl class implements a threaded algorithm that accumulates the
+ * second order moments of a set of Features by walking each Feature's own list of bounding faces
+ */
+class FindTriangleGeomMomentsImpl
+{
+  FindTriangleGeomShapes* m_Filter;
+  TriangleGeom::Pointer m_Triangles;
+  const TriangleTopology::CSRList& m_FeatureFaces;
+  float* m_Centroids;
+  double* m_FeatureMoments;
+
+public:
+  FindTriangleGeomMomentsImpl(FindTriangleGeomShapes* filter, TriangleGeom::Pointer triangles, const TriangleTopology::CSRList& featureFaces, float* centroids, double* featureMoments)
+  : m_Filter(filter)
+  , m_Triangles(triangles)
+  , m_FeatureFaces(featureFaces)
+  , m_Centroids(centroids)
+  , m_FeatureMoments(featureMoments)
+  {
+  }
+  virtual ~FindTriangleGeomMomentsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    float* vertPtr = m_Triangles->getVertexPointer(0);
+    float centroid[3];
+    float tetInfo[32];
+    int64_t vertIds[3];
+    double xdist = 0.0f;
+    double ydist = 0.0f;
+    double zdist = 0.0f;
+    float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
+
+    for(size_t gnum = start; gnum < end; gnum++)
+    {
+      double* moments = m_FeatureMoments + 6 * gnum;
+      const int64_t* faces = m_FeatureFaces.getElementListPointer(gnum);
+      int64_t numFaces = m_FeatureFaces.getNumberOfElements(gnum);
+
+      centroid[0] = m_Centroids[3 * gnum + 0];
+      centroid[1] = m_Centroids[3 * gnum + 1];
+      centroid[2] = m_Centroids[3 * gnum + 2];
+
+      // Faces are listed as 2 * triangle + side, in the same order the original face sweep visited them
+      for(int64_t f = 0; f < numFaces; f++)
+      {
+        m_Triangles->getVertsAtTri(faces[f] / 2, vertIds);
+        if(faces[f] % 2 == 1)
+        {
+          std::swap(vertIds[2], vertIds[1]);
+        }
+        m_Filter->findTetrahedronInfo(vertIds, vertPtr, centroid, tetInfo);
+        for(size_t iter = 0; iter < 8; iter++)
+        {
+          xdist = (tetInfo[4 * iter + 1] - centroid[0]);
+          ydist = (tetInfo[4 * iter + 2] - centroid[1]);
+          zdist = (tetInfo[4 * iter + 3] - centroid[2]);
+
+          xx = ((ydist) * (ydist)) + ((zdist) * (zdist));
+          yy = ((xdist) * (xdist)) + ((zdist) * (zdist));
+          zz = ((xdist) * (xdist)) + ((ydist) * (ydist));
+          xy = ((xdist) * (ydist));
+          yz = ((ydist) * (zdist));
+          xz = ((xdist) * (zdist));
+
+          moments[0] = moments[0] + (xx * tetInfo[4 * iter + 0]);
+          moments[1] = moments[1] + (yy * tetInfo[4 * iter + 0]);
+          moments[2] = moments[2] + (zz * tetInfo[4 * iter + 0]);
+          moments[3] = moments[3] + (xy * tetInfo[4 * iter + 0]);
+          moments[4] = moments[4] + (yz * tetInfo[4 * iter + 0]);
+          moments[5] = moments[5] + (xz * tetInfo[4 * iter + 0]);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -327,7 +420,6 @@ void FindTriangleGeomShapes::find_moments()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FaceLabelsArrayPath.getDataContainerName());
 
   TriangleGeom::Pointer triangles = getDataContainerArray()->getDataContainer(m_FaceLabelsArrayPath.getDataContainerName())->getGeometryAs<TriangleGeom>();
-  float* vertPtr = triangles->getVertexPointer(0);
 
   size_t numFaces = m_FaceLabelsPtr.lock()->getNumberOfTuples();
 
@@ -337,7 +429,6 @@ void FindTriangleGeomShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resize(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
@@ -352,49 +443,26 @@ void FindTriangleGeomShapes::find_moments()
     featuremoments[6 * i + 5] = 0.0f;
   }
 
-  float centroid[3];
-  float tetInfo[32];
-  int64_t vertIds[3];
-  double xdist = 0.0f;
-  double ydist = 0.0f;
-  double zdist = 0.0f;
+  TriangleTopology::CSRList featureFaces;
+  TriangleTopology::FindFeatureFaces(m_FaceLabels, static_cast<int64_t>(numFaces), static_cast<int32_t>(numfeatures), featureFaces);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  for (size_t i = 0; i < numFaces; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-	  triangles->getVertsAtTri(i, vertIds);
-	  for (size_t j = 0; j < 2; j++)
-	  {
-		  if (j == 1) { std::swap(vertIds[2], vertIds[1]); }
-		  int32_t gnum = m_FaceLabels[2 * i + j];
-		  if (gnum > 0)
-		  {
-			  centroid[0] = m_Centroids[3 * gnum + 0];
-			  centroid[1] = m_Centroids[3 * gnum + 1];
-			  centroid[2] = m_Centroids[3 * gnum + 2];
-			  findTetrahedronInfo(vertIds, vertPtr, centroid, tetInfo);
-			  for (size_t iter = 0; iter < 8; iter++)
-			  {
-				  xdist = (tetInfo[4 * iter + 1] - m_Centroids[gnum * 3 + 0]);
-				  ydist = (tetInfo[4 * iter + 2] - m_Centroids[gnum * 3 + 1]);
-				  zdist = (tetInfo[4 * iter + 3] - m_Centroids[gnum * 3 + 2]);
-
-				  xx = ((ydist)* (ydist)) + ((zdist)* (zdist));
-				  yy = ((xdist)* (xdist)) + ((zdist)* (zdist));
-				  zz = ((xdist)* (xdist)) + ((ydist)* (ydist));
-				  xy = ((xdist)* (ydist));
-				  yz = ((ydist)* (zdist));
-				  xz = ((xdist)* (zdist));
-
-				  featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + (xx * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + (yy * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + (zz * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 3] = featuremoments[gnum * 6 + 3] + (xy * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 4] = featuremoments[gnum * 6 + 4] + (yz * tetInfo[4 * iter + 0]);
-				  featuremoments[gnum * 6 + 5] = featuremoments[gnum * 6 + 5] + (xz * tetInfo[4 * iter + 0]);
-			  }
-		  }
-	  }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numfeatures), FindTriangleGeomMomentsImpl(this, triangles, featureFaces, m_Centroids, featuremoments), tbb::auto_partitioner());
   }
+  else
+#endif
+  {
+    FindTriangleGeomMomentsImpl serial(this, triangles, featureFaces, m_Centroids, featuremoments);
+    serial.compute(0, numfeatures);
+  }
+
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   double o3 = 0.0, vol5 = 0.0, omega3 = 0.0;
   for(size_t i = 1; i < numfeatures; i++)
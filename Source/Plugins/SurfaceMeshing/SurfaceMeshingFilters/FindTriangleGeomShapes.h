@@ -62,6 +62,8 @@ public:
   SIMPL_TYPE_MACRO_SUPER_OVERRIDE(FindTriangleGeomShapes, AbstractFilter)
 
   ~FindTriangleGeomShapes() override;
+
+  friend class FindTriangleGeomMomentsImpl;
   SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureAttributeMatrixName)
   Q_PROPERTY(DataArrayPath FeatureAttributeMatrixName READ getFeatureAttributeMatrixName WRITE setFeatureAttributeMatrixName)
 
@@ -39,9 +39,11 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/TriangleTopology.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -129,11 +131,14 @@ void GenerateGeometryConnectivity::execute()
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
   IGeometry::Pointer geom = sm->getGeometry();
+  // Triangle geometries use the sort based builder; the lists are always rebuilt because the mesh may have changed
+  // since they were cached
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
   if(m_GenerateVertexTriangleLists == true || m_GenerateTriangleNeighbors == true)
   {
     notifyStatusMessage(getHumanLabel(), "Generating Vertex Element List");
-    err = geom->findElementsContainingVert();
+    err = (nullptr != triangleGeom.get()) ? TriangleTopology::BuildElementsContainingVert(triangleGeom) : geom->findElementsContainingVert();
     if(err < 0)
     {
       setErrorCondition(-400);
@@ -144,7 +149,7 @@ void GenerateGeometryConnectivity::execute()
   if(m_GenerateTriangleNeighbors == true)
   {
     notifyStatusMessage(getHumanLabel(), "Generating Element Neighbors List");
-    err = geom->findElementNeighbors();
+    err = (nullptr != triangleGeom.get()) ? TriangleTopology::BuildElementNeighbors(triangleGeom) : geom->findElementNeighbors();
     if(err < 0)
     {
       setErrorCondition(-401);
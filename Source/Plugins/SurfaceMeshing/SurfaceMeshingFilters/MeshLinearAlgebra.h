@@ -43,10 +43,19 @@
 
 // LinearAlgebra.h
 #pragma once
+#include<algorithm>
 #include<vector>
 #include<cmath>
 #include<iostream>
 
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 
 namespace MFE
 {
@@ -401,6 +410,139 @@ namespace MFE
     return norm;
   }
 
+  /**
+   * @brief The CSRMatrix class is a sparse matrix in compressed sparse row storage. The nonzero pattern is given
+   * when the matrix is constructed and never changes, so entries are found with a binary search in their row and
+   * rows may be filled concurrently as long as every row is written by only one thread.
+   */
+  template<typename vtype = double>
+  class CSRMatrix
+  {
+    public:
+      /**
+       * @brief CSRMatrix
+       * @param rowOffsets Start of every row in columns, with one extra entry holding the number of nonzeros
+       * @param columns Sorted column indices of the nonzeros of every row
+       * @param n Number of columns
+       */
+      CSRMatrix(const std::vector<size_t>& rowOffsets, const std::vector<int>& columns, int n)
+        : m_RowOffsets(rowOffsets)
+        , m_Columns(columns)
+        , m_Values(columns.size(), 0.0)
+        , d(n)
+      {
+      }
+      vtype& operator()(int i, int j)
+      {
+        return m_Values[find(i, j)];
+      }
+      vtype operator()(int i, int j) const
+      {
+        return m_Values[find(i, j)];
+      }
+      vtype* rowValues(int i)
+      {
+        return m_Values.data() + m_RowOffsets[i];
+      }
+      const vtype* rowValues(int i) const
+      {
+        return m_Values.data() + m_RowOffsets[i];
+      }
+      const int* rowColumns(int i) const
+      {
+        return m_Columns.data() + m_RowOffsets[i];
+      }
+      int nonzero(int i) const
+      {
+        return static_cast<int>(m_RowOffsets[i + 1] - m_RowOffsets[i]);
+      }
+      /**
+       * @brief rowFind Returns the position of the entry (i,j) inside row i
+       */
+      size_t rowFind(int i, int j) const
+      {
+        return find(i, j) - m_RowOffsets[i];
+      }
+      Vector<vtype> operator*(const Vector<vtype>&) const;
+      int dimension1() const
+      {
+        return static_cast<int>(m_RowOffsets.size()) - 1;
+      }
+      int dimension2() const
+      {
+        return d;
+      }
+    private:
+      size_t find(int i, int j) const
+      {
+        std::vector<int>::const_iterator first = m_Columns.begin() + m_RowOffsets[i];
+        std::vector<int>::const_iterator last = m_Columns.begin() + m_RowOffsets[i + 1];
+        return static_cast<size_t>(std::lower_bound(first, last, j) - m_Columns.begin());
+      }
+
+      std::vector<size_t> m_RowOffsets;
+      std::vector<int> m_Columns;
+      std::vector<vtype> m_Values;
+      int d;
+  };
+
+  /**
+   * @brief The CSRMatrixMultiplyImpl class implements a threaded algorithm that multiplies a range of rows of a
+   * CSRMatrix with a vector.
+   */
+  template<typename vtype>
+  class CSRMatrixMultiplyImpl
+  {
+    public:
+      CSRMatrixMultiplyImpl(const CSRMatrix<vtype>& A, const Vector<vtype>& x, Vector<vtype>& b)
+        : m_A(A)
+        , m_X(x)
+        , m_B(b)
+      {
+      }
+      virtual ~CSRMatrixMultiplyImpl() = default;
+
+      void multiply(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          int row = static_cast<int>(i);
+          int N = m_A.nonzero(row);
+          const int* columns = m_A.rowColumns(row);
+          const vtype* values = m_A.rowValues(row);
+          vtype sum = 0.0;
+          for (int j = 0; j < N; j++)
+          { sum += values[j] * m_X[columns[j]]; }
+          m_B[row] = sum;
+        }
+      }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        multiply(r.begin(), r.end());
+      }
+#endif
+    private:
+      const CSRMatrix<vtype>& m_A;
+      const Vector<vtype>& m_X;
+      Vector<vtype>& m_B;
+  };
+
+  template<typename vtype>
+  Vector<vtype> CSRMatrix<vtype>::operator*(const Vector<vtype>& x) const
+  {
+    int m = dimension1();
+    Vector<vtype> b(m);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(m)), CSRMatrixMultiplyImpl<vtype>(*this, x, b), tbb::auto_partitioner());
+#else
+    CSRMatrixMultiplyImpl<vtype> serial(*this, x, b);
+    serial.multiply(0, static_cast<size_t>(m));
+#endif
+    return b;
+  }
+
 // Iterative solution methods
 
   template<typename matrix, typename vector, typename type>
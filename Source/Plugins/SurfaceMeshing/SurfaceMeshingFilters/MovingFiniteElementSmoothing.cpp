@@ -51,14 +51,23 @@
 // Michael A. Jackson as part of SAIC Prime contract N00173-07-C-2068
 #include "MovingFiniteElementSmoothing.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <limits>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/StructArray.hpp"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/Geometry/MeshStructs.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SurfaceMeshing/SurfaceMeshingFilters/MeshFunctions.h"
 #include "SurfaceMeshing/SurfaceMeshingFilters/MeshLinearAlgebra.h"
 
@@ -127,11 +136,289 @@ template <typename Node, typename T> double AngleLineCurvature(Node& n0, Node& n
   return 2. * angle / (d1 + d2);
 }
 
+typedef NodeFunctions<VertexArray::VertD_t, double> MFENodeFunctionsType;
+typedef TriangleFunctions<VertexArray::VertD_t, double> MFETriangleFunctionsType;
+
+/**
+ * @brief The MFETriangleQualityImpl class implements a threaded algorithm that computes the unit normal, area,
+ * circularity and minimum dihedral angle of every triangle at the start of an MFE iteration.
+ */
+class MFETriangleQualityImpl
+{
+public:
+  MFETriangleQualityImpl(VertexArray::VertD_t* nodes, FaceArray::Face_t* triangles, double* normals, double* areas, double* qualities, double* dihedrals)
+  : m_Nodes(nodes)
+  , m_Triangles(triangles)
+  , m_Normals(normals)
+  , m_Areas(areas)
+  , m_Qualities(qualities)
+  , m_Dihedrals(dihedrals)
+  {
+  }
+  virtual ~MFETriangleQualityImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      FaceArray::Face_t& rtri = m_Triangles[t];
+      VertexArray::VertD_t& n0 = m_Nodes[rtri.verts[0]];
+      VertexArray::VertD_t& n1 = m_Nodes[rtri.verts[1]];
+      VertexArray::VertD_t& n2 = m_Nodes[rtri.verts[2]];
+      MFE::Vector<double> n = MFETriangleFunctionsType::normal(n0, n1, n2);
+      m_Normals[3 * t + 0] = n[0];
+      m_Normals[3 * t + 1] = n[1];
+      m_Normals[3 * t + 2] = n[2];
+      m_Areas[t] = MFETriangleFunctionsType::area(n0, n1, n2);
+      m_Qualities[t] = MFETriangleFunctionsType::circularity(n0, n1, n2, m_Areas[t]);
+      m_Dihedrals[t] = MFETriangleFunctionsType::MinDihedral(n0, n1, n2);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  VertexArray::VertD_t* m_Nodes;
+  FaceArray::Face_t* m_Triangles;
+  double* m_Normals;
+  double* m_Areas;
+  double* m_Qualities;
+  double* m_Dihedrals;
+};
+
+/**
+ * @brief The MFEAssembleImpl class implements a threaded algorithm that assembles the rows of the MFE system that
+ * belong to a range of nodes. Every node gathers the contributions of its own triangles, so each row of K and each
+ * entry of F is written by a single thread, in the same triangle order as a serial loop over the triangles would.
+ */
+class MFEAssembleImpl
+{
+public:
+  struct Scales
+  {
+    double A;
+    double Q;
+    double TJ;
+  };
+
+  MFEAssembleImpl(VertexArray::VertD_t* nodes, FaceArray::Face_t* triangles, const size_t* nodeTriOffsets, const int32_t* nodeTris, const double* normals, const double* areas,
+                  const double* qualities, int8_t* nodeTypes, TripleNN* triplenn, bool smoothTripleLines, const int* nodeConstraint, bool applyConstraints, Scales scales,
+                  MFE::CSRMatrix<double>& K, MFE::Vector<double>& F)
+  : m_Nodes(nodes)
+  , m_Triangles(triangles)
+  , m_NodeTriOffsets(nodeTriOffsets)
+  , m_NodeTris(nodeTris)
+  , m_Normals(normals)
+  , m_Areas(areas)
+  , m_Qualities(qualities)
+  , m_NodeTypes(nodeTypes)
+  , m_Triplenn(triplenn)
+  , m_SmoothTripleLines(smoothTripleLines)
+  , m_NodeConstraint(nodeConstraint)
+  , m_ApplyConstraints(applyConstraints)
+  , m_Scales(scales)
+  , m_K(K)
+  , m_F(F)
+  {
+  }
+  virtual ~MFEAssembleImpl() = default;
+
+  void assemble(size_t start, size_t end) const
+  {
+    const double epsilon = 1.0;
+    const double small = 1.0e-12;
+    const double large = 1.0e+50;
+    const double one12th = 1.0 / 12.0;
+    double LDistance = 0.0, deltaLDistance = 0.0;
+
+    for(size_t node = start; node < end; node++)
+    {
+      int r = static_cast<int>(node);
+      bool tripleNode = m_SmoothTripleLines && (m_NodeTypes[r] == 3 || m_NodeTypes[r] == 13);
+      for(size_t e = m_NodeTriOffsets[r]; e < m_NodeTriOffsets[r + 1]; e++)
+      {
+        int32_t t = m_NodeTris[e];
+        FaceArray::Face_t& rtri = m_Triangles[t];
+        const double* n = m_Normals + 3 * t;
+        double A = m_Areas[t];
+        double Q = m_Qualities[t];
+        // The node is moved on a copy of the triangle, so other threads keep seeing the unperturbed mesh
+        VertexArray::VertD_t tri[3] = {m_Nodes[rtri.verts[0]], m_Nodes[rtri.verts[1]], m_Nodes[rtri.verts[2]]};
+
+        for(int n0 = 0; n0 < 3; n0++)
+        {
+          int i = static_cast<int>(rtri.verts[n0]);
+          if(i == r)
+          {
+            for(int j = 0; j < 3; j++)
+            {
+              if(tripleNode)
+              {
+                LDistance = MFENodeFunctionsType::Distance(tri[n0], m_Nodes[m_Triplenn[r].triplenn1]) + MFENodeFunctionsType::Distance(m_Nodes[m_Triplenn[r].triplenn2], tri[n0]);
+              }
+              tri[n0].pos[j] += small;
+              double Anew = MFETriangleFunctionsType::area(tri[0], tri[1], tri[2]);
+              double Qnew = MFETriangleFunctionsType::circularity(tri[0], tri[1], tri[2], Anew);
+              if(tripleNode)
+              {
+                deltaLDistance = MFENodeFunctionsType::Distance(tri[n0], m_Nodes[m_Triplenn[r].triplenn1]) + MFENodeFunctionsType::Distance(m_Nodes[m_Triplenn[r].triplenn2], tri[n0]) - LDistance;
+                m_F[3 * r + j] -= m_Scales.TJ * deltaLDistance;
+              }
+              tri[n0].pos[j] = m_Nodes[r].pos[j];
+              double arg = (m_Scales.A * (Anew - A) + m_Scales.Q * (Qnew - Q) * A) / small;
+              m_F[3 * r + j] -= arg;
+            }
+          }
+          for(int n1 = 0; n1 < 3; n1++)
+          {
+            int h = static_cast<int>(rtri.verts[n1]);
+            if(h != r)
+            {
+              continue;
+            }
+            // Every row of a node has the same column pattern, so the block offset is found once
+            int block = static_cast<int>(m_K.rowFind(3 * h, 3 * i));
+            for(int k = 0; k < 3; k++)
+            {
+              double* row = m_K.rowValues(3 * h + k) + block;
+              for(int j = 0; j < 3; j++)
+              {
+                row[j] += one12th * (1.0 + delta(i, h)) * n[j] * n[k] * A;
+              }
+            }
+          }
+        }
+      }
+
+      // add epsilon to the diagonal and apply the boundary conditions
+      for(int s = 0; s < 3; s++)
+      {
+        m_K(3 * r + s, 3 * r + s) += epsilon;
+      }
+      if(m_ApplyConstraints)
+      {
+        if(m_NodeConstraint[r] % 2 != 0)
+        {
+          m_K(3 * r, 3 * r) = large;
+        } // X
+        if((m_NodeConstraint[r] / 2) % 2 != 0)
+        {
+          m_K(3 * r + 1, 3 * r + 1) = large;
+        } // Y
+        if(m_NodeConstraint[r] / 4 != 0)
+        {
+          m_K(3 * r + 2, 3 * r + 2) = large;
+        } // Z
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    assemble(r.begin(), r.end());
+  }
+#endif
+
+private:
+  VertexArray::VertD_t* m_Nodes;
+  FaceArray::Face_t* m_Triangles;
+  const size_t* m_NodeTriOffsets;
+  const int32_t* m_NodeTris;
+  const double* m_Normals;
+  const double* m_Areas;
+  const double* m_Qualities;
+  int8_t* m_NodeTypes;
+  TripleNN* m_Triplenn;
+  bool m_SmoothTripleLines;
+  const int* m_NodeConstraint;
+  bool m_ApplyConstraints;
+  Scales m_Scales;
+  MFE::CSRMatrix<double>& m_K;
+  MFE::Vector<double>& m_F;
+};
+
+/**
+ * @brief The MFEUpdateNodesImpl class implements a threaded algorithm that moves a range of nodes with their
+ * solved velocities and records the largest coordinate change of every node.
+ */
+class MFEUpdateNodesImpl
+{
+public:
+  MFEUpdateNodesImpl(VertexArray::VertD_t* nodes, const MFE::Vector<double>& x, const int* nodeConstraint, bool nodeConstraints, double dt, double* displacements)
+  : m_Nodes(nodes)
+  , m_X(x)
+  , m_NodeConstraint(nodeConstraint)
+  , m_ApplyNodeConstraints(nodeConstraints)
+  , m_Dt(dt)
+  , m_Displacements(displacements)
+  {
+  }
+  virtual ~MFEUpdateNodesImpl() = default;
+
+  void update(size_t start, size_t end) const
+  {
+    for(size_t node = start; node < end; node++)
+    {
+      int r = static_cast<int>(node);
+      double displacement = 0.0;
+      for(int s = 0; s < 3; s++)
+      {
+        double bc_dt = m_Dt;
+        if(m_ApplyNodeConstraints)
+        {
+          if(s == 0 && m_NodeConstraint[r] % 2 != 0)
+          {
+            bc_dt = 0.0;
+          } // X
+          if(s == 1 && (m_NodeConstraint[r] / 2) % 2 != 0)
+          {
+            bc_dt = 0.0;
+          } // Y
+          if(s == 2 && m_NodeConstraint[r] / 4 != 0)
+          {
+            bc_dt = 0.0;
+          } // Z
+        }
+
+        double velocity = m_X[3 * r + s];
+        if(fabs(m_Dt * velocity) < 1.0)
+        {
+          m_Nodes[r].pos[s] += bc_dt * velocity;
+          displacement = std::max(displacement, fabs(bc_dt * velocity));
+        }
+      }
+      m_Displacements[r] = displacement;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    update(r.begin(), r.end());
+  }
+#endif
+
+private:
+  VertexArray::VertD_t* m_Nodes;
+  const MFE::Vector<double>& m_X;
+  const int* m_NodeConstraint;
+  bool m_ApplyNodeConstraints;
+  double m_Dt;
+  double* m_Displacements;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 MovingFiniteElementSmoothing::MovingFiniteElementSmoothing()
 : m_IterationSteps(1)
+, m_ConvergenceTolerance(0.0f)
 , m_NodeConstraints(true)
 , m_ConstrainSurfaceNodes(true)
 , m_ConstrainQuadPoints(true)
@@ -155,6 +442,7 @@ void MovingFiniteElementSmoothing::setupFilterParameters()
   SurfaceMeshFilter::setupFilterParameters();
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Iteration Steps", IterationSteps, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Convergence Tolerance", ConvergenceTolerance, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Apply Node Contraints", NodeConstraints, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Constrain Surface Nodes", ConstrainSurfaceNodes, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Constrain Quad Points", ConstrainQuadPoints, FilterParameter::Uncategorized, MovingFiniteElementSmoothing));
@@ -174,6 +462,7 @@ void MovingFiniteElementSmoothing::readFilterParameters(AbstractFilterParameters
   reader->openFilterGroup(this, index);
   setSurfaceMeshNodeTypeArrayPath(reader->readDataArrayPath("SurfaceMeshNodeTypeArrayPath", getSurfaceMeshNodeTypeArrayPath()));
   setIterationSteps(reader->readValue("IterationSteps", getIterationSteps()));
+  setConvergenceTolerance(reader->readValue("ConvergenceTolerance", getConvergenceTolerance()));
   setNodeConstraints(reader->readValue("NodeConstraints", false));
   setConstrainSurfaceNodes(reader->readValue("ConstrainSurfaceNodes", false));
   setConstrainQuadPoints(reader->readValue("ConstrainQuadPoints", false));
@@ -630,19 +919,99 @@ void MovingFiniteElementSmoothing::execute()
     qDebug() << "Y (1): " << min[1] << " " << max[1] << "\n";
     qDebug() << "Z (2): " << min[2] << " " << max[2] << "\n";
   }
+  // Find the triangles of every node and, from them, the nodes each node is coupled to in the stiffness matrix
+  QVector<size_t> nodeTriOffsets(numberNodes + 1, 0);
+  for(int t = 0; t < ntri; t++)
+  {
+    for(int n0 = 0; n0 < 3; n0++)
+    {
+      int i = static_cast<int>(triangles[t].verts[n0]);
+      if(n0 > 0 && i == triangles[t].verts[0])
+      {
+        continue;
+      }
+      if(n0 > 1 && i == triangles[t].verts[1])
+      {
+        continue;
+      }
+      nodeTriOffsets[i + 1]++;
+    }
+  }
+  for(int r = 0; r < numberNodes; r++)
+  {
+    nodeTriOffsets[r + 1] += nodeTriOffsets[r];
+  }
+  QVector<int32_t> nodeTris(static_cast<int>(nodeTriOffsets[numberNodes]));
+  {
+    QVector<size_t> fill = nodeTriOffsets;
+    for(int t = 0; t < ntri; t++)
+    {
+      for(int n0 = 0; n0 < 3; n0++)
+      {
+        int i = static_cast<int>(triangles[t].verts[n0]);
+        if(n0 > 0 && i == triangles[t].verts[0])
+        {
+          continue;
+        }
+        if(n0 > 1 && i == triangles[t].verts[1])
+        {
+          continue;
+        }
+        nodeTris[static_cast<int>(fill[i]++)] = t;
+      }
+    }
+  }
+
+  // Every node row of K couples the 3 coordinates of the node to the 3 coordinates of itself and of each node it shares
+  // a triangle with. The pattern never changes, so K is stored in CSR form and filled row by row in parallel.
+  std::vector<size_t> kRowOffsets(3 * numberNodes + 1, 0);
+  std::vector<int> kColumns;
+  {
+    std::vector<int> coupled;
+    for(int r = 0; r < numberNodes; r++)
+    {
+      coupled.clear();
+      coupled.push_back(r);
+      for(size_t e = nodeTriOffsets[r]; e < nodeTriOffsets[r + 1]; e++)
+      {
+        FaceArray::Face_t& rtri = triangles[nodeTris[static_cast<int>(e)]];
+        coupled.push_back(static_cast<int>(rtri.verts[0]));
+        coupled.push_back(static_cast<int>(rtri.verts[1]));
+        coupled.push_back(static_cast<int>(rtri.verts[2]));
+      }
+      std::sort(coupled.begin(), coupled.end());
+      coupled.erase(std::unique(coupled.begin(), coupled.end()), coupled.end());
+      for(int k = 0; k < 3; k++)
+      {
+        for(size_t c = 0; c < coupled.size(); c++)
+        {
+          kColumns.push_back(3 * coupled[c] + 0);
+          kColumns.push_back(3 * coupled[c] + 1);
+          kColumns.push_back(3 * coupled[c] + 2);
+        }
+        kRowOffsets[3 * r + k + 1] = kColumns.size();
+      }
+    }
+  }
+
   // Allocate vectors and matricies
   int n_size = 3 * numberNodes;
   MFE::Vector<double> x(n_size), F(n_size);
-  MFE::SMatrix<double> K(n_size, n_size);
+  MFE::CSRMatrix<double> K(kRowOffsets, kColumns, n_size);
+  std::vector<double> triNormals(3 * ntri, 0.0);
+  std::vector<double> triAreas(ntri, 0.0);
+  std::vector<double> triQualities(ntri, 0.0);
+  std::vector<double> triDihedrals(ntri, 0.0);
+  std::vector<double> displacements(numberNodes, 0.0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
   // Allocate constants for solving linear equations
-  const double epsilon = 1.0; // change this if quality force too
-  // high, low
   const double dt = (40.0e-6) * (10 / max[1]);
   // time step, change if mesh moves too much, little
-  const double small = 1.0e-12;
-  const double large = 1.0e+50;
-  const double one12th = 1.0 / 12.0;
   const double tolerance = 1.0e-5;
   // Tolerance for nodes that are
   // near the RVE boundary
@@ -654,7 +1023,7 @@ void MovingFiniteElementSmoothing::execute()
 
   // Variables for logging of quality progress
   double Q_max, Q_sum, Q_ave, Q_max_ave;
-  double A, Q;
+  double Q;
   int hist_count = 10;
 
   QVector<double> Q_max_hist(hist_count);
@@ -747,18 +1116,23 @@ void MovingFiniteElementSmoothing::execute()
     Dihedral_sum = 0.;
     Dihedral_min = 180.;
     Dihedral_max = -1.; //  added may 10, ADR
-    double LDistance, deltaLDistance;
 
-    typedef NodeFunctions<VertexArray::VertD_t, double> NodeFunctionsType;
-    typedef TriangleFunctions<VertexArray::VertD_t, double> TriangleFunctionsType;
-    // Loop through each of the triangles
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, ntri),
+                        MFETriangleQualityImpl(nodes, triangles, triNormals.data(), triAreas.data(), triQualities.data(), triDihedrals.data()), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      MFETriangleQualityImpl serial(nodes, triangles, triNormals.data(), triAreas.data(), triQualities.data(), triDihedrals.data());
+      serial.compute(0, ntri);
+    }
+
     for(int t = 0; t < ntri; t++)
     {
-      FaceArray::Face_t& rtri = triangles[t];
-      MFE::Vector<double> n(3);
-      n = TriangleFunctionsType::normal(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);
-      A = TriangleFunctionsType::area(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);           //  current Area
-      Q = TriangleFunctionsType::circularity(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]], A); //  current quality
+      Q = triQualities[t];
       if(Q > 100.)
       {
         if(isVerbose)
@@ -772,9 +1146,7 @@ void MovingFiniteElementSmoothing::execute()
         Q_max = Q;
       }
 
-      Dihedral = TriangleFunctionsType::MinDihedral(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);
-      // debug
-      //      qDebug() << "triangle, min dihedral: " << t << ", " << Dihedral*180/PI << "\n";
+      Dihedral = triDihedrals[t];
       Dihedral_sum += Dihedral;
       if(Dihedral < Dihedral_min)
       {
@@ -784,77 +1156,25 @@ void MovingFiniteElementSmoothing::execute()
       {
         Dihedral_max = Dihedral;
       }
-
-      for(int n0 = 0; n0 < 3; n0++)
-      {
-        // for each of 3 nodes on the t^th triangle
-        int i = rtri.verts[n0];
-        VertexArray::VertD_t& node_i = nodes[i];
-        for(int j = 0; j < 3; j++)
-        {
-          //  for each of the three coordinates of the node
-          if(m_SmoothTripleLines == true && (m_SurfaceMeshNodeType[i] == 3 || m_SurfaceMeshNodeType[i] == 13))
-          {
-            //  if we are smoothing triple lines, and we have a TJ node
-            LDistance = NodeFunctionsType::Distance(node_i, nodes[triplenn[i].triplenn1]) + NodeFunctionsType::Distance(nodes[triplenn[i].triplenn2], nodes[i]);
-          }
-          node_i.pos[j] += small;
-          double Anew = TriangleFunctionsType::area(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]); //  current Area
-          double Qnew = TriangleFunctionsType::circularity(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]], Anew);
-          if(m_SmoothTripleLines == true && (m_SurfaceMeshNodeType[i] == 3 || m_SurfaceMeshNodeType[i] == 13))
-          {
-            //  if we are smoothing triple lines, and we have a TJ node
-            deltaLDistance =
-                NodeFunctionsType::Distance(node_i, nodes[triplenn[i].triplenn1]) + NodeFunctionsType::Distance(nodes[triplenn[i].triplenn2], nodes[i]) - LDistance; // change in line length
-            F[3 * i + j] -= TJ_scale * deltaLDistance;
-          }
-          node_i.pos[j] -= small;
-          double arg = (A_scale * (Anew - A) + Q_scale * (Qnew - Q) * A) / small;
-          F[3 * i + j] -= arg;
-        }
-        for(int n1 = 0; n1 < 3; n1++)
-        {
-          //  for each of 3 nodes
-          int h = rtri.verts[n1];
-          for(int k = 0; k < 3; k++)
-          {
-            for(int j = 0; j < 3; j++)
-            {
-              K[3 * h + k][3 * i + j] += one12th * (1.0 + delta(i, h)) * n[j] * n[k] * A;
-            }
-          }
-        }
-      }
     }
-    // add epsilon to the diagonal
-    for(int r = 0; r < numberNodes; r++)
+
+    // compute the triangle contributions to K and F node by node, add epsilon to the diagonal and apply the boundary conditions
+    MFEAssembleImpl::Scales scales = {A_scale, Q_scale, TJ_scale};
+    bool applyConstraints = (m_NodeConstraints == true || m_ConstrainQuadPoints == true);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
     {
-      for(int s = 0; s < 3; s++)
-      {
-        K[3 * r + s][3 * r + s] += epsilon;
-      }
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numberNodes),
+                        MFEAssembleImpl(nodes, triangles, nodeTriOffsets.data(), nodeTris.data(), triNormals.data(), triAreas.data(), triQualities.data(), m_SurfaceMeshNodeType, triplenn,
+                                        m_SmoothTripleLines, nodeConstraint.data(), applyConstraints, scales, K, F),
+                        tbb::auto_partitioner());
     }
-
-    // apply boundary conditions
-    for(int r = 0; r < numberNodes; r++)
+    else
+#endif
     {
-      if(m_NodeConstraints == true || m_ConstrainQuadPoints == true)
-      {
-        // only do this if we want the constraint
-        if(nodeConstraint[r] % 2 != 0)
-        {
-          K[3 * r][3 * r] = large;
-        } // X
-        if((nodeConstraint[r] / 2) % 2 != 0)
-        {
-          K[3 * r + 1][3 * r + 1] = large;
-        } // Y
-        if(nodeConstraint[r] / 4 != 0)
-        {
-          K[3 * r + 2][3 * r + 2] = large;
-        } // Z
-        //  changed  12 v 10, ADR
-      }
+      MFEAssembleImpl serial(nodes, triangles, nodeTriOffsets.data(), nodeTris.data(), triNormals.data(), triAreas.data(), triQualities.data(), m_SurfaceMeshNodeType, triplenn,
+                             m_SmoothTripleLines, nodeConstraint.data(), applyConstraints, scales, K, F);
+      serial.assemble(0, numberNodes);
     }
 
     // solve for node velocities
@@ -950,46 +1270,33 @@ void MovingFiniteElementSmoothing::execute()
 #endif
 
     // update node positions
-    for(int r = 0; r < numberNodes; r++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
     {
-      //    velocityfile << r << " ";
-      for(int s = 0; s < 3; s++)
-      {
-        double bc_dt = dt;
-        if(m_NodeConstraints == true)
-        {
-          // only do this if we want the constraint
-          /*
-           if( (fabs(nodes[r][s] - max[s]) < tolerance)
-           || (fabs(nodes[r][s] - min[s]) < tolerance)) bc_dt = 0.0 ;
-           */
-          if(s == 0 && nodeConstraint[r] % 2 != 0)
-          {
-            bc_dt = 0.0;
-          } // X
-          if(s == 1 && (nodeConstraint[r] / 2) % 2 != 0)
-          {
-            bc_dt = 0.0;
-          } // Y
-          if(s == 2 && nodeConstraint[r] / 4 != 0)
-          {
-            bc_dt = 0.0;
-          } // Z
-          //  changed  12 v 10, ADR
-        }
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numberNodes), MFEUpdateNodesImpl(nodes, x, nodeConstraint.data(), m_NodeConstraints, dt, displacements.data()), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      MFEUpdateNodesImpl serial(nodes, x, nodeConstraint.data(), m_NodeConstraints, dt, displacements.data());
+      serial.update(0, numberNodes);
+    }
 
-        if(fabs(dt * x[3 * r + s]) > 1.0)
-        {
-          nodes[r].pos[s] += 0.0;
-        }
-        else if(fabs(dt * x[3 * r + s]) < 1.0)
-        {
-          nodes[r].pos[s] += bc_dt * x[3 * r + s];
-        }
-        //    velocityfile  << std::scientific << QSetw(4)
-        //        << QSetprecision(4) << F[3*r+s] << "\t"<< x[3*r+s] <<"\t";
-      }
-      //    velocityfile << "\n";
+    // stop early once no node moves by more than the convergence tolerance
+    double maxDisplacement = 0.0;
+    for(int r = 0; r < numberNodes; r++)
+    {
+      maxDisplacement = std::max(maxDisplacement, displacements[r]);
+    }
+    if(isVerbose)
+    {
+      qDebug() << "Largest node displacement ... " << maxDisplacement << "\n";
+    }
+    if(m_ConvergenceTolerance > 0.0f && maxDisplacement < m_ConvergenceTolerance)
+    {
+      ss = QObject::tr("Converged after %1 iterations").arg(updates);
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      break;
     }
 //  velocityfile.close();
 
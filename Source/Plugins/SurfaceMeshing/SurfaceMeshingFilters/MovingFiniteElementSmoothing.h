@@ -64,6 +64,7 @@ class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFil
     Q_OBJECT
     // PYB11_CREATE_BINDINGS(MovingFiniteElementSmoothing SUPERCLASS SurfaceMeshFilter)
     // PYB11_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
+    // PYB11_PROPERTY(float ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
     // PYB11_PROPERTY(bool NodeConstraints READ getNodeConstraints WRITE setNodeConstraints)
     // PYB11_PROPERTY(bool ConstrainSurfaceNodes READ getConstrainSurfaceNodes WRITE setConstrainSurfaceNodes)
     // PYB11_PROPERTY(bool ConstrainQuadPoints READ getConstrainQuadPoints WRITE setConstrainQuadPoints)
@@ -79,6 +80,8 @@ class SurfaceMeshing_EXPORT MovingFiniteElementSmoothing : public SurfaceMeshFil
      /* Place your input parameters here. You can use some of the DREAM3D Macros if you want to */
      SIMPL_FILTER_PARAMETER(int, IterationSteps)
      Q_PROPERTY(int IterationSteps READ getIterationSteps WRITE setIterationSteps)
+     SIMPL_FILTER_PARAMETER(float, ConvergenceTolerance)
+     Q_PROPERTY(float ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
      SIMPL_FILTER_PARAMETER(bool, NodeConstraints)
      Q_PROPERTY(bool NodeConstraints READ getNodeConstraints WRITE setNodeConstraints)
      SIMPL_FILTER_PARAMETER(bool, ConstrainSurfaceNodes)
@@ -0,0 +1,549 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TriangleTopology.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+typedef std::pair<int64_t, int64_t> RowIdPair;
+
+/**
+ * @brief The EdgeKey struct identifies a triangle edge by its sorted vertex ids
+ */
+struct EdgeKey
+{
+  int64_t v0;
+  int64_t v1;
+  int64_t tri;
+
+  bool operator<(const EdgeKey& other) const
+  {
+    if(v0 != other.v0)
+    {
+      return v0 < other.v0;
+    }
+    if(v1 != other.v1)
+    {
+      return v1 < other.v1;
+    }
+    return tri < other.tri;
+  }
+
+  bool sameEdge(const EdgeKey& other) const
+  {
+    return v0 == other.v0 && v1 == other.v1;
+  }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T> void sortKeys(std::vector<T>& keys)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(keys.begin(), keys.end());
+#else
+  std::sort(keys.begin(), keys.end());
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Compacts sorted (row, id) pairs into a CSR list. Rows outside [0, numRows)
+// are dropped, which lets the generators mark unused slots with a row of -1.
+// -----------------------------------------------------------------------------
+void compactSortedPairs(const std::vector<RowIdPair>& pairs, int64_t numRows, bool unique, TriangleTopology::CSRList& list)
+{
+  list.offsets.assign(static_cast<size_t>(numRows + 1), 0);
+  list.ids.clear();
+  list.ids.reserve(pairs.size());
+
+  for(size_t k = 0; k < pairs.size(); k++)
+  {
+    int64_t row = pairs[k].first;
+    if(row < 0 || row >= numRows)
+    {
+      continue;
+    }
+    if(unique && k > 0 && pairs[k] == pairs[k - 1])
+    {
+      continue;
+    }
+    list.ids.push_back(pairs[k].second);
+    list.offsets[row + 1]++;
+  }
+
+  for(int64_t i = 0; i < numRows; i++)
+  {
+    list.offsets[i + 1] += list.offsets[i];
+  }
+}
+}
+
+/**
+ * @brief The VertexTrianglePairsImpl class implements a threaded algorithm that emits a
+ * (vertex, triangle) pair for every corner of a set of triangles
+ */
+class VertexTrianglePairsImpl
+{
+  const int64_t* m_Triangles;
+  int64_t m_NumVerts;
+  RowIdPair* m_Pairs;
+
+public:
+  VertexTrianglePairsImpl(const int64_t* triangles, int64_t numVerts, RowIdPair* pairs)
+  : m_Triangles(triangles)
+  , m_NumVerts(numVerts)
+  , m_Pairs(pairs)
+  {
+  }
+  virtual ~VertexTrianglePairsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      for(size_t k = 0; k < 3; k++)
+      {
+        int64_t v = m_Triangles[3 * t + k];
+        m_Pairs[3 * t + k] = (v >= 0 && v < m_NumVerts) ? RowIdPair(v, static_cast<int64_t>(t)) : RowIdPair(-1, -1);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The EdgeKeysImpl class implements a threaded algorithm that emits the three
+ * edges of every triangle in a set of triangles
+ */
+class EdgeKeysImpl
+{
+  const int64_t* m_Triangles;
+  EdgeKey* m_Keys;
+
+public:
+  EdgeKeysImpl(const int64_t* triangles, EdgeKey* keys)
+  : m_Triangles(triangles)
+  , m_Keys(keys)
+  {
+  }
+  virtual ~EdgeKeysImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      for(size_t k = 0; k < 3; k++)
+      {
+        int64_t a = m_Triangles[3 * t + k];
+        int64_t b = m_Triangles[3 * t + (k + 1) % 3];
+        EdgeKey& key = m_Keys[3 * t + k];
+        key.v0 = std::min(a, b);
+        key.v1 = std::max(a, b);
+        key.tri = static_cast<int64_t>(t);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
+/**
+ * @brief The FeaturePairsImpl class implements a threaded algorithm that emits, for every
+ * face, either a (feature, face side) pair per label or the two (feature, neighbor) pairs
+ * across the face
+ */
+class FeaturePairsImpl
+{
+  const int32_t* m_FaceLabels;
+  int32_t m_NumFeatures;
+  bool m_Neighbors;
+  RowIdPair* m_Pairs;
+
+public:
+  FeaturePairsImpl(const int32_t* faceLabels, int32_t numFeatures, bool neighbors, RowIdPair* pairs)
+  : m_FaceLabels(faceLabels)
+  , m_NumFeatures(numFeatures)
+  , m_Neighbors(neighbors)
+  , m_Pairs(pairs)
+  {
+  }
+  virtual ~FeaturePairsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t t = start; t < end; t++)
+    {
+      int32_t feature1 = m_FaceLabels[2 * t];
+      int32_t feature2 = m_FaceLabels[2 * t + 1];
+      bool valid1 = (feature1 > 0 && feature1 < m_NumFeatures);
+      bool valid2 = (feature2 > 0 && feature2 < m_NumFeatures);
+      if(m_Neighbors)
+      {
+        if(valid1 && valid2)
+        {
+          m_Pairs[2 * t] = RowIdPair(feature1, feature2);
+          m_Pairs[2 * t + 1] = RowIdPair(feature2, feature1);
+        }
+        else
+        {
+          m_Pairs[2 * t] = RowIdPair(-1, -1);
+          m_Pairs[2 * t + 1] = RowIdPair(-1, -1);
+        }
+      }
+      else
+      {
+        m_Pairs[2 * t] = valid1 ? RowIdPair(feature1, static_cast<int64_t>(2 * t)) : RowIdPair(-1, -1);
+        m_Pairs[2 * t + 1] = valid2 ? RowIdPair(feature2, static_cast<int64_t>(2 * t + 1)) : RowIdPair(-1, -1);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleTopology::CSRList::CSRList()
+: offsets(1, 0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleTopology::CSRList::~CSRList() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t TriangleTopology::CSRList::getNumberOfLists() const
+{
+  return offsets.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleTopology::CSRList::getNumberOfElements(size_t i) const
+{
+  return offsets[i + 1] - offsets[i];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int64_t* TriangleTopology::CSRList::getElementListPointer(size_t i) const
+{
+  return ids.data() + offsets[i];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriangleTopology::CSRList::getMaxElements() const
+{
+  int64_t maxElements = 0;
+  for(size_t i = 0; i < getNumberOfLists(); i++)
+  {
+    maxElements = std::max(maxElements, getNumberOfElements(i));
+  }
+  return maxElements;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleTopology::TriangleTopology() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleTopology::~TriangleTopology() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleTopology::FindElementsContainingVert(const int64_t* triangles, int64_t numTris, int64_t numVerts, CSRList& list)
+{
+  std::vector<RowIdPair> pairs(static_cast<size_t>(3 * numTris));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTris), VertexTrianglePairsImpl(triangles, numVerts, pairs.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    VertexTrianglePairsImpl serial(triangles, numVerts, pairs.data());
+    serial.generate(0, numTris);
+  }
+
+  sortKeys(pairs);
+  compactSortedPairs(pairs, numVerts, false, list);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleTopology::FindElementNeighbors(const int64_t* triangles, int64_t numTris, CSRList& list)
+{
+  std::vector<EdgeKey> edges(static_cast<size_t>(3 * numTris));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTris), EdgeKeysImpl(triangles, edges.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    EdgeKeysImpl serial(triangles, edges.data());
+    serial.generate(0, numTris);
+  }
+
+  sortKeys(edges);
+
+  // Every pair of triangles in a run of identical edges are neighbors. Manifold
+  // edges give a single pair; non-manifold edges connect all of their triangles.
+  std::vector<RowIdPair> pairs;
+  pairs.reserve(edges.size());
+  size_t runStart = 0;
+  while(runStart < edges.size())
+  {
+    size_t runEnd = runStart + 1;
+    while(runEnd < edges.size() && edges[runEnd].sameEdge(edges[runStart]))
+    {
+      runEnd++;
+    }
+    if(edges[runStart].v0 != edges[runStart].v1)
+    {
+      for(size_t a = runStart; a < runEnd; a++)
+      {
+        for(size_t b = a + 1; b < runEnd; b++)
+        {
+          if(edges[a].tri != edges[b].tri)
+          {
+            pairs.push_back(RowIdPair(edges[a].tri, edges[b].tri));
+            pairs.push_back(RowIdPair(edges[b].tri, edges[a].tri));
+          }
+        }
+      }
+    }
+    runStart = runEnd;
+  }
+
+  sortKeys(pairs);
+  compactSortedPairs(pairs, numTris, true, list);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleTopology::FindFeatureFaces(const int32_t* faceLabels, int64_t numTris, int32_t numFeatures, CSRList& list)
+{
+  std::vector<RowIdPair> pairs(static_cast<size_t>(2 * numTris));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTris), FeaturePairsImpl(faceLabels, numFeatures, false, pairs.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FeaturePairsImpl serial(faceLabels, numFeatures, false, pairs.data());
+    serial.generate(0, numTris);
+  }
+
+  sortKeys(pairs);
+  compactSortedPairs(pairs, numFeatures, false, list);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriangleTopology::FindFeatureNeighbors(const int32_t* faceLabels, int64_t numTris, int32_t numFeatures, CSRList& list)
+{
+  std::vector<RowIdPair> pairs(static_cast<size_t>(2 * numTris));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTris), FeaturePairsImpl(faceLabels, numFeatures, true, pairs.data()), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FeaturePairsImpl serial(faceLabels, numFeatures, true, pairs.data());
+    serial.generate(0, numTris);
+  }
+
+  sortKeys(pairs);
+  compactSortedPairs(pairs, numFeatures, true, list);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ElementDynamicList::Pointer TriangleTopology::CreateElementDynamicList(const CSRList& list)
+{
+  if(list.getMaxElements() > std::numeric_limits<uint16_t>::max())
+  {
+    return ElementDynamicList::NullPointer();
+  }
+
+  size_t numLists = list.getNumberOfLists();
+  std::vector<uint16_t> linkCount(numLists, 0);
+  for(size_t i = 0; i < numLists; i++)
+  {
+    linkCount[i] = static_cast<uint16_t>(list.getNumberOfElements(i));
+  }
+
+  ElementDynamicList::Pointer dynamicList = ElementDynamicList::New();
+  dynamicList->allocateLists(linkCount);
+  for(size_t i = 0; i < numLists; i++)
+  {
+    const int64_t* ids = list.getElementListPointer(i);
+    std::copy(ids, ids + linkCount[i], dynamicList->getElementListPointer(i));
+  }
+  return dynamicList;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriangleTopology::BuildElementsContainingVert(TriangleGeom::Pointer triangles)
+{
+  CSRList list;
+  FindElementsContainingVert(triangles->getTriPointer(0), triangles->getNumberOfTris(), triangles->getNumberOfVertices(), list);
+  ElementDynamicList::Pointer dynamicList = CreateElementDynamicList(list);
+  if(nullptr == dynamicList.get())
+  {
+    return -1;
+  }
+  triangles->setElementsContainingVert(dynamicList);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriangleTopology::BuildElementNeighbors(TriangleGeom::Pointer triangles)
+{
+  CSRList list;
+  FindElementNeighbors(triangles->getTriPointer(0), triangles->getNumberOfTris(), list);
+  ElementDynamicList::Pointer dynamicList = CreateElementDynamicList(list);
+  if(nullptr == dynamicList.get())
+  {
+    return -1;
+  }
+  triangles->setElementNeighbors(dynamicList);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriangleTopology::CacheElementsContainingVert(TriangleGeom::Pointer triangles)
+{
+  if(nullptr != triangles->getElementsContainingVert().get())
+  {
+    return 0;
+  }
+  return BuildElementsContainingVert(triangles);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriangleTopology::CacheElementNeighbors(TriangleGeom::Pointer triangles)
+{
+  if(nullptr != triangles->getElementNeighbors().get())
+  {
+    return 0;
+  }
+  return BuildElementNeighbors(triangles);
+}
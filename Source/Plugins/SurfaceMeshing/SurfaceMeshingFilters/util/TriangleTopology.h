@@ -0,0 +1,179 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+/**
+ * @brief The TriangleTopology class builds the connectivity of a triangle mesh as flat compressed
+ * row (CSR) lists: vertex-to-triangle, triangle-to-triangle (shared edge) and feature-to-feature
+ * (shared face). Each relation is generated as a set of (row, id) pairs which are sorted, in
+ * parallel when available, and then compacted, so every list comes out in ascending order. The
+ * vertex and triangle lists may be cached on the TriangleGeom so that later filters find them
+ * through getElementsContainingVert() and getElementNeighbors().
+ */
+class TriangleTopology
+{
+  public:
+    /**
+     * @brief The CSRList class stores one list per row as an offsets array of length
+     * numRows + 1 and a flat array of ids
+     */
+    class CSRList
+    {
+      public:
+        CSRList();
+        virtual ~CSRList();
+
+        /**
+         * @brief getNumberOfLists
+         * @return
+         */
+        size_t getNumberOfLists() const;
+
+        /**
+         * @brief getNumberOfElements Returns the length of the list at row i
+         * @param i
+         * @return
+         */
+        int64_t getNumberOfElements(size_t i) const;
+
+        /**
+         * @brief getElementListPointer Returns a pointer to the first id of the list at row i
+         * @param i
+         * @return
+         */
+        const int64_t* getElementListPointer(size_t i) const;
+
+        /**
+         * @brief getMaxElements Returns the length of the longest list
+         * @return
+         */
+        int64_t getMaxElements() const;
+
+        std::vector<int64_t> offsets;
+        std::vector<int64_t> ids;
+    };
+
+    virtual ~TriangleTopology();
+
+    /**
+     * @brief FindElementsContainingVert Builds the list of triangles that use each vertex
+     * @param triangles Triangle connectivity (3 vertex ids per triangle)
+     * @param numTris
+     * @param numVerts
+     * @param list
+     */
+    static void FindElementsContainingVert(const int64_t* triangles, int64_t numTris, int64_t numVerts, CSRList& list);
+
+    /**
+     * @brief FindElementNeighbors Builds the list of triangles that share an edge with each triangle
+     * @param triangles Triangle connectivity (3 vertex ids per triangle)
+     * @param numTris
+     * @param list
+     */
+    static void FindElementNeighbors(const int64_t* triangles, int64_t numTris, CSRList& list);
+
+    /**
+     * @brief FindFeatureFaces Builds the list of faces bounding each feature. Every entry is
+     * encoded as 2 * triangle + side, where side is the face label component (0 or 1) that
+     * holds the feature. Only positive labels below numFeatures are listed.
+     * @param faceLabels
+     * @param numTris
+     * @param numFeatures
+     * @param list
+     */
+    static void FindFeatureFaces(const int32_t* faceLabels, int64_t numTris, int32_t numFeatures, CSRList& list);
+
+    /**
+     * @brief FindFeatureNeighbors Builds the unique list of features that share at least one face
+     * with each feature. Only positive labels below numFeatures are listed.
+     * @param faceLabels
+     * @param numTris
+     * @param numFeatures
+     * @param list
+     */
+    static void FindFeatureNeighbors(const int32_t* faceLabels, int64_t numTris, int32_t numFeatures, CSRList& list);
+
+    /**
+     * @brief CreateElementDynamicList Copies a CSR list into the DynamicListArray layout used by the geometries
+     * @param list
+     * @return nullptr if a list is too long to be counted by the ElementDynamicList
+     */
+    static ElementDynamicList::Pointer CreateElementDynamicList(const CSRList& list);
+
+    /**
+     * @brief BuildElementsContainingVert Builds the vertex-to-triangle lists and stores them on the
+     * geometry, replacing any lists it already holds.
+     * @param triangles
+     * @return Negative error code on failure
+     */
+    static int32_t BuildElementsContainingVert(TriangleGeom::Pointer triangles);
+
+    /**
+     * @brief BuildElementNeighbors Builds the triangle-to-triangle lists and stores them on the
+     * geometry, replacing any lists it already holds.
+     * @param triangles
+     * @return Negative error code on failure
+     */
+    static int32_t BuildElementNeighbors(TriangleGeom::Pointer triangles);
+
+    /**
+     * @brief CacheElementsContainingVert Builds the vertex-to-triangle lists and stores them on the
+     * geometry. Nothing is done if the geometry already holds them.
+     * @param triangles
+     * @return Negative error code on failure
+     */
+    static int32_t CacheElementsContainingVert(TriangleGeom::Pointer triangles);
+
+    /**
+     * @brief CacheElementNeighbors Builds the triangle-to-triangle lists and stores them on the
+     * geometry. Nothing is done if the geometry already holds them.
+     * @param triangles
+     * @return Negative error code on failure
+     */
+    static int32_t CacheElementNeighbors(TriangleGeom::Pointer triangles);
+
+  protected:
+    TriangleTopology();
+
+  private:
+    TriangleTopology(const TriangleTopology&) = delete;            // Copy Constructor Not Implemented
+    TriangleTopology& operator=(const TriangleTopology&) = delete; // Copy Assignment Not Implemented
+};
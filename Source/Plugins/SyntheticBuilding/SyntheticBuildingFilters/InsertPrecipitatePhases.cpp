@@ -38,6 +38,8 @@
 
 #include "InsertPrecipitatePhases.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include <QtCore/QDir>
@@ -363,6 +365,11 @@ void InsertPrecipitatePhases::initialize()
   m_RdfCurrentDistNorm.clear();
   m_RandomCentroids.clear();
   m_RdfRandom.clear();
+  m_RdfTrackedBins = 0;
+  m_RdfGridCellSize = 0.0f;
+  m_RdfGridDims[0] = m_RdfGridDims[1] = m_RdfGridDims[2] = 0;
+  m_RdfGridCells.clear();
+  m_RdfGridCellOfFeature.clear();
   m_FeatureSizeDistStep.clear();
   m_GSizes.clear();
 
@@ -892,9 +899,10 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   }
 
   // This is the set that we are going to keep updated with the points that are
-  // not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  // not in an exclusion zone. Both tables are indexed directly by packing point
+  // and by slot, so they are stored as flat arrays rather than maps
+  std::vector<size_t> availablePoints(static_cast<size_t>(m_TotalPoints), 0);
+  std::vector<size_t> availablePointsInv(static_cast<size_t>(m_TotalPoints), 0);
 
   // Get a pointer to the Feature Owners that was just initialized in the
   // initialize_packinggrid() method
@@ -1373,6 +1381,7 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   {
     // calculate the initial current RDF - this will change as we move particles
     // around
+    initialize_rdfGrid(numfeatures);
     for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
     {
       m_oldRDFerror = check_RDFerror(int32_t(i), -1000, false);
@@ -1935,7 +1944,7 @@ void InsertPrecipitatePhases::update_exclusionZones(int32_t gadd, int32_t gremov
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void InsertPrecipitatePhases::update_availablepoints(std::vector<size_t>& availablePoints, std::vector<size_t>& availablePointsInv)
 {
   size_t removeSize = m_PointsToRemove.size();
   size_t addSize = m_PointsToAdd.size();
@@ -1966,6 +1975,82 @@ void InsertPrecipitatePhases::update_availablepoints(std::map<size_t, size_t>& a
   m_PointsToAdd.clear();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::initialize_rdfGrid(size_t numfeatures)
+{
+  // Only the bins that are compared against the target distribution are tracked; every
+  // pair further apart than that lands in a bin that never contributes to the RDF error
+  m_RdfTrackedBins = std::min(m_RdfCurrentDist.size(), m_RdfTargetDist.size());
+  m_RdfCurrentDistNorm.assign(m_RdfTrackedBins, 0.0f);
+  float cutoff = (m_RdfTrackedBins > 0) ? m_rdfMin + static_cast<float>(m_RdfTrackedBins - 1) * m_StepSize : 0.0f;
+
+  // Size the cells so that on average they hold about one precipitate; for very small cutoffs this
+  // keeps the grid proportional to the number of precipitates instead of to the volume
+  size_t numPrecipitates = (numfeatures > size_t(m_FirstPrecipitateFeature)) ? numfeatures - size_t(m_FirstPrecipitateFeature) : 0;
+  numPrecipitates = std::max(numPrecipitates, size_t(1));
+  float volume = std::max(m_SizeX, 1.0E-6f) * std::max(m_SizeY, 1.0E-6f) * std::max(m_SizeZ, 1.0E-6f);
+  m_RdfGridCellSize = std::max(cutoff, std::cbrt(volume / static_cast<float>(numPrecipitates)));
+  if(m_RdfGridCellSize <= 0.0f)
+  {
+    m_RdfGridCellSize = 1.0f;
+  }
+  // Thin (or 2D) volumes get more cells along their long axes than the cube root estimate, so grow
+  // the cells until the grid is no larger than the number of precipitates
+  while(true)
+  {
+    m_RdfGridDims[0] = static_cast<int64_t>(m_SizeX / m_RdfGridCellSize) + 1;
+    m_RdfGridDims[1] = static_cast<int64_t>(m_SizeY / m_RdfGridCellSize) + 1;
+    m_RdfGridDims[2] = static_cast<int64_t>(m_SizeZ / m_RdfGridCellSize) + 1;
+    size_t numCells = static_cast<size_t>(m_RdfGridDims[0] * m_RdfGridDims[1] * m_RdfGridDims[2]);
+    if(numCells <= numPrecipitates)
+    {
+      break;
+    }
+    m_RdfGridCellSize *= 1.25f;
+  }
+
+  m_RdfGridCells.clear();
+  m_RdfGridCells.resize(static_cast<size_t>(m_RdfGridDims[0] * m_RdfGridDims[1] * m_RdfGridDims[2]));
+  m_RdfGridCellOfFeature.assign(numfeatures, -1);
+  for(size_t i = size_t(m_FirstPrecipitateFeature); i < numfeatures; i++)
+  {
+    update_rdfGrid(static_cast<int32_t>(i));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InsertPrecipitatePhases::update_rdfGrid(int32_t gnum)
+{
+  int64_t cell[3] = {0, 0, 0};
+  for(size_t d = 0; d < 3; d++)
+  {
+    cell[d] = static_cast<int64_t>(m_Centroids[3 * gnum + d] / m_RdfGridCellSize);
+    cell[d] = std::max(int64_t(0), std::min(cell[d], m_RdfGridDims[d] - 1));
+  }
+  int64_t newCell = (cell[2] * m_RdfGridDims[1] + cell[1]) * m_RdfGridDims[0] + cell[0];
+  int64_t oldCell = m_RdfGridCellOfFeature[gnum];
+  if(newCell == oldCell)
+  {
+    return;
+  }
+  if(oldCell >= 0)
+  {
+    std::vector<int32_t>& members = m_RdfGridCells[oldCell];
+    std::vector<int32_t>::iterator iter = std::find(members.begin(), members.end(), gnum);
+    if(iter != members.end())
+    {
+      *iter = members.back();
+      members.pop_back();
+    }
+  }
+  m_RdfGridCells[newCell].push_back(gnum);
+  m_RdfGridCellOfFeature[gnum] = newCell;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1975,55 +2060,61 @@ void InsertPrecipitatePhases::determine_currentRDF(int32_t gnum, int32_t add, bo
   float xn = 0.0f, yn = 0.0f, zn = 0.0f;
   float r = 0.0f;
 
-  size_t iter = 0;
-  int32_t numPPTfeatures = 1;
   int32_t rdfBin = 0;
-
   int32_t phase = m_FeaturePhases[gnum];
-  while(phase != m_PrecipitatePhases[iter])
-  {
-    iter++;
-  }
+  float increment = (double_count == true) ? static_cast<float>(2 * add) : static_cast<float>(add);
+
+  // The precipitate may have moved since it was last binned
+  update_rdfGrid(gnum);
 
   x = m_Centroids[3 * gnum];
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
-  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  for(size_t n = size_t(m_FirstPrecipitateFeature); n < numFeatures; n++)
+  int64_t cell = m_RdfGridCellOfFeature[gnum];
+  int64_t cx = cell % m_RdfGridDims[0];
+  int64_t cy = (cell / m_RdfGridDims[0]) % m_RdfGridDims[1];
+  int64_t cz = cell / (m_RdfGridDims[0] * m_RdfGridDims[1]);
+
+  // The grid cells are at least as large as the tracked distance range, so every
+  // precipitate that can land in a tracked bin is in one of the 27 surrounding cells
+  for(int64_t k = std::max(int64_t(0), cz - 1); k <= std::min(m_RdfGridDims[2] - 1, cz + 1); k++)
   {
-    if(m_FeaturePhases[n] == phase && n != gnum)
+    for(int64_t j = std::max(int64_t(0), cy - 1); j <= std::min(m_RdfGridDims[1] - 1, cy + 1); j++)
     {
-      xn = m_Centroids[3 * n];
-      yn = m_Centroids[3 * n + 1];
-      zn = m_Centroids[3 * n + 2];
-      r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
-
-      rdfBin = (r - m_rdfMin) / m_StepSize;
-
-      if(r < m_rdfMin)
+      for(int64_t i = std::max(int64_t(0), cx - 1); i <= std::min(m_RdfGridDims[0] - 1, cx + 1); i++)
       {
-        rdfBin = -1;
-      }
-      // if (r < 6.0)
-      //{
-      //  int stop = 0;
-      //}
-      // if (rdfBin >= m_numRDFbins) {rdfBin = m_numRDFbins;}
-      if(double_count == true)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += 2 * add;
-      }
-      else if(double_count == false)
-      {
-        m_RdfCurrentDist[rdfBin + 1] += add;
-      }
+        const std::vector<int32_t>& members = m_RdfGridCells[(k * m_RdfGridDims[1] + j) * m_RdfGridDims[0] + i];
+        for(const auto& n : members)
+        {
+          if(n == gnum || m_FeaturePhases[n] != phase)
+          {
+            continue;
+          }
+          xn = m_Centroids[3 * n];
+          yn = m_Centroids[3 * n + 1];
+          zn = m_Centroids[3 * n + 2];
+          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
 
-      numPPTfeatures += 1;
+          rdfBin = static_cast<int32_t>((r - m_rdfMin) / m_StepSize);
+          if(r < m_rdfMin)
+          {
+            rdfBin = -1;
+          }
+          if(static_cast<size_t>(rdfBin + 1) < m_RdfTrackedBins)
+          {
+            m_RdfCurrentDist[rdfBin + 1] += increment;
+          }
+        }
+      }
     }
   }
 
-  m_RdfCurrentDistNorm = normalizeRDF(m_RdfCurrentDist, m_numRDFbins, m_StepSize, m_rdfMin, numPPTfeatures);
+  // Normalize the tracked bins by the random distribution
+  for(size_t i = 0; i < m_RdfTrackedBins; i++)
+  {
+    m_RdfCurrentDistNorm[i] = m_RdfCurrentDist[i] / m_RdfRandom[i];
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -2071,44 +2162,6 @@ void InsertPrecipitatePhases::determine_randomRDF(size_t gnum, int32_t add, bool
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-std::vector<float> InsertPrecipitatePhases::normalizeRDF(std::vector<float> rdf, int32_t num_bins, float m_StepSize, float rdfmin, int32_t numPPTfeatures)
-{
-  //  //Normalizing the RDF by number density of particles
-  //  (4/3*pi*(r2^3-r1^3)*numPPTfeatures/volume)
-  //  float normfactor;
-  //  float r1;
-  //  float r2;
-  //  float oneovervolume = 1.0f/volume;
-  //  float finiteAdjFactor = .5;
-
-  //  r1 = 0*finiteAdjFactor;
-  //  r2 = rdfmin*finiteAdjFactor;
-  //  normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) -
-  //  (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //  rdf[0] = rdf[0];
-
-  //  for (size_t i = 1; i < num_bins+2; i++)
-  //  {
-  //    r1 = (rdfmin + (i-1)*m_StepSize);
-  //    r2 = (r1 + m_StepSize);
-  //    r1 = r1*finiteAdjFactor;
-  //    r2 = r2*finiteAdjFactor;
-  //    normfactor = 4.0f/3.0f*SIMPLib::Constants::k_Pi*((r2*r2*r2) -
-  //    (r1*r1*r1))*numPPTfeatures*oneovervolume;
-  //    rdf[i] = rdf[i]/normfactor;
-  //  }
-
-  for(size_t i = 0; i < rdf.size(); i++)
-  {
-    rdf[i] = rdf[i] / m_RdfRandom[i];
-  }
-
-  return rdf;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -2141,18 +2194,12 @@ float InsertPrecipitatePhases::check_RDFerror(int32_t gadd, int32_t gremove, boo
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& bhattdist)
 {
   bhattdist = 0;
   float sum_array1 = 0.0f;
   float sum_array2 = 0.0f;
 
-  //  for (std::vector<float>::iterator j=array1.begin(); j!=array1.end(); j++)
-  //  {sum_array1 += *j;}
-
-  //  for (std::vector<float>::iterator j=array2.begin(); j!=array2.end(); j++)
-  //  {sum_array2 += *j;}
-
   size_t array1Size = array1.size();
   for(size_t i = 0; i < array1Size; i++)
   {
@@ -2162,16 +2209,14 @@ void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1,
 
   for(size_t i = 0; i < array1Size; i++)
   {
-    array1[i] = array1[i] / sum_array1;
-    array2[i] = array2[i] / sum_array2;
-    bhattdist = bhattdist + sqrtf((array1[i] * array2[i]));
+    bhattdist = bhattdist + sqrtf(((array1[i] / sum_array1) * (array2[i] / sum_array2)));
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_2Ddistributions(std::vector<std::vector<float>> array1, std::vector<std::vector<float>> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_2Ddistributions(const std::vector<std::vector<float>>& array1, const std::vector<std::vector<float>>& array2, float& bhattdist)
 {
   bhattdist = 0;
   size_t array1Size = array1.size();
@@ -2188,36 +2233,26 @@ void InsertPrecipitatePhases::compare_2Ddistributions(std::vector<std::vector<fl
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void InsertPrecipitatePhases::compare_3Ddistributions(std::vector<std::vector<std::vector<float>>> array1, std::vector<std::vector<std::vector<float>>> array2, float& bhattdist)
+void InsertPrecipitatePhases::compare_3Ddistributions(const std::vector<std::vector<std::vector<float>>>& array1, const std::vector<std::vector<std::vector<float>>>& array2, float& bhattdist)
 {
   bhattdist = 0;
-  std::vector<std::vector<float>> counts1(array1.size());
-  std::vector<std::vector<float>> counts2(array2.size());
   size_t array1Size = array1.size();
   for(size_t i = 0; i < array1Size; i++)
   {
-    counts1[i].resize(array1[i].size());
-    counts2[i].resize(array2[i].size());
     size_t array2Size = array1[i].size();
     for(size_t j = 0; j < array2Size; j++)
     {
+      float count1 = 0.0f;
+      float count2 = 0.0f;
       size_t array3Size = array1[i][j].size();
       for(size_t k = 0; k < array3Size; k++)
       {
-        counts1[i][j] += array1[i][j][k];
-        counts2[i][j] += array2[i][j][k];
+        count1 += array1[i][j][k];
+        count2 += array2[i][j][k];
       }
-    }
-  }
-  for(size_t i = 0; i < array1Size; i++)
-  {
-    size_t array2Size = array1[i].size();
-    for(size_t j = 0; j < array2Size; j++)
-    {
-      size_t array3Size = array1[i][j].size();
       for(size_t k = 0; k < array3Size; k++)
       {
-        bhattdist = bhattdist + sqrtf(((array1[i][j][k] / counts1[i][j]) * (array2[i][j][k] / counts2[i][j])));
+        bhattdist = bhattdist + sqrtf(((array1[i][j][k] / count1) * (array2[i][j][k] / count2)));
       }
     }
   }
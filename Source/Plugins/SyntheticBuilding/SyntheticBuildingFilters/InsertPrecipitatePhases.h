@@ -358,11 +358,26 @@ protected:
   //    bool check_for_overlap(size_t gNum, Int32ArrayType::Pointer exlusionZonesPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between precipitate owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief update_availablepoints Updates the flat tables used to associate packing points with an "available" state
+   * @param availablePoints Slot in the available list for each packing point
+   * @param availablePointsInv Packing point stored in each slot of the available list
    */
-  void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  void update_availablepoints(std::vector<size_t>& availablePoints, std::vector<size_t>& availablePointsInv);
+
+  /**
+   * @brief initialize_rdfGrid Bins the precipitate centroids into a uniform grid of cells that are at
+   * least as large as the largest distance tracked by the radial distribution function, so that only
+   * the 27 surrounding cells need to be visited when a precipitate is added or removed. The grid never
+   * has more cells than there are precipitates
+   * @param numfeatures Number of Features, including the precipitates
+   */
+  void initialize_rdfGrid(size_t numfeatures);
+
+  /**
+   * @brief update_rdfGrid Moves a precipitate into the grid cell that contains its current centroid
+   * @param gnum Index for the precipitate
+   */
+  void update_rdfGrid(int32_t gnum);
 
   /**
    * @brief determine_currentRDF Determines the radial distribution function about a given precipitate
@@ -381,18 +396,6 @@ protected:
    */
   void determine_randomRDF(size_t gnum, int32_t add, bool double_count, int32_t largeNumber);
 
-  /**
-   * @brief normalizeRDF Normalizes a radial distribution function
-   * @param rdf RDF to normalize
-   * @param num_bins Number of bins in the discretized RDF
-   * @param stepsize Bin sted size for discretized RDF
-   * @param rdfmin Minimum value for RDF
-   * @param numPPTfeatures Number of precipiate Features
-   * @param volume Volume for a given precipitate
-   * @return Normalized RDF
-   */
-  std::vector<float> normalizeRDF(std::vector<float> rdf, int num_bins, float stepsize, float rdfmin, int32_t numPPTfeatures);
-
   /**
    * @brief check_RDFerror Computes the error between the current radial distribution function
    * and the goal radial distribution function
@@ -443,19 +446,19 @@ protected:
    * @brief compare_1Ddistributions Computes the 1D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare_1Ddistributions(std::vector<float>, std::vector<float>, float& sqrerror);
+  void compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float& sqrerror);
 
   /**
    * @brief compare_2Ddistributions Computes the 2D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare_2Ddistributions(std::vector<std::vector<float>>, std::vector<std::vector<float>>, float& sqrerror);
+  void compare_2Ddistributions(const std::vector<std::vector<float>>& array1, const std::vector<std::vector<float>>& array2, float& sqrerror);
 
   /**
    * @brief compare_3Ddistributions Computes the 3D Bhattacharyya distance
    * @param sqrerror Float 1D Bhattacharyya distance
    */
-  void compare_3Ddistributions(std::vector<std::vector<std::vector<float>>>, std::vector<std::vector<std::vector<float>>>, float& sqrerror);
+  void compare_3Ddistributions(const std::vector<std::vector<std::vector<float>>>& array1, const std::vector<std::vector<std::vector<float>>>& array2, float& sqrerror);
 
   /**
    * @brief Moves the temporary arrays that hold the inputs into the shape algorithms
@@ -530,6 +533,12 @@ private:
   std::vector<float> m_RandomCentroids;
   std::vector<float> m_RdfRandom;
 
+  size_t m_RdfTrackedBins;
+  float m_RdfGridCellSize;
+  int64_t m_RdfGridDims[3];
+  std::vector<std::vector<int32_t>> m_RdfGridCells;
+  std::vector<int64_t> m_RdfGridCellOfFeature;
+
   std::vector<float> m_FeatureSizeDistStep;
 
   std::vector<int64_t> m_GSizes;
@@ -35,6 +35,16 @@
 
 #include "MatchCrystallography.h"
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -58,6 +68,99 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+namespace
+{
+/**
+ * @brief The BinDeltaAccumulator class collects the changes a trial move would make to a
+ * binned distribution, so that the change in squared error can be evaluated exactly even
+ * when several of those changes land in the same bin
+ */
+class BinDeltaAccumulator
+{
+public:
+  explicit BinDeltaAccumulator(size_t numBins)
+  : m_Deltas(numBins, 0.0f)
+  , m_Touched(numBins, false)
+  {
+  }
+
+  void add(int32_t bin, float value)
+  {
+    if(!m_Touched[bin])
+    {
+      m_Touched[bin] = true;
+      m_Bins.push_back(bin);
+    }
+    m_Deltas[bin] += value;
+  }
+
+  /**
+   * @brief errorReduction Returns how much the squared error against the goal distribution
+   * would drop if the pending changes were applied to the simulated distribution
+   */
+  float errorReduction(const float* goal, const std::vector<float>& sim) const
+  {
+    float change = 0.0f;
+    for(const int32_t& bin : m_Bins)
+    {
+      float before = goal[bin] - sim[bin];
+      float after = before - m_Deltas[bin];
+      change = change + (before * before) - (after * after);
+    }
+    return change;
+  }
+
+  void apply(std::vector<float>& sim) const
+  {
+    for(const int32_t& bin : m_Bins)
+    {
+      sim[bin] += m_Deltas[bin];
+    }
+  }
+
+  void clear()
+  {
+    for(const int32_t& bin : m_Bins)
+    {
+      m_Deltas[bin] = 0.0f;
+      m_Touched[bin] = false;
+    }
+    m_Bins.clear();
+  }
+
+private:
+  std::vector<float> m_Deltas;
+  std::vector<bool> m_Touched;
+  std::vector<int32_t> m_Bins;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float squaredError(const float* goal, const std::vector<float>& sim)
+{
+  float error = 0.0f;
+  for(size_t i = 0; i < sim.size(); i++)
+  {
+    float delta = goal[i] - sim[i];
+    error = error + (delta * delta);
+  }
+  return error;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t misorientationBin(const LaueOps::Pointer& ops, QuatF q1, QuatF q2)
+{
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+  float w = ops->getMisoQuat(q1, q2, n1, n2, n3);
+  FOrientArrayType rod(4);
+  FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
+  return ops->getMisoBin(rod);
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -76,6 +179,7 @@ MatchCrystallography::MatchCrystallography()
 , m_FeatureEulerAnglesArrayName(SIMPL::FeatureData::EulerAngles)
 , m_AvgQuatsArrayName(SIMPL::FeatureData::AvgQuats)
 , m_MaxIterations(1)
+, m_NumberOfChains(1)
 , m_FeatureIds(nullptr)
 , m_CellEulerAngles(nullptr)
 , m_SurfaceFeatures(nullptr)
@@ -92,8 +196,6 @@ MatchCrystallography::MatchCrystallography()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
-
   m_ActualOdf = FloatArrayType::NullPointer();
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
@@ -115,6 +217,7 @@ void MatchCrystallography::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Maximum Number of Iterations (Swaps)", MaxIterations, FilterParameter::Parameter, MatchCrystallography));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Number of Independent Chains", NumberOfChains, FilterParameter::Parameter, MatchCrystallography));
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -191,6 +294,7 @@ void MatchCrystallography::readFilterParameters(AbstractFilterParametersReader*
 {
   reader->openFilterGroup(this, index);
   setMaxIterations(reader->readValue("MaxIterations", getMaxIterations()));
+  setNumberOfChains(reader->readValue("NumberOfChains", getNumberOfChains()));
   setInputStatsArrayPath(reader->readDataArrayPath("InputStatsArrayPath", getInputStatsArrayPath()));
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setPhaseTypesArrayPath(reader->readDataArrayPath("PhaseTypesArrayPath", getPhaseTypesArrayPath()));
@@ -216,7 +320,6 @@ void MatchCrystallography::initialize()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
   m_UnbiasedVolume.clear();
   m_TotalSurfaceArea.clear();
 
@@ -224,7 +327,10 @@ void MatchCrystallography::initialize()
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
   m_SimMdf = FloatArrayType::NullPointer();
-  m_MisorientationLists.clear();
+  m_FeatureOdfBins.clear();
+  m_NeighborPairIds.clear();
+  m_PairMisoBins.clear();
+  m_PairWeights.clear();
 
   m_OrientationOps = LaueOps::getOrientationOpsQVector();
 }
@@ -239,6 +345,13 @@ void MatchCrystallography::dataCheck()
   initialize();
   DataArrayPath tempPath;
 
+  if(getNumberOfChains() < 1)
+  {
+    QString ss = QObject::tr("The number of independent chains must be at least 1");
+    setErrorCondition(-55001);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
   getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getFeatureIdsArrayPath().getDataContainerName());
 
   QVector<size_t> cDims(1, 1);
@@ -494,6 +607,7 @@ void MatchCrystallography::initializeArrays(size_t ensem)
     return;
   }
 
+  m_OdfSampler.initialize(m_ActualOdf->getPointer(0), m_ActualOdf->getSize());
   m_SimOdf = FloatArrayType::CreateArray(m_ActualOdf->getSize(), SIMPL::StringConstants::ODF);
   m_SimMdf = FloatArrayType::CreateArray(m_ActualMdf->getSize(), SIMPL::StringConstants::MisorientationBins);
   for(size_t j = 0; j < m_SimOdf->getSize(); j++)
@@ -592,6 +706,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
   int32_t choose = 0, phase = 0;
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  m_FeatureOdfBins.resize(totalFeatures, -1);
 
   CubicOps cOps;
   HexagonalOps hOps;
@@ -624,6 +739,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
       }
 
       choose = pick_euler(random, numbins);
+      m_FeatureOdfBins[i] = choose;
 
       FOrientArrayType eulers = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, choose);
       eulers = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(eulers);
@@ -647,19 +763,10 @@ void MatchCrystallography::assign_eulers(size_t ensem)
 // -----------------------------------------------------------------------------
 int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
 {
-  int32_t choose = 0;
-  float totaldensity = 0.0f;
-
-  for(int32_t j = 0; j < numbins; j++)
+  int32_t choose = m_OdfSampler.sample(random);
+  if(choose >= numbins)
   {
-    float density = m_ActualOdf->getValue(j);
-    float td1 = totaldensity;
-    totaldensity = totaldensity + density;
-    if(random < totaldensity && random >= td1)
-    {
-      choose = j;
-      break;
-    }
+    choose = 0;
   }
   return choose;
 }
@@ -667,455 +774,254 @@ int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
+void MatchCrystallography::runChain(size_t ensem, uint64_t seed, ChainState& chain, bool reportProgress)
 {
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  FOrientArrayType rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
-  {
-    rod[3] = std::numeric_limits<float>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
-
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
-
-  FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin)) * (m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin))) -
-                               ((m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin)) * (m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin))) -
-                               ((m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
-{
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-  float miso1 = 0.0f, miso2 = 0.0f, miso3 = 0.0f;
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  FOrientArrayType rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
-  {
-    rod[3] = std::numeric_limits<float>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
-
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
-
-  FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MisorientationLists[feature][3 * j] = miso1;
-  m_MisorientationLists[feature][3 * j + 1] = miso2;
-  m_MisorientationLists[feature][3 * j + 2] = miso3;
-  m_SimMdf->setValue(curmisobin, (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
-  m_SimMdf->setValue(newmisobin, (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::matchCrystallography(size_t ensem)
-{
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-  NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  LaueOps::Pointer ops = m_OrientationOps[m_CrystalStructures[ensem]];
 
-  uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-  SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
+  SIMPL_RANDOMNG_NEW_SEEDED(seed);
 
-  int32_t numbins = 0;
-  int32_t iterations = 0, badtrycount = 0;
-  float random = 0.0f;
-  size_t counter = 0;
+  int32_t numbins = ops->getODFSize();
+  const float* actualOdf = m_ActualOdf->getPointer(0);
+  const float* actualMdf = m_ActualMdf->getPointer(0);
 
-  QuatF q1;
-  QuatF q2;
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  BinDeltaAccumulator odfDelta(chain.simOdf.size());
+  BinDeltaAccumulator mdfDelta(chain.simMdf.size());
+  std::vector<std::pair<int32_t, int32_t>> trialPairBins;
 
-  float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
-  float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
-  int32_t g1odfbin = 0, g2odfbin = 0;
-  float deltaerror = 0.0f;
-  float currentodferror = 0.0f, currentmdferror = 0.0f;
-  int32_t selectedfeature1 = 0, selectedfeature2 = 0;
-  iterations = 0;
-  badtrycount = 0;
-  if(Ebsd::CrystalStructure::Cubic_High == m_CrystalStructures[ensem])
-  {
-    numbins = 18 * 18 * 18;
-  }
-  if(Ebsd::CrystalStructure::Hexagonal_High == m_CrystalStructures[ensem])
-  {
-    numbins = 36 * 36 * 12;
-  }
+  // Walks forward from a random Feature to the first one of this phase that is not
+  // touching the surface; returns -1 if there is no such Feature
+  auto selectFeature = [&](int32_t exclude) -> int32_t {
+    size_t feature = static_cast<size_t>(rg.genrand_res53() * totalFeatures);
+    for(size_t counter = 0; counter < totalFeatures; counter++, feature++)
+    {
+      if(feature >= totalFeatures)
+      {
+        feature = feature - totalFeatures;
+      }
+      if(!m_SurfaceFeatures[feature] && m_FeaturePhases[feature] == static_cast<int32_t>(ensem) && static_cast<int32_t>(feature) != exclude)
+      {
+        return static_cast<int32_t>(feature);
+      }
+    }
+    return -1;
+  };
+
+  // Stages the MDF changes of giving 'feature' the orientation 'q'; only the cached
+  // bins of its own boundaries are touched, all other boundaries keep their bins
+  auto stageNeighborChanges = [&](int32_t feature, int32_t exclude, const QuatF& q) {
+    const std::vector<int32_t>& pairIds = m_NeighborPairIds[feature];
+    for(size_t j = 0; j < pairIds.size(); j++)
+    {
+      int32_t pair = pairIds[j];
+      int32_t neighbor = neighborlist[feature][j];
+      if(pair < 0 || neighbor == exclude)
+      {
+        continue;
+      }
+      int32_t curBin = chain.pairMisoBins[pair];
+      int32_t newBin = misorientationBin(ops, q, chain.quats[neighbor]);
+      if(newBin != curBin)
+      {
+        mdfDelta.add(curBin, -m_PairWeights[pair]);
+        mdfDelta.add(newBin, m_PairWeights[pair]);
+        trialPairBins.push_back(std::make_pair(pair, newBin));
+      }
+    }
+  };
+
+  auto acceptTrial = [&](float odfChange, float mdfChange) {
+    odfDelta.apply(chain.simOdf);
+    mdfDelta.apply(chain.simMdf);
+    chain.odfError = chain.odfError - odfChange;
+    chain.mdfError = chain.mdfError - mdfChange;
+    for(const std::pair<int32_t, int32_t>& pairBin : trialPairBins)
+    {
+      chain.pairMisoBins[pairBin.first] = pairBin.second;
+    }
+  };
+
+  chain.odfError = squaredError(actualOdf, chain.simOdf);
+  chain.mdfError = squaredError(actualMdf, chain.simMdf);
 
+  int32_t iterations = 0, badtrycount = 0;
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t startMillis = millis;
-  int32_t lastIteration = 0;
   while(badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
   {
-    m_Seed++;
-    uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    if(reportProgress)
     {
-      QString ss = QObject::tr("Swapping/Switching Orientations Iteration %1/%2").arg(iterations).arg(m_MaxIterations);
-      float timeDiff = ((float)iterations / (float)(currentMillis - startMillis));
-      float estimatedTime = (float)(m_MaxIterations - iterations) / timeDiff;
+      uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
+      if(currentMillis - millis > 1000)
+      {
+        QString ss = QObject::tr("Swapping/Switching Orientations Iteration %1/%2").arg(iterations).arg(m_MaxIterations);
+        float timeDiff = ((float)iterations / (float)(currentMillis - startMillis));
+        float estimatedTime = (float)(m_MaxIterations - iterations) / timeDiff;
 
-      ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+        ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
+        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
-      millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iterations;
+        millis = QDateTime::currentMSecsSinceEpoch();
+      }
     }
-    currentodferror = 0;
-    currentmdferror = 0;
-    float* actualOdfPtr = m_ActualOdf->getPointer(0);
-    float* simOdfPtr = m_SimOdf->getPointer(0);
-    float delta = 0.0f;
-    for(int32_t i = 0; i < numbins; i++)
+    if(getCancel())
     {
-      delta = actualOdfPtr[i] - simOdfPtr[i];
-      currentodferror = currentodferror + (delta * delta);
+      return;
     }
-    for(int32_t i = 0; i < (numbins); i++)
+
+    // The errors are tracked incrementally; re-accumulate them once every numbins iterations
+    // so round-off cannot build up, which keeps the amortized cost per iteration constant
+    if(iterations > 0 && iterations % numbins == 0)
     {
-      currentmdferror = currentmdferror + ((m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)) * (m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)));
+      chain.odfError = squaredError(actualOdf, chain.simOdf);
+      chain.mdfError = squaredError(actualMdf, chain.simMdf);
     }
+
     iterations++;
     badtrycount++;
-    random = static_cast<float>(rg.genrand_res53());
-
-    if(getCancel())
-    {
-      return;
-    }
+    seed++;
+    odfDelta.clear();
+    mdfDelta.clear();
+    trialPairBins.clear();
 
+    float random = static_cast<float>(rg.genrand_res53());
     if(random < 0.5) // SwapOutOrientation
     {
-      counter = 0;
-      selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      while((m_SurfaceFeatures[selectedfeature1] == true || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
-      {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
-      }
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      if(counter == totalFeatures)
+      int32_t selectedfeature1 = selectFeature(-1);
+      if(selectedfeature1 < 0)
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        break;
       }
-      else
-      {
-        ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-        ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-        ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-        FOrientArrayType rod(4, 0.0);
-        FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
-
-        g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-        random = static_cast<float>(rg.genrand_res53());
-        int32_t choose = 0;
-
-        choose = pick_euler(random, numbins);
-
-        FOrientArrayType g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, choose);
-        g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(g1ea);
-        FOrientArrayType quat(4, 0.0);
-        FOrientTransformsType::eu2qu(g1ea, quat);
-        q1 = quat.toQuaternion();
-
-        m_OdfChange = ((m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose)) * (m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose))) -
-                      ((m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                       (m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))));
-        m_OdfChange = m_OdfChange + (((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-                                     ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                                      (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-        m_MdfChange = 0;
-        size_t size = 0;
-        if(neighborlist[selectedfeature1].size() != 0)
-        {
-          size = neighborlist[selectedfeature1].size();
-        }
-        for(size_t j = 0; j < size; j++)
-        {
-          int32_t neighbor = neighborlist[selectedfeature1][j];
-          FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-          q1 = quat.toQuaternion();
-          float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-          MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-        }
 
-        deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-        if(deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          size = 0;
-          if(neighborlist[selectedfeature1].size() != 0)
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedfeature1][j];
-            FOrientArrayType quat(4);
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-          }
-        }
-      }
-      if(getCancel())
+      random = static_cast<float>(rg.genrand_res53());
+      int32_t choose = pick_euler(random, numbins);
+
+      FOrientArrayType g1ea = ops->determineEulerAngles(seed, choose);
+      g1ea = ops->randomizeEulerAngles(g1ea);
+      FOrientArrayType quat(4, 0.0);
+      FOrientTransformsType::eu2qu(g1ea, quat);
+      QuatF q1 = quat.toQuaternion();
+
+      float volFrac = m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem];
+      odfDelta.add(chain.odfBins[selectedfeature1], -volFrac);
+      odfDelta.add(choose, volFrac);
+      stageNeighborChanges(selectedfeature1, -1, q1);
+
+      float odfChange = odfDelta.errorReduction(actualOdf, chain.simOdf);
+      float mdfChange = mdfDelta.errorReduction(actualMdf, chain.simMdf);
+      float deltaerror = (odfChange / chain.odfError) + (mdfChange / chain.mdfError);
+      if(deltaerror > 0)
       {
-        return;
+        badtrycount = 0;
+        acceptTrial(odfChange, mdfChange);
+        chain.eulers[3 * selectedfeature1] = g1ea[0];
+        chain.eulers[3 * selectedfeature1 + 1] = g1ea[1];
+        chain.eulers[3 * selectedfeature1 + 2] = g1ea[2];
+        chain.quats[selectedfeature1] = q1;
+        chain.odfBins[selectedfeature1] = choose;
       }
     }
     else // SwitchOrientation
     {
-      counter = 0;
-      selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      while((m_SurfaceFeatures[selectedfeature1] == true || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
-      {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
-      }
-      if(selectedfeature1 >= totalFeatures)
+      int32_t selectedfeature1 = selectFeature(-1);
+      if(selectedfeature1 < 0)
       {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
+        break;
       }
-      if(counter == totalFeatures)
+      int32_t selectedfeature2 = selectFeature(selectedfeature1);
+      if(selectedfeature2 < 0)
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        break;
       }
-      else
+
+      float volFrac1 = m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem];
+      float volFrac2 = m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem];
+      odfDelta.add(chain.odfBins[selectedfeature1], volFrac2 - volFrac1);
+      odfDelta.add(chain.odfBins[selectedfeature2], volFrac1 - volFrac2);
+
+      // The boundary between the two Features (if any) keeps its misorientation
+      stageNeighborChanges(selectedfeature1, selectedfeature2, chain.quats[selectedfeature2]);
+      stageNeighborChanges(selectedfeature2, selectedfeature1, chain.quats[selectedfeature1]);
+
+      float odfChange = odfDelta.errorReduction(actualOdf, chain.simOdf);
+      float mdfChange = mdfDelta.errorReduction(actualMdf, chain.simMdf);
+      float deltaerror = (odfChange / chain.odfError) + (mdfChange / chain.mdfError);
+      if(deltaerror > 0)
       {
-        counter = 0;
-        selectedfeature2 = int32_t(rg.genrand_res53() * totalFeatures);
-        if(selectedfeature2 >= totalFeatures)
-        {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        while((m_SurfaceFeatures[selectedfeature2] == true || m_FeaturePhases[selectedfeature2] != static_cast<int32_t>(ensem) || selectedfeature2 == selectedfeature1) && counter < totalFeatures)
-        {
-          if(selectedfeature2 >= totalFeatures)
-          {
-            selectedfeature2 = selectedfeature2 - totalFeatures;
-          }
-          selectedfeature2++;
-          counter++;
-        }
-        if(selectedfeature2 >= totalFeatures)
+        badtrycount = 0;
+        acceptTrial(odfChange, mdfChange);
+        for(size_t k = 0; k < 3; k++)
         {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        if(counter == totalFeatures)
-        {
-          badtrycount = 10 * m_NumFeatures[ensem];
-        }
-        else
-        {
-          g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-          g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-          g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-          g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
-          g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
-          g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          FOrientArrayType rod(4);
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
-
-          g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature2]), 3), rod);
-          g2odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-
-          m_OdfChange =
-              ((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-              ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))) *
-               (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))));
-          m_OdfChange =
-              m_OdfChange +
-              (((m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin)) * (m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin))) -
-               ((m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                (m_ActualOdf->getValue(g2odfbin) -
-                 (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-          m_MdfChange = 0;
-
-          FOrientArrayType quat(4);
-          FOrientTransformsType::eu2qu(FOrientArrayType(g2ea1, g2ea2, g2ea3), quat);
-          q1 = quat.toQuaternion();
-
-          size_t size = 0;
-          if(neighborlist[selectedfeature1].size() != 0)
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int32_t neighbor = neighborlist[selectedfeature1][j];
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            if(neighbor != static_cast<int>(selectedfeature2))
-            {
-              MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
-
-          FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-          q1 = quat.toQuaternion();
-          size = 0;
-          if(neighborlist[selectedfeature2].size() != 0)
-          {
-            size = neighborlist[selectedfeature2].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            size_t neighbor = neighborlist[selectedfeature2][j];
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-            if(neighbor != selectedfeature1)
-            {
-              MC_LoopBody1(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
-
-          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-          if(deltaerror > 0)
-          {
-
-            badtrycount = 0;
-            m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
-            m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
-            m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-            m_SimOdf->setValue(g2odfbin, (m_SimOdf->getValue(g2odfbin) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem])));
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-            size = 0;
-            if(neighborlist[selectedfeature1].size() != 0)
-            {
-              size = neighborlist[selectedfeature1].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature1][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-              if(neighbor != selectedfeature2)
-              {
-                MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-            size = 0;
-            if(neighborlist[selectedfeature2].size() != 0)
-            {
-              size = neighborlist[selectedfeature2].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature2][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-              if(neighbor != selectedfeature1)
-              {
-                MC_LoopBody2(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-          }
+          std::swap(chain.eulers[3 * selectedfeature1 + k], chain.eulers[3 * selectedfeature2 + k]);
         }
+        std::swap(chain.quats[selectedfeature1], chain.quats[selectedfeature2]);
+        std::swap(chain.odfBins[selectedfeature1], chain.odfBins[selectedfeature2]);
       }
     }
-    if(getCancel())
+  }
+
+  chain.odfError = squaredError(actualOdf, chain.simOdf);
+  chain.mdfError = squaredError(actualMdf, chain.simMdf);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::matchCrystallography(size_t ensem)
+{
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+
+  // Every chain starts from the orientations handed out by assign_eulers
+  ChainState initialState;
+  initialState.eulers.assign(m_FeatureEulerAngles, m_FeatureEulerAngles + 3 * totalFeatures);
+  initialState.quats.assign(avgQuats, avgQuats + totalFeatures);
+  initialState.odfBins = m_FeatureOdfBins;
+  initialState.pairMisoBins = m_PairMisoBins;
+  initialState.simOdf.assign(m_SimOdf->getPointer(0), m_SimOdf->getPointer(0) + m_SimOdf->getSize());
+  initialState.simMdf.assign(m_SimMdf->getPointer(0), m_SimMdf->getPointer(0) + m_SimMdf->getSize());
+
+  size_t numChains = static_cast<size_t>(m_NumberOfChains);
+  std::vector<ChainState> chains(numChains, initialState);
+
+  // Space the chain seeds apart by the iteration count so no two chains ever
+  // hand determineEulerAngles the same seed
+  uint64_t seed = QDateTime::currentMSecsSinceEpoch();
+  uint64_t seedStride = static_cast<uint64_t>(m_MaxIterations) + 1;
+
+  if(numChains == 1)
+  {
+    runChain(ensem, seed, chains[0], true);
+  }
+  else
+  {
+    QString ss = QObject::tr("Swapping/Switching Orientations in %1 Independent Chains").arg(numChains);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+
+    if(doParallel)
     {
-      return;
+      std::shared_ptr<tbb::task_group> g(new tbb::task_group);
+      for(size_t c = 0; c < numChains; c++)
+      {
+        ChainState* chain = &(chains[c]);
+        uint64_t chainSeed = seed + c * seedStride;
+        g->run([this, ensem, chainSeed, chain] { runChain(ensem, chainSeed, *chain, false); });
+      }
+      g->wait(); // Wait for all the threads to complete before moving on.
+    }
+    else
+#endif
+    {
+      for(size_t c = 0; c < numChains; c++)
+      {
+        runChain(ensem, seed + c * seedStride, chains[c], false);
+      }
     }
   }
 
@@ -1124,6 +1030,30 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
     return;
   }
 
+  // Keep the chain that ended closest to the goal. Both errors are taken relative to the
+  // common starting point, the same way the acceptance test weighs the ODF against the MDF
+  float startOdfError = squaredError(m_ActualOdf->getPointer(0), initialState.simOdf);
+  float startMdfError = squaredError(m_ActualMdf->getPointer(0), initialState.simMdf);
+  size_t best = 0;
+  float bestScore = std::numeric_limits<float>::max();
+  for(size_t c = 0; c < numChains; c++)
+  {
+    float score = (startOdfError > 0.0f ? chains[c].odfError / startOdfError : chains[c].odfError) + (startMdfError > 0.0f ? chains[c].mdfError / startMdfError : chains[c].mdfError);
+    if(score < bestScore)
+    {
+      bestScore = score;
+      best = c;
+    }
+  }
+
+  const ChainState& winner = chains[best];
+  std::copy(winner.eulers.begin(), winner.eulers.end(), m_FeatureEulerAngles);
+  std::copy(winner.quats.begin(), winner.quats.end(), avgQuats);
+  std::copy(winner.simOdf.begin(), winner.simOdf.end(), m_SimOdf->getPointer(0));
+  std::copy(winner.simMdf.begin(), winner.simMdf.end(), m_SimMdf->getPointer(0));
+  m_FeatureOdfBins = winner.odfBins;
+  m_PairMisoBins = winner.pairMisoBins;
+
   for(size_t i = 0; i < totalPoints; i++)
   {
     m_CellEulerAngles[3 * i] = m_FeatureEulerAngles[3 * m_FeatureIds[i]];
@@ -1144,62 +1074,62 @@ void MatchCrystallography::measure_misorientations(size_t ensem)
   NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  LaueOps::Pointer ops = m_OrientationOps[m_CrystalStructures[ensem]];
 
-  uint32_t crys1 = 0;
-  int32_t mbin = 0;
-
-  m_MisorientationLists.resize(totalFeatures);
+  m_NeighborPairIds.resize(totalFeatures);
+  m_PairMisoBins.clear();
+  m_PairWeights.clear();
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
+    m_NeighborPairIds[i].clear();
     if(m_FeaturePhases[i] == ensem)
     {
-      if(m_MisorientationLists[i].size() != 0)
-      {
-        m_MisorientationLists[i].clear();
-      }
-      if(neighborlist[i].size() != 0)
+      m_NeighborPairIds[i].assign(neighborlist[i].size(), -1);
+    }
+  }
+
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    if(m_FeaturePhases[i] != ensem || m_SurfaceFeatures[i] == true)
+    {
+      continue;
+    }
+    size_t size = 0;
+    if(neighborlist[i].size() != 0 && neighborsurfacearealist[i].size() == neighborlist[i].size())
+    {
+      size = neighborlist[i].size();
+    }
+
+    for(size_t j = 0; j < size; j++)
+    {
+      int32_t nname = neighborlist[i][j];
+      if(m_FeaturePhases[nname] != ensem)
       {
-        m_MisorientationLists[i].assign(neighborlist[i].size() * 3, 0.0f);
+        continue;
       }
-      QuaternionMathF::Copy(avgQuats[i], q1);
-      crys1 = m_CrystalStructures[ensem];
-      size_t size = 0;
-      if(neighborlist[i].size() != 0 && neighborsurfacearealist[i].size() == neighborlist[i].size())
+      // Each boundary enters the MDF once, from the lower id unless the other Feature touches the surface
+      if(nname < static_cast<int32_t>(i) && m_SurfaceFeatures[nname] == false)
       {
-        size = neighborlist[i].size();
+        continue;
       }
 
-      for(size_t j = 0; j < size; j++)
+      int32_t pair = static_cast<int32_t>(m_PairWeights.size());
+      float weight = neighborsurfacearealist[i][j] / m_TotalSurfaceArea[ensem];
+      int32_t mbin = misorientationBin(ops, avgQuats[i], avgQuats[nname]);
+      m_PairWeights.push_back(weight);
+      m_PairMisoBins.push_back(mbin);
+      m_SimMdf->setValue(mbin, (m_SimMdf->getValue(mbin) + weight));
+
+      m_NeighborPairIds[i][j] = pair;
+      std::vector<int32_t>& otherPairIds = m_NeighborPairIds[nname];
+      for(size_t k = 0; k < otherPairIds.size(); k++)
       {
-        int32_t nname = neighborlist[i][j];
-        if(m_FeaturePhases[nname] == ensem)
-        {
-          w = 10000.0f;
-          float neighsurfarea = neighborsurfacearealist[i][j];
-          QuaternionMathF::Copy(avgQuats[nname], q2);
-          w = m_OrientationOps[crys1]->getMisoQuat(q1, q2, n1, n2, n3);
-          FOrientArrayType rod(4);
-          FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-          m_MisorientationLists[i][3 * j] = rod[0];
-          m_MisorientationLists[i][3 * j + 1] = rod[1];
-          m_MisorientationLists[i][3 * j + 2] = rod[2];
-          mbin = m_OrientationOps[crys1]->getMisoBin(rod);
-          if(m_SurfaceFeatures[i] == false && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname] == true))
-          {
-            m_SimMdf->setValue(mbin, (m_SimMdf->getValue(mbin) + (neighsurfarea / m_TotalSurfaceArea[m_FeaturePhases[i]])));
-          }
-        }
-        else
+        if(neighborlist[nname][k] == static_cast<int32_t>(i))
         {
-          m_MisorientationLists[i][3 * j] = -100;
-          m_MisorientationLists[i][3 * j + 1] = -100;
-          m_MisorientationLists[i][3 * j + 2] = -100;
+          otherPairIds[k] = pair;
+          break;
         }
       }
     }
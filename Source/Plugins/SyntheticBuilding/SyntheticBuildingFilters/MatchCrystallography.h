@@ -35,7 +35,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Texture/DiscreteDistributionSampler.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 #include "SIMPLib/DataArrays/StatsDataArray.h"
@@ -68,6 +71,7 @@ class SyntheticBuilding_EXPORT MatchCrystallography : public AbstractFilter
     PYB11_PROPERTY(QString FeatureEulerAnglesArrayName READ getFeatureEulerAnglesArrayName WRITE setFeatureEulerAnglesArrayName)
     PYB11_PROPERTY(QString AvgQuatsArrayName READ getAvgQuatsArrayName WRITE setAvgQuatsArrayName)
     PYB11_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
+    PYB11_PROPERTY(int NumberOfChains READ getNumberOfChains WRITE setNumberOfChains)
 public:
   SIMPL_SHARED_POINTERS(MatchCrystallography)
   SIMPL_FILTER_NEW_MACRO(MatchCrystallography)
@@ -120,6 +124,9 @@ public:
   SIMPL_FILTER_PARAMETER(int, MaxIterations)
   Q_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
 
+  SIMPL_FILTER_PARAMETER(int, NumberOfChains)
+  Q_PROPERTY(int NumberOfChains READ getNumberOfChains WRITE setNumberOfChains)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -245,7 +252,8 @@ protected:
   void assign_eulers(size_t ensem);
 
   /**
-   * @brief pick_euler Picks a random bin from the incoming orientation statistics
+   * @brief pick_euler Picks a random bin from the incoming orientation statistics with a binary search in the
+   * cumulative ODF, which is built once per phase in initializeArrays
    * @param random Key random value to compare for sampling
    * @param numbins Number of possible bins to sample
    * @return Integer value for bin index
@@ -253,38 +261,41 @@ protected:
   int32_t pick_euler(float random, int32_t numbins);
 
   /**
-   * @brief MC_LoopBody1 Determines the misorientation change after performing a swap
-   * @param feature Feature Id of Feature that has been swapped
-   * @param ensem Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaterions for the Feature
-   * @param q2 Quaterions for the Feature neighbor
+   * @brief The ChainState struct holds everything a single Monte Carlo chain mutates
+   * while swapping/switching orientations, so that several chains can run independently
    */
-  void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
+  struct ChainState
+  {
+    std::vector<float> eulers;
+    std::vector<QuatF> quats;
+    std::vector<int32_t> odfBins;
+    std::vector<int32_t> pairMisoBins;
+    std::vector<float> simOdf;
+    std::vector<float> simMdf;
+    float odfError = 0.0f;
+    float mdfError = 0.0f;
+  };
 
   /**
-   * @brief MC_LoopBody2 Reinserts the swapped orientation if the swap did not improve the fit
-   * @param feature Feature Id of the Feature that has been swapped
-   * @param phase Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaternions for the Feature
-   * @param q2 Quaternions for the Feature neighbor
+   * @brief runChain Performs the swap/switch Monte Carlo search on a single chain, updating
+   * the simulated ODF/MDF and the cached neighbor misorientation bins incrementally
+   * @param ensem Ensemble index of the current phase
+   * @param seed Seed for the random number generator of this chain
+   * @param chain Chain state to evolve
+   * @param reportProgress Whether this chain should emit progress messages
    */
-  void MC_LoopBody2(int32_t feature, size_t phase, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
+  void runChain(size_t ensem, uint64_t seed, ChainState& chain, bool reportProgress);
 
   /**
    * @brief matchCrystallography Swaps orientations for Features unitl convergence to
-   * the input statistics
+   * the input statistics, keeping the best of NumberOfChains independent chains
    * @param ensem Ensemble index of the current phase
    */
   void matchCrystallography(size_t ensem);
 
   /**
-   * @brief measure_misorientations Determines the misorientations between each Feature
+   * @brief measure_misorientations Determines the misorientations between each Feature and
+   * caches the misorientation bin and MDF weight of every neighboring Feature pair
    * @param ensem Ensemle index of the current phase
    */
   void measure_misorientations(size_t ensem);
@@ -311,18 +322,19 @@ private:
   StatsDataArray::WeakPointer m_StatsDataArray;
 
   // All other private instance variables
-  float m_MdfChange;
-  float m_OdfChange;
-
   std::vector<float> m_UnbiasedVolume;
   std::vector<float> m_TotalSurfaceArea;
 
   FloatArrayType::Pointer m_ActualOdf;
+  DiscreteDistributionSampler<float> m_OdfSampler;
   FloatArrayType::Pointer m_SimOdf;
   FloatArrayType::Pointer m_ActualMdf;
   FloatArrayType::Pointer m_SimMdf;
 
-  std::vector<std::vector<float>> m_MisorientationLists;
+  std::vector<int32_t> m_FeatureOdfBins;
+  std::vector<std::vector<int32_t>> m_NeighborPairIds;
+  std::vector<int32_t> m_PairMisoBins;
+  std::vector<float> m_PairWeights;
 
   QVector<LaueOps::Pointer> m_OrientationOps;
 
@@ -0,0 +1,703 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+// C Includes
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// C++ Includes
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
+// Qt Includes
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QProcess>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTemporaryFile>
+
+// DREAM3DLib includes
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/H5FilterParametersReader.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/SIMPLibVersion.h"
+
+#include "PipelineBenchmark.h"
+
+/**
+ * The PipelineBenchmark executable runs a list of pipelines once for every requested thread count and
+ * upscale factor and writes the wall time, the peak resident set size and the execution time of every
+ * filter to a JSON file, followed by a scaling summary for each pipeline. Every run executes in its own
+ * child process (the benchmark re-invoked with --run-output) so that the peak resident set size reported
+ * for a run is not masked by the high water mark of an earlier, larger run. Reconstruction pipelines can
+ * be run on synthetically upscaled data: once the first image geometry appears in the data container
+ * array it is resampled with ChangeResolution so every dimension larger than one cell is multiplied by
+ * the factor before the remaining filters execute.
+ *
+ * Pipelines in the list may form chains where a later pipeline reads a file written by an earlier one.
+ * Every configuration therefore runs the whole list in order, and a pipeline that reads the output of an
+ * earlier pipeline is not resampled again because its input was already upscaled at the head of the
+ * chain. The upscale factors run from largest to smallest so that, when a factor of 1 is requested, the
+ * files left in the output directories hold the full size results and not the upscaled ones.
+ *
+ * Usage: PipelineBenchmark [--threads 1,2,4] [--upscale 1,2] [--repeat N] [--output file.json] [pipeline ...]
+ *
+ * Without pipeline arguments the list configured at build time (the Workshop pipelines) is used. Like
+ * PipelineRunnerTest, the program must be run from the directory the pipelines' relative "Data/" paths
+ * resolve against.
+ */
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct BenchmarkOptions
+{
+  QVector<int> threadCounts;
+  QVector<int> upscaleFactors;
+  int repetitions = 1;
+  int repetitionIndex = 0;
+  bool upscaledInput = false;
+  QString outputFile;
+  QString runOutputFile;
+  QStringList pipelines;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double secondsSince(const Clock::time_point& start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// -----------------------------------------------------------------------------
+// Returns the high water mark of the resident set size of this process in KiB. The value is never reset,
+// which is why every benchmark run executes in a process of its own.
+// -----------------------------------------------------------------------------
+qint64 peakResidentSetSize()
+{
+#if defined(_MSC_VER)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+  {
+    return -1;
+  }
+  return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return -1;
+  }
+#if defined(__APPLE__)
+  return static_cast<qint64>(usage.ru_maxrss / 1024);
+#else
+  return static_cast<qint64>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> parseIntList(const QString& value, bool& ok)
+{
+  QVector<int> values;
+  QStringList tokens = value.split(',', QString::SkipEmptyParts);
+  for(const QString& token : tokens)
+  {
+    int v = token.trimmed().toInt(&ok);
+    if(!ok || v < 1)
+    {
+      ok = false;
+      return values;
+    }
+    values.push_back(v);
+  }
+  ok = !values.isEmpty();
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList readPipelineList(const QString& listFile)
+{
+  QStringList pipelines;
+  QFile source(listFile);
+  if(!source.open(QFile::ReadOnly))
+  {
+    return pipelines;
+  }
+  QString contents = source.readAll();
+  source.close();
+
+  QStringList lines = contents.split(QRegExp("\\n"));
+  for(QString line : lines)
+  {
+    line = line.trimmed();
+    if(!line.isEmpty())
+    {
+      pipelines.push_back(line);
+    }
+  }
+  return pipelines;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int parseArguments(int argc, char* argv[], BenchmarkOptions& options)
+{
+  options.threadCounts.push_back(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+  options.upscaleFactors.push_back(1);
+  options.outputFile = getBenchmarkOutputFile();
+
+  for(int i = 1; i < argc; i++)
+  {
+    QString arg = QString::fromLocal8Bit(argv[i]);
+    bool hasValue = (i + 1 < argc);
+    bool ok = true;
+    if(arg == "--threads" && hasValue)
+    {
+      options.threadCounts = parseIntList(QString::fromLocal8Bit(argv[++i]), ok);
+    }
+    else if(arg == "--upscale" && hasValue)
+    {
+      options.upscaleFactors = parseIntList(QString::fromLocal8Bit(argv[++i]), ok);
+    }
+    else if(arg == "--repeat" && hasValue)
+    {
+      options.repetitions = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+      ok = ok && options.repetitions > 0;
+    }
+    else if(arg == "--output" && hasValue)
+    {
+      options.outputFile = QString::fromLocal8Bit(argv[++i]);
+    }
+    else if(arg == "--run-output" && hasValue)
+    {
+      options.runOutputFile = QString::fromLocal8Bit(argv[++i]);
+    }
+    else if(arg == "--repetition-index" && hasValue)
+    {
+      options.repetitionIndex = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+      ok = ok && options.repetitionIndex >= 0;
+    }
+    else if(arg == "--upscaled-input")
+    {
+      options.upscaledInput = true;
+    }
+    else if(arg.startsWith("--"))
+    {
+      ok = false;
+    }
+    else
+    {
+      options.pipelines.push_back(arg);
+    }
+
+    if(!ok)
+    {
+      std::cout << "Invalid argument '" << arg.toStdString() << "'" << std::endl;
+      std::cout << "Usage: " << argv[0] << " [--threads 1,2,4] [--upscale 1,2] [--repeat N] [--output file.json] [pipeline ...]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if(options.pipelines.isEmpty())
+  {
+    options.pipelines = readPipelineList(getBenchmarkPipelineListFile());
+  }
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterPipeline::Pointer readPipeline(const QString& pipelineFile)
+{
+  QFileInfo fi(pipelineFile);
+  if(!fi.exists())
+  {
+    return FilterPipeline::NullPointer();
+  }
+  if(fi.completeSuffix() == "dream3d")
+  {
+    H5FilterParametersReader::Pointer dream3dReader = H5FilterParametersReader::New();
+    return dream3dReader->readPipelineFromFile(pipelineFile);
+  }
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  return jsonReader->readPipelineFromFile(pipelineFile);
+}
+
+// -----------------------------------------------------------------------------
+// Returns the absolute paths held by the given property of the filters in the pipeline, e.g. the files
+// written by "OutputFile" or read by "InputFile".
+// -----------------------------------------------------------------------------
+QSet<QString> pipelineFiles(const QString& pipelineFile, const char* propertyName)
+{
+  QSet<QString> files;
+  FilterPipeline::Pointer pipeline = readPipeline(pipelineFile);
+  if(nullptr == pipeline.get())
+  {
+    return files;
+  }
+  for(const AbstractFilter::Pointer& filter : pipeline->getFilterContainer())
+  {
+    QVariant value = filter->property(propertyName);
+    if(filter->getEnabled() && value.isValid() && !value.toString().isEmpty())
+    {
+      files.insert(QFileInfo(value.toString()).absoluteFilePath());
+    }
+  }
+  return files;
+}
+
+// -----------------------------------------------------------------------------
+// Returns for every pipeline whether it reads a file written by an earlier pipeline in the list.
+// -----------------------------------------------------------------------------
+QVector<bool> findChainedPipelines(const QStringList& pipelines)
+{
+  QVector<bool> chained;
+  QSet<QString> writtenFiles;
+  for(const QString& pipelineFile : pipelines)
+  {
+    QSet<QString> readFiles = pipelineFiles(pipelineFile, "InputFile");
+    chained.push_back(readFiles.intersect(writtenFiles).size() > 0);
+    writtenFiles.unite(pipelineFiles(pipelineFile, "OutputFile"));
+  }
+  return chained;
+}
+
+// -----------------------------------------------------------------------------
+// Resamples every image geometry that has not been upscaled yet so each dimension larger than one cell is
+// multiplied by factor; 2D geometries stay 2D. The names of the data containers that were handled are added
+// to upscaled.
+// -----------------------------------------------------------------------------
+int upscaleImageGeometries(const DataContainerArray::Pointer& dca, int factor, QSet<QString>& upscaled)
+{
+  IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryFromClassName("ChangeResolution");
+  if(nullptr == factory.get())
+  {
+    std::cout << "The ChangeResolution filter is needed to upscale pipelines but it could not be loaded." << std::endl;
+    return -1;
+  }
+
+  for(const DataContainer::Pointer& dc : dca->getDataContainers())
+  {
+    ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
+    if(nullptr == image.get() || upscaled.contains(dc->getName()))
+    {
+      continue;
+    }
+    for(const AttributeMatrix::Pointer& am : dc->getAttributeMatrices())
+    {
+      if(am->getType() != AttributeMatrix::Type::Cell)
+      {
+        continue;
+      }
+
+      size_t dims[3] = {0, 0, 0};
+      std::tie(dims[0], dims[1], dims[2]) = image->getDimensions();
+      FloatVec3_t resolution;
+      std::tie(resolution.x, resolution.y, resolution.z) = image->getResolution();
+      resolution.x = (dims[0] > 1) ? resolution.x / factor : resolution.x;
+      resolution.y = (dims[1] > 1) ? resolution.y / factor : resolution.y;
+      resolution.z = (dims[2] > 1) ? resolution.z / factor : resolution.z;
+
+      AbstractFilter::Pointer filter = factory->create();
+      filter->setDataContainerArray(dca);
+      filter->setProperty("CellAttributeMatrixPath", QVariant::fromValue(DataArrayPath(dc->getName(), am->getName(), "")));
+      filter->setProperty("Resolution", QVariant::fromValue(resolution));
+      filter->setProperty("RenumberFeatures", false);
+      filter->setProperty("SaveAsNewDataContainer", false);
+      filter->execute();
+      if(filter->getErrorCondition() < 0)
+      {
+        return filter->getErrorCondition();
+      }
+      upscaled.insert(dc->getName());
+      break;
+    }
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject benchmarkPipeline(const QString& pipelineFile, int threads, int upscale, bool upscaledInput, int repetition)
+{
+  QJsonObject run;
+  run["Pipeline"] = QFileInfo(pipelineFile).absoluteFilePath();
+  run["Threads"] = threads;
+  run["Upscale"] = upscale;
+  run["UpscaledInput"] = upscaledInput;
+  run["Repetition"] = repetition;
+
+  FilterPipeline::Pointer pipeline = readPipeline(pipelineFile);
+  if(nullptr == pipeline.get())
+  {
+    run["ErrorCondition"] = -1;
+    run["Error"] = QString("The pipeline file could not be read");
+    return run;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // The filters create their own default schedulers; those nest inside this one and inherit its size
+  tbb::task_scheduler_init init(threads);
+#endif
+
+  Clock::time_point start = Clock::now();
+  int err = pipeline->preflightPipeline();
+  run["PreflightTime"] = secondsSince(start);
+  if(err < 0)
+  {
+    run["ErrorCondition"] = err;
+    run["Error"] = QString("The pipeline failed to preflight");
+    return run;
+  }
+
+  // Execute the filters one at a time, in the same way FilterPipeline::execute() does, so each one can be timed
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  QSet<QString> upscaled;
+  QJsonArray filterTimes;
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  start = Clock::now();
+  int index = 0;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+    filter->setDataContainerArray(dca);
+    Clock::time_point filterStart = Clock::now();
+    filter->execute();
+    QJsonObject filterTime;
+    filterTime["Index"] = index++;
+    filterTime["Filter"] = filter->getNameOfClass();
+    filterTime["HumanLabel"] = filter->getHumanLabel();
+    filterTime["Time"] = secondsSince(filterStart);
+    filterTimes.push_back(filterTime);
+
+    err = filter->getErrorCondition();
+    if(err < 0)
+    {
+      break;
+    }
+
+    if(upscale > 1 && !upscaledInput)
+    {
+      int numUpscaled = upscaled.size();
+      filterStart = Clock::now();
+      err = upscaleImageGeometries(dca, upscale, upscaled);
+      if(err < 0)
+      {
+        break;
+      }
+      if(upscaled.size() > numUpscaled)
+      {
+        QJsonObject upscaleTime;
+        upscaleTime["Index"] = index++;
+        upscaleTime["Filter"] = QString("ChangeResolution");
+        upscaleTime["HumanLabel"] = QString("Benchmark Upscale");
+        upscaleTime["Time"] = secondsSince(filterStart);
+        filterTimes.push_back(upscaleTime);
+      }
+    }
+  }
+  run["WallTime"] = secondsSince(start);
+  run["PeakRSS_KiB"] = peakResidentSetSize();
+  run["ErrorCondition"] = err;
+  run["Filters"] = filterTimes;
+  return run;
+}
+
+// -----------------------------------------------------------------------------
+// Runs a single benchmark case in a child process and returns the run it reports, so that the peak
+// resident set size belongs to this case alone.
+// -----------------------------------------------------------------------------
+QJsonObject benchmarkPipelineInProcess(const QString& pipelineFile, int threads, int upscale, bool upscaledInput, int repetition)
+{
+  QJsonObject run;
+  run["Pipeline"] = QFileInfo(pipelineFile).absoluteFilePath();
+  run["Threads"] = threads;
+  run["Upscale"] = upscale;
+  run["UpscaledInput"] = upscaledInput;
+  run["Repetition"] = repetition;
+
+  QTemporaryFile runFile;
+  if(!runFile.open())
+  {
+    run["ErrorCondition"] = -1;
+    run["Error"] = QString("The temporary file for the run could not be created");
+    return run;
+  }
+  runFile.close();
+
+  QStringList arguments;
+  arguments << "--threads" << QString::number(threads) << "--upscale" << QString::number(upscale) << "--repetition-index" << QString::number(repetition) << "--run-output" << runFile.fileName();
+  if(upscaledInput)
+  {
+    arguments << "--upscaled-input";
+  }
+  arguments << pipelineFile;
+
+  QProcess process;
+  process.setProcessChannelMode(QProcess::ForwardedChannels);
+  process.start(QCoreApplication::applicationFilePath(), arguments);
+  if(!process.waitForFinished(-1) || process.exitStatus() != QProcess::NormalExit)
+  {
+    run["ErrorCondition"] = -1;
+    run["Error"] = QString("The benchmark process for the run did not finish");
+    return run;
+  }
+
+  QFile source(runFile.fileName());
+  if(!source.open(QFile::ReadOnly))
+  {
+    run["ErrorCondition"] = -1;
+    run["Error"] = QString("The benchmark process for the run did not report a result");
+    return run;
+  }
+  QJsonDocument doc = QJsonDocument::fromJson(source.readAll());
+  source.close();
+  if(!doc.isObject())
+  {
+    run["ErrorCondition"] = -1;
+    run["Error"] = QString("The benchmark process for the run reported an unreadable result");
+    return run;
+  }
+  return doc.object();
+}
+
+// -----------------------------------------------------------------------------
+// Summarizes the fastest repetition of every pipeline/upscale/thread configuration and its speedup
+// over the smallest thread count that was run for the same pipeline and upscale factor.
+// -----------------------------------------------------------------------------
+QJsonArray scalingReport(const QJsonArray& runs)
+{
+  using ConfigKey = std::pair<QString, int>;
+  std::map<ConfigKey, std::map<int, QJsonObject>> best;
+  for(const QJsonValue& value : runs)
+  {
+    QJsonObject run = value.toObject();
+    if(run["ErrorCondition"].toInt() < 0)
+    {
+      continue;
+    }
+    ConfigKey key(run["Pipeline"].toString(), run["Upscale"].toInt());
+    int threads = run["Threads"].toInt();
+    std::map<int, QJsonObject>& byThreads = best[key];
+    if(byThreads.count(threads) == 0 || run["WallTime"].toDouble() < byThreads[threads]["WallTime"].toDouble())
+    {
+      byThreads[threads] = run;
+    }
+  }
+
+  QJsonArray report;
+  for(const auto& config : best)
+  {
+    double baseTime = config.second.begin()->second["WallTime"].toDouble();
+    int baseThreads = config.second.begin()->first;
+    for(const auto& entry : config.second)
+    {
+      const QJsonObject& run = entry.second;
+      double wallTime = run["WallTime"].toDouble();
+
+      // Name the filter that took the largest share of the run
+      QString slowestFilter;
+      double slowestTime = -1.0;
+      for(const QJsonValue& filterValue : run["Filters"].toArray())
+      {
+        QJsonObject filterTime = filterValue.toObject();
+        if(filterTime["Time"].toDouble() > slowestTime)
+        {
+          slowestTime = filterTime["Time"].toDouble();
+          slowestFilter = filterTime["Filter"].toString();
+        }
+      }
+
+      QJsonObject row;
+      row["Pipeline"] = config.first.first;
+      row["Upscale"] = config.first.second;
+      row["Threads"] = entry.first;
+      row["WallTime"] = wallTime;
+      row["Speedup"] = (wallTime > 0.0) ? baseTime / wallTime : 0.0;
+      row["ParallelEfficiency"] = (wallTime > 0.0) ? (baseTime / wallTime) * baseThreads / entry.first : 0.0;
+      row["PeakRSS_KiB"] = run["PeakRSS_KiB"];
+      row["SlowestFilter"] = slowestFilter;
+      row["SlowestFilterFraction"] = (wallTime > 0.0) ? slowestTime / wallTime : 0.0;
+      report.push_back(row);
+    }
+  }
+  return report;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("PipelineBenchmark");
+
+  BenchmarkOptions options;
+  if(parseArguments(argc, argv, options) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  if(options.pipelines.isEmpty())
+  {
+    std::cout << "No pipelines to benchmark." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+  QMetaObjectUtilities::RegisterMetaTypes();
+
+  // A child process runs exactly one case and hands its result back through the run output file
+  if(!options.runOutputFile.isEmpty())
+  {
+    QJsonObject run = benchmarkPipeline(options.pipelines.front(), options.threadCounts.front(), options.upscaleFactors.front(), options.upscaledInput, options.repetitionIndex);
+    QFile runFile(options.runOutputFile);
+    if(!runFile.open(QFile::WriteOnly))
+    {
+      return EXIT_FAILURE;
+    }
+    runFile.write(QJsonDocument(run).toJson());
+    runFile.close();
+    return EXIT_SUCCESS;
+  }
+
+  // Every configuration runs the whole list in order so a chained pipeline always reads the output its
+  // predecessor wrote with the same upscale factor
+  QVector<bool> chained = findChainedPipelines(options.pipelines);
+  QVector<int> upscaleFactors = options.upscaleFactors;
+  std::sort(upscaleFactors.begin(), upscaleFactors.end(), std::greater<int>());
+
+  int err = EXIT_SUCCESS;
+  QJsonArray runs;
+  for(int upscale : upscaleFactors)
+  {
+    for(int threads : options.threadCounts)
+    {
+      for(int r = 0; r < options.repetitions; r++)
+      {
+        for(int p = 0; p < options.pipelines.size(); p++)
+        {
+          const QString& pipelineFile = options.pipelines[p];
+          QJsonObject run = benchmarkPipelineInProcess(pipelineFile, threads, upscale, chained[p], r);
+          int runError = run["ErrorCondition"].toInt();
+          std::cout << std::left << std::setw(60) << QFileInfo(pipelineFile).fileName().toStdString() << " threads " << std::setw(3) << threads << " upscale " << std::setw(2) << upscale
+                    << " wall " << std::fixed << std::setprecision(3) << run["WallTime"].toDouble() << " s  peak RSS " << run["PeakRSS_KiB"].toVariant().toLongLong() << " KiB";
+          if(runError < 0)
+          {
+            std::cout << "  FAILED (" << runError << ")";
+            err = EXIT_FAILURE;
+          }
+          std::cout << std::endl;
+          runs.push_back(run);
+        }
+      }
+    }
+  }
+
+  QJsonObject root;
+  root["Benchmark"] = QString("PipelineBenchmark");
+  root["SIMPLibVersion"] = SIMPLib::Version::Complete();
+  root["Date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+  root["HardwareConcurrency"] = static_cast<int>(std::thread::hardware_concurrency());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  root["ParallelAlgorithms"] = true;
+#else
+  root["ParallelAlgorithms"] = false;
+#endif
+  root["Runs"] = runs;
+  root["Scaling"] = scalingReport(runs);
+
+  QFile outFile(options.outputFile);
+  if(!outFile.open(QFile::WriteOnly))
+  {
+    std::cout << "The benchmark report could not be written to '" << options.outputFile.toStdString() << "'" << std::endl;
+    return EXIT_FAILURE;
+  }
+  outFile.write(QJsonDocument(root).toJson());
+  outFile.close();
+  std::cout << "Benchmark report written to " << QFileInfo(options.outputFile).absoluteFilePath().toStdString() << std::endl;
+
+  return err;
+}